@@ -0,0 +1,248 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#define BENCH_MAX_ITERATIONS (1ull << 40)
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Allocation counting. glibc lets a program replace malloc; forwarding to
+// the __libc_ entry points keeps one heap and also counts allocations made
+// inside libc on our behalf (fopen buffers and the like).
+static uint64_t g_allocs;
+
+#ifdef __GLIBC__
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+    g_allocs++;
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    g_allocs++;
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    g_allocs++;
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) {
+    __libc_free(ptr);
+}
+
+bool bench_allocs_available(void) {
+    return true;
+}
+#else
+bool bench_allocs_available(void) {
+    return false;
+}
+#endif
+
+// Hardware counters: cycles leads a group with instructions and cache
+// misses, so all three cover exactly the same interval
+enum { COUNTER_CYCLES, COUNTER_INSTRUCTIONS, COUNTER_CACHE_MISSES, COUNTER_COUNT };
+
+typedef struct {
+    int fds[COUNTER_COUNT];
+    int slot[COUNTER_COUNT];        // Position in the group read, or -1
+    int opened;
+} PerfGroup;
+
+static PerfGroup g_perf;
+static bool g_perf_ready;
+
+#ifdef __linux__
+static int perf_open(uint64_t config, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group_fd == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+#endif
+
+static void perf_init(void) {
+    if (g_perf_ready) return;
+    g_perf_ready = true;
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        g_perf.fds[i] = -1;
+        g_perf.slot[i] = -1;
+    }
+#ifdef __linux__
+    static const uint64_t configs[COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        int fd = perf_open(configs[i], g_perf.opened ? g_perf.fds[0] : -1);
+        if (fd < 0) {
+            if (i == 0) return;     // No leader, no group
+            continue;
+        }
+        g_perf.fds[i] = fd;
+        g_perf.slot[i] = g_perf.opened++;
+    }
+#endif
+}
+
+bool bench_perf_available(void) {
+    perf_init();
+    return g_perf.opened > 0;
+}
+
+static void perf_start(void) {
+#ifdef __linux__
+    if (g_perf.opened == 0) return;
+    ioctl(g_perf.fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(g_perf.fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+// values[i] = -1 for counters that are not running
+static void perf_stop(double* values) {
+    for (int i = 0; i < COUNTER_COUNT; i++) values[i] = -1.0;
+#ifdef __linux__
+    if (g_perf.opened == 0) return;
+    ioctl(g_perf.fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    uint64_t data[1 + COUNTER_COUNT];
+    ssize_t size = read(g_perf.fds[0], data, sizeof(data));
+    if (size < (ssize_t)sizeof(uint64_t)) return;
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        if (g_perf.slot[i] >= 0 && (uint64_t)g_perf.slot[i] < data[0]) {
+            values[i] = (double)data[1 + g_perf.slot[i]];
+        }
+    }
+#endif
+}
+
+static double time_call(const BenchCase* bench_case, void* context, uint64_t iterations) {
+    double start = now_seconds();
+    bench_case->run(context, iterations);
+    return now_seconds() - start;
+}
+
+void bench_run_case(const BenchCase* bench_case, const BenchOptions* options, BenchResult* result) {
+    perf_init();
+    memset(result, 0, sizeof(*result));
+    result->name = bench_case->name;
+    void* context = bench_case->setup ? bench_case->setup() : NULL;
+
+    // Calibrate: grow until one call is long enough to time reliably
+    double calibrate = options->min_seconds / 10.0;
+    uint64_t iterations = 1;
+    double elapsed = time_call(bench_case, context, iterations);
+    while (elapsed < calibrate && iterations < BENCH_MAX_ITERATIONS) {
+        iterations *= 2;
+        elapsed = time_call(bench_case, context, iterations);
+    }
+    if (elapsed > 0.0 && elapsed < options->min_seconds) {
+        double scaled = (double)iterations * options->min_seconds / elapsed;
+        iterations = scaled < (double)BENCH_MAX_ITERATIONS ? (uint64_t)scaled : BENCH_MAX_ITERATIONS;
+    }
+
+    result->iterations = iterations;
+    result->ns_per_op = -1.0;
+    for (uint32_t rep = 0; rep < options->repetitions; rep++) {
+        double counters[COUNTER_COUNT];
+        uint64_t allocs_before = g_allocs;
+        perf_start();
+        double seconds = time_call(bench_case, context, iterations);
+        perf_stop(counters);
+        uint64_t allocs = g_allocs - allocs_before;
+
+        double ns = seconds * 1e9 / (double)iterations;
+        if (result->ns_per_op >= 0.0 && ns >= result->ns_per_op) continue;
+        result->ns_per_op = ns;
+        result->allocs_per_op = bench_allocs_available() ? (double)allocs / (double)iterations : -1.0;
+        result->cycles_per_op = counters[COUNTER_CYCLES] >= 0 ? counters[COUNTER_CYCLES] / iterations : -1.0;
+        result->instructions_per_op =
+            counters[COUNTER_INSTRUCTIONS] >= 0 ? counters[COUNTER_INSTRUCTIONS] / iterations : -1.0;
+        result->cache_misses_per_op =
+            counters[COUNTER_CACHE_MISSES] >= 0 ? counters[COUNTER_CACHE_MISSES] / iterations : -1.0;
+    }
+
+    if (bench_case->teardown) bench_case->teardown(context);
+}
+
+static void print_metric(double value, const char* format) {
+    if (value < 0.0) {
+        printf("%12s", "-");
+    } else {
+        printf(format, value);
+    }
+}
+
+void bench_print_table(const BenchResult* results, uint32_t count) {
+    printf("%-36s %12s %12s %12s %12s %12s\n", "benchmark", "ns/op", "allocs/op", "cycles/op",
+           "instr/op", "cmiss/op");
+    for (uint32_t i = 0; i < count; i++) {
+        const BenchResult* r = &results[i];
+        printf("%-36s %12.2f ", r->name, r->ns_per_op);
+        print_metric(r->allocs_per_op, "%12.3f");
+        printf(" ");
+        print_metric(r->cycles_per_op, "%12.1f");
+        printf(" ");
+        print_metric(r->instructions_per_op, "%12.1f");
+        printf(" ");
+        print_metric(r->cache_misses_per_op, "%12.3f");
+        printf("\n");
+    }
+    if (!bench_perf_available()) {
+        printf("\nHardware counters unavailable (perf_event_open refused)\n");
+    }
+}
+
+static void print_json_number(double value) {
+    if (value < 0.0) {
+        printf("null");
+    } else {
+        printf("%.6g", value);
+    }
+}
+
+void bench_print_json(const BenchResult* results, uint32_t count) {
+    printf("{\n  \"perf_counters\": %s,\n  \"allocation_counting\": %s,\n  \"benchmarks\": [\n",
+           bench_perf_available() ? "true" : "false", bench_allocs_available() ? "true" : "false");
+    for (uint32_t i = 0; i < count; i++) {
+        const BenchResult* r = &results[i];
+        printf("    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": ", r->name,
+               (unsigned long long)r->iterations);
+        print_json_number(r->ns_per_op);
+        printf(", \"allocs_per_op\": ");
+        print_json_number(r->allocs_per_op);
+        printf(", \"cycles_per_op\": ");
+        print_json_number(r->cycles_per_op);
+        printf(", \"instructions_per_op\": ");
+        print_json_number(r->instructions_per_op);
+        printf(", \"cache_misses_per_op\": ");
+        print_json_number(r->cache_misses_per_op);
+        printf("}%s\n", i + 1 < count ? "," : "");
+    }
+    printf("  ]\n}\n");
+}
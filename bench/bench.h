@@ -0,0 +1,56 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Microbenchmark harness for combocounter_bench.
+//
+// Each case runs `iterations` operations per call. The harness doubles the
+// count until a call takes a measurable time, scales it to the requested
+// duration, then keeps the fastest of a few measured calls. Around each
+// measured call it counts heap allocations (glibc builds replace malloc
+// and friends with counting forwarders) and, on Linux, reads cycles,
+// instructions and cache misses from one perf_event_open group. Counters
+// the kernel refuses (perf_event_paranoid, containers) report -1.
+
+typedef struct {
+    const char* name;
+    void* (*setup)(void);                           // May be NULL
+    void (*run)(void* context, uint64_t iterations);
+    void (*teardown)(void* context);                // May be NULL
+} BenchCase;
+
+typedef struct {
+    const char* name;
+    uint64_t iterations;
+    double ns_per_op;
+    double allocs_per_op;           // -1 when allocations cannot be counted
+    double cycles_per_op;           // -1 when the counter is unavailable
+    double instructions_per_op;
+    double cache_misses_per_op;
+} BenchResult;
+
+typedef struct {
+    double min_seconds;             // Per measured call
+    uint32_t repetitions;           // Measured calls; the fastest is kept
+} BenchOptions;
+
+extern const BenchCase bench_desktop_cases[];
+extern const uint32_t bench_desktop_case_count;
+extern const BenchCase bench_embedded_cases[];
+extern const uint32_t bench_embedded_case_count;
+
+void bench_run_case(const BenchCase* bench_case, const BenchOptions* options, BenchResult* result);
+bool bench_perf_available(void);
+bool bench_allocs_available(void);
+
+void bench_print_table(const BenchResult* results, uint32_t count);
+void bench_print_json(const BenchResult* results, uint32_t count);
+
+// Keep a value alive so the optimizer cannot drop the work behind it
+static inline void bench_keep(const void* value) {
+    __asm__ volatile("" : : "g"(value) : "memory");
+}
+
+#endif // BENCH_H
@@ -0,0 +1,451 @@
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core.h"
+#include "combo_table.h"
+#include "combo_format.h"
+#include "objective_stream.h"
+#include "sync_worker.h"
+#include "session.h"
+#include "session_replay.h"
+
+// Desktop tracker core: hit path, per-frame update, whole-file save/load,
+// the struct-of-arrays table at scale, objective decoding and session replay
+
+#define BENCH_TRACKERS MAX_TRACKERS
+#define BENCH_OBJECTIVES 4
+#define BENCH_SAVE_FILE "combocounter_bench_trackers.dat"
+#define BENCH_TABLE_TRACKERS 10000
+#define BENCH_FRAME_DT (1.0f / 60.0f)
+#define BENCH_HIT_EVENTS 65536
+#define BENCH_HIT_BATCH 256
+#define BENCH_CATALOG_TRACKERS 10
+#define BENCH_CATALOG_OBJECTIVES 10000
+#define BENCH_CATALOG_CHUNK 16384
+#define BENCH_SESSION_FILE "combocounter_bench_session.bin"
+#define BENCH_SESSION_TRACKERS 6
+#define BENCH_SESSION_SECONDS 3600
+#define BENCH_SESSION_FPS 60
+
+typedef struct {
+    ComboState trackers[BENCH_TRACKERS];
+    ComboState loaded[BENCH_TRACKERS];
+} DesktopBench;
+
+static void* setup_trackers(void) {
+    DesktopBench* bench = calloc(1, sizeof(DesktopBench));
+    Objective objectives[BENCH_OBJECTIVES];
+    for (int i = 0; i < BENCH_OBJECTIVES; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "Objective %d", i);
+        objective_init(&objectives[i], name, "Reach the target score", 100 * (i + 1));
+    }
+    for (int t = 0; t < BENCH_TRACKERS; t++) {
+        char label[32];
+        snprintf(label, sizeof(label), "Tracker %d", t);
+        combo_init(&bench->trackers[t], label);
+        combo_set_objectives(&bench->trackers[t], objectives, BENCH_OBJECTIVES);
+        // A 30 s interval keeps the per-frame countdown busy, completing
+        // once every 1800 frames like a real workout timer
+        interval_tracker_add(&bench->trackers[t].interval_tracker, "Work", 30, 1000000);
+        combo_resume(&bench->trackers[t]);
+    }
+    return bench;
+}
+
+static void teardown_trackers(void* context) {
+    DesktopBench* bench = context;
+    for (int t = 0; t < BENCH_TRACKERS; t++) {
+        combo_release(&bench->trackers[t]);
+    }
+    remove(BENCH_SAVE_FILE);
+    free(bench);
+}
+
+static void run_increment(void* context, uint64_t iterations) {
+    ComboState* state = &((DesktopBench*)context)->trackers[0];
+    state->score = 0;
+    for (uint64_t i = 0; i < iterations; i++) {
+        combo_increment(state, 1);
+    }
+    bench_keep(state);
+}
+
+static void run_update(void* context, uint64_t iterations) {
+    DesktopBench* bench = context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        for (int t = 0; t < BENCH_TRACKERS; t++) {
+            combo_update(&bench->trackers[t], 1.0f / 60.0f);
+        }
+    }
+    bench_keep(bench->trackers);
+}
+
+static void run_save(void* context, uint64_t iterations) {
+    DesktopBench* bench = context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        combo_save_all_trackers(bench->trackers, BENCH_TRACKERS, BENCH_SAVE_FILE);
+    }
+}
+
+static void* setup_saved_trackers(void) {
+    DesktopBench* bench = setup_trackers();
+    combo_save_all_trackers(bench->trackers, BENCH_TRACKERS, BENCH_SAVE_FILE);
+    return bench;
+}
+
+static void run_load(void* context, uint64_t iterations) {
+    DesktopBench* bench = context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        int count = combo_load_all_trackers(bench->loaded, BENCH_TRACKERS, BENCH_SAVE_FILE);
+        for (int t = 0; t < count; t++) {
+            combo_release(&bench->loaded[t]);
+        }
+    }
+}
+
+// Per-frame cost at scale: the ComboState loop polls every interval, the
+// table's timer wheel only does work for intervals that complete, and the
+// bulk settle folds lazy decay into every tracker at once.
+
+typedef struct {
+    ComboState* states;
+    ComboStateTable table;
+    double now;
+} TableBench;
+
+static void* setup_table(void) {
+    TableBench* bench = calloc(1, sizeof(TableBench));
+    bench->states = malloc(sizeof(ComboState) * BENCH_TABLE_TRACKERS);
+    combo_table_init(&bench->table, BENCH_TABLE_TRACKERS);
+    srand(1234);
+    for (uint32_t i = 0; i < BENCH_TABLE_TRACKERS; i++) {
+        ComboState* state = &bench->states[i];
+        combo_init(state, "Bench");
+        combo_table_add(&bench->table, "Bench");
+        if (i % 8 == 0) {
+            interval_tracker_add(&state->interval_tracker, "Set", 30, 3);
+            combo_table_set_interval(&bench->table, i, "Set", 30, 3);
+        }
+        if (rand() % 4) {
+            combo_resume(state);
+            combo_table_resume(&bench->table, i);
+        }
+        int hits = rand() % 10;
+        for (int h = 0; h < hits; h++) {
+            combo_table_increment(&bench->table, i, 1);
+        }
+    }
+    bench->now = combo_clock_now();
+    return bench;
+}
+
+static void teardown_table(void* context) {
+    TableBench* bench = context;
+    for (uint32_t i = 0; i < BENCH_TABLE_TRACKERS; i++) {
+        combo_release(&bench->states[i]);
+    }
+    free(bench->states);
+    combo_table_free(&bench->table);
+    free(bench);
+}
+
+static void run_update_states(void* context, uint64_t iterations) {
+    TableBench* bench = context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        for (uint32_t t = 0; t < BENCH_TABLE_TRACKERS; t++) {
+            combo_update(&bench->states[t], BENCH_FRAME_DT);
+        }
+    }
+    bench_keep(bench->states);
+}
+
+static void run_update_table(void* context, uint64_t iterations) {
+    TableBench* bench = context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        combo_update_all(&bench->table, BENCH_FRAME_DT);
+    }
+    bench_keep(bench->table.score);
+}
+
+static void run_settle_all(void* context, uint64_t iterations) {
+    TableBench* bench = context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench->now += BENCH_FRAME_DT;
+        combo_table_settle_all(&bench->table, bench->now);
+    }
+    bench_keep(bench->table.combo);
+}
+
+static void run_settle_all_scalar(void* context, uint64_t iterations) {
+    TableBench* bench = context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench->now += BENCH_FRAME_DT;
+        combo_table_settle_all_scalar(&bench->table, bench->now);
+    }
+    bench_keep(bench->table.combo);
+}
+
+// Hit ingestion, one operation per hit: combo_increment reads the clock
+// on every call, combo_increment_batch takes timestamped events. The
+// tracker restarts when the event stream wraps.
+
+typedef struct {
+    HitEvent events[BENCH_HIT_EVENTS];
+    ComboState state;
+    Objective goal;
+    uint32_t cursor;
+} HitBench;
+
+static double g_hit_now = 0.0;
+static double hit_clock(void) { return g_hit_now; }
+
+static void restart_hit_tracker(HitBench* bench) {
+    combo_release(&bench->state);
+    g_hit_now = 0.0;
+    combo_init(&bench->state, "Bench");
+    combo_set_objectives(&bench->state, &bench->goal, 1);
+    combo_resume(&bench->state);
+    bench->cursor = 0;
+}
+
+static void* setup_hits(void) {
+    HitBench* bench = calloc(1, sizeof(HitBench));
+    srand(1234);
+    double t = 1.0;
+    for (uint32_t i = 0; i < BENCH_HIT_EVENTS; i++) {
+        t += (rand() % 100 == 0) ? 6.0 : 0.05;
+        bench->events[i].time = t;
+        bench->events[i].amount = 1 + (uint32_t)(rand() % 5);
+        bench->events[i].type = (rand() % 30 == 0) ? HIT_EVENT_MISS : HIT_EVENT_HIT;
+    }
+    objective_init(&bench->goal, "Goal", "Bench objective", 1000000000);
+    combo_set_clock(hit_clock);
+    restart_hit_tracker(bench);
+    return bench;
+}
+
+static void teardown_hits(void* context) {
+    HitBench* bench = context;
+    combo_release(&bench->state);
+    combo_set_clock(NULL);
+    free(bench);
+}
+
+static void run_hits_single(void* context, uint64_t iterations) {
+    HitBench* bench = context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        if (bench->cursor == BENCH_HIT_EVENTS) restart_hit_tracker(bench);
+        const HitEvent* event = &bench->events[bench->cursor++];
+        g_hit_now = event->time;
+        if (event->type == HIT_EVENT_MISS) {
+            combo_decrement(&bench->state, event->amount);
+        } else {
+            combo_increment(&bench->state, event->amount);
+        }
+    }
+    bench_keep(&bench->state);
+}
+
+static void run_hits_batch(void* context, uint64_t iterations) {
+    HitBench* bench = context;
+    while (iterations > 0) {
+        if (bench->cursor == BENCH_HIT_EVENTS) restart_hit_tracker(bench);
+        uint32_t n = BENCH_HIT_BATCH;
+        if (n > BENCH_HIT_EVENTS - bench->cursor) n = BENCH_HIT_EVENTS - bench->cursor;
+        if (n > iterations) n = (uint32_t)iterations;
+        combo_increment_batch(&bench->state, bench->events + bench->cursor, n);
+        bench->cursor += n;
+        iterations -= n;
+    }
+    bench_keep(&bench->state);
+}
+
+// Decoding a 10k-objective catalog, one operation per payload: fed in
+// network-sized chunks to the streaming decoder (catalog sink, as the sync
+// worker does) versus applied from one buffer straight into pooled trackers
+
+typedef struct {
+    char* json;
+    size_t size;
+    ComboPool pool;
+    ComboState trackers[BENCH_CATALOG_TRACKERS];
+} CatalogBench;
+
+static void* setup_catalog(void) {
+    CatalogBench* bench = calloc(1, sizeof(CatalogBench));
+    bench->json = malloc((size_t)BENCH_CATALOG_OBJECTIVES * 160 + 1024);
+    char* json = bench->json;
+    size_t at = 0;
+    at += (size_t)sprintf(json + at, "{");
+    for (int t = 0; t < BENCH_CATALOG_TRACKERS; t++) {
+        at += (size_t)sprintf(json + at, "%s\"Tracker %d\":[", t ? "," : "", t);
+        for (int i = 0; i < BENCH_CATALOG_OBJECTIVES / BENCH_CATALOG_TRACKERS; i++) {
+            at += (size_t)sprintf(json + at,
+                                  "%s{\"name\":\"Objective %d-%d\",\"description\":\"Reach the \\\"%d\\\" mark\","
+                                  "\"target_score\":%d}",
+                                  i ? "," : "", t, i, i * 10, 100 + i);
+        }
+        at += (size_t)sprintf(json + at, "]");
+    }
+    at += (size_t)sprintf(json + at, "}");
+    bench->size = at;
+
+    combo_pool_init(&bench->pool, 0);
+    for (int t = 0; t < BENCH_CATALOG_TRACKERS; t++) {
+        char label[MAX_LABEL_LENGTH];
+        snprintf(label, sizeof(label), "Tracker %d", t);
+        combo_init(&bench->trackers[t], label);
+        combo_set_pool(&bench->trackers[t], &bench->pool);
+    }
+    return bench;
+}
+
+static void teardown_catalog(void* context) {
+    CatalogBench* bench = context;
+    for (int t = 0; t < BENCH_CATALOG_TRACKERS; t++) {
+        combo_release(&bench->trackers[t]);
+    }
+    combo_pool_destroy(&bench->pool);
+    free(bench->json);
+    free(bench);
+}
+
+static void run_catalog_stream(void* context, uint64_t iterations) {
+    CatalogBench* bench = context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        ObjectiveCatalog catalog;
+        objective_catalog_init(&catalog);
+        ObjectiveStream stream;
+        objective_stream_init(&stream, objective_catalog_sink(&catalog));
+        for (size_t at = 0; at < bench->size; at += BENCH_CATALOG_CHUNK) {
+            size_t left = bench->size - at;
+            objective_stream_feed(&stream, bench->json + at, left < BENCH_CATALOG_CHUNK ? left : BENCH_CATALOG_CHUNK);
+        }
+        objective_stream_finish(&stream);
+        bench_keep(&catalog);
+        objective_catalog_free(&catalog);
+    }
+}
+
+static void run_catalog_apply(void* context, uint64_t iterations) {
+    CatalogBench* bench = context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        combo_sync_apply_objectives(bench->trackers, BENCH_CATALOG_TRACKERS, bench->json, bench->size);
+    }
+    bench_keep(bench->trackers);
+}
+
+// Headless replay of a synthesized hour at 60 fps with a few inputs per
+// second, one operation per whole session. COMBO_BENCH_SESSION points the
+// cases at a recorded desktop session instead.
+
+typedef struct {
+    const char* path;
+    bool synthesized;
+    SessionLog log;
+    ComboState trackers[MAX_TRACKERS];
+} SessionBench;
+
+static bool synthesize_session(const char* path) {
+    ComboState trackers[BENCH_SESSION_TRACKERS];
+    for (int i = 0; i < BENCH_SESSION_TRACKERS; i++) {
+        char label[32];
+        snprintf(label, sizeof(label), "Tracker %d", i);
+        combo_init(&trackers[i], label);
+        combo_resume(&trackers[i]);
+    }
+    ByteWriter base;
+    writer_init(&base, 1024);
+    combo_format_encode(&base, trackers, BENCH_SESSION_TRACKERS, 0);
+    for (int i = 0; i < BENCH_SESSION_TRACKERS; i++) combo_release(&trackers[i]);
+
+    uint64_t time_us = 5000000000ULL;
+    SessionRecorder recorder;
+    bool opened = session_recorder_open(&recorder, path, SESSION_SOURCE_DESKTOP, base.data, (uint32_t)base.size,
+                                        time_us);
+    writer_free(&base);
+    if (!opened) return false;
+
+    srand(3);
+    for (int frame = 0; frame < BENCH_SESSION_SECONDS * BENCH_SESSION_FPS; frame++) {
+        float dt = 1.0f / BENCH_SESSION_FPS;
+        time_us += (uint64_t)(dt * 1e6f);
+        session_record_frame(&recorder, time_us, dt);
+        if (rand() % 20 == 0) {
+            SessionEvent event = {time_us, 1, (uint16_t)(rand() % BENCH_SESSION_TRACKERS), SESSION_OP_HIT, 0};
+            if (rand() % 5 == 0) event.op = SESSION_OP_DECREMENT;
+            session_record(&recorder, &event);
+        }
+    }
+    return session_recorder_close(&recorder);
+}
+
+static void* setup_session(void) {
+    SessionBench* bench = calloc(1, sizeof(SessionBench));
+    bench->path = getenv("COMBO_BENCH_SESSION");
+    if (!bench->path) {
+        bench->path = BENCH_SESSION_FILE;
+        bench->synthesized = synthesize_session(bench->path);
+    }
+    if (!session_load(&bench->log, bench->path)) {
+        fprintf(stderr, "Cannot read session %s\n", bench->path);
+        exit(1);
+    }
+    return bench;
+}
+
+static void teardown_session(void* context) {
+    SessionBench* bench = context;
+    session_log_free(&bench->log);
+    if (bench->synthesized) remove(bench->path);
+    free(bench);
+}
+
+static void run_session_load(void* context, uint64_t iterations) {
+    SessionBench* bench = context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        SessionLog log;
+        if (session_load(&log, bench->path)) {
+            bench_keep(&log);
+            session_log_free(&log);
+        }
+    }
+}
+
+static void run_session_replay(void* context, uint64_t iterations) {
+    SessionBench* bench = context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        int count = session_replay_load_base(&bench->log, bench->trackers, MAX_TRACKERS);
+        if (count < 0) {
+            fprintf(stderr, "%s has no desktop tracker base\n", bench->path);
+            exit(1);
+        }
+        SessionReplayStats stats;
+        session_replay(&bench->log, bench->trackers, count, &stats);
+        bench_keep(bench->trackers);
+        for (int t = 0; t < count; t++) {
+            combo_release(&bench->trackers[t]);
+        }
+    }
+}
+
+const BenchCase bench_desktop_cases[] = {
+    {"combo_increment", setup_trackers, run_increment, teardown_trackers},
+    {"combo_update/8 trackers", setup_trackers, run_update, teardown_trackers},
+    {"combo_save_all_trackers/8", setup_trackers, run_save, teardown_trackers},
+    {"combo_load_all_trackers/8", setup_saved_trackers, run_load, teardown_trackers},
+    {"combo_update/10k trackers", setup_table, run_update_states, teardown_table},
+    {"combo_update_all/10k trackers", setup_table, run_update_table, teardown_table},
+    {"combo_table_settle_all/10k", setup_table, run_settle_all, teardown_table},
+    {"combo_table_settle_all_scalar/10k", setup_table, run_settle_all_scalar, teardown_table},
+    {"combo_increment/timestamped hit", setup_hits, run_hits_single, teardown_hits},
+    {"combo_increment_batch/hit", setup_hits, run_hits_batch, teardown_hits},
+    {"objective_stream/10k objectives", setup_catalog, run_catalog_stream, teardown_catalog},
+    {"combo_sync_apply_objectives/10k", setup_catalog, run_catalog_apply, teardown_catalog},
+    {"session_load/1 h at 60 fps", setup_session, run_session_load, teardown_session},
+    {"session_replay/1 h at 60 fps", setup_session, run_session_replay, teardown_session},
+};
+
+const uint32_t bench_desktop_case_count = sizeof(bench_desktop_cases) / sizeof(bench_desktop_cases[0]);
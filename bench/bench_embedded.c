@@ -0,0 +1,178 @@
+#define CLAY_IMPLEMENTATION     // The e-paper renderer needs Clay's arena helpers
+#include "bench.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "simple_combo_core.h"
+#include "turso_local.h"
+#include "clay_epaper_renderer.h"
+#include "audio_kernels.h"
+
+// Embedded kernels built for the host: counter updates per CounterType,
+// the sync-record CRC, the e-paper rasterizer and the audio analysis
+// window. Absolute numbers are for the host CPU; the ratios and the
+// allocation counts carry over to the nRF52840.
+
+#define BENCH_AUDIO_WINDOW 256      // AUDIO_ANALYSIS_WINDOW
+#define BENCH_AUDIO_RATE 16000.0f   // AUDIO_SAMPLE_RATE
+#define BENCH_CRC_BYTES 32          // TursoSyncRecord payload
+
+typedef struct {
+    ComboDevice device;
+} CounterBench;
+
+static void* setup_counter(CounterType type) {
+    CounterBench* bench = calloc(1, sizeof(CounterBench));
+    combo_device_init(&bench->device);
+    combo_core_set_time_ms(0);
+    counter_add(&bench->device, "Bench", type);
+    Counter* counter = &bench->device.counters[0];
+    switch (type) {
+        case COUNTER_TYPE_SIMPLE: counter_configure_simple(counter, "Bench", 1); break;
+        case COUNTER_TYPE_COMBO: counter_configure_combo(counter, "Bench", 1, 3.0f, 0.1f); break;
+        case COUNTER_TYPE_TIMED: counter_configure_timed(counter, "Bench", 1, 0.5f); break;
+        case COUNTER_TYPE_ACCUMULATOR: counter_configure_accumulator(counter, "Bench", 10); break;
+    }
+    counter_set_active(&bench->device, 0);
+    return bench;
+}
+
+static void* setup_simple(void) { return setup_counter(COUNTER_TYPE_SIMPLE); }
+static void* setup_combo(void) { return setup_counter(COUNTER_TYPE_COMBO); }
+static void* setup_timed(void) { return setup_counter(COUNTER_TYPE_TIMED); }
+static void* setup_accumulator(void) { return setup_counter(COUNTER_TYPE_ACCUMULATOR); }
+
+static void run_counter_increment(void* context, uint64_t iterations) {
+    Counter* counter = &((CounterBench*)context)->device.counters[0];
+    counter_reset(counter);
+    // Reps 100 ms apart so timed decay runs; one miss in every eight
+    static const ActionQuality qualities[8] = {QUALITY_PERFECT, QUALITY_GOOD, QUALITY_PERFECT, QUALITY_PARTIAL,
+                                               QUALITY_GOOD, QUALITY_PERFECT, QUALITY_GOOD, QUALITY_MISS};
+    for (uint64_t i = 0; i < iterations; i++) {
+        combo_core_set_time_ms((uint32_t)(i * 100));
+        counter_increment(counter, qualities[i & 7]);
+    }
+    bench_keep(counter);
+}
+
+static void* setup_crc(void) {
+    uint8_t* data = malloc(BENCH_CRC_BYTES);
+    for (int i = 0; i < BENCH_CRC_BYTES; i++) data[i] = (uint8_t)(i * 37 + 11);
+    return data;
+}
+
+static void run_crc(void* context, uint64_t iterations) {
+    uint8_t* data = context;
+    uint16_t crc = 0;
+    for (uint64_t i = 0; i < iterations; i++) {
+        data[0] = (uint8_t)i;   // Different input each time
+        crc ^= turso_crc16(data, BENCH_CRC_BYTES);
+    }
+    bench_keep(&crc);
+}
+
+typedef struct {
+    ClayEpaperContext ctx;
+    uint8_t arena[CLAY_EPAPER_DEFAULT_ARENA_SIZE];
+} EpaperBench;
+
+static void* setup_epaper(void) {
+    EpaperBench* bench = calloc(1, sizeof(EpaperBench));
+    clay_epaper_init(&bench->ctx, bench->arena, sizeof(bench->arena));
+    clay_epaper_allocate_framebuffer(&bench->ctx);
+    return bench;
+}
+
+static void teardown_free(void* context) {
+    free(context);
+}
+
+static void run_epaper_clear(void* context, uint64_t iterations) {
+    EpaperBench* bench = context;
+    for (uint64_t i = 0; i < iterations; i++) {
+        clay_epaper_clear(&bench->ctx, (i & 1) ? EPAPER_COLOR_WHITE : EPAPER_COLOR_BLACK);
+    }
+    bench_keep(bench->ctx.framebuffer);
+}
+
+// One counter screen as simulation_main.c lays it out: header bar, label,
+// big count, multiplier, progress bar and divider
+static void run_epaper_counter_screen(void* context, uint64_t iterations) {
+    EpaperBench* bench = context;
+    ClayEpaperContext* ctx = &bench->ctx;
+    Clay_TextElementConfig title = {.textColor = {0, 0, 0, 255}, .fontSize = 12};
+    Clay_TextElementConfig big = {.textColor = {0, 0, 0, 255}, .fontSize = 24};
+    Clay_TextElementConfig accent = {.textColor = {255, 0, 0, 255}, .fontSize = 16};
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        clay_epaper_clear(ctx, EPAPER_COLOR_WHITE);
+        clay_epaper_draw_rect(ctx, (Clay_BoundingBox){0, 0, EPAPER_WIDTH, 20}, EPAPER_COLOR_BLACK, true);
+        clay_epaper_draw_rect(ctx, (Clay_BoundingBox){EPAPER_WIDTH - 30, 4, 22, 12}, EPAPER_COLOR_WHITE, false);
+        clay_epaper_draw_text(ctx, CLAY_STRING("Perfect Form"), (Clay_BoundingBox){8, 28, 200, 14}, &title);
+        clay_epaper_draw_text(ctx, CLAY_STRING("1234"), (Clay_BoundingBox){8, 50, 200, 26}, &big);
+        clay_epaper_draw_text(ctx, CLAY_STRING("x2.5 COMBO"), (Clay_BoundingBox){8, 84, 200, 18}, &accent);
+        float progress = (float)(i % 100) / 100.0f;
+        clay_epaper_draw_rect(ctx, (Clay_BoundingBox){8, 112, EPAPER_WIDTH - 16, 12}, EPAPER_COLOR_BLACK, false);
+        clay_epaper_draw_rect(ctx, (Clay_BoundingBox){10, 114, (EPAPER_WIDTH - 20) * progress, 8},
+                              EPAPER_COLOR_RED, true);
+        clay_epaper_draw_line(ctx, 0, 132, EPAPER_WIDTH - 1, 132, EPAPER_COLOR_BLACK);
+    }
+    bench_keep(ctx->framebuffer);
+}
+
+static void* setup_audio(void) {
+    int16_t* samples = malloc(BENCH_AUDIO_WINDOW * sizeof(int16_t));
+    // A rep-like burst: 90 Hz tone under a decaying envelope plus noise
+    srand(9);
+    for (int i = 0; i < BENCH_AUDIO_WINDOW; i++) {
+        float envelope = expf(-(float)i / 96.0f);
+        float tone = sinf(2.0f * 3.14159265f * 90.0f * (float)i / BENCH_AUDIO_RATE);
+        samples[i] = (int16_t)(12000.0f * envelope * tone + (float)(rand() % 400 - 200));
+    }
+    return samples;
+}
+
+static void run_audio_rms(void* context, uint64_t iterations) {
+    const int16_t* samples = context;
+    float sum = 0.0f;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_keep(samples);
+        sum += audio_rms_energy(samples, BENCH_AUDIO_WINDOW);
+    }
+    bench_keep(&sum);
+}
+
+static void run_audio_centroid(void* context, uint64_t iterations) {
+    const int16_t* samples = context;
+    float sum = 0.0f;
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_keep(samples);
+        sum += audio_spectral_centroid(samples, BENCH_AUDIO_WINDOW, BENCH_AUDIO_RATE);
+    }
+    bench_keep(&sum);
+}
+
+static void run_audio_bands(void* context, uint64_t iterations) {
+    const int16_t* samples = context;
+    float bands[AUDIO_SIGNATURE_BANDS];
+    for (uint64_t i = 0; i < iterations; i++) {
+        bench_keep(samples);
+        audio_band_energies(samples, BENCH_AUDIO_WINDOW, bands);
+        bench_keep(bands);
+    }
+}
+
+const BenchCase bench_embedded_cases[] = {
+    {"counter_increment/simple", setup_simple, run_counter_increment, teardown_free},
+    {"counter_increment/combo", setup_combo, run_counter_increment, teardown_free},
+    {"counter_increment/timed", setup_timed, run_counter_increment, teardown_free},
+    {"counter_increment/accumulator", setup_accumulator, run_counter_increment, teardown_free},
+    {"turso_crc16/32B", setup_crc, run_crc, teardown_free},
+    {"epaper_clear", setup_epaper, run_epaper_clear, teardown_free},
+    {"epaper_counter_screen", setup_epaper, run_epaper_counter_screen, teardown_free},
+    {"audio_rms_energy/256", setup_audio, run_audio_rms, teardown_free},
+    {"audio_spectral_centroid/256", setup_audio, run_audio_centroid, teardown_free},
+    {"audio_band_energies/256", setup_audio, run_audio_bands, teardown_free},
+};
+
+const uint32_t bench_embedded_case_count = sizeof(bench_embedded_cases) / sizeof(bench_embedded_cases[0]);
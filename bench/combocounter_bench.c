@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+// combocounter_bench [--json] [--filter substring] [--min-time seconds]
+//                    [--repetitions n] [--list]
+//
+// Desktop and embedded hot paths in one binary. --json prints one object
+// per benchmark for tracking regressions across commits.
+
+#define BENCH_MAX_RESULTS 64
+
+static void usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--json] [--filter substring] [--min-time seconds] [--repetitions n] [--list]\n",
+            program);
+}
+
+int main(int argc, char** argv) {
+    bool json = false;
+    bool list = false;
+    const char* filter = NULL;
+    BenchOptions options = {0.2, 3};
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (strcmp(argv[i], "--list") == 0) {
+            list = true;
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            options.min_seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc) {
+            options.repetitions = (uint32_t)atoi(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (options.min_seconds <= 0.0) options.min_seconds = 0.2;
+    if (options.repetitions == 0) options.repetitions = 1;
+
+    const BenchCase* groups[] = {bench_desktop_cases, bench_embedded_cases};
+    const uint32_t group_counts[] = {bench_desktop_case_count, bench_embedded_case_count};
+
+    static BenchResult results[BENCH_MAX_RESULTS];
+    uint32_t count = 0;
+    for (int g = 0; g < 2; g++) {
+        for (uint32_t i = 0; i < group_counts[g] && count < BENCH_MAX_RESULTS; i++) {
+            const BenchCase* bench_case = &groups[g][i];
+            if (filter && !strstr(bench_case->name, filter)) continue;
+            if (list) {
+                printf("%s\n", bench_case->name);
+                continue;
+            }
+            if (!json) fprintf(stderr, "running %s...\n", bench_case->name);
+            bench_run_case(bench_case, &options, &results[count++]);
+        }
+    }
+    if (list) return 0;
+
+    if (json) {
+        bench_print_json(results, count);
+    } else {
+        bench_print_table(results, count);
+    }
+    return 0;
+}
@@ -4,6 +4,9 @@
 #include <assert.h>
 #include "src/core.h"
 
+static double g_test_now = 0.0;
+static double test_clock(void) { return g_test_now; }
+
 int main() {
     printf("Testing core functionality...\n");
     
@@ -83,6 +86,93 @@ int main() {
     
     // Remove test file
     remove("test_core.dat");
+
+    // Test 5: Decay is computed from timestamps, not ticked
+    printf("Test 5: Lazy combo decay\n");
+    combo_set_clock(test_clock);
+    ComboState idle;
+    combo_init(&idle, "Idle");
+    combo_resume(&idle);
+    for (int i = 0; i < 4; i++) {
+        combo_increment(&idle, 1);
+    }
+    g_test_now = 4.9;
+    combo_settle(&idle, combo_clock_now());
+    assert(idle.combo == 4);
+
+    // 2.5s past the decay pause at one point per second
+    g_test_now = COMBO_DECAY_TIME + 2.5;
+    combo_settle(&idle, combo_clock_now());
+    printf("  Combo after %.1fs idle: %d, multiplier %.2f\n", g_test_now, idle.combo, idle.multiplier);
+    assert(idle.combo == 2);
+    assert(idle.multiplier > 1.19f && idle.multiplier < 1.21f);
+
+    // Paused time does not count
+    combo_pause(&idle);
+    g_test_now += 1000.0;
+    combo_resume(&idle);
+    combo_settle(&idle, combo_clock_now());
+    assert(idle.combo == 2);
+
+    // A hit settles first (the half second already drained carries over),
+    // then builds on the decayed combo
+    g_test_now += 1.5;
+    combo_increment(&idle, 1);
+    assert(idle.combo == 1 && idle.decay_pause == COMBO_DECAY_TIME);
+    combo_set_clock(NULL);
+    printf("  ✓ Lazy decay test passed\n");
+    
+    // Test 6: Batched hits match one call per hit
+    printf("Test 6: Batched hit ingestion\n");
+    combo_set_clock(test_clock);
+    g_test_now = 50.0;
+    Objective goals[2];
+    objective_init(&goals[0], "Warmup", "Reach 400", 400);
+    objective_init(&goals[1], "Main", "Reach 5000", 5000);
+
+    ComboState single, batched;
+    combo_init(&single, "Single");
+    combo_init(&batched, "Batched");
+    combo_set_objectives(&single, goals, 2);
+    combo_set_objectives(&batched, goals, 2);
+    combo_resume(&single);
+    combo_resume(&batched);
+
+    HitEvent events[2000];
+    srand(99);
+    double t = g_test_now;
+    for (int i = 0; i < 2000; i++) {
+        // Mostly quick hits, with the odd gap long enough to decay
+        t += (rand() % 50 == 0) ? 3.0 + (rand() % 700) / 100.0 : (rand() % 100) / 200.0;
+        events[i].time = t;
+        events[i].amount = 1 + (uint32_t)(rand() % 9);
+        events[i].type = (rand() % 25 == 0) ? HIT_EVENT_MISS : HIT_EVENT_HIT;
+
+        g_test_now = t;
+        if (events[i].type == HIT_EVENT_MISS) {
+            combo_decrement(&single, events[i].amount);
+        } else {
+            combo_increment(&single, events[i].amount);
+        }
+    }
+    // Split into uneven batches
+    combo_increment_batch(&batched, events, 700);
+    combo_increment_batch(&batched, events + 700, 1300);
+
+    printf("  Score %d, combo %d, max combo %d\n", batched.score, batched.combo, batched.max_combo);
+    assert(batched.score == single.score);
+    assert(batched.combo == single.combo);
+    assert(batched.max_combo == single.max_combo);
+    assert(batched.multiplier == single.multiplier);
+    assert(batched.decay_pause == single.decay_pause);
+    assert(batched.last_hit_time == single.last_hit_time);
+    assert(batched.total_hits == single.total_hits && batched.miss_hits == single.miss_hits);
+    assert(batched.objectives[0].current_score == single.objectives[0].current_score);
+    assert(batched.objectives[0].completed == single.objectives[0].completed);
+    free(single.objectives);
+    free(batched.objectives);
+    combo_set_clock(NULL);
+    printf("  ✓ Batch matches per-hit calls\n");
     
     printf("\n🎉 All core tests passed!\n");
     return 0;
@@ -1,5 +1,6 @@
 #include "audio_action_recorder.h"
 #include "musicmaker_integration.h"
+#include "audio_kernels.h"
 #include "nrf_log.h"
 #include "nrf_delay.h"
 #include "app_error.h"
@@ -44,8 +45,6 @@ static ret_code_t sd_card_init(void);
 static void pdm_event_handler(nrf_drv_pdm_evt_t const * p_evt);
 static void analysis_timer_handler(void * p_context);
 static void memo_timeout_handler(void * p_context);
-static float calculate_rms_energy(const int16_t* data, uint16_t length);
-static float calculate_spectral_centroid(const int16_t* data, uint16_t length);
 static bool detect_movement_pattern(const int16_t* data, uint16_t length, movement_analysis_t* result);
 static ret_code_t save_memo_to_file(const voice_memo_t* memo);
 static ret_code_t load_memo_from_file(uint16_t memo_id, voice_memo_t* memo);
@@ -491,7 +490,7 @@ ret_code_t audio_calibrate_baseline(audio_action_recorder_t* recorder) {
     nrf_delay_ms(2000);
     
     // Calculate baseline noise level
-    g_baseline_noise_level = calculate_rms_energy(g_audio_buffer, AUDIO_BUFFER_SIZE);
+    g_baseline_noise_level = audio_rms_energy(g_audio_buffer, AUDIO_BUFFER_SIZE);
     
     // Set movement threshold relative to baseline
     recorder->movement_threshold = (uint16_t)(g_baseline_noise_level * 2.5f);
@@ -690,25 +689,9 @@ ret_code_t audio_generate_movement_signature(const int16_t* audio_data, uint16_t
         return NRF_ERROR_NULL;
     }
     
-    // Initialize signature
-    memset(signature, 0, 8 * sizeof(float));
-    
     // Simple frequency domain analysis
     // This is a simplified implementation - real world would use FFT
-    
-    uint16_t bin_size = length / 8;
-    
-    for (int bin = 0; bin < 8; bin++) {
-        float energy = 0.0f;
-        uint16_t start = bin * bin_size;
-        uint16_t end = fminf(start + bin_size, length);
-        
-        for (uint16_t i = start; i < end; i++) {
-            energy += (float)(audio_data[i] * audio_data[i]);
-        }
-        
-        signature[bin] = sqrtf(energy / bin_size) / 32768.0f;  // Normalize
-    }
+    audio_band_energies(audio_data, length, signature);
     
     return NRF_SUCCESS;
 }
@@ -793,26 +776,13 @@ static void memo_timeout_handler(void * p_context) {
     }
 }
 
-static float calculate_rms_energy(const int16_t* data, uint16_t length) {
-    if (data == NULL || length == 0) {
-        return 0.0f;
-    }
-    
-    float sum = 0.0f;
-    for (uint16_t i = 0; i < length; i++) {
-        sum += (float)(data[i] * data[i]);
-    }
-    
-    return sqrtf(sum / length);
-}
-
 static bool detect_movement_pattern(const int16_t* data, uint16_t length, movement_analysis_t* result) {
     if (data == NULL || result == NULL || length == 0) {
         return false;
     }
     
     // Calculate energy level
-    float energy = calculate_rms_energy(data, length);
+    float energy = audio_rms_energy(data, length);
     
     // Check if energy exceeds movement threshold
     if (energy < g_baseline_noise_level * 1.5f) {
@@ -821,7 +791,7 @@ static bool detect_movement_pattern(const int16_t* data, uint16_t length, moveme
     
     // Fill in movement analysis results
     result->movement_intensity = (uint16_t)fminf(energy, 1000.0f);
-    result->movement_frequency = calculate_spectral_centroid(data, length);
+    result->movement_frequency = audio_spectral_centroid(data, length, AUDIO_SAMPLE_RATE);
     result->movement_duration_ms = 100;  // Analysis window duration
     result->movement_quality = (uint8_t)(energy / (g_baseline_noise_level * 10.0f));
     result->movement_quality = fminf(10, fmaxf(0, result->movement_quality));
@@ -838,29 +808,6 @@ static bool detect_movement_pattern(const int16_t* data, uint16_t length, moveme
     return true;
 }
 
-static float calculate_spectral_centroid(const int16_t* data, uint16_t length) {
-    if (data == NULL || length == 0) {
-        return 0.0f;
-    }
-    
-    // Simplified spectral centroid calculation
-    // Real implementation would use FFT
-    float weighted_sum = 0.0f;
-    float magnitude_sum = 0.0f;
-    
-    for (uint16_t i = 0; i < length; i++) {
-        float magnitude = fabsf((float)data[i]);
-        weighted_sum += magnitude * i;
-        magnitude_sum += magnitude;
-    }
-    
-    if (magnitude_sum > 0) {
-        return (weighted_sum / magnitude_sum) * (AUDIO_SAMPLE_RATE / (2.0f * length));
-    }
-    
-    return 0.0f;
-}
-
 static ret_code_t save_memo_to_file(const voice_memo_t* memo) {
     if (memo == NULL) {
         return NRF_ERROR_NULL;
@@ -0,0 +1,53 @@
+#include "audio_kernels.h"
+#include <math.h>
+#include <string.h>
+
+static uint64_t sum_squares(const int16_t* data, uint16_t start, uint16_t end) {
+    uint64_t sum = 0;
+    for (uint16_t i = start; i < end; i++) {
+        int32_t sample = data[i];
+        sum += (uint32_t)(sample * sample);
+    }
+    return sum;
+}
+
+float audio_rms_energy(const int16_t* data, uint16_t length) {
+    if (data == NULL || length == 0) {
+        return 0.0f;
+    }
+    return sqrtf((float)sum_squares(data, 0, length) / length);
+}
+
+float audio_spectral_centroid(const int16_t* data, uint16_t length, float sample_rate) {
+    if (data == NULL || length == 0) {
+        return 0.0f;
+    }
+
+    uint64_t weighted_sum = 0;
+    uint64_t magnitude_sum = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        int32_t sample = data[i];
+        uint32_t magnitude = (uint32_t)(sample < 0 ? -sample : sample);
+        weighted_sum += (uint64_t)magnitude * i;
+        magnitude_sum += magnitude;
+    }
+
+    if (magnitude_sum > 0) {
+        return ((float)weighted_sum / (float)magnitude_sum) * (sample_rate / (2.0f * length));
+    }
+    return 0.0f;
+}
+
+void audio_band_energies(const int16_t* data, uint16_t length, float* bands) {
+    memset(bands, 0, AUDIO_SIGNATURE_BANDS * sizeof(float));
+    uint16_t bin_size = length / AUDIO_SIGNATURE_BANDS;
+    if (data == NULL || bin_size == 0) {
+        return;
+    }
+
+    for (int bin = 0; bin < AUDIO_SIGNATURE_BANDS; bin++) {
+        uint16_t start = (uint16_t)(bin * bin_size);
+        uint64_t energy = sum_squares(data, start, (uint16_t)(start + bin_size));
+        bands[bin] = sqrtf((float)energy / bin_size) / 32768.0f;  // Normalize
+    }
+}
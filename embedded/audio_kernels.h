@@ -0,0 +1,23 @@
+#ifndef AUDIO_KERNELS_H
+#define AUDIO_KERNELS_H
+
+#include <stdint.h>
+
+// Signal kernels behind audio_action_recorder's movement detection, kept
+// free of SDK headers so they can be benchmarked and tested on the host.
+// Sums are accumulated in integers: exact for any window up to 65535
+// samples and friendly to the M4's multiply-accumulate.
+
+#define AUDIO_SIGNATURE_BANDS 8
+
+// Root mean square of the samples
+float audio_rms_energy(const int16_t* data, uint16_t length);
+
+// Magnitude-weighted mean sample position, scaled to Hz. A cheap stand-in
+// for an FFT centroid.
+float audio_spectral_centroid(const int16_t* data, uint16_t length, float sample_rate);
+
+// RMS of AUDIO_SIGNATURE_BANDS equal slices, normalized to full scale
+void audio_band_energies(const int16_t* data, uint16_t length, float* bands);
+
+#endif // AUDIO_KERNELS_H
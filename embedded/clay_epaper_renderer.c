@@ -1,4 +1,5 @@
 #include "clay_epaper_renderer.h"
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
@@ -122,11 +123,13 @@ bool clay_epaper_allocate_framebuffer(ClayEpaperContext* ctx) {
     }
     
     // Allocate from Clay arena
-    ctx->framebuffer = Clay__Array_Allocate_Arena(&ctx->clay_arena, EPAPER_BUFFER_SIZE, uint8_t);
-    if (!ctx->framebuffer) {
+    Clay_Arena* arena = &ctx->clay_arena;
+    if (arena->nextAllocation + EPAPER_BUFFER_SIZE > arena->capacity) {
         g_last_error = CLAY_EPAPER_ERROR_MEMORY_ALLOCATION;
         return false;
     }
+    ctx->framebuffer = (uint8_t*)(arena->memory + arena->nextAllocation);
+    arena->nextAllocation += EPAPER_BUFFER_SIZE;
     
     // Clear to white
     memset(ctx->framebuffer, 0x55, EPAPER_BUFFER_SIZE);  // 0x55 = all white pixels
@@ -467,9 +467,10 @@ static void draw_combo_meter(Counter* counter) {
     printf("] %.1f%%\n", g_enhanced.decay_progress * 100);
     
     // Multiplier effect visualization
-    if (counter->multiplier > 1.0f) {
+    float multiplier = counter_get_multiplier(counter);
+    if (multiplier > 1.0f) {
         printf("\n🚀 MULTIPLIER: ");
-        int mult_bars = (int)((counter->multiplier - 1.0f) / (counter->max_multiplier - 1.0f) * 10);
+        int mult_bars = (int)((multiplier - 1.0f) / (counter->max_multiplier - 1.0f) * 10);
         printf("[");
         for (int i = 0; i < 10; i++) {
             if (i < mult_bars) {
@@ -478,7 +479,7 @@ static void draw_combo_meter(Counter* counter) {
                 printf("▱");
             }
         }
-        printf("] ×%.2f\n", counter->multiplier);
+        printf("] ×%.2f\n", multiplier);
     }
 }
 
@@ -907,7 +908,7 @@ static void handle_counter_input(char key) {
             update_statistics(current, QUALITY_GOOD);
     
             // Save counter to database (batched writes for energy efficiency)
-            turso_save_counter(current, false);
+            turso_save_counter(g_device.current_counter, current, false);
     
             if (g_enhanced.audio.count_aloud) {
                 char count_audio[32];
@@ -925,7 +926,7 @@ static void handle_counter_input(char key) {
             if (tracker_num < g_device.counter_count) {
                 Counter* target = &g_device.counters[tracker_num];
                 counter_increment(target, QUALITY_GOOD);
-                turso_save_counter(target, false);
+                turso_save_counter(tracker_num, target, false);
                 
                 // Quick visual feedback without clearing screen
                 printf("\r✅ +1 to %s (now: %d)                    ", target->label, target->count);
@@ -1282,13 +1283,13 @@ static void handle_custom_counters_input(char key) {
                     g_device.counters[g_custom_counters_selection].label[MAX_LABEL_LENGTH - 1] = '\0';
                     
                     // Save updated counter to database
-                    turso_save_counter(&g_device.counters[g_custom_counters_selection], true);
+                    turso_save_counter(g_custom_counters_selection, &g_device.counters[g_custom_counters_selection], true);
                 } else if (g_custom_counters_selection == g_device.counter_count && g_device.counter_count < MAX_COUNTERS) {
                     // Add new counter
                     if (counter_add(&g_device, g_temp_counter_name, COUNTER_TYPE_SIMPLE)) {
                         // Save new counter to database immediately
                         Counter* new_counter = &g_device.counters[g_device.counter_count - 1];
-                        turso_save_counter(new_counter, true);
+                        turso_save_counter(g_device.counter_count - 1, new_counter, true);
                         printf("✅ Added tracker: %s\n", g_temp_counter_name);
                     }
                 }
@@ -1591,8 +1592,9 @@ int main(void) {
     // Show database statistics
     TursoDatabaseStats db_stats;
     if (turso_get_database_stats(&db_stats)) {
-        NRF_LOG_INFO("Database stats - Records: %d, Pending sync: %d, Flash writes: %d", 
-                     db_stats.total_records, db_stats.pending_sync_records, db_stats.total_flash_writes);
+        NRF_LOG_INFO("Database stats - Records: %d, Pending sync: %d, Flash writes: %d, Page erases: %d (%d..%d per page)", 
+                     db_stats.total_records, db_stats.pending_sync_records, db_stats.total_flash_writes,
+                     db_stats.flash_erases, db_stats.min_page_erases, db_stats.max_page_erases);
     }
     
     // Shutdown database
@@ -0,0 +1,493 @@
+#include "flash_log.h"
+#include <stddef.h>
+#include <string.h>
+
+#define PAGE_HEADER_SIZE ((uint16_t)sizeof(FlashLogPageHeader))
+#define RECORD_HEADER_SIZE ((uint16_t)sizeof(FlashLogRecordHeader))
+#define RECORD_CRC_SPAN 10      // Record header bytes ahead of its crc16
+#define COPY_CHUNK 64           // Stack buffer for moving and verifying records
+
+// CRC16-CCITT, same parameters as turso_crc16, continued across chunks
+static uint16_t crc16_update(uint16_t crc, const uint8_t* data, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t footprint(uint16_t length) {
+    return (uint16_t)((RECORD_HEADER_SIZE + length + 3u) & ~3u);
+}
+
+static uint32_t page_addr(const FlashLog* log, uint16_t page) {
+    return log->device.base_addr + (uint32_t)page * log->device.page_size;
+}
+
+static bool page_is_free(const FlashLog* log, uint16_t page) {
+    return log->pages[page].sequence == FLASH_LOG_ERASED;
+}
+
+static uint16_t dead_bytes(const FlashLog* log, uint16_t page) {
+    const FlashLogPage* p = &log->pages[page];
+    if (page_is_free(log, page)) return 0;
+    return (uint16_t)(p->write_offset - PAGE_HEADER_SIZE - p->live_bytes);
+}
+
+// Bytes that can still be appended: the active page's remainder plus every
+// openable free page
+static uint32_t writable_bytes(const FlashLog* log) {
+    uint32_t room = 0;
+    for (uint16_t i = 0; i < log->device.page_count; i++) {
+        bool openable = page_is_free(log, i) && log->pages[i].write_offset == PAGE_HEADER_SIZE;
+        if ((int16_t)i == log->active_page || openable) {
+            room += log->device.page_size - log->pages[i].write_offset;
+        }
+    }
+    return room;
+}
+
+// Free pages that can be opened; one whose header failed to program can't
+static uint16_t count_free_pages(const FlashLog* log) {
+    uint16_t free_pages = 0;
+    for (uint16_t i = 0; i < log->device.page_count; i++) {
+        if (page_is_free(log, i) && log->pages[i].write_offset == PAGE_HEADER_SIZE) free_pages++;
+    }
+    return free_pages;
+}
+
+static bool entry_written(const FlashLogEntry* entry) {
+    return entry->page != FLASH_LOG_UNWRITTEN;
+}
+
+// Slot holding (type, record_id), or the empty slot where it would go.
+// The table is never full (FLASH_LOG_MAX_RECORDS < slots), so the probe ends.
+static FlashLogEntry* probe(const FlashLog* log, uint8_t type, uint16_t record_id) {
+    uint32_t key = ((uint32_t)type << 16) | record_id;
+    uint32_t index = (key * 2654435761u) & (FLASH_LOG_INDEX_SLOTS - 1);
+    while (true) {
+        const FlashLogEntry* entry = &log->entries[index];
+        if (entry->type == 0 || (entry->type == type && entry->record_id == record_id)) {
+            return (FlashLogEntry*)entry;
+        }
+        index = (index + 1) & (FLASH_LOG_INDEX_SLOTS - 1);
+    }
+}
+
+static FlashLogEntry* find_entry(FlashLog* log, uint8_t type, uint16_t record_id) {
+    FlashLogEntry* entry = probe(log, type, record_id);
+    return entry->type != 0 ? entry : NULL;
+}
+
+const FlashLogEntry* flash_log_find(const FlashLog* log, uint8_t type, uint16_t record_id) {
+    if (!log || type == 0) return NULL;
+    return find_entry((FlashLog*)log, type, record_id);
+}
+
+FlashLogEntry* flash_log_claim(FlashLog* log, uint8_t type, uint16_t record_id) {
+    if (!log || type == 0) return NULL;
+    FlashLogEntry* entry = probe(log, type, record_id);
+    if (entry->type != 0) return entry;
+    if (log->entry_count >= FLASH_LOG_MAX_RECORDS) return NULL;
+
+    entry->record_id = record_id;
+    entry->page = FLASH_LOG_UNWRITTEN;
+    entry->offset = 0;
+    entry->length = 0;
+    entry->type = type;
+    entry->flags = 0;
+    entry->slot = FLASH_LOG_NO_SLOT;
+    log->entry_count++;
+    return entry;
+}
+
+static uint16_t record_crc(const FlashLogRecordHeader* header, const void* data) {
+    uint16_t crc = crc16_update(0xFFFF, (const uint8_t*)header, RECORD_CRC_SPAN);
+    return crc16_update(crc, (const uint8_t*)data, header->length);
+}
+
+// Erase a page and program its header with the new erase count. The page
+// comes back free.
+static bool erase_page(FlashLog* log, uint16_t page, uint32_t erase_count) {
+    FlashLogPage* p = &log->pages[page];
+    p->sequence = FLASH_LOG_ERASED;
+    p->erase_count = erase_count;
+    p->write_offset = log->device.page_size;   // Unusable until the header is in
+    p->live_bytes = 0;
+
+    if (!log->device.erase(page_addr(log, page))) return false;
+    log->erases++;
+
+    FlashLogPageHeader header;
+    memset(&header, 0xFF, sizeof(header));
+    header.magic = FLASH_LOG_PAGE_MAGIC;
+    header.erase_count = erase_count;
+    header.crc16 = crc16_update(0xFFFF, (const uint8_t*)&header, 8);
+    if (!log->device.program(page_addr(log, page), &header, PAGE_HEADER_SIZE)) return false;
+
+    p->write_offset = PAGE_HEADER_SIZE;
+    return true;
+}
+
+// Lowest-wear free page becomes the active page
+static bool open_page(FlashLog* log, bool use_reserve) {
+    uint16_t free_pages = count_free_pages(log);
+    if (free_pages == 0 || (!use_reserve && free_pages <= FLASH_LOG_RESERVE_PAGES)) return false;
+
+    int16_t best = -1;
+    for (uint16_t i = 0; i < log->device.page_count; i++) {
+        if (!page_is_free(log, i) || log->pages[i].write_offset != PAGE_HEADER_SIZE) continue;
+        if (best < 0 || log->pages[i].erase_count < log->pages[best].erase_count) best = (int16_t)i;
+    }
+    if (best < 0) return false;
+
+    uint32_t sequence = log->next_page_sequence;
+    uint32_t addr = page_addr(log, (uint16_t)best) + offsetof(FlashLogPageHeader, sequence);
+    if (!log->device.program(addr, &sequence, sizeof(sequence))) {
+        log->pages[best].write_offset = log->device.page_size;
+        return false;
+    }
+    log->next_page_sequence++;
+    log->pages[best].sequence = sequence;
+    log->active_page = best;
+    return true;
+}
+
+// Make room for `size` bytes on the active page. Outside GC this may run
+// GC itself, a bounded number of times: each pass can strand a page tail,
+// so a nearly full store could otherwise shuffle records forever. GC moves
+// may dip into the reserve.
+static bool reserve_space(FlashLog* log, uint16_t size, bool in_gc) {
+    uint16_t gc_passes = 0;
+    while (true) {
+        if (log->active_page >= 0 &&
+            log->device.page_size - log->pages[log->active_page].write_offset >= size) {
+            return true;
+        }
+        // Whatever is left at the end of the old page stays dead
+        if (log->active_page >= 0) {
+            log->pages[log->active_page].write_offset = log->device.page_size;
+            log->active_page = -1;
+        }
+        if (open_page(log, in_gc)) continue;
+        if (in_gc || gc_passes++ >= log->device.page_count || !flash_log_gc_step(log)) return false;
+    }
+}
+
+// Point the directory at a new copy and move the live byte count with it
+static void index_record(FlashLog* log, FlashLogEntry* entry, const FlashLogRecordHeader* header,
+                         uint16_t page, uint16_t offset) {
+    if (entry_written(entry)) {
+        log->pages[entry->page].live_bytes -= footprint(entry->length);
+    }
+    entry->flags = header->flags;
+    entry->page = page;
+    entry->offset = offset;
+    entry->length = header->length;
+    log->pages[page].live_bytes += footprint(header->length);
+}
+
+static bool append(FlashLog* log, FlashLogRecordHeader* header, const void* data) {
+    uint16_t size = footprint(header->length);
+    if (size > log->device.page_size - PAGE_HEADER_SIZE) return false;
+    FlashLogEntry* entry = flash_log_claim(log, header->type, header->record_id);
+    if (!entry) return false;
+    // GC may move the old version; directory slots themselves never move
+    if (!reserve_space(log, size, false)) return false;
+
+    uint16_t page = (uint16_t)log->active_page;
+    uint16_t offset = log->pages[page].write_offset;
+    uint32_t addr = page_addr(log, page) + offset;
+    header->sequence = log->next_record_sequence++;
+    header->crc16 = record_crc(header, data);
+
+    // Taken even if programming fails: the cells are no longer erased
+    log->pages[page].write_offset += size;
+    if (!log->device.program(addr, header, RECORD_HEADER_SIZE)) return false;
+    if (header->length > 0 && !log->device.program(addr + RECORD_HEADER_SIZE, data, header->length)) {
+        return false;
+    }
+    index_record(log, entry, header, page, offset);
+    log->records_written++;
+    return true;
+}
+
+bool flash_log_write(FlashLog* log, uint8_t type, uint16_t record_id, const void* data, uint16_t length) {
+    if (!log || (!data && length > 0)) return false;
+    FlashLogRecordHeader header = {0, type, 0, record_id, length, 0};
+    return append(log, &header, data);
+}
+
+bool flash_log_delete(FlashLog* log, uint8_t type, uint16_t record_id) {
+    if (!log) return false;
+    const FlashLogEntry* entry = flash_log_find(log, type, record_id);
+    if (!entry || !entry_written(entry)) return false;
+    if (entry->flags & FLASH_LOG_FLAG_DELETED) return true;
+    // Tombstones stay live: an older copy may still sit on a page GC has
+    // not reached, and it must not come back at the next mount
+    FlashLogRecordHeader header = {0, type, FLASH_LOG_FLAG_DELETED, record_id, 0, 0};
+    return append(log, &header, NULL);
+}
+
+bool flash_log_read(const FlashLog* log, uint8_t type, uint16_t record_id, void* data,
+                    uint16_t max_length, uint16_t* length) {
+    if (!log || !data) return false;
+    const FlashLogEntry* entry = flash_log_find(log, type, record_id);
+    if (!entry || !entry_written(entry) || (entry->flags & FLASH_LOG_FLAG_DELETED)) return false;
+
+    uint16_t size = entry->length < max_length ? entry->length : max_length;
+    uint32_t addr = page_addr(log, entry->page) + entry->offset + RECORD_HEADER_SIZE;
+    if (size > 0 && !log->device.read(addr, data, size)) return false;
+    if (length) *length = entry->length;
+    return true;
+}
+
+// Copy one record byte for byte to the active page, sequence and CRC intact
+static bool move_record(FlashLog* log, FlashLogEntry* entry) {
+    uint16_t size = footprint(entry->length);
+    if (!reserve_space(log, size, true)) return false;
+
+    uint16_t page = (uint16_t)log->active_page;
+    uint16_t offset = log->pages[page].write_offset;
+    uint32_t from = page_addr(log, entry->page) + entry->offset;
+    uint32_t to = page_addr(log, page) + offset;
+    uint16_t remaining = RECORD_HEADER_SIZE + entry->length;
+
+    log->pages[page].write_offset += size;
+    uint8_t buffer[COPY_CHUNK];
+    for (uint16_t done = 0; done < remaining; ) {
+        uint16_t chunk = remaining - done < COPY_CHUNK ? remaining - done : COPY_CHUNK;
+        if (!log->device.read(from + done, buffer, chunk)) return false;
+        if (!log->device.program(to + done, buffer, chunk)) return false;
+        done += chunk;
+    }
+
+    log->pages[entry->page].live_bytes -= size;
+    entry->page = page;
+    entry->offset = offset;
+    log->pages[page].live_bytes += size;
+    log->records_moved++;
+    return true;
+}
+
+// Move every live record off a closed page, then erase it. The page's own
+// record headers say what is on it; a record is live if the directory
+// still points at that copy.
+static bool collect_page(FlashLog* log, uint16_t victim) {
+    uint16_t offset = PAGE_HEADER_SIZE;
+    while (log->pages[victim].live_bytes > 0 && offset + RECORD_HEADER_SIZE <= log->device.page_size) {
+        FlashLogRecordHeader header;
+        if (!log->device.read(page_addr(log, victim) + offset, &header, RECORD_HEADER_SIZE)) return false;
+        uint16_t size = footprint(header.length);
+        if (header.sequence == FLASH_LOG_ERASED || size > log->device.page_size - offset) break;
+
+        FlashLogEntry* entry = header.type != 0 ? find_entry(log, header.type, header.record_id) : NULL;
+        if (entry && entry->page == victim && entry->offset == offset && !move_record(log, entry)) {
+            return false;
+        }
+        offset += size;
+    }
+    return erase_page(log, victim, log->pages[victim].erase_count + 1);
+}
+
+bool flash_log_gc_step(FlashLog* log) {
+    if (!log) return false;
+    int16_t victim = -1;
+    uint16_t most_dead = 0;
+    for (uint16_t i = 0; i < log->device.page_count; i++) {
+        if ((int16_t)i == log->active_page || page_is_free(log, i)) continue;
+        uint16_t dead = dead_bytes(log, i);
+        if (dead > most_dead ||
+            (dead == most_dead && dead > 0 && log->pages[i].erase_count < log->pages[victim].erase_count)) {
+            victim = (int16_t)i;
+            most_dead = dead;
+        }
+    }
+    if (victim < 0) return false;
+    return collect_page(log, (uint16_t)victim);
+}
+
+bool flash_log_wear_level(FlashLog* log) {
+    if (!log) return false;
+    int16_t coldest = -1;
+    uint32_t most_worn = 0;
+    for (uint16_t i = 0; i < log->device.page_count; i++) {
+        const FlashLogPage* p = &log->pages[i];
+        if (p->erase_count > most_worn) most_worn = p->erase_count;
+        if ((int16_t)i == log->active_page || page_is_free(log, i)) continue;
+        if (coldest < 0 || p->erase_count < log->pages[coldest].erase_count) coldest = (int16_t)i;
+    }
+    if (coldest < 0 || most_worn - log->pages[coldest].erase_count <= FLASH_LOG_WEAR_SPREAD) {
+        return false;
+    }
+    // The cold data lands on a worn page and its barely used cells go back
+    // into rotation
+    return collect_page(log, (uint16_t)coldest);
+}
+
+uint16_t flash_log_compact(FlashLog* log) {
+    if (!log) return 0;
+    uint32_t before = log->erases;
+    // A closed page's stranded tail counts as dead, and collecting it can
+    // strand another tail on the page the moves fill. Stop once a pass
+    // gains no room, and never run more passes than there are pages.
+    for (uint16_t pass = 0; pass < log->device.page_count; pass++) {
+        uint32_t room = writable_bytes(log);
+        if (!flash_log_gc_step(log) || writable_bytes(log) <= room) break;
+    }
+    flash_log_wear_level(log);
+    return (uint16_t)(log->erases - before);
+}
+
+static uint32_t entry_sequence(const FlashLog* log, const FlashLogEntry* entry) {
+    FlashLogRecordHeader header;
+    if (!log->device.read(page_addr(log, entry->page) + entry->offset, &header, RECORD_HEADER_SIZE)) return 0;
+    return header.sequence;
+}
+
+// Read a page's records into the directory. Stops at the first erased header;
+// a record that fails its CRC was cut short and closes the page.
+static void scan_page(FlashLog* log, uint16_t page) {
+    FlashLogPage* p = &log->pages[page];
+    uint16_t offset = PAGE_HEADER_SIZE;
+    uint8_t buffer[COPY_CHUNK];
+
+    while (offset + RECORD_HEADER_SIZE <= log->device.page_size) {
+        FlashLogRecordHeader header;
+        uint32_t addr = page_addr(log, page) + offset;
+        if (!log->device.read(addr, &header, RECORD_HEADER_SIZE)) break;
+        if (header.sequence == FLASH_LOG_ERASED) {
+            p->write_offset = offset;
+            return;
+        }
+
+        uint16_t size = footprint(header.length);
+        bool valid = size <= log->device.page_size - offset;
+        uint16_t crc = crc16_update(0xFFFF, (const uint8_t*)&header, RECORD_CRC_SPAN);
+        for (uint16_t done = 0; valid && done < header.length; ) {
+            uint16_t chunk = header.length - done < COPY_CHUNK ? header.length - done : COPY_CHUNK;
+            valid = log->device.read(addr + RECORD_HEADER_SIZE + done, buffer, chunk);
+            crc = crc16_update(crc, buffer, chunk);
+            done += chunk;
+        }
+        if (!valid || crc != header.crc16) break;
+
+        // Equal sequences are a GC copy whose source was never erased
+        FlashLogEntry* entry = flash_log_claim(log, header.type, header.record_id);
+        if (entry && (!entry_written(entry) || entry_sequence(log, entry) < header.sequence)) {
+            index_record(log, entry, &header, page, offset);
+        }
+        if (header.sequence >= log->next_record_sequence) {
+            log->next_record_sequence = header.sequence + 1;
+        }
+        offset += size;
+    }
+    p->write_offset = log->device.page_size;
+}
+
+bool flash_log_mount(FlashLog* log, const FlashLogDevice* device) {
+    if (!log || !device || device->page_count < FLASH_LOG_RESERVE_PAGES + 2 ||
+        device->page_count > FLASH_LOG_MAX_PAGES) {
+        return false;
+    }
+    memset(log, 0, sizeof(*log));
+    log->device = *device;
+    log->active_page = -1;
+
+    // Headers first: unformatted pages take the highest erase count seen,
+    // which never understates wear
+    bool formatted[FLASH_LOG_MAX_PAGES];
+    uint32_t most_worn = 0;
+    for (uint16_t i = 0; i < device->page_count; i++) {
+        FlashLogPageHeader header;
+        FlashLogPage* p = &log->pages[i];
+        formatted[i] = device->read(page_addr(log, i), &header, PAGE_HEADER_SIZE) &&
+                       header.magic == FLASH_LOG_PAGE_MAGIC &&
+                       header.crc16 == crc16_update(0xFFFF, (const uint8_t*)&header, 8);
+        p->sequence = formatted[i] ? header.sequence : FLASH_LOG_ERASED;
+        p->erase_count = formatted[i] ? header.erase_count : 0;
+        p->write_offset = PAGE_HEADER_SIZE;
+        if (p->erase_count > most_worn) most_worn = p->erase_count;
+    }
+    for (uint16_t i = 0; i < device->page_count; i++) {
+        if (!formatted[i] && !erase_page(log, i, most_worn)) return false;
+    }
+
+    // Then records, and the newest page with room goes on taking writes
+    for (uint16_t i = 0; i < device->page_count; i++) {
+        FlashLogPage* p = &log->pages[i];
+        if (page_is_free(log, i)) continue;
+        scan_page(log, i);
+        if (p->sequence >= log->next_page_sequence) {
+            log->next_page_sequence = p->sequence + 1;
+        }
+        if (p->write_offset < device->page_size &&
+            (log->active_page < 0 || p->sequence > log->pages[log->active_page].sequence)) {
+            log->active_page = (int16_t)i;
+        }
+    }
+    // Older pages with room are closed so every write lands on one page
+    for (uint16_t i = 0; i < device->page_count; i++) {
+        if ((int16_t)i != log->active_page && !page_is_free(log, i)) {
+            log->pages[i].write_offset = device->page_size;
+        }
+    }
+    return true;
+}
+
+bool flash_log_verify(const FlashLog* log) {
+    if (!log) return false;
+    uint8_t buffer[COPY_CHUNK];
+    for (uint32_t i = 0; i < FLASH_LOG_INDEX_SLOTS; i++) {
+        const FlashLogEntry* entry = &log->entries[i];
+        if (entry->type == 0 || !entry_written(entry)) continue;
+        FlashLogRecordHeader header;
+        uint32_t addr = page_addr(log, entry->page) + entry->offset;
+        if (!log->device.read(addr, &header, RECORD_HEADER_SIZE)) return false;
+        if (header.type != entry->type || header.record_id != entry->record_id ||
+            header.length != entry->length) {
+            return false;
+        }
+
+        uint16_t crc = crc16_update(0xFFFF, (const uint8_t*)&header, RECORD_CRC_SPAN);
+        for (uint16_t done = 0; done < header.length; ) {
+            uint16_t chunk = header.length - done < COPY_CHUNK ? header.length - done : COPY_CHUNK;
+            if (!log->device.read(addr + RECORD_HEADER_SIZE + done, buffer, chunk)) return false;
+            crc = crc16_update(crc, buffer, chunk);
+            done += chunk;
+        }
+        if (crc != header.crc16) return false;
+    }
+    return true;
+}
+
+void flash_log_stats(const FlashLog* log, FlashLogStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+    if (!log || log->device.page_count == 0) return;
+
+    for (uint32_t i = 0; i < FLASH_LOG_INDEX_SLOTS; i++) {
+        const FlashLogEntry* entry = &log->entries[i];
+        if (entry->type != 0 && entry_written(entry) && !(entry->flags & FLASH_LOG_FLAG_DELETED)) {
+            stats->live_records++;
+        }
+    }
+    stats->min_erase_count = FLASH_LOG_ERASED;
+    for (uint16_t i = 0; i < log->device.page_count; i++) {
+        const FlashLogPage* p = &log->pages[i];
+        stats->live_bytes += p->live_bytes;
+        stats->dead_bytes += dead_bytes(log, i);
+        if (page_is_free(log, i)) stats->free_pages++;
+        if (p->erase_count < stats->min_erase_count) stats->min_erase_count = p->erase_count;
+        if (p->erase_count > stats->max_erase_count) stats->max_erase_count = p->erase_count;
+    }
+    stats->erases = log->erases;
+    stats->records_written = log->records_written;
+    stats->records_moved = log->records_moved;
+}
+
+uint32_t flash_log_page_erase_count(const FlashLog* log, uint16_t page) {
+    if (!log || page >= log->device.page_count) return 0;
+    return log->pages[page].erase_count;
+}
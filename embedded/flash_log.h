@@ -0,0 +1,162 @@
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Log-structured record store for NOR flash (nRF52840 internal flash or
+// the host simulation buffer).
+//
+// Records are never rewritten in place. Every save appends a new version
+// to the active page and a RAM directory points each (type, id) at its
+// newest copy; older copies become dead space. The directory is an
+// open-addressing hash table with linear probing, so lookups are O(1) and
+// its size is fixed at build time (FLASH_LOG_INDEX_SLOTS entries of 12
+// bytes). Entries are never removed: deleting a record appends a tombstone
+// that stays indexed, so probe chains never need tombstones of their own.
+// Type 0 is reserved for empty directory slots. When free pages run short, GC
+// picks the page with the most dead bytes, moves its live records to the
+// active page and erases it. Fresh pages are always taken lowest erase
+// count first, and compaction also moves cold pages whose erase count
+// lags far behind so their cells take a turn too.
+//
+// Page layout (page_size bytes, erased to 0xFF):
+//   header: magic u32 | erase_count u32 | sequence u32 | crc16 u16 | pad u16
+//   records, each 4-byte aligned:
+//     sequence u32 | type u8 | flags u8 | record_id u16 | length u16 | crc16 u16
+//     payload[length]
+//
+// The header's magic and erase count are programmed right after an erase;
+// the sequence stays 0xFFFFFFFF (free) until the page is opened for
+// writing. A record header is programmed before its payload, so a write
+// cut short by power loss fails its CRC on the next mount and the page is
+// closed there. GC copies keep their record sequence, so the newest
+// version always wins however pages are ordered.
+
+#define FLASH_LOG_PAGE_MAGIC 0x474F4C46u      // "FLOG"
+#define FLASH_LOG_ERASED 0xFFFFFFFFu
+#define FLASH_LOG_MAX_PAGES 64
+#ifndef FLASH_LOG_INDEX_SLOTS
+#define FLASH_LOG_INDEX_SLOTS 2048            // Power of two; 24 KB of RAM
+#endif
+#define FLASH_LOG_MAX_RECORDS (FLASH_LOG_INDEX_SLOTS / 4 * 3)   // Probe chains stay short at 75% load
+#define FLASH_LOG_UNWRITTEN 0xFFFF            // Entry page before the record reaches flash
+#define FLASH_LOG_NO_SLOT 0xFF
+#define FLASH_LOG_RESERVE_PAGES 1             // Kept erased so GC always has room
+#define FLASH_LOG_WEAR_SPREAD 8               // Erase-count gap before cold data is moved
+
+#define FLASH_LOG_FLAG_DELETED 0x01
+
+typedef struct {
+    uint32_t magic;
+    uint32_t erase_count;
+    uint32_t sequence;          // Order pages were opened in; FLASH_LOG_ERASED while free
+    uint16_t crc16;             // Over magic and erase_count
+    uint16_t reserved;
+} FlashLogPageHeader;
+
+typedef struct {
+    uint32_t sequence;          // Global write order, kept when GC moves the record
+    uint8_t type;
+    uint8_t flags;
+    uint16_t record_id;
+    uint16_t length;
+    uint16_t crc16;             // Over the fields above and the payload
+} FlashLogRecordHeader;
+
+// Flash backend. Addresses are absolute; page n starts at
+// base_addr + n * page_size. program() may only clear bits and should fail
+// if the cells were not erased.
+typedef struct {
+    bool (*read)(uint32_t addr, void* data, uint16_t size);
+    bool (*program)(uint32_t addr, const void* data, uint16_t size);
+    bool (*erase)(uint32_t addr);
+    uint32_t base_addr;
+    uint16_t page_size;
+    uint16_t page_count;
+} FlashLogDevice;
+
+// RAM state of one page
+typedef struct {
+    uint32_t sequence;
+    uint32_t erase_count;
+    uint16_t write_offset;      // Next free byte; page_size once closed
+    uint16_t live_bytes;        // Bytes of live records
+} FlashLogPage;
+
+// Directory entry: where the newest version of a record lives
+typedef struct {
+    uint16_t record_id;
+    uint16_t page;              // FLASH_LOG_UNWRITTEN until first written
+    uint16_t offset;
+    uint16_t length;
+    uint8_t type;               // 0 for an empty slot
+    uint8_t flags;
+    uint8_t slot;               // Caller's RAM slot for an unflushed copy, or FLASH_LOG_NO_SLOT
+    uint8_t reserved;
+} FlashLogEntry;
+
+typedef struct {
+    FlashLogDevice device;
+    FlashLogPage pages[FLASH_LOG_MAX_PAGES];
+    FlashLogEntry entries[FLASH_LOG_INDEX_SLOTS];
+    uint16_t entry_count;
+    int16_t active_page;        // -1 until a write opens one
+    uint32_t next_record_sequence;
+    uint32_t next_page_sequence;
+
+    // Lifetime of this mount
+    uint32_t erases;
+    uint32_t records_written;
+    uint32_t records_moved;
+} FlashLog;
+
+typedef struct {
+    uint32_t live_records;
+    uint32_t live_bytes;
+    uint32_t dead_bytes;
+    uint16_t free_pages;
+    uint32_t erases;            // Since mount
+    uint32_t min_erase_count;   // Per page, from the page headers
+    uint32_t max_erase_count;
+    uint32_t records_written;
+    uint32_t records_moved;
+} FlashLogStats;
+
+// Scan flash and rebuild the index. Pages without a valid header are
+// erased and formatted.
+bool flash_log_mount(FlashLog* log, const FlashLogDevice* device);
+
+// Append a new version of (type, record_id). Runs GC first if the active
+// page is full and only the reserve is left; fails when live data fills
+// the store.
+bool flash_log_write(FlashLog* log, uint8_t type, uint16_t record_id, const void* data, uint16_t length);
+// Copy the newest version into data (up to max_length bytes). False if the
+// record was never written or has been deleted.
+bool flash_log_read(const FlashLog* log, uint8_t type, uint16_t record_id, void* data,
+                    uint16_t max_length, uint16_t* length);
+// Append a tombstone so the record stays deleted after the next mount
+bool flash_log_delete(FlashLog* log, uint8_t type, uint16_t record_id);
+
+// Directory lookup; NULL if the record has no entry
+const FlashLogEntry* flash_log_find(const FlashLog* log, uint8_t type, uint16_t record_id);
+// Entry for (type, record_id), added unwritten if missing so the caller can
+// track a pending copy in its slot field. NULL when the directory is full.
+FlashLogEntry* flash_log_claim(FlashLog* log, uint8_t type, uint16_t record_id);
+
+// Reclaim the closed page with the most dead bytes. Returns false when no
+// page has anything to reclaim.
+bool flash_log_gc_step(FlashLog* log);
+// Move the coldest page if its erase count trails the most worn page by
+// more than FLASH_LOG_WEAR_SPREAD
+bool flash_log_wear_level(FlashLog* log);
+// Run GC until a pass stops gaining room (at most page_count passes),
+// then level wear once. Returns the number of pages erased.
+uint16_t flash_log_compact(FlashLog* log);
+
+// Re-read every live record and check its CRC
+bool flash_log_verify(const FlashLog* log);
+void flash_log_stats(const FlashLog* log, FlashLogStats* stats);
+uint32_t flash_log_page_erase_count(const FlashLog* log, uint16_t page);
+
+#endif // FLASH_LOG_H
@@ -0,0 +1,102 @@
+// Headless replay of a session recorded by combocounter_sim with
+// COMBO_SESSION_FILE set. Restores the recorded starting device, pushes
+// every input through the counter API with the device clock stepped by the
+// recorded frames, and prints the resulting counters.
+//
+//   make -f Makefile.sim replay
+//   ./combocounter_replay session.bin [repeat]
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "simple_combo_core.h"
+#include "../src/session.h"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void replay_once(const SessionLog* log, ComboDevice* device, uint32_t* skipped) {
+    memcpy(device, log->base, sizeof(ComboDevice));
+    combo_core_set_time_ms(0);
+
+    for (uint32_t i = 0; i < log->count; i++) {
+        const SessionEvent* event = &log->events[i];
+        if (event->op == SESSION_OP_FRAME) {
+            combo_device_update(device, session_frame_dt(event));
+            continue;
+        }
+        if (event->tracker >= device->counter_count) {
+            (*skipped)++;
+            continue;
+        }
+
+        Counter* counter = &device->counters[event->tracker];
+        switch (event->op) {
+            case SESSION_OP_HIT:
+                counter_increment(counter, (ActionQuality)event->quality);
+                break;
+            case SESSION_OP_DECREMENT:
+                counter_decrement(counter, event->amount);
+                break;
+            case SESSION_OP_RESET:
+                counter_reset(counter);
+                break;
+            default:
+                (*skipped)++;
+                break;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printf("Usage: %s <session file> [repeat]\n", argv[0]);
+        return 1;
+    }
+    int repeat = argc > 2 ? atoi(argv[2]) : 1;
+    if (repeat < 1) repeat = 1;
+
+    SessionLog log;
+    if (!session_load(&log, argv[1])) {
+        printf("[ERROR] Could not read session %s\n", argv[1]);
+        return 1;
+    }
+    if (log.source != SESSION_SOURCE_EMBEDDED || log.base_size != sizeof(ComboDevice)) {
+        printf("[ERROR] %s was not recorded by this simulator build\n", argv[1]);
+        session_log_free(&log);
+        return 1;
+    }
+
+    ComboDevice device;
+    uint32_t skipped = 0;
+    double start = now_seconds();
+    for (int r = 0; r < repeat; r++) {
+        skipped = 0;
+        replay_once(&log, &device, &skipped);
+    }
+    double elapsed = (now_seconds() - start) / repeat;
+
+    double session_seconds = 0.0;
+    if (log.count > 0) {
+        session_seconds = (double)(log.events[log.count - 1].time_us - log.events[0].time_us) / 1e6;
+    }
+    printf("Replayed %u events (%.1f s of input) in %.3f ms", log.count, session_seconds, elapsed * 1e3);
+    if (elapsed > 0.0) printf(", %.0fx real time", session_seconds / elapsed);
+    printf("\n");
+    if (skipped > 0) printf("Skipped %u events for missing counters\n", skipped);
+
+    for (uint8_t i = 0; i < device.counter_count; i++) {
+        const Counter* counter = &device.counters[i];
+        printf("  %-16s count=%d total=%d max_combo=%d x%.2f\n", counter->label, counter->count,
+               counter->total, counter->max_combo, counter_get_multiplier(counter));
+    }
+
+    session_log_free(&log);
+    return 0;
+}
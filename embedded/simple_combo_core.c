@@ -5,6 +5,10 @@
 // Static error state
 static ComboError g_last_error = COMBO_OK;
 
+// Device clock
+static uint32_t g_time_ms = 0;
+static float g_time_fraction_ms = 0.0f;
+
 // Helper functions
 static void set_error(ComboError error) {
     g_last_error = error;
@@ -27,15 +31,48 @@ static void counter_init_defaults(Counter* counter) {
     counter->multiplier = 1.0f;
     counter->breaks_on_miss = true;
     counter->active = false;
+    counter->last_update_ms = g_time_ms;
+}
+
+void combo_core_set_time_ms(uint32_t now_ms) {
+    g_time_ms = now_ms;
+    g_time_fraction_ms = 0.0f;
+}
+
+uint32_t combo_core_time_ms(void) {
+    return g_time_ms;
+}
+
+float counter_get_multiplier(const Counter* counter) {
+    if (!counter) return 1.0f;
+    if (counter->type != COUNTER_TYPE_TIMED || counter->multiplier <= 1.0f) {
+        return counter->multiplier;
+    }
+
+    // Signed difference: a timestamp from before a reboot counts as no time
+    int32_t elapsed_ms = (int32_t)(g_time_ms - counter->last_update_ms);
+    if (elapsed_ms <= 0) return counter->multiplier;
+
+    float multiplier = counter->multiplier - counter->decay_rate * (elapsed_ms / 1000.0f);
+    return multiplier < 1.0f ? 1.0f : multiplier;
 }
 
-static void counter_apply_decay(Counter* counter, float dt_sec) {
-    if (counter->type == COUNTER_TYPE_TIMED && counter->multiplier > 1.0f) {
-        counter->multiplier -= counter->decay_rate * dt_sec;
-        if (counter->multiplier < 1.0f) {
-            counter->multiplier = 1.0f;
-        }
+// How long after the previous action this one had to land: a timed
+// counter's bonus runs out (multiplier - 1) / decay_rate seconds after it
+// was last settled. Other types don't decay.
+static uint32_t counter_deadline_ms(const Counter* counter) {
+    if (counter->type != COUNTER_TYPE_TIMED || counter->multiplier <= 1.0f ||
+        counter->decay_rate <= 0.0f || !counter->timing.has_last_hit) {
+        return 0;
     }
+    uint32_t bonus_ms = (uint32_t)((counter->multiplier - 1.0f) / counter->decay_rate * 1000.0f);
+    return (counter->last_update_ms - counter->timing.last_hit_ms) + bonus_ms;
+}
+
+void counter_settle(Counter* counter) {
+    if (!counter) return;
+    counter->multiplier = counter_get_multiplier(counter);
+    counter->last_update_ms = g_time_ms;
 }
 
 // Core device functions
@@ -66,14 +103,11 @@ void combo_device_update(ComboDevice* device, float dt_sec) {
     
     device->device_uptime_sec += (uint32_t)dt_sec;
     
-    // Update all active counters
-    for (uint8_t i = 0; i < device->counter_count; i++) {
-        Counter* counter = &device->counters[i];
-        if (counter->active) {
-            counter->last_update_ms += (uint32_t)(dt_sec * 1000);
-            counter_apply_decay(counter, dt_sec);
-        }
-    }
+    // Advance the clock; counters decay lazily against it
+    float elapsed_ms = dt_sec * 1000.0f + g_time_fraction_ms;
+    uint32_t whole_ms = (uint32_t)elapsed_ms;
+    g_time_ms += whole_ms;
+    g_time_fraction_ms = elapsed_ms - (float)whole_ms;
     
     // Check for sleep timeout
     if (device->last_interaction_ms > 0 && 
@@ -141,7 +175,8 @@ void counter_reset(Counter* counter) {
     
     counter->count = 0;
     counter->multiplier = 1.0f;
-    counter->last_update_ms = 0;
+    counter->last_update_ms = g_time_ms;
+    hit_stats_break(&counter->timing);
 }
 
 void counter_clear_stats(Counter* counter) {
@@ -153,11 +188,16 @@ void counter_clear_stats(Counter* counter) {
     counter->good_count = 0;
     counter->partial_count = 0;
     counter->miss_count = 0;
+    hit_stats_init(&counter->timing);
 }
 
 // User actions
 void counter_increment(Counter* counter, ActionQuality quality) {
     if (!counter || !counter->active) return;
+    if (quality != QUALITY_MISS) {
+        hit_stats_record(&counter->timing, g_time_ms, counter_deadline_ms(counter));
+    }
+    counter_settle(counter);
     
     // Update quality statistics
     switch (quality) {
@@ -232,6 +272,7 @@ void counter_increment(Counter* counter, ActionQuality quality) {
 
 void counter_decrement(Counter* counter, uint32_t amount) {
     if (!counter || !counter->active) return;
+    counter_settle(counter);
     
     if (counter->count >= (int32_t)amount) {
         counter->count -= amount;
@@ -432,6 +473,14 @@ float counter_get_average_quality(const Counter* counter) {
     return weighted_sum / total_actions;
 }
 
+void counter_get_timing(const Counter* counter, HitTimingSummary* summary) {
+    if (!counter) {
+        memset(summary, 0, sizeof(*summary));
+        return;
+    }
+    hit_stats_summary(&counter->timing, summary);
+}
+
 // Bluetooth/external communication
 void bluetooth_message_pack(BluetoothMessage* msg, const Counter* counter, 
                           uint8_t counter_id, ActionQuality quality) {
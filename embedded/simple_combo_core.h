@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "../src/hit_stats.h"
 
 // Memory constraints for nRF52840
 #define MAX_LABEL_LENGTH 16
@@ -47,9 +48,10 @@ typedef struct {
     uint32_t good_count;
     uint32_t partial_count;
     uint32_t miss_count;
+    HitStats timing;                // Gaps between non-miss actions
     
     // Timing
-    uint32_t last_update_ms;        // For timed decay
+    uint32_t last_update_ms;        // Device time the multiplier was last settled
     bool active;                    // Whether this counter is enabled
 } Counter;
 
@@ -92,6 +94,13 @@ typedef struct __attribute__((packed)) {
 void combo_device_init(ComboDevice* device);
 void combo_device_update(ComboDevice* device, float dt_sec);
 
+// Device clock used for decay. Timed decay is computed from timestamps when
+// a counter is read or hit, so combo_device_update does no per-counter work
+// and the device can sleep between events; firmware waking from sleep sets
+// the clock from its RTC instead of ticking.
+void combo_core_set_time_ms(uint32_t now_ms);
+uint32_t combo_core_time_ms(void);
+
 // Counter management
 bool counter_add(ComboDevice* device, const char* label, CounterType type);
 bool counter_remove(ComboDevice* device, uint8_t index);
@@ -104,6 +113,10 @@ void counter_increment(Counter* counter, ActionQuality quality);
 void counter_decrement(Counter* counter, uint32_t amount);
 void counter_add_raw(Counter* counter, int32_t amount);
 
+// Decayed multiplier as of the device clock. counter_settle stores it.
+float counter_get_multiplier(const Counter* counter);
+void counter_settle(Counter* counter);
+
 // Navigation
 void device_next_counter(ComboDevice* device);
 void device_prev_counter(ComboDevice* device);
@@ -128,6 +141,7 @@ void preset_productivity(ComboDevice* device);         // Pomodoro/task counting
 float counter_get_accuracy(const Counter* counter);
 uint32_t counter_get_total_actions(const Counter* counter);
 float counter_get_average_quality(const Counter* counter);
+void counter_get_timing(const Counter* counter, HitTimingSummary* summary);
 
 // Bluetooth/external communication
 bool bluetooth_send_counter_update(const Counter* counter, uint8_t counter_id, ActionQuality quality);
@@ -18,6 +18,7 @@
 
 // Application includes
 #include "simple_combo_core.h"
+#include "../src/session.h"
 
 // Simulated hardware pins (just for documentation)
 #define BUTTON_UP_PIN       13
@@ -46,6 +47,10 @@ static time_t g_last_interaction = 0;
 static time_t g_last_display_update = 0;
 static bool g_display_dirty = true;
 
+// Input recording for session_replay (COMBO_SESSION_FILE)
+static SessionRecorder g_session;
+static bool g_recording = false;
+
 // Terminal handling
 static struct termios g_old_terminal;
 static bool g_terminal_setup = false;
@@ -64,6 +69,7 @@ static void save_data(void);
 static void load_data(void);
 static void clear_screen(void);
 static char get_char_non_blocking(void);
+static void record_event(SessionOp op, uint8_t counter, ActionQuality quality, uint32_t amount);
 
 // Terminal setup for real-time input
 static void setup_terminal(void) {
@@ -139,6 +145,7 @@ static void handle_input(char c) {
                         Counter* counter = device_get_current_counter(&g_device);
                         if (counter) {
                             counter_increment(counter, QUALITY_GOOD);
+                            record_event(SESSION_OP_HIT, g_device.current_counter, QUALITY_GOOD, 0);
                             printf("[ACTION] Increment: %s = %d\n", counter->label, counter->count);
                         }
                     }
@@ -150,6 +157,7 @@ static void handle_input(char c) {
                         Counter* counter = device_get_current_counter(&g_device);
                         if (counter && counter->count > 0) {
                             counter_decrement(counter, 1);
+                            record_event(SESSION_OP_DECREMENT, g_device.current_counter, QUALITY_MISS, 1);
                             printf("[ACTION] Decrement: %s = %d\n", counter->label, counter->count);
                         }
                     }
@@ -175,6 +183,7 @@ static void handle_input(char c) {
                 case 'R':
                     for (uint8_t i = 0; i < g_device.counter_count; i++) {
                         counter_reset(&g_device.counters[i]);
+                        record_event(SESSION_OP_RESET, i, QUALITY_MISS, 0);
                     }
                     printf("[ACTION] Reset all counters\n");
                     break;
@@ -215,6 +224,7 @@ static void handle_input(char c) {
                 Counter* counter = device_get_current_counter(&g_device);
                 if (counter) {
                     counter_increment(counter, QUALITY_PERFECT);
+                    record_event(SESSION_OP_HIT, g_device.current_counter, QUALITY_PERFECT, 0);
                     printf("[ACTION] Perfect increment: %s = %d (x%.1f)\n", 
                            counter->label, counter->count, counter->multiplier);
                 }
@@ -227,6 +237,7 @@ static void handle_input(char c) {
                 Counter* counter = device_get_current_counter(&g_device);
                 if (counter) {
                     counter_increment(counter, QUALITY_GOOD);
+                    record_event(SESSION_OP_HIT, g_device.current_counter, QUALITY_GOOD, 0);
                     printf("[ACTION] Good increment: %s = %d\n", counter->label, counter->count);
                 }
             }
@@ -238,6 +249,7 @@ static void handle_input(char c) {
                 Counter* counter = device_get_current_counter(&g_device);
                 if (counter) {
                     counter_increment(counter, QUALITY_PARTIAL);
+                    record_event(SESSION_OP_HIT, g_device.current_counter, QUALITY_PARTIAL, 0);
                     printf("[ACTION] Partial increment: %s = %d\n", counter->label, counter->count);
                 }
             }
@@ -249,6 +261,7 @@ static void handle_input(char c) {
                 Counter* counter = device_get_current_counter(&g_device);
                 if (counter) {
                     counter_increment(counter, QUALITY_MISS);
+                    record_event(SESSION_OP_HIT, g_device.current_counter, QUALITY_MISS, 0);
                     printf("[ACTION] Miss: %s = %d (combo broken)\n", counter->label, counter->count);
                 }
             }
@@ -260,6 +273,9 @@ static void handle_input(char c) {
 
 // Device update
 static void update_device(void) {
+    if (g_recording) {
+        session_record_frame(&g_session, (uint64_t)combo_core_time_ms() * 1000, UPDATE_INTERVAL_MS / 1000.0f);
+    }
     combo_device_update(&g_device, UPDATE_INTERVAL_MS / 1000.0f);
     
     // Check sleep conditions
@@ -272,6 +288,12 @@ static void update_device(void) {
     }
 }
 
+static void record_event(SessionOp op, uint8_t counter, ActionQuality quality, uint32_t amount) {
+    if (!g_recording) return;
+    SessionEvent event = {(uint64_t)combo_core_time_ms() * 1000, amount, counter, (uint8_t)op, (uint8_t)quality};
+    session_record(&g_session, &event);
+}
+
 // Display rendering
 static void render_display(void) {
     if (!g_display_dirty) return;
@@ -397,6 +419,17 @@ static void render_stats_screen(void) {
         if (c->active) {
             printf("  %s: %d (total: %d, best: %d)\n", 
                    c->label, c->count, c->total, c->max_combo);
+            HitTimingSummary timing;
+            counter_get_timing(c, &timing);
+            if (timing.gaps > 0) {
+                printf("    rhythm: p50 %.0f ms, p95 %.0f ms, mean %.0f ± %.0f ms",
+                       timing.p50_ms, timing.p95_ms, timing.mean_ms, timing.stddev_ms);
+                if (c->type == COUNTER_TYPE_TIMED) {
+                    printf(", %.0f%% near deadline, %.0f%% late",
+                           timing.near_deadline_fraction * 100.0f, timing.late_fraction * 100.0f);
+                }
+                printf("\n");
+            }
         }
     }
     
@@ -463,6 +496,17 @@ int main(void) {
     
     // Initialize device
     load_data();
+
+    // Record input from the loaded state so the session can be replayed
+    const char* session_file = getenv("COMBO_SESSION_FILE");
+    if (session_file) {
+        g_recording = session_recorder_open(&g_session, session_file, SESSION_SOURCE_EMBEDDED,
+                                            &g_device, sizeof(ComboDevice),
+                                            (uint64_t)combo_core_time_ms() * 1000);
+        if (!g_recording) {
+            printf("[ERROR] Failed to start session recording: %s\n", session_file);
+        }
+    }
     
     // Setup terminal for real-time input
     setup_terminal();
@@ -497,6 +541,10 @@ int main(void) {
     
     // Save data before exit
     save_data();
+    if (g_recording) {
+        session_recorder_close(&g_session);
+        g_recording = false;
+    }
     
     printf("\n[INFO] Combo Chracker simulation ended\n");
     return 0;
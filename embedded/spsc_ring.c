@@ -0,0 +1,59 @@
+#include "spsc_ring.h"
+#include <string.h>
+
+bool spsc_ring_init(SpscRing* ring, void* storage, uint16_t element_size, uint32_t capacity) {
+    if (!ring || !storage || element_size == 0 || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return false;
+    }
+    ring->storage = (uint8_t*)storage;
+    ring->element_size = element_size;
+    ring->mask = capacity - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropped = 0;
+    return true;
+}
+
+bool spsc_ring_push(SpscRing* ring, const void* element) {
+    uint32_t tail = ring->tail;     // Only this side writes it
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    if (tail - head > ring->mask) {
+        // Single producer, so a plain increment can't race
+        __atomic_store_n(&ring->dropped, ring->dropped + 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    memcpy(&ring->storage[(tail & ring->mask) * ring->element_size], element, ring->element_size);
+    // Element bytes land before the consumer can see the new tail
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool spsc_ring_peek(SpscRing* ring, void* element) {
+    uint32_t head = ring->head;     // Only this side writes it
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (head == tail) {
+        return false;
+    }
+    memcpy(element, &ring->storage[(head & ring->mask) * ring->element_size], ring->element_size);
+    return true;
+}
+
+bool spsc_ring_pop(SpscRing* ring, void* element) {
+    if (!spsc_ring_peek(ring, element)) {
+        return false;
+    }
+    // The copy is finished before the producer may reuse the slot
+    __atomic_store_n(&ring->head, ring->head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+uint32_t spsc_ring_count(const SpscRing* ring) {
+    // Head first: the tail read after it can only be further along
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    return tail - head;
+}
+
+uint32_t spsc_ring_dropped(const SpscRing* ring) {
+    return __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,46 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Lock-free single-producer, single-consumer ring of fixed-size elements.
+//
+// Built for handing work from interrupt handlers to the main loop: an ISR
+// pushes, the main context pops and does the flash or BTLE work. Each
+// side writes only its own cursor. The producer copies the element in and
+// then publishes it with a release store of the tail; the consumer reads
+// the tail with acquire before copying out, and releases the slot with a
+// release store of the head. On Cortex-M4 the release/acquire pairs
+// compile to DMB barriers around plain 32-bit loads and stores, so no
+// interrupts are masked. On a host the two sides can be two threads.
+//
+// Cursors are free-running uint32_t counters; count = tail - head stays
+// right across wrap. Storage is supplied by the caller (static arrays on
+// the device) and capacity must be a power of two.
+
+typedef struct {
+    uint8_t* storage;
+    uint16_t element_size;
+    uint32_t mask;              // capacity - 1
+    uint32_t head;              // Written by the consumer only
+    uint32_t tail;              // Written by the producer only
+    uint32_t dropped;           // Pushes rejected because the ring was full (producer side)
+} SpscRing;
+
+// storage must hold capacity * element_size bytes
+bool spsc_ring_init(SpscRing* ring, void* storage, uint16_t element_size, uint32_t capacity);
+
+// Producer side. Returns false (and counts a drop) when the ring is full.
+bool spsc_ring_push(SpscRing* ring, const void* element);
+
+// Consumer side. peek copies the oldest element without removing it, so
+// the consumer can leave it queued if it can't be handled yet.
+bool spsc_ring_peek(SpscRing* ring, void* element);
+bool spsc_ring_pop(SpscRing* ring, void* element);
+
+// Either side; a snapshot that may be stale by the time it is used
+uint32_t spsc_ring_count(const SpscRing* ring);
+uint32_t spsc_ring_dropped(const SpscRing* ring);
+
+#endif // SPSC_RING_H
@@ -0,0 +1,431 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "flash_log.h"
+#include "turso_local.h"
+
+// Host tests for the log-structured flash store: a RAM NOR device with
+// per-page erase counters, plus turso_local on its flash simulation.
+
+#define TEST_PAGE_SIZE 1024
+#define TEST_PAGES 4
+#define TEST_BASE 0x40000
+
+static uint8_t test_flash[TEST_PAGE_SIZE * TEST_PAGES];
+static uint32_t test_erases[TEST_PAGES];
+static int32_t program_budget = -1;     // Bytes left before a simulated power cut; -1 for none
+
+static bool test_read(uint32_t addr, void* data, uint16_t size) {
+    memcpy(data, &test_flash[addr - TEST_BASE], size);
+    return true;
+}
+
+static bool test_program(uint32_t addr, const void* data, uint16_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (uint16_t i = 0; i < size; i++) {
+        if (program_budget == 0) return false;
+        if (program_budget > 0) program_budget--;
+        uint8_t* cell = &test_flash[addr - TEST_BASE + i];
+        // NOR: bits only go from 1 to 0
+        assert((*cell & bytes[i]) == bytes[i]);
+        *cell &= bytes[i];
+    }
+    return true;
+}
+
+static bool test_erase(uint32_t addr) {
+    uint32_t page = (addr - TEST_BASE) / TEST_PAGE_SIZE;
+    memset(&test_flash[page * TEST_PAGE_SIZE], 0xFF, TEST_PAGE_SIZE);
+    test_erases[page]++;
+    return true;
+}
+
+static const FlashLogDevice test_device = {
+    test_read, test_program, test_erase, TEST_BASE, TEST_PAGE_SIZE, TEST_PAGES
+};
+
+typedef struct {
+    uint32_t id;
+    uint32_t version;
+    uint8_t padding[40];
+} TestRecord;
+
+static void blank_flash(void) {
+    memset(test_flash, 0, sizeof(test_flash));     // Unformatted, not erased
+    memset(test_erases, 0, sizeof(test_erases));
+    program_budget = -1;
+}
+
+static TestRecord make_record(uint32_t id, uint32_t version) {
+    TestRecord record;
+    memset(&record, (int)(id * 31 + version), sizeof(record));
+    record.id = id;
+    record.version = version;
+    return record;
+}
+
+static void check_record(const FlashLog* log, uint32_t id, uint32_t version) {
+    TestRecord expected = make_record(id, version);
+    TestRecord actual;
+    uint16_t length = 0;
+    assert(flash_log_read(log, 1, (uint16_t)id, &actual, sizeof(actual), &length));
+    assert(length == sizeof(TestRecord));
+    assert(memcmp(&expected, &actual, sizeof(actual)) == 0);
+}
+
+void test_append_and_remount() {
+    printf("Test 1: Updates append new versions and survive a remount\n");
+
+    blank_flash();
+    static FlashLog log;
+    assert(flash_log_mount(&log, &test_device));
+    for (int i = 0; i < TEST_PAGES; i++) assert(test_erases[i] == 1);
+
+    TestRecord record = make_record(7, 1);
+    assert(flash_log_write(&log, 1, 7, &record, sizeof(record)));
+    uint16_t first_offset = flash_log_find(&log, 1, 7)->offset;
+    record = make_record(7, 2);
+    assert(flash_log_write(&log, 1, 7, &record, sizeof(record)));
+    assert(flash_log_find(&log, 1, 7)->offset != first_offset);
+    check_record(&log, 7, 2);
+
+    // Same id, different type is a different record
+    uint8_t config[3] = {1, 2, 3};
+    assert(flash_log_write(&log, 3, 7, config, sizeof(config)));
+    check_record(&log, 7, 2);
+
+    static FlashLog remounted;
+    assert(flash_log_mount(&remounted, &test_device));
+    check_record(&remounted, 7, 2);
+    uint8_t loaded[3];
+    assert(flash_log_read(&remounted, 3, 7, loaded, sizeof(loaded), NULL));
+    assert(memcmp(loaded, config, sizeof(config)) == 0);
+    assert(remounted.next_record_sequence == log.next_record_sequence);
+    assert(remounted.active_page == log.active_page);
+    assert(flash_log_verify(&remounted));
+    printf("  ✓ Newest version wins, index rebuilt from flash\n");
+}
+
+void test_gc_under_churn() {
+    printf("Test 2: Constant updates are reclaimed by GC and spread across pages\n");
+
+    blank_flash();
+    static FlashLog log;
+    assert(flash_log_mount(&log, &test_device));
+
+    uint32_t versions[8] = {0};
+    for (uint32_t n = 0; n < 4000; n++) {
+        // Six hot records, two that change only now and then
+        uint32_t id = (n % 100 == 0) ? 6 + (n / 100) % 2 : n % 6;
+        versions[id]++;
+        TestRecord record = make_record(id, versions[id]);
+        assert(flash_log_write(&log, 1, (uint16_t)id, &record, sizeof(record)));
+    }
+    for (uint32_t id = 0; id < 8; id++) check_record(&log, id, versions[id]);
+
+    FlashLogStats stats;
+    flash_log_stats(&log, &stats);
+    assert(stats.live_records == 8);
+    assert(stats.live_bytes == 8 * 60);     // 12-byte header + 48-byte record each
+    assert(stats.free_pages >= FLASH_LOG_RESERVE_PAGES);
+    // Every page took its share of erases, and the headers agree with the device
+    for (uint16_t i = 0; i < TEST_PAGES; i++) {
+        assert(flash_log_page_erase_count(&log, i) + 1 == test_erases[i]);
+        assert(test_erases[i] >= stats.max_erase_count / 2);
+    }
+    assert(stats.erases > 0 && stats.records_moved > 0);
+
+    static FlashLog remounted;
+    assert(flash_log_mount(&remounted, &test_device));
+    for (uint32_t id = 0; id < 8; id++) check_record(&remounted, id, versions[id]);
+    printf("  ✓ %u writes, %u page erases (%u..%u per page), %u records moved\n",
+           stats.records_written, stats.erases, stats.min_erase_count, stats.max_erase_count,
+           stats.records_moved);
+}
+
+void test_wear_leveling() {
+    printf("Test 3: Cold data is moved off a page that stops wearing\n");
+
+    blank_flash();
+    static FlashLog log;
+    assert(flash_log_mount(&log, &test_device));
+
+    // Fill most of a page with records that never change
+    uint32_t cold = 0;
+    for (; cold < 16; cold++) {
+        TestRecord record = make_record(100 + cold, 1);
+        assert(flash_log_write(&log, 1, (uint16_t)(100 + cold), &record, sizeof(record)));
+    }
+    uint16_t cold_page = flash_log_find(&log, 1, 100)->page;
+
+    // Hot records churn through the other pages
+    uint32_t hot = 0;
+    for (; hot < 3000; hot++) {
+        TestRecord record = make_record(hot % 2, hot);
+        assert(flash_log_write(&log, 1, (uint16_t)(hot % 2), &record, sizeof(record)));
+    }
+    assert(flash_log_page_erase_count(&log, cold_page) == 0);
+    FlashLogStats before;
+    flash_log_stats(&log, &before);
+    assert(before.max_erase_count > FLASH_LOG_WEAR_SPREAD);
+
+    assert(flash_log_wear_level(&log));
+    assert(flash_log_page_erase_count(&log, cold_page) == 1);
+    assert(flash_log_find(&log, 1, 100)->page != cold_page);
+    for (uint32_t i = 0; i < cold; i++) check_record(&log, 100 + i, 1);
+    check_record(&log, 0, hot - 2);
+    check_record(&log, 1, hot - 1);
+    assert(flash_log_verify(&log));
+    printf("  ✓ Cold page rejoined rotation after %u erases elsewhere\n", before.max_erase_count);
+}
+
+void test_power_cut() {
+    printf("Test 4: A write cut short keeps the previous version\n");
+
+    blank_flash();
+    static FlashLog log;
+    assert(flash_log_mount(&log, &test_device));
+    TestRecord record = make_record(3, 1);
+    assert(flash_log_write(&log, 1, 3, &record, sizeof(record)));
+
+    // Header goes in, payload is cut halfway
+    program_budget = 12 + 20;
+    record = make_record(3, 2);
+    assert(!flash_log_write(&log, 1, 3, &record, sizeof(record)));
+    program_budget = -1;
+
+    static FlashLog remounted;
+    assert(flash_log_mount(&remounted, &test_device));
+    check_record(&remounted, 3, 1);
+    // The damaged page is closed, the next write opens a fresh one
+    int16_t damaged = remounted.active_page;
+    assert(damaged < 0);
+    record = make_record(3, 3);
+    assert(flash_log_write(&remounted, 1, 3, &record, sizeof(record)));
+    check_record(&remounted, 3, 3);
+    assert(flash_log_verify(&remounted));
+    printf("  ✓ Torn record ignored, writes continue on a new page\n");
+}
+
+void test_delete_and_full() {
+    printf("Test 5: Deletes persist, a full store refuses writes\n");
+
+    blank_flash();
+    static FlashLog log;
+    assert(flash_log_mount(&log, &test_device));
+    TestRecord record = make_record(9, 1);
+    assert(flash_log_write(&log, 1, 9, &record, sizeof(record)));
+    assert(flash_log_delete(&log, 1, 9));
+    TestRecord loaded;
+    assert(!flash_log_read(&log, 1, 9, &loaded, sizeof(loaded), NULL));
+
+    static FlashLog remounted;
+    assert(flash_log_mount(&remounted, &test_device));
+    assert(!flash_log_read(&remounted, 1, 9, &loaded, sizeof(loaded), NULL));
+
+    // Distinct records until live data leaves no page to reclaim
+    uint32_t written = 0;
+    for (uint32_t id = 10; id < 10 + FLASH_LOG_MAX_RECORDS - 1; id++) {
+        record = make_record(id, 1);
+        if (!flash_log_write(&remounted, 1, (uint16_t)id, &record, sizeof(record))) break;
+        written++;
+    }
+    assert(written > 0 && written < FLASH_LOG_MAX_RECORDS - 1);
+    for (uint32_t i = 0; i < written; i++) check_record(&remounted, 10 + i, 1);
+    FlashLogStats stats;
+    flash_log_stats(&remounted, &stats);
+    assert(stats.free_pages == FLASH_LOG_RESERVE_PAGES);
+    printf("  ✓ %u records fit, the reserve page stayed free\n", written);
+}
+
+void test_turso_store() {
+    printf("Test 6: turso_local saves through the log and reports wear\n");
+
+    assert(turso_local_init("test_device"));
+
+    Counter counter;
+    memset(&counter, 0, sizeof(counter));
+    strcpy(counter.label, "Pushups");
+    counter.type = COUNTER_TYPE_SIMPLE;
+    for (int i = 1; i <= 3000; i++) {
+        counter.count = i;
+        counter.total = i;
+        assert(turso_save_counter(3, &counter, true));
+    }
+
+    TursoAudioRecord audio;
+    memset(&audio, 0, sizeof(audio));
+    audio.record_id = 1;
+    audio.volume = 7;
+    assert(turso_save_audio_config(&audio));
+
+    TursoDatabaseStats stats;
+    assert(turso_get_database_stats(&stats));
+    assert(stats.total_records == 2);
+    assert(stats.integrity_ok);
+    assert(stats.flash_erases > TURSO_FLASH_PAGES);
+    assert(stats.max_page_erases > 0);
+
+    uint32_t counts[TURSO_FLASH_PAGES];
+    assert(turso_get_page_erase_counts(counts, TURSO_FLASH_PAGES) == TURSO_FLASH_PAGES);
+    uint32_t least = counts[0], most = counts[0];
+    for (int i = 1; i < TURSO_FLASH_PAGES; i++) {
+        if (counts[i] < least) least = counts[i];
+        if (counts[i] > most) most = counts[i];
+    }
+    assert(least == stats.min_page_erases && most == stats.max_page_erases);
+
+    turso_compact_database();
+    assert(turso_verify_database_integrity());
+
+    // Restart: everything comes back from flash
+    turso_local_shutdown();
+    assert(turso_local_init("test_device"));
+    Counter loaded;
+    memset(&loaded, 0, sizeof(loaded));
+    assert(turso_load_counter(3, &loaded));
+    assert(loaded.count == 3000 && strcmp(loaded.label, "Pushups") == 0);
+    TursoAudioRecord loaded_audio;
+    assert(turso_load_audio_config(&loaded_audio));
+    assert(loaded_audio.volume == 7);
+    turso_local_shutdown();
+    printf("  ✓ 3000 saves, page erases %u..%u\n", least, most);
+}
+
+void test_directory_capacity() {
+    printf("Test 7: The directory holds every record it promises\n");
+
+    blank_flash();
+    static FlashLog log;
+    assert(flash_log_mount(&log, &test_device));
+
+    // Ids that would all share one slot under id % 8, in two record types
+    for (uint32_t i = 0; i < FLASH_LOG_MAX_RECORDS; i++) {
+        FlashLogEntry* entry = flash_log_claim(&log, (uint8_t)(1 + i % 2), (uint16_t)(i / 2 * 8));
+        assert(entry && entry->page == FLASH_LOG_UNWRITTEN && entry->slot == FLASH_LOG_NO_SLOT);
+        entry->slot = (uint8_t)(i % 200);
+    }
+    assert(flash_log_claim(&log, 1, 65535) == NULL);
+    for (uint32_t i = 0; i < FLASH_LOG_MAX_RECORDS; i++) {
+        const FlashLogEntry* entry = flash_log_find(&log, (uint8_t)(1 + i % 2), (uint16_t)(i / 2 * 8));
+        assert(entry && entry->slot == i % 200);
+    }
+    assert(flash_log_find(&log, 2, 65535) == NULL);
+    assert(flash_log_find(&log, 0, 0) == NULL);
+
+    // Unwritten entries read as missing and stay out of the stats
+    TestRecord record;
+    assert(!flash_log_read(&log, 1, 8, &record, sizeof(record), NULL));
+    FlashLogStats stats;
+    flash_log_stats(&log, &stats);
+    assert(stats.live_records == 0);
+    printf("  ✓ %d ids in %d slots (%u bytes of RAM)\n", FLASH_LOG_MAX_RECORDS, FLASH_LOG_INDEX_SLOTS,
+           (unsigned)sizeof(log.entries));
+}
+
+void test_turso_many_counters() {
+    printf("Test 8: turso_local keeps a thousand counters apart\n");
+
+    assert(turso_local_init("test_device"));
+    Counter counter;
+    memset(&counter, 0, sizeof(counter));
+    counter.type = COUNTER_TYPE_COMBO;
+    for (uint16_t id = 0; id < 1000; id++) {
+        snprintf(counter.label, sizeof(counter.label), "Set %u", id);
+        counter.count = id;
+        counter.total = id * 3;
+        // Batched: the pending slots fill and flush along the way
+        assert(turso_save_counter((uint16_t)(id * 8), &counter, false));
+    }
+    Counter loaded;
+    assert(turso_load_counter(999 * 8, &loaded));
+    assert(loaded.count == 999);
+
+    assert(turso_delete_counter(8));
+    assert(!turso_load_counter(8, &loaded));
+    assert(!turso_load_counter(1, &loaded));
+
+    turso_local_shutdown();
+    assert(turso_local_init("test_device"));
+    for (uint16_t id = 0; id < 1000; id++) {
+        if (id == 1) {
+            assert(!turso_load_counter(8, &loaded));
+            continue;
+        }
+        char label[MAX_LABEL_LENGTH];
+        snprintf(label, sizeof(label), "Set %u", id);
+        assert(turso_load_counter((uint16_t)(id * 8), &loaded));
+        assert(loaded.count == id && loaded.total == id * 3 && strcmp(loaded.label, label) == 0);
+    }
+    assert(turso_load_counter(3, &loaded) && loaded.count == 3000);
+
+    TursoDatabaseStats stats;
+    assert(turso_get_database_stats(&stats));
+    assert(stats.total_records == 1 + 999 + 1);     // Test 6's counter and audio config
+    assert(stats.integrity_ok);
+    turso_local_shutdown();
+    printf("  ✓ 999 counters reloaded after a restart, deleted one stays gone\n");
+}
+
+void test_compact_terminates() {
+    printf("Test 9: Compaction ends when record size doesn't divide the page\n");
+
+    // 60-byte footprints leave a 48-byte tail on every closed page
+    blank_flash();
+    static FlashLog log;
+    assert(flash_log_mount(&log, &test_device));
+    uint32_t versions[20] = {0};
+    for (uint32_t n = 0; n < 60; n++) {
+        uint32_t id = n % 20;
+        versions[id]++;
+        TestRecord record = make_record(id, versions[id]);
+        assert(flash_log_write(&log, 1, (uint16_t)id, &record, sizeof(record)));
+    }
+
+    uint32_t erases_before = log.erases;
+    uint16_t erased = flash_log_compact(&log);
+    assert(erased <= TEST_PAGES + 1);   // GC passes plus one wear-leveling move
+    assert(log.erases - erases_before == erased);
+
+    // Nothing left to reclaim but page tails: a second pass stays bounded
+    erased = flash_log_compact(&log);
+    assert(erased <= TEST_PAGES + 1);
+    for (uint32_t id = 0; id < 20; id++) check_record(&log, id, versions[id]);
+    assert(flash_log_verify(&log));
+    printf("  ✓ Bounded passes, all 20 records intact\n");
+}
+
+int main() {
+    printf("Running flash log tests...\n\n");
+
+    test_append_and_remount();
+    printf("\n");
+
+    test_gc_under_churn();
+    printf("\n");
+
+    test_wear_leveling();
+    printf("\n");
+
+    test_power_cut();
+    printf("\n");
+
+    test_delete_and_full();
+    printf("\n");
+
+    test_turso_store();
+    printf("\n");
+
+    test_directory_capacity();
+    printf("\n");
+
+    test_turso_many_counters();
+    printf("\n");
+
+    test_compact_terminates();
+    printf("\n");
+
+    printf("🎉 All flash log tests passed!\n");
+    return 0;
+}
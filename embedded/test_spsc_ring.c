@@ -0,0 +1,210 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include "spsc_ring.h"
+#include "turso_local.h"
+
+// Host tests for the SPSC ring: single-threaded semantics, then a producer
+// thread standing in for an ISR while the main thread consumes. Both sides
+// yield when they can't make progress so the tests also finish on one core.
+
+#define HAMMER_ITEMS 2000000u
+#define RECORD_ITEMS 500000u
+#define ISR_SAVES 20000
+
+typedef struct {
+    uint32_t sequence;
+    uint32_t words[10];
+    uint32_t checksum;
+} WideItem;
+
+static uint32_t wide_checksum(const WideItem* item) {
+    uint32_t sum = item->sequence * 2654435761u;
+    for (int i = 0; i < 10; i++) sum = (sum ^ item->words[i]) * 16777619u;
+    return sum;
+}
+
+void test_basic_semantics() {
+    printf("Test 1: Capacity, order, drops and cursor wrap\n");
+
+    uint32_t storage[8];
+    SpscRing ring;
+    assert(!spsc_ring_init(&ring, storage, sizeof(uint32_t), 6));
+    assert(spsc_ring_init(&ring, storage, sizeof(uint32_t), 8));
+
+    // Cursors start just short of wrapping
+    ring.head = ring.tail = UINT32_MAX - 3;
+    for (uint32_t i = 0; i < 8; i++) assert(spsc_ring_push(&ring, &i));
+    uint32_t extra = 99;
+    assert(!spsc_ring_push(&ring, &extra));
+    assert(spsc_ring_count(&ring) == 8 && spsc_ring_dropped(&ring) == 1);
+
+    uint32_t value;
+    assert(spsc_ring_peek(&ring, &value) && value == 0);
+    assert(spsc_ring_count(&ring) == 8);
+    for (uint32_t i = 0; i < 8; i++) {
+        assert(spsc_ring_pop(&ring, &value) && value == i);
+        if (i == 3) assert(spsc_ring_push(&ring, &extra));
+    }
+    assert(spsc_ring_pop(&ring, &value) && value == 99);
+    assert(!spsc_ring_pop(&ring, &value));
+    assert(spsc_ring_count(&ring) == 0);
+    assert(ring.tail < 16);     // Wrapped
+    printf("  ✓ FIFO across the 32-bit wrap, full ring drops\n");
+}
+
+static void* hammer_producer(void* arg) {
+    SpscRing* ring = (SpscRing*)arg;
+    for (uint32_t i = 0; i < HAMMER_ITEMS; i++) {
+        while (!spsc_ring_push(ring, &i)) sched_yield();
+    }
+    return NULL;
+}
+
+void test_two_threads_in_order() {
+    printf("Test 2: Two threads, every value once and in order\n");
+
+    static uint32_t storage[64];
+    SpscRing ring;
+    assert(spsc_ring_init(&ring, storage, sizeof(uint32_t), 64));
+
+    pthread_t producer;
+    pthread_create(&producer, NULL, hammer_producer, &ring);
+    uint32_t expected = 0;
+    uint32_t value;
+    while (expected < HAMMER_ITEMS) {
+        if (!spsc_ring_pop(&ring, &value)) {
+            sched_yield();
+            continue;
+        }
+        assert(value == expected);
+        expected++;
+    }
+    pthread_join(producer, NULL);
+    assert(spsc_ring_count(&ring) == 0);
+    printf("  ✓ %u values, %u rejected pushes retried\n", HAMMER_ITEMS, spsc_ring_dropped(&ring));
+}
+
+static void* wide_producer(void* arg) {
+    SpscRing* ring = (SpscRing*)arg;
+    for (uint32_t i = 0; i < RECORD_ITEMS; i++) {
+        WideItem item;
+        item.sequence = i;
+        for (int w = 0; w < 10; w++) item.words[w] = i * 31u + (uint32_t)w;
+        item.checksum = wide_checksum(&item);
+        while (!spsc_ring_push(ring, &item)) sched_yield();
+    }
+    return NULL;
+}
+
+void test_no_torn_elements() {
+    printf("Test 3: Multi-word elements are never seen half written\n");
+
+    static WideItem storage[16];
+    SpscRing ring;
+    assert(spsc_ring_init(&ring, storage, sizeof(WideItem), 16));
+
+    pthread_t producer;
+    pthread_create(&producer, NULL, wide_producer, &ring);
+    uint32_t expected = 0;
+    WideItem item;
+    while (expected < RECORD_ITEMS) {
+        if (!spsc_ring_pop(&ring, &item)) {
+            sched_yield();
+            continue;
+        }
+        assert(item.sequence == expected);
+        assert(item.checksum == wide_checksum(&item));
+        expected++;
+    }
+    pthread_join(producer, NULL);
+    printf("  ✓ %u 48-byte elements through a 16-slot ring\n", RECORD_ITEMS);
+}
+
+static volatile int isr_done = 0;
+
+// Stands in for a button ISR: saves and queues sync work, never waits on flash
+static void* isr_producer(void* arg) {
+    (void)arg;
+    Counter counters[4];
+    memset(counters, 0, sizeof(counters));
+    for (int c = 0; c < 4; c++) snprintf(counters[c].label, sizeof(counters[c].label), "Button %d", c);
+
+    for (int i = 1; i <= ISR_SAVES; i++) {
+        Counter* counter = &counters[i % 4];
+        counter->count++;
+        counter->total++;
+        while (!turso_save_counter_from_isr((uint16_t)(100 + i % 4), counter)) sched_yield();
+    }
+    uint8_t marker = 0x5A;
+    while (!turso_queue_sync_operation_from_isr(RECORD_TYPE_SYNC_STATE, 1, SYNC_OP_UPDATE, &marker, 1)) {
+        sched_yield();
+    }
+    __atomic_store_n(&isr_done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+void test_isr_handoff() {
+    printf("Test 4: ISR saves reach flash only through the main loop\n");
+
+    assert(turso_local_init("spsc_test"));
+    turso_set_btle_connected(true);
+    uint32_t writes_before = turso_get_flash_write_count();
+
+    pthread_t isr;
+    pthread_create(&isr, NULL, isr_producer, NULL);
+    TursoSyncRecord record;
+    bool saw_marker = false;
+    bool draining = true;
+    while (draining) {
+        // Checked before the pass so the last pushes are still handled
+        bool producer_done = __atomic_load_n(&isr_done, __ATOMIC_ACQUIRE);
+        if (turso_process_pending() == 0) sched_yield();
+        // Main loop is also the BTLE side: send and ack what is queued
+        while (turso_get_next_sync_record(&record)) {
+            if (record.type == RECORD_TYPE_SYNC_STATE && record.data[0] == 0x5A) saw_marker = true;
+            turso_ack_sync_record(record.sequence);
+        }
+        draining = !producer_done;
+    }
+    pthread_join(isr, NULL);
+    assert(saw_marker);
+    assert(turso_get_pending_sync_count() == 0);
+
+    turso_force_flush_pending_writes();
+    assert(turso_get_flash_write_count() > writes_before);
+    for (int c = 0; c < 4; c++) {
+        Counter loaded;
+        assert(turso_load_counter((uint16_t)(100 + c), &loaded));
+        assert(loaded.count == ISR_SAVES / 4 && loaded.total == ISR_SAVES / 4);
+    }
+
+    TursoDatabaseStats stats;
+    assert(turso_get_database_stats(&stats));
+    assert(stats.isr_requests_queued == 0);
+    turso_local_shutdown();
+    printf("  ✓ %d saves handed off, %u pushes found the ring full and retried\n",
+           ISR_SAVES, stats.isr_requests_dropped);
+}
+
+int main() {
+    printf("Running SPSC ring tests...\n\n");
+
+    test_basic_semantics();
+    printf("\n");
+
+    test_two_threads_in_order();
+    printf("\n");
+
+    test_no_torn_elements();
+    printf("\n");
+
+    test_isr_handoff();
+    printf("\n");
+
+    printf("🎉 All SPSC ring tests passed!\n");
+    return 0;
+}
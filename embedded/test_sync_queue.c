@@ -0,0 +1,253 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "turso_local.h"
+
+// Host tests for the BTLE sync queue: sequence-numbered ring with
+// cumulative and selective acknowledgements, backed by a flash overflow.
+
+static uint32_t queue_record(uint16_t record_id) {
+    uint8_t payload[4] = {(uint8_t)record_id, 1, 2, 3};
+    assert(turso_queue_sync_operation(RECORD_TYPE_COUNTER, record_id, SYNC_OP_UPDATE,
+                                      payload, sizeof(payload)));
+    return record_id;
+}
+
+// Send everything queued; returns how many went out
+static uint32_t send_all(uint32_t* sequences, uint32_t max) {
+    TursoSyncRecord record;
+    uint32_t sent = 0;
+    while (sent < max && turso_get_next_sync_record(&record)) {
+        sequences[sent++] = record.sequence;
+    }
+    return sent;
+}
+
+void test_out_of_order_acks() {
+    printf("Test 1: Out-of-order acks never leak slots\n");
+
+    assert(turso_local_init("sync_test"));
+    turso_set_btle_connected(true);
+
+    for (uint16_t i = 0; i < MAX_SYNC_QUEUE_SIZE; i++) queue_record(i);
+    uint32_t sequences[MAX_SYNC_QUEUE_SIZE];
+    assert(send_all(sequences, MAX_SYNC_QUEUE_SIZE) == MAX_SYNC_QUEUE_SIZE);
+    for (uint32_t i = 1; i < MAX_SYNC_QUEUE_SIZE; i++) assert(sequences[i] == sequences[i - 1] + 1);
+    
+    // The window is full, so the next record waits behind it
+    queue_record(99);
+    TursoSyncRecord record;
+    assert(!turso_get_next_sync_record(&record));
+    
+    // Everything but the oldest, newest first: the window can't slide yet
+    for (int i = MAX_SYNC_QUEUE_SIZE - 1; i >= 1; i--) turso_ack_sync_record(sequences[i]);
+    assert(turso_get_pending_sync_count() == 2);
+    assert(!turso_get_next_sync_record(&record));
+    
+    // The oldest arrives, the whole window frees at once and the waiting
+    // record moves in with the next sequence
+    turso_ack_sync_record(sequences[0]);
+    assert(turso_get_pending_sync_count() == 1);
+    assert(turso_get_next_sync_record(&record));
+    assert(record.record_id == 99 && record.sequence == sequences[MAX_SYNC_QUEUE_SIZE - 1] + 1);
+    turso_ack_sync_record(record.sequence);
+    assert(turso_get_pending_sync_count() == 0);
+    for (uint16_t i = 0; i < MAX_SYNC_QUEUE_SIZE; i++) queue_record(i);
+    assert(turso_get_pending_sync_count() == MAX_SYNC_QUEUE_SIZE);
+    
+    TursoDatabaseStats stats;
+    assert(turso_get_database_stats(&stats));
+    assert(stats.sync_overflow_records == 0 && stats.sync_overflow_page_writes == 0);
+    
+    turso_local_shutdown();
+    printf("  ✓ 31 acks ahead of the oldest, waiting record admitted, window reused\n");
+}
+
+void test_cumulative_and_resend() {
+    printf("Test 2: Cumulative acks, selective gaps and resend on reconnect\n");
+
+    assert(turso_local_init("sync_test"));
+    turso_set_btle_connected(true);
+
+    for (uint16_t i = 0; i < 10; i++) queue_record(i);
+    uint32_t sequences[10];
+    assert(send_all(sequences, 10) == 10);
+    TursoSyncRecord record;
+    assert(!turso_get_next_sync_record(&record));
+
+    turso_ack_sync_through(sequences[4]);
+    assert(turso_get_pending_sync_count() == 5);
+    turso_ack_sync_record(sequences[7]);
+    assert(turso_get_pending_sync_count() == 4);
+
+    // Link drops; the unacked records go out again, the acked one doesn't
+    turso_set_btle_connected(false);
+    turso_set_btle_connected(true);
+    uint32_t resent[10];
+    assert(send_all(resent, 10) == 4);
+    assert(resent[0] == sequences[5] && resent[1] == sequences[6]);
+    assert(resent[2] == sequences[8] && resent[3] == sequences[9]);
+    assert(turso_get_next_sync_record(&record) == false);
+
+    // Stale, duplicate and future acks change nothing
+    turso_ack_sync_through(sequences[2]);
+    turso_ack_sync_record(sequences[7]);
+    turso_ack_sync_record(sequences[9] + 5);
+    turso_ack_sync_through(sequences[9] + 5);
+    assert(turso_get_pending_sync_count() == 4);
+
+    // A cumulative ack over a selectively acked record counts it once
+    turso_ack_sync_through(sequences[9]);
+    assert(turso_get_pending_sync_count() == 0);
+
+    // Acks for queued records that haven't gone out yet are ignored
+    for (uint16_t i = 0; i < 3; i++) queue_record(i);
+    turso_ack_sync_record(sequences[9] + 2);
+    turso_ack_sync_through(sequences[9] + 3);
+    assert(turso_get_pending_sync_count() == 3);
+    assert(send_all(resent, 10) == 3 && resent[0] == sequences[9] + 1);
+
+    // Resent after reconnect, then acked: the earlier send still counts
+    turso_set_btle_connected(false);
+    turso_set_btle_connected(true);
+    turso_ack_sync_through(sequences[9] + 3);
+    assert(turso_get_pending_sync_count() == 0);
+
+    turso_local_shutdown();
+    printf("  ✓ 4 resent after reconnect, late and unsent acks ignored\n");
+}
+
+void test_random_ack_order() {
+    printf("Test 3: Random ack order over many windows\n");
+
+    assert(turso_local_init("sync_test"));
+    turso_set_btle_connected(true);
+    srand(23);
+
+    uint32_t queued = 0;
+    uint32_t in_flight[MAX_SYNC_QUEUE_SIZE];
+    uint32_t flight_count = 0;
+    while (queued < 20000) {
+        // Fill whatever the window allows
+        while (turso_queue_sync_operation(RECORD_TYPE_COUNTER, (uint16_t)queued, SYNC_OP_UPDATE, NULL, 0)) {
+            queued++;
+        }
+        TursoSyncRecord record;
+        while (turso_get_next_sync_record(&record)) in_flight[flight_count++] = record.sequence;
+        assert(flight_count > 0);
+
+        // Ack a random subset in random order, now and then cumulatively
+        uint32_t acks = 1 + (uint32_t)rand() % flight_count;
+        for (uint32_t a = 0; a < acks; a++) {
+            uint32_t pick = (uint32_t)rand() % flight_count;
+            if (rand() % 8 == 0) {
+                turso_ack_sync_through(in_flight[pick]);
+            } else {
+                turso_ack_sync_record(in_flight[pick]);
+            }
+            in_flight[pick] = in_flight[--flight_count];
+            if (flight_count == 0) break;
+        }
+        // Whatever is still unacked goes out again next round
+        turso_set_btle_connected(false);
+        turso_set_btle_connected(true);
+        flight_count = 0;
+    }
+
+    // Drain: the peer acks the rest, a window at a time
+    TursoSyncRecord record;
+    while (turso_get_pending_sync_count() > 0) {
+        uint32_t last = 0;
+        while (turso_get_next_sync_record(&record)) last = record.sequence;
+        assert(last != 0);
+        turso_ack_sync_through(last);
+    }
+    assert(turso_queue_sync_operation(RECORD_TYPE_COUNTER, 1, SYNC_OP_UPDATE, NULL, 0));
+
+    turso_local_shutdown();
+    printf("  ✓ %u records through a %d-slot window, none stranded\n", queued, MAX_SYNC_QUEUE_SIZE);
+}
+
+// Queue until the overflow is full, then drain and check nothing was
+// lost or reordered; returns how many records were accepted
+static uint32_t fill_and_drain(uint16_t first_id) {
+    TursoDatabaseStats stats;
+    assert(turso_get_database_stats(&stats));
+    uint32_t pages_before = stats.sync_overflow_page_writes;
+    uint32_t writes_before = turso_get_flash_write_count();
+    uint32_t queued = 0;
+    while (turso_queue_sync_operation(RECORD_TYPE_COUNTER, (uint16_t)(first_id + queued),
+                                      SYNC_OP_UPDATE, &queued, sizeof(queued))) {
+        queued++;
+    }
+    assert(turso_get_last_error() == TURSO_ERROR_SYNC_QUEUE_FULL);
+    assert(turso_get_pending_sync_count() == queued);
+    
+    // Overflow reached flash in whole pages, one write each
+    assert(turso_get_database_stats(&stats));
+    assert(stats.sync_overflow_records == queued - MAX_SYNC_QUEUE_SIZE);
+    assert(stats.sync_overflow_page_writes - pages_before == TURSO_SYNC_OVERFLOW_PAGES);
+    assert(turso_get_flash_write_count() - writes_before == TURSO_SYNC_OVERFLOW_PAGES);
+    
+    // Reconnect; each cumulative ack pulls the next records into the window
+    turso_set_btle_connected(true);
+    uint32_t expected = 0;
+    TursoSyncRecord record;
+    while (turso_get_pending_sync_count() > 0) {
+        uint32_t last = 0;
+        while (turso_get_next_sync_record(&record)) {
+            uint32_t payload;
+            memcpy(&payload, record.data, sizeof(payload));
+            assert(record.record_id == (uint16_t)(first_id + expected) && payload == expected);
+            assert(record.crc16 == turso_crc16(record.data, sizeof(payload)));
+            last = record.sequence;
+            expected++;
+        }
+        turso_ack_sync_through(last);
+    }
+    assert(expected == queued);
+    assert(turso_get_flash_write_count() == writes_before + TURSO_SYNC_OVERFLOW_PAGES);
+    turso_set_btle_connected(false);
+    return queued;
+}
+
+void test_flash_overflow() {
+    printf("Test 4: Long disconnect spills to flash and drains in order\n");
+    
+    assert(turso_local_init("sync_test"));
+    
+    uint32_t first = fill_and_drain(0);
+    assert(first > MAX_SYNC_QUEUE_SIZE + TURSO_SYNC_OVERFLOW_PAGES * 64);
+    
+    // Second time round every overflow page is erased before reuse
+    uint32_t second = fill_and_drain(1000);
+    assert(second == first);
+    TursoDatabaseStats stats;
+    assert(turso_get_database_stats(&stats));
+    assert(stats.sync_overflow_page_writes == 2 * TURSO_SYNC_OVERFLOW_PAGES);
+    assert(stats.sync_overflow_records == 0);
+    
+    turso_local_shutdown();
+    printf("  ✓ %u records per disconnect, %d page writes each, none lost\n",
+           first, TURSO_SYNC_OVERFLOW_PAGES);
+}
+
+int main() {
+    printf("Running sync queue tests...\n\n");
+
+    test_out_of_order_acks();
+    printf("\n");
+
+    test_cumulative_and_resend();
+    printf("\n");
+
+    test_random_ack_order();
+    printf("\n");
+    
+    test_flash_overflow();
+    printf("\n");
+
+    printf("🎉 All sync queue tests passed!\n");
+    return 0;
+}
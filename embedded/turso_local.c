@@ -1,4 +1,6 @@
 #include "turso_local.h"
+#include "flash_log.h"
+#include "spsc_ring.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -13,20 +15,64 @@
 #define FLASH_PAGE_SIZE 4096
 #define FLASH_SECTOR_SIZE 64
 #define TURSO_FLASH_BASE_ADDR 0x80000
-static uint8_t flash_simulation[FLASH_PAGE_SIZE * 4];
+// Sync overflow pages sit right after the record log
+#define TURSO_OVERFLOW_BASE_ADDR (TURSO_FLASH_BASE_ADDR + FLASH_PAGE_SIZE * TURSO_FLASH_PAGES)
+static uint8_t flash_simulation[FLASH_PAGE_SIZE * (TURSO_FLASH_PAGES + TURSO_SYNC_OVERFLOW_PAGES)];
+
+// Records live in a log-structured store on top of the flash pages
+#define AUDIO_CONFIG_RECORD_ID 0
 
 // Global database state
 static TursoLocalDB g_db;
+static FlashLog g_log;
 static bool g_db_initialized = false;
 static TursoError g_last_error = TURSO_OK;
 
-// Energy-conscious write batching
-static TursoCounterRecord g_pending_counters[MAX_COUNTERS];
-static bool g_counter_dirty[MAX_COUNTERS];
+// Energy-conscious write batching. A counter with unflushed changes has
+// its pending slot recorded in its flash log directory entry.
+static TursoCounterRecord g_pending_counters[MAX_PENDING_WRITES];
+static bool g_counter_dirty[MAX_PENDING_WRITES];
 static uint8_t g_dirty_counter_count = 0;
 
+// Work handed from interrupt context to the main loop
+typedef struct {
+    uint8_t type;
+    uint8_t operation;
+    uint16_t record_id;
+    uint8_t data_size;
+    uint8_t data[32];
+} TursoSyncRequest;
+
+static SpscRing g_write_requests;
+static TursoCounterRecord g_write_request_storage[TURSO_ISR_QUEUE_SIZE];
+static SpscRing g_sync_requests;
+static TursoSyncRequest g_sync_request_storage[TURSO_ISR_QUEUE_SIZE];
+
+// Sync records queued behind a full window, in flash form. They collect
+// in a page-sized RAM batch; the batch is programmed with one write when
+// the next record finds it full. Flash pages form a FIFO ring and are
+// erased only just before reuse.
+typedef struct {
+    uint32_t timestamp_ms;
+    uint16_t record_id;
+    uint8_t type;
+    uint8_t operation;
+    uint8_t data[32];
+    uint16_t crc16;
+} __attribute__((packed)) TursoOverflowRecord;
+
+#define OVERFLOW_RECORDS_PER_PAGE (FLASH_PAGE_SIZE / sizeof(TursoOverflowRecord))
+
+static TursoOverflowRecord g_overflow_batch[OVERFLOW_RECORDS_PER_PAGE];
+static uint16_t g_overflow_batch_count = 0;
+static uint8_t g_overflow_head_page = 0;    // Oldest page still holding records
+static uint8_t g_overflow_page_count = 0;   // Programmed pages not fully drained
+static uint16_t g_overflow_read_index = 0;  // Records of the head page already in the window
+static uint32_t g_overflow_page_writes = 0;
+static uint32_t g_overflow_erases = 0;
+
 // CRC16 calculation for data integrity
-static uint16_t calculate_crc16(const uint8_t* data, uint16_t length) {
+uint16_t turso_crc16(const uint8_t* data, uint16_t length) {
     uint16_t crc = 0xFFFF;
     for (uint16_t i = 0; i < length; i++) {
         crc ^= (uint16_t)data[i] << 8;
@@ -49,26 +95,36 @@ static uint32_t get_timestamp_ms(void) {
     return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
 }
 
-// Flash write wrapper with energy monitoring
+// Flash write wrapper with energy monitoring. Like NOR flash, a write can
+// only clear bits; writing over cells that weren't erased fails.
 static bool flash_write_sector(uint32_t addr, const void* data, uint16_t size) {
     // In real nRF52840, use nrf_fstorage or fds (Flash Data Storage)
-    if (addr < TURSO_FLASH_BASE_ADDR || addr + size >= TURSO_FLASH_BASE_ADDR + sizeof(flash_simulation)) {
+    if (addr < TURSO_FLASH_BASE_ADDR || addr + size > TURSO_FLASH_BASE_ADDR + sizeof(flash_simulation)) {
         g_last_error = TURSO_ERROR_FLASH_WRITE_FAILED;
         return false;
     }
     
-    memcpy(&flash_simulation[addr - TURSO_FLASH_BASE_ADDR], data, size);
+    uint8_t* cells = &flash_simulation[addr - TURSO_FLASH_BASE_ADDR];
+    const uint8_t* bytes = (const uint8_t*)data;
+    bool clean = true;
+    for (uint16_t i = 0; i < size; i++) {
+        cells[i] &= bytes[i];
+        clean = clean && cells[i] == bytes[i];
+    }
     g_db.total_writes++;
     g_db.last_flash_write_ms = get_timestamp_ms();
     
     NRF_LOG_DEBUG("Flash write: addr=0x%08X, size=%d, total_writes=%d", 
                   addr, size, g_db.total_writes);
-    return true;
+    if (!clean) {
+        g_last_error = TURSO_ERROR_FLASH_WRITE_FAILED;
+    }
+    return clean;
 }
 
 // Flash read wrapper
 static bool flash_read_sector(uint32_t addr, void* data, uint16_t size) {
-    if (addr < TURSO_FLASH_BASE_ADDR || addr + size >= TURSO_FLASH_BASE_ADDR + sizeof(flash_simulation)) {
+    if (addr < TURSO_FLASH_BASE_ADDR || addr + size > TURSO_FLASH_BASE_ADDR + sizeof(flash_simulation)) {
         return false;
     }
     
@@ -76,31 +132,174 @@ static bool flash_read_sector(uint32_t addr, void* data, uint16_t size) {
     return true;
 }
 
-// Add record to sync queue for BTLE transmission
-static bool add_to_sync_queue(TursoRecordType type, uint16_t record_id, 
-                             TursoSyncOperation op, const void* data, uint8_t data_size) {
-    if (g_db.pending_sync_count >= MAX_SYNC_QUEUE_SIZE) {
+// Page erase (nrf_fstorage_erase on the device)
+static bool flash_erase_page(uint32_t addr) {
+    if (addr < TURSO_FLASH_BASE_ADDR || addr + FLASH_PAGE_SIZE > TURSO_FLASH_BASE_ADDR + sizeof(flash_simulation)) {
+        return false;
+    }
+    
+    memset(&flash_simulation[addr - TURSO_FLASH_BASE_ADDR], 0xFF, FLASH_PAGE_SIZE);
+    NRF_LOG_DEBUG("Flash erase: addr=0x%08X", addr);
+    return true;
+}
+
+static const FlashLogDevice g_flash_device = {
+    flash_read_sector, flash_write_sector, flash_erase_page,
+    TURSO_FLASH_BASE_ADDR, FLASH_PAGE_SIZE, TURSO_FLASH_PAGES
+};
+
+#if (MAX_SYNC_QUEUE_SIZE & (MAX_SYNC_QUEUE_SIZE - 1)) != 0
+#error "MAX_SYNC_QUEUE_SIZE must be a power of two"
+#endif
+
+#define SYNC_SLOT(sequence) (&g_db.sync_queue[(sequence) & (MAX_SYNC_QUEUE_SIZE - 1)])
+
+// True if sequence lies in [from, to); differences keep this right across wrap
+static bool sync_in_range(uint32_t sequence, uint32_t from, uint32_t to) {
+    return sequence - from < to - from;
+}
+
+static bool sync_window_full(void) {
+    return g_db.sync_next_sequence - g_db.sync_head_sequence >= MAX_SYNC_QUEUE_SIZE;
+}
+
+// The record takes the next sequence number and becomes sendable
+static void admit_sync_record(const TursoOverflowRecord* entry) {
+    TursoSyncRecord* record = SYNC_SLOT(g_db.sync_next_sequence);
+    record->sequence = g_db.sync_next_sequence;
+    record->timestamp_ms = entry->timestamp_ms;
+    record->record_id = entry->record_id;
+    record->type = (TursoRecordType)entry->type;
+    record->operation = (TursoSyncOperation)entry->operation;
+    memcpy(record->data, entry->data, sizeof(record->data));
+    record->crc16 = entry->crc16;
+    record->pending_sync = true;
+    g_db.sync_next_sequence++;
+}
+
+static uint32_t overflow_page_addr(uint8_t page) {
+    return TURSO_OVERFLOW_BASE_ADDR + (uint32_t)page * FLASH_PAGE_SIZE;
+}
+
+static uint32_t overflow_record_count(void) {
+    return (uint32_t)g_overflow_page_count * OVERFLOW_RECORDS_PER_PAGE - g_overflow_read_index +
+           g_overflow_batch_count;
+}
+
+// Program the full RAM batch as the newest overflow page
+static bool spill_overflow_batch(void) {
+    if (g_overflow_page_count == TURSO_SYNC_OVERFLOW_PAGES) {
         g_last_error = TURSO_ERROR_SYNC_QUEUE_FULL;
         NRF_LOG_ERROR("Sync queue full!");
         return false;
     }
     
-    TursoSyncRecord* record = &g_db.sync_queue[g_db.sync_queue_tail];
-    record->timestamp_ms = get_timestamp_ms();
-    record->record_id = record_id;
-    record->type = type;
-    record->operation = op;
-    record->pending_sync = true;
+    uint8_t page = (g_overflow_head_page + g_overflow_page_count) % TURSO_SYNC_OVERFLOW_PAGES;
+    uint32_t addr = overflow_page_addr(page);
+    
+    // Pages are written whole from offset 0, so a blank first record means
+    // the page is still erased (pages left over from before init aren't)
+    uint8_t first[8];
+    if (!flash_read_sector(addr, first, sizeof(first))) {
+        g_last_error = TURSO_ERROR_FLASH_READ_FAILED;
+        return false;
+    }
+    for (uint8_t i = 0; i < sizeof(first); i++) {
+        if (first[i] != 0xFF) {
+            if (!flash_erase_page(addr)) {
+                g_last_error = TURSO_ERROR_FLASH_WRITE_FAILED;
+                return false;
+            }
+            g_overflow_erases++;
+            break;
+        }
+    }
+    
+    if (!flash_write_sector(addr, g_overflow_batch, sizeof(g_overflow_batch))) {
+        return false;
+    }
+    g_overflow_page_count++;
+    g_overflow_batch_count = 0;
+    g_overflow_page_writes++;
+    NRF_LOG_DEBUG("Sync overflow spilled to page %d, %d pages queued", page, g_overflow_page_count);
+    return true;
+}
+
+// Fill free window slots from the overflow, oldest first: flash pages,
+// then the RAM batch. Only reads flash.
+static void refill_sync_window(void) {
+    while (!sync_window_full() && g_overflow_page_count > 0) {
+        TursoOverflowRecord entry;
+        if (!flash_read_sector(overflow_page_addr(g_overflow_head_page) + g_overflow_read_index * sizeof(entry),
+                               &entry, sizeof(entry))) {
+            // Leave the cursor; the record is retried on the next refill
+            g_last_error = TURSO_ERROR_FLASH_READ_FAILED;
+            NRF_LOG_ERROR("Sync overflow read failed on page %d", g_overflow_head_page);
+            return;
+        }
+        admit_sync_record(&entry);
+        if (++g_overflow_read_index == OVERFLOW_RECORDS_PER_PAGE) {
+            g_overflow_read_index = 0;
+            g_overflow_head_page = (g_overflow_head_page + 1) % TURSO_SYNC_OVERFLOW_PAGES;
+            g_overflow_page_count--;
+        }
+    }
+    if (g_overflow_page_count > 0 || g_overflow_batch_count == 0) {
+        return;
+    }
+    
+    uint16_t taken = 0;
+    while (!sync_window_full() && taken < g_overflow_batch_count) {
+        admit_sync_record(&g_overflow_batch[taken++]);
+    }
+    memmove(g_overflow_batch, &g_overflow_batch[taken],
+            (g_overflow_batch_count - taken) * sizeof(TursoOverflowRecord));
+    g_overflow_batch_count -= taken;
+}
+
+// Slide the window past records already acked out of order. Every record
+// is stepped over once, so acks cost O(1) amortized. Freed slots are
+// refilled from the overflow.
+static void advance_sync_head(void) {
+    while (g_db.sync_head_sequence != g_db.sync_next_sequence &&
+           !SYNC_SLOT(g_db.sync_head_sequence)->pending_sync) {
+        g_db.sync_head_sequence++;
+    }
+    if (!sync_in_range(g_db.sync_send_sequence, g_db.sync_head_sequence, g_db.sync_next_sequence + 1)) {
+        g_db.sync_send_sequence = g_db.sync_head_sequence;
+    }
+    refill_sync_window();
+}
+
+// Add record to sync queue for BTLE transmission
+static bool add_to_sync_queue(TursoRecordType type, uint16_t record_id, 
+                             TursoSyncOperation op, const void* data, uint8_t data_size) {
+    TursoOverflowRecord entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.timestamp_ms = get_timestamp_ms();
+    entry.record_id = record_id;
+    entry.type = (uint8_t)type;
+    entry.operation = (uint8_t)op;
     
     // Copy data with size limit for BTLE efficiency
-    uint8_t copy_size = (data_size > sizeof(record->data)) ? sizeof(record->data) : data_size;
+    uint8_t copy_size = (data_size > sizeof(entry.data)) ? sizeof(entry.data) : data_size;
     if (data && copy_size > 0) {
-        memcpy(record->data, data, copy_size);
+        memcpy(entry.data, data, copy_size);
     }
     
-    record->crc16 = calculate_crc16(record->data, copy_size);
+    entry.crc16 = turso_crc16(entry.data, copy_size);
+    
+    // Straight into the window unless older records are still waiting
+    if (g_overflow_page_count == 0 && g_overflow_batch_count == 0 && !sync_window_full()) {
+        admit_sync_record(&entry);
+    } else {
+        // The spill sets the error: full, or the flash failed
+        if (g_overflow_batch_count == OVERFLOW_RECORDS_PER_PAGE && !spill_overflow_batch()) {
+            return false;
+        }
+        g_overflow_batch[g_overflow_batch_count++] = entry;
+    }
     
-    g_db.sync_queue_tail = (g_db.sync_queue_tail + 1) % MAX_SYNC_QUEUE_SIZE;
     g_db.pending_sync_count++;
     
     NRF_LOG_DEBUG("Added to sync queue: type=%d, id=%d, op=%d", type, record_id, op);
@@ -125,11 +324,29 @@ bool turso_local_init(const char* device_id) {
     }
     
     g_db.local_sequence_number = 1;
+    g_db.sync_head_sequence = 1;        // Acking through 0 acks nothing
+    g_db.sync_send_sequence = 1;
+    g_db.sync_sent_limit = 1;
+    g_db.sync_next_sequence = 1;
+    g_overflow_batch_count = 0;
+    g_overflow_head_page = 0;
+    g_overflow_page_count = 0;
+    g_overflow_read_index = 0;
+    g_overflow_page_writes = 0;
+    g_overflow_erases = 0;
     g_db.btle_connected = false;
     g_db.low_power_mode = false;
     
-    // Initialize flash simulation (in real nRF52840, check flash integrity)
-    memset(flash_simulation, 0xFF, sizeof(flash_simulation));
+    // Rebuild the record directory from flash; blank pages are formatted
+    memset(g_counter_dirty, 0, sizeof(g_counter_dirty));
+    g_dirty_counter_count = 0;
+    spsc_ring_init(&g_write_requests, g_write_request_storage, sizeof(TursoCounterRecord), TURSO_ISR_QUEUE_SIZE);
+    spsc_ring_init(&g_sync_requests, g_sync_request_storage, sizeof(TursoSyncRequest), TURSO_ISR_QUEUE_SIZE);
+    if (!flash_log_mount(&g_log, &g_flash_device)) {
+        g_last_error = TURSO_ERROR_FLASH_WRITE_FAILED;
+        NRF_LOG_ERROR("Flash store mount failed");
+        return false;
+    }
     
     g_db_initialized = true;
     g_last_error = TURSO_OK;
@@ -144,15 +361,98 @@ void turso_local_shutdown(void) {
         return;
     }
     
-    // Force flush any pending writes to save data
+    // Take in ISR work, then force flush any pending writes to save data
+    turso_process_pending();
     turso_force_flush_pending_writes();
     
     NRF_LOG_INFO("Turso local DB shutdown. Total flash writes: %d", g_db.total_writes);
     g_db_initialized = false;
 }
 
+static uint8_t claim_pending_slot(void) {
+    for (uint8_t i = 0; i < MAX_PENDING_WRITES; i++) {
+        if (!g_counter_dirty[i]) {
+            return i;
+        }
+    }
+    return FLASH_LOG_NO_SLOT;
+}
+
+static void counter_from_record(const TursoCounterRecord* turso_counter, Counter* counter) {
+    snprintf(counter->label, sizeof(counter->label), "%s", turso_counter->label);
+    counter->type = turso_counter->type;
+    counter->count = turso_counter->count;
+    counter->total = turso_counter->total;
+    counter->max_combo = turso_counter->max_combo;
+    counter->multiplier = turso_counter->multiplier;
+    counter->active = turso_counter->active;
+}
+
+static void flush_pending_writes(void);
+
+// Convert to Turso record format. Only reads the counter, so it is safe
+// in interrupt context.
+static void build_counter_record(uint16_t counter_id, const Counter* counter, TursoCounterRecord* turso_counter) {
+    memset(turso_counter, 0, sizeof(*turso_counter));
+    turso_counter->record_id = counter_id;
+    turso_counter->created_at = get_timestamp_ms();
+    turso_counter->updated_at = turso_counter->created_at;
+    
+    // Fixed-size copy, no libc formatting in an ISR; memset left the terminator
+    memcpy(turso_counter->label, counter->label, MAX_LABEL_LENGTH - 1);
+    turso_counter->type = counter->type;
+    turso_counter->count = counter->count;
+    turso_counter->total = counter->total;
+    turso_counter->max_combo = counter->max_combo;
+    turso_counter->multiplier = counter_get_multiplier(counter);
+    turso_counter->active = counter->active;
+}
+
+// Main context: stage a counter record for the next batched flash write
+static bool apply_counter_record(const TursoCounterRecord* turso_counter, bool force_immediate_write) {
+    uint16_t counter_id = turso_counter->record_id;
+    
+    // Directory entry first: it holds the pending slot until the flush
+    FlashLogEntry* entry = flash_log_claim(&g_log, RECORD_TYPE_COUNTER, counter_id);
+    if (!entry) {
+        g_last_error = TURSO_ERROR_FLASH_WRITE_FAILED;
+        NRF_LOG_ERROR("Record directory full, counter %d not saved", counter_id);
+        return false;
+    }
+    if (entry->slot == FLASH_LOG_NO_SLOT) {
+        uint8_t slot = claim_pending_slot();
+        if (slot == FLASH_LOG_NO_SLOT) {
+            flush_pending_writes();
+            slot = claim_pending_slot();
+        }
+        if (slot == FLASH_LOG_NO_SLOT) {
+            g_last_error = TURSO_ERROR_FLASH_WRITE_FAILED;
+            return false;
+        }
+        entry->slot = slot;
+        g_counter_dirty[slot] = true;
+        g_dirty_counter_count++;
+    }
+    
+    // Energy-conscious batched writing
+    g_pending_counters[entry->slot] = *turso_counter;
+    
+    // Queue for BTLE sync
+    add_to_sync_queue(RECORD_TYPE_COUNTER, counter_id, 
+                     SYNC_OP_UPDATE, turso_counter, sizeof(*turso_counter));
+    
+    // Write immediately if forced or threshold reached
+    if (force_immediate_write || g_dirty_counter_count >= BATCH_WRITE_THRESHOLD) {
+        flush_pending_writes();
+    }
+    
+    NRF_LOG_DEBUG("Counter saved (batched): %s, dirty_count=%d", 
+                  turso_counter->label, g_dirty_counter_count);
+    return true;
+}
+
 // Save counter with batched writes for energy efficiency
-bool turso_save_counter(const Counter* counter, bool force_immediate_write) {
+bool turso_save_counter(uint16_t counter_id, const Counter* counter, bool force_immediate_write) {
     if (!g_db_initialized) {
         g_last_error = TURSO_ERROR_NOT_INITIALIZED;
         return false;
@@ -163,41 +463,64 @@ bool turso_save_counter(const Counter* counter, bool force_immediate_write) {
         return false;
     }
     
-    // Convert to Turso record format
-    TursoCounterRecord turso_counter = {0};
-    turso_counter.record_id = (uint16_t)(counter - (Counter*)0); // Simple ID based on pointer offset
-    turso_counter.created_at = get_timestamp_ms();
-    turso_counter.updated_at = turso_counter.created_at;
-    
-    strncpy(turso_counter.label, counter->label, MAX_LABEL_LENGTH - 1);
-    turso_counter.type = counter->type;
-    turso_counter.count = counter->count;
-    turso_counter.total = counter->total;
-    turso_counter.max_combo = counter->max_combo;
-    turso_counter.multiplier = counter->multiplier;
-    turso_counter.active = counter->active;
+    // Earlier saves from ISRs land first so they can't overwrite this one
+    turso_process_pending();
     
-    // Energy-conscious batched writing
-    uint8_t counter_index = turso_counter.record_id % MAX_COUNTERS;
-    g_pending_counters[counter_index] = turso_counter;
+    TursoCounterRecord turso_counter;
+    build_counter_record(counter_id, counter, &turso_counter);
+    return apply_counter_record(&turso_counter, force_immediate_write);
+}
+
+bool turso_save_counter_from_isr(uint16_t counter_id, const Counter* counter) {
+    if (!g_db_initialized || !counter) {
+        return false;
+    }
     
-    if (!g_counter_dirty[counter_index]) {
-        g_counter_dirty[counter_index] = true;
-        g_dirty_counter_count++;
+    TursoCounterRecord turso_counter;
+    build_counter_record(counter_id, counter, &turso_counter);
+    return spsc_ring_push(&g_write_requests, &turso_counter);
+}
+
+bool turso_queue_sync_operation_from_isr(TursoRecordType type, uint16_t record_id,
+                                         TursoSyncOperation op, const void* data, uint8_t data_size) {
+    if (!g_db_initialized) {
+        return false;
     }
     
-    // Queue for BTLE sync
-    add_to_sync_queue(RECORD_TYPE_COUNTER, turso_counter.record_id, 
-                     SYNC_OP_UPDATE, &turso_counter, sizeof(turso_counter));
+    TursoSyncRequest request = {0};
+    request.type = (uint8_t)type;
+    request.operation = (uint8_t)op;
+    request.record_id = record_id;
+    request.data_size = (data_size > sizeof(request.data)) ? sizeof(request.data) : data_size;
+    if (data && request.data_size > 0) {
+        memcpy(request.data, data, request.data_size);
+    }
+    return spsc_ring_push(&g_sync_requests, &request);
+}
+
+uint16_t turso_process_pending(void) {
+    if (!g_db_initialized) {
+        return 0;
+    }
     
-    // Write immediately if forced or threshold reached
-    if (force_immediate_write || g_dirty_counter_count >= BATCH_WRITE_THRESHOLD) {
-        turso_force_flush_pending_writes();
+    uint16_t handled = 0;
+    TursoCounterRecord turso_counter;
+    while (spsc_ring_pop(&g_write_requests, &turso_counter)) {
+        apply_counter_record(&turso_counter, false);
+        handled++;
     }
     
-    NRF_LOG_DEBUG("Counter saved (batched): %s, dirty_count=%d", 
-                  counter->label, g_dirty_counter_count);
-    return true;
+    // A sync request stays queued while the BTLE window is full
+    TursoSyncRequest request;
+    while (spsc_ring_peek(&g_sync_requests, &request)) {
+        if (!add_to_sync_queue((TursoRecordType)request.type, request.record_id,
+                               (TursoSyncOperation)request.operation, request.data, request.data_size)) {
+            break;
+        }
+        spsc_ring_pop(&g_sync_requests, &request);
+        handled++;
+    }
+    return handled;
 }
 
 // Load counter from flash
@@ -207,78 +530,163 @@ bool turso_load_counter(uint16_t counter_id, Counter* counter) {
         return false;
     }
     
+    turso_process_pending();
+    
+    const FlashLogEntry* entry = flash_log_find(&g_log, RECORD_TYPE_COUNTER, counter_id);
+    if (!entry) {
+        g_last_error = TURSO_ERROR_RECORD_NOT_FOUND;
+        return false;
+    }
+    
     // First check if it's in pending writes
-    uint8_t counter_index = counter_id % MAX_COUNTERS;
-    if (g_counter_dirty[counter_index]) {
-        TursoCounterRecord* turso_counter = &g_pending_counters[counter_index];
-        
-        strncpy(counter->label, turso_counter->label, MAX_LABEL_LENGTH);
-        counter->type = turso_counter->type;
-        counter->count = turso_counter->count;
-        counter->total = turso_counter->total;
-        counter->max_combo = turso_counter->max_combo;
-        counter->multiplier = turso_counter->multiplier;
-        counter->active = turso_counter->active;
-        
+    if (entry->slot != FLASH_LOG_NO_SLOT) {
+        counter_from_record(&g_pending_counters[entry->slot], counter);
         return true;
     }
     
-    // Load from flash (simplified - in real implementation, use proper addressing)
+    // Newest version from the flash log
     TursoCounterRecord turso_counter;
-    uint32_t addr = TURSO_FLASH_BASE_ADDR + (counter_id * sizeof(TursoCounterRecord));
+    if (!flash_log_read(&g_log, RECORD_TYPE_COUNTER, counter_id, &turso_counter,
+                        sizeof(turso_counter), NULL)) {
+        g_last_error = TURSO_ERROR_RECORD_NOT_FOUND;
+        return false;
+    }
+    
+    counter_from_record(&turso_counter, counter);
+    return true;
+}
+
+bool turso_delete_counter(uint16_t counter_id) {
+    if (!g_db_initialized) {
+        g_last_error = TURSO_ERROR_NOT_INITIALIZED;
+        return false;
+    }
     
-    if (!flash_read_sector(addr, &turso_counter, sizeof(turso_counter))) {
+    turso_process_pending();
+    
+    if (!flash_log_find(&g_log, RECORD_TYPE_COUNTER, counter_id)) {
         g_last_error = TURSO_ERROR_RECORD_NOT_FOUND;
         return false;
     }
+    FlashLogEntry* entry = flash_log_claim(&g_log, RECORD_TYPE_COUNTER, counter_id);
     
-    // Convert back to Counter format
-    strncpy(counter->label, turso_counter.label, MAX_LABEL_LENGTH);
-    counter->type = turso_counter.type;
-    counter->count = turso_counter.count;
-    counter->total = turso_counter.total;
-    counter->max_combo = turso_counter.max_combo;
-    counter->multiplier = turso_counter.multiplier;
-    counter->active = turso_counter.active;
+    // Drop any unflushed copy, then tombstone what is on flash
+    if (entry->slot != FLASH_LOG_NO_SLOT) {
+        g_counter_dirty[entry->slot] = false;
+        g_dirty_counter_count--;
+        entry->slot = FLASH_LOG_NO_SLOT;
+    }
+    if (entry->page != FLASH_LOG_UNWRITTEN && !flash_log_delete(&g_log, RECORD_TYPE_COUNTER, counter_id)) {
+        g_last_error = TURSO_ERROR_FLASH_WRITE_FAILED;
+        return false;
+    }
     
+    add_to_sync_queue(RECORD_TYPE_COUNTER, counter_id, SYNC_OP_DELETE, NULL, 0);
     return true;
 }
 
 // Force flush pending writes (energy-conscious batch operation)
 void turso_force_flush_pending_writes(void) {
+    turso_process_pending();
+    flush_pending_writes();
+}
+
+static void flush_pending_writes(void) {
     if (!g_db_initialized || g_dirty_counter_count == 0) {
         return;
     }
     
     NRF_LOG_INFO("Flushing %d pending counter writes to flash", g_dirty_counter_count);
     
-    for (uint8_t i = 0; i < MAX_COUNTERS; i++) {
+    // Each flush appends new versions; nothing is rewritten in place
+    for (uint8_t i = 0; i < MAX_PENDING_WRITES; i++) {
         if (g_counter_dirty[i]) {
-            uint32_t addr = TURSO_FLASH_BASE_ADDR + (i * sizeof(TursoCounterRecord));
-            flash_write_sector(addr, &g_pending_counters[i], sizeof(TursoCounterRecord));
+            uint16_t counter_id = g_pending_counters[i].record_id;
+            if (!flash_log_write(&g_log, RECORD_TYPE_COUNTER, counter_id, &g_pending_counters[i],
+                                 sizeof(TursoCounterRecord))) {
+                g_last_error = TURSO_ERROR_FLASH_WRITE_FAILED;
+                NRF_LOG_ERROR("Counter %d not written, flash store full", counter_id);
+                continue;       // Stays dirty for the next flush
+            }
+            flash_log_claim(&g_log, RECORD_TYPE_COUNTER, counter_id)->slot = FLASH_LOG_NO_SLOT;
             g_counter_dirty[i] = false;
+            g_dirty_counter_count--;
         }
     }
     
-    g_dirty_counter_count = 0;
     NRF_LOG_DEBUG("Flash write batch complete");
 }
 
 // BTLE sync operations
 bool turso_queue_sync_operation(TursoRecordType type, uint16_t record_id, 
                                TursoSyncOperation op, const void* data, uint8_t data_size) {
+    turso_process_pending();
     return add_to_sync_queue(type, record_id, op, data, data_size);
 }
 
 bool turso_get_next_sync_record(TursoSyncRecord* record) {
-    if (!g_db_initialized || !record || g_db.pending_sync_count == 0) {
+    if (!g_db_initialized || !record) {
         return false;
     }
     
-    *record = g_db.sync_queue[g_db.sync_queue_head];
+    turso_process_pending();
+    
+    // Skip records the peer already acked selectively
+    while (g_db.sync_send_sequence != g_db.sync_next_sequence &&
+           !SYNC_SLOT(g_db.sync_send_sequence)->pending_sync) {
+        g_db.sync_send_sequence++;
+    }
+    if (g_db.sync_send_sequence == g_db.sync_next_sequence) {
+        return false;
+    }
+    
+    *record = *SYNC_SLOT(g_db.sync_send_sequence);
+    g_db.sync_send_sequence++;
+    // A resend after reconnect doesn't move the high-water mark back
+    if (!sync_in_range(record->sequence, g_db.sync_head_sequence, g_db.sync_sent_limit)) {
+        g_db.sync_sent_limit = g_db.sync_send_sequence;
+    }
     return true;
 }
 
+void turso_ack_sync_through(uint32_t sequence) {
+    if (!g_db_initialized) {
+        return;
+    }
+    
+    // Duplicate and stale acks fall outside the window; so do acks for
+    // records never sent, which would otherwise drop them untransmitted
+    if (!sync_in_range(sequence, g_db.sync_head_sequence, g_db.sync_sent_limit)) {
+        return;
+    }
+    
+    for (uint32_t s = g_db.sync_head_sequence; s != sequence + 1; s++) {
+        TursoSyncRecord* record = SYNC_SLOT(s);
+        if (record->pending_sync) {
+            record->pending_sync = false;
+            g_db.pending_sync_count--;
+        }
+    }
+    g_db.sync_head_sequence = sequence + 1;
+    advance_sync_head();
+    NRF_LOG_DEBUG("Sync acked through seq=%u, %d pending", sequence, g_db.pending_sync_count);
+}
+
+void turso_ack_sync_record(uint32_t sequence) {
+    if (!g_db_initialized || !sync_in_range(sequence, g_db.sync_head_sequence, g_db.sync_sent_limit)) {
+        return;
+    }
+    
+    TursoSyncRecord* record = SYNC_SLOT(sequence);
+    if (record->pending_sync) {
+        record->pending_sync = false;
+        g_db.pending_sync_count--;
+    }
+    if (sequence == g_db.sync_head_sequence) {
+        advance_sync_head();
+    }
+}
+
 // Save audio configuration
 bool turso_save_audio_config(const TursoAudioRecord* audio_config) {
     if (!g_db_initialized || !audio_config) {
@@ -286,9 +694,8 @@ bool turso_save_audio_config(const TursoAudioRecord* audio_config) {
         return false;
     }
     
-    uint32_t addr = TURSO_FLASH_BASE_ADDR + (MAX_COUNTERS * sizeof(TursoCounterRecord));
-    
-    if (!flash_write_sector(addr, audio_config, sizeof(TursoAudioRecord))) {
+    if (!flash_log_write(&g_log, RECORD_TYPE_AUDIO_CONFIG, AUDIO_CONFIG_RECORD_ID,
+                         audio_config, sizeof(TursoAudioRecord))) {
         g_last_error = TURSO_ERROR_FLASH_WRITE_FAILED;
         return false;
     }
@@ -308,9 +715,8 @@ bool turso_load_audio_config(TursoAudioRecord* audio_config) {
         return false;
     }
     
-    uint32_t addr = TURSO_FLASH_BASE_ADDR + (MAX_COUNTERS * sizeof(TursoCounterRecord));
-    
-    if (!flash_read_sector(addr, audio_config, sizeof(TursoAudioRecord))) {
+    if (!flash_log_read(&g_log, RECORD_TYPE_AUDIO_CONFIG, AUDIO_CONFIG_RECORD_ID,
+                        audio_config, sizeof(TursoAudioRecord), NULL)) {
         g_last_error = TURSO_ERROR_RECORD_NOT_FOUND;
         return false;
     }
@@ -325,28 +731,6 @@ bool turso_load_audio_config(TursoAudioRecord* audio_config) {
     return true;
 }
 
-void turso_mark_sync_complete(uint16_t record_id) {
-    if (!g_db_initialized || g_db.pending_sync_count == 0) {
-        return;
-    }
-    
-    // Find and mark as synced
-    for (uint8_t i = 0; i < MAX_SYNC_QUEUE_SIZE; i++) {
-        if (g_db.sync_queue[i].record_id == record_id && g_db.sync_queue[i].pending_sync) {
-            g_db.sync_queue[i].pending_sync = false;
-            
-            // Move queue head if this was the next record
-            if (i == g_db.sync_queue_head) {
-                g_db.sync_queue_head = (g_db.sync_queue_head + 1) % MAX_SYNC_QUEUE_SIZE;
-                g_db.pending_sync_count--;
-            }
-            
-            NRF_LOG_DEBUG("Sync marked complete for record_id=%d", record_id);
-            break;
-        }
-    }
-}
-
 uint16_t turso_get_pending_sync_count(void) {
     return g_db_initialized ? g_db.pending_sync_count : 0;
 }
@@ -357,8 +741,10 @@ void turso_enter_low_power_mode(void) {
         return;
     }
     
-    // Flush any pending writes before entering low power
+    // Flush any pending writes before entering low power, then reclaim
+    // one page while the device is idle anyway
     turso_force_flush_pending_writes();
+    flash_log_gc_step(&g_log);
     
     g_db.low_power_mode = true;
     NRF_LOG_INFO("Turso DB entering low power mode");
@@ -383,6 +769,8 @@ void turso_set_btle_connected(bool connected) {
     g_db.btle_connected = connected;
     
     if (connected && !was_connected) {
+        // Anything sent but not acked on the last link goes out again
+        g_db.sync_send_sequence = g_db.sync_head_sequence;
         NRF_LOG_INFO("BTLE connected - %d records pending sync", g_db.pending_sync_count);
     } else if (!connected && was_connected) {
         NRF_LOG_INFO("BTLE disconnected");
@@ -445,13 +833,24 @@ bool turso_get_database_stats(TursoDatabaseStats* stats) {
     
     memset(stats, 0, sizeof(TursoDatabaseStats));
     
-    stats->total_records = MAX_COUNTERS; // Simplified
+    FlashLogStats log_stats;
+    flash_log_stats(&g_log, &log_stats);
+    
+    stats->total_records = log_stats.live_records;
     stats->pending_sync_records = g_db.pending_sync_count;
     stats->total_flash_writes = g_db.total_writes;
     stats->last_sync_timestamp = g_db.last_sync_timestamp;
     stats->database_size_kb = (sizeof(flash_simulation) / 1024);
-    stats->integrity_ok = true; // Simplified
+    stats->integrity_ok = flash_log_verify(&g_log);
     stats->btle_sync_healthy = g_db.btle_connected && (g_db.pending_sync_count < MAX_SYNC_QUEUE_SIZE / 2);
+    stats->flash_erases = log_stats.erases + g_overflow_erases;
+    stats->min_page_erases = log_stats.min_erase_count;
+    stats->max_page_erases = log_stats.max_erase_count;
+    stats->free_pages = log_stats.free_pages;
+    stats->isr_requests_queued = spsc_ring_count(&g_write_requests) + spsc_ring_count(&g_sync_requests);
+    stats->isr_requests_dropped = spsc_ring_dropped(&g_write_requests) + spsc_ring_dropped(&g_sync_requests);
+    stats->sync_overflow_records = overflow_record_count();
+    stats->sync_overflow_page_writes = g_overflow_page_writes;
     
     return true;
 }
@@ -471,6 +870,7 @@ const char* turso_error_string(TursoError error) {
         case TURSO_ERROR_INVALID_RECORD: return "Invalid record";
         case TURSO_ERROR_LOW_POWER_MODE: return "Operation not allowed in low power mode";
         case TURSO_ERROR_BTLE_DISCONNECTED: return "BTLE disconnected";
+        case TURSO_ERROR_FLASH_READ_FAILED: return "Flash read failed";
         default: return "Unknown error";
     }
 }
@@ -481,8 +881,30 @@ void turso_compact_database(void) {
         return;
     }
     
-    NRF_LOG_INFO("Database compaction started (placeholder)");
-    // In real implementation: defragment flash, remove deleted records, etc.
+    // Land pending counters first so their old versions are dead too
+    turso_force_flush_pending_writes();
+    uint16_t erased = flash_log_compact(&g_log);
+    
+    FlashLogStats log_stats;
+    flash_log_stats(&g_log, &log_stats);
+    NRF_LOG_INFO("Database compaction: %d pages erased, %d free, page erases %d..%d",
+                 erased, log_stats.free_pages, log_stats.min_erase_count, log_stats.max_erase_count);
+}
+
+bool turso_verify_database_integrity(void) {
+    return g_db_initialized && flash_log_verify(&g_log);
+}
+
+uint16_t turso_get_page_erase_counts(uint32_t* counts, uint16_t max_pages) {
+    if (!g_db_initialized || !counts) {
+        return 0;
+    }
+    
+    uint16_t pages = max_pages < TURSO_FLASH_PAGES ? max_pages : TURSO_FLASH_PAGES;
+    for (uint16_t i = 0; i < pages; i++) {
+        counts[i] = flash_log_page_erase_count(&g_log, i);
+    }
+    return pages;
 }
 
 uint32_t turso_get_flash_write_count(void) {
@@ -9,9 +9,13 @@
 // Designed for energy efficiency and BTLE sync
 
 #define TURSO_LOCAL_VERSION "1.0.0"
-#define MAX_SYNC_QUEUE_SIZE 32
+#define MAX_SYNC_QUEUE_SIZE 32      // Power of two: slots are indexed by sequence
 #define MAX_DEVICE_ID_LENGTH 16
 #define TURSO_MAGIC_BYTES 0xC0FFEE42
+#define TURSO_FLASH_PAGES 32        // 4 KB pages given to the record log (~1900 counters)
+#define MAX_PENDING_WRITES 8        // Counters with changes not yet flushed
+#define TURSO_ISR_QUEUE_SIZE 32     // Power of two: requests from ISRs awaiting the main loop
+#define TURSO_SYNC_OVERFLOW_PAGES 8 // 4 KB pages for sync records queued behind a full window
 
 // Energy-conscious settings
 #define BATCH_WRITE_THRESHOLD 5     // Write after 5 changes to save flash cycles
@@ -38,6 +42,7 @@ typedef enum {
 
 // Lightweight sync record for BTLE transmission
 typedef struct {
+    uint32_t sequence;             // Queue order; the peer acks by sequence
     uint32_t timestamp_ms;
     uint16_t record_id;
     TursoRecordType type;
@@ -56,10 +61,16 @@ typedef struct {
     bool btle_connected;
     bool low_power_mode;
     
-    // Sync queue for BTLE transmission
+    // Sync queue for BTLE transmission: a ring indexed by sequence.
+    // [sync_head_sequence, sync_next_sequence) is the window still held;
+    // records inside it may already be acked selectively. Records queued
+    // while the window is full wait in an overflow log and get their
+    // sequence when they move into the window.
     TursoSyncRecord sync_queue[MAX_SYNC_QUEUE_SIZE];
-    uint8_t sync_queue_head;
-    uint8_t sync_queue_tail;
+    uint32_t sync_head_sequence;   // Oldest record not yet acked
+    uint32_t sync_send_sequence;   // Next record to transmit
+    uint32_t sync_sent_limit;      // One past the newest record ever transmitted
+    uint32_t sync_next_sequence;   // Given to the next queued record
     
     // Energy monitoring
     uint32_t total_writes;
@@ -115,10 +126,24 @@ typedef struct {
 bool turso_local_init(const char* device_id);
 void turso_local_shutdown(void);
 
-// Counter operations (energy-optimized)
-bool turso_save_counter(const Counter* counter, bool force_immediate_write);
+// Counter operations (energy-optimized). Counters are keyed by a caller
+// assigned id (e.g. the counter's index on the device) through a hashed
+// record directory, so loads are O(1) and ids never share a slot.
+bool turso_save_counter(uint16_t counter_id, const Counter* counter, bool force_immediate_write);
 bool turso_load_counter(uint16_t counter_id, Counter* counter);
 bool turso_delete_counter(uint16_t counter_id);
+
+// Interrupt context (e.g. a button ISR). These only copy the request into a
+// lock-free SPSC ring; flash and the BTLE window are touched later, by
+// turso_process_pending in the main loop. One interrupt priority may
+// produce; a counter should be saved from one context only. Returns false
+// if the ring is full (counted in the stats).
+bool turso_save_counter_from_isr(uint16_t counter_id, const Counter* counter);
+bool turso_queue_sync_operation_from_isr(TursoRecordType type, uint16_t record_id,
+                                         TursoSyncOperation op, const void* data, uint8_t data_size);
+// Main context: apply everything ISRs queued. The other main-context calls
+// run this first, so they always see ISR saves. Returns requests handled.
+uint16_t turso_process_pending(void);
 bool turso_load_all_counters(Counter* counters, uint8_t max_count, uint8_t* actual_count);
 
 // Session tracking
@@ -130,11 +155,21 @@ bool turso_get_session_stats(uint16_t counter_id, uint32_t* total_sessions, floa
 bool turso_save_audio_config(const TursoAudioRecord* audio_config);
 bool turso_load_audio_config(TursoAudioRecord* audio_config);
 
-// BTLE sync operations
+// BTLE sync operations. When the window is full, records wait in a RAM
+// batch that is programmed to flash one page at a time; acks pull them
+// back into the window in queue order. Fails with TURSO_ERROR_SYNC_QUEUE_FULL
+// only once the overflow pages are full too.
 bool turso_queue_sync_operation(TursoRecordType type, uint16_t record_id, 
                                TursoSyncOperation op, const void* data, uint8_t data_size);
+// Records go out in sequence order; each call returns the next one not yet
+// sent or acked. Reconnecting starts over from the oldest unacked record.
 bool turso_get_next_sync_record(TursoSyncRecord* record);
-void turso_mark_sync_complete(uint16_t record_id);
+// Cumulative ack: the peer has every record up to and including sequence
+void turso_ack_sync_through(uint32_t sequence);
+// Selective ack of one record received out of order. The window slides as
+// soon as the oldest record is acked, so out-of-order acks never hold slots.
+void turso_ack_sync_record(uint32_t sequence);
+// Unacked records in the window plus those waiting in the overflow
 uint16_t turso_get_pending_sync_count(void);
 
 // Remote database sync (for later BTLE implementation)
@@ -155,7 +190,12 @@ bool turso_is_btle_connected(void);
 uint8_t turso_serialize_counter(const TursoCounterRecord* counter, uint8_t* buffer, uint8_t max_size);
 bool turso_deserialize_counter(const uint8_t* buffer, uint8_t size, TursoCounterRecord* counter);
 
-// Database maintenance (run periodically to optimize storage)
+// CRC16-CCITT (poly 0x1021, init 0xFFFF) stored in each sync record
+uint16_t turso_crc16(const uint8_t* data, uint16_t length);
+
+// Database maintenance (run periodically to optimize storage). Compaction
+// reclaims pages holding superseded record versions and moves cold data
+// off lightly worn pages.
 void turso_compact_database(void);
 bool turso_verify_database_integrity(void);
 
@@ -168,9 +208,25 @@ typedef struct {
     uint16_t database_size_kb;
     bool integrity_ok;
     bool btle_sync_healthy;
+    
+    // Flash wear
+    uint32_t flash_erases;          // Page erases since init
+    uint32_t min_page_erases;       // Lifetime erase counts across pages
+    uint32_t max_page_erases;
+    uint16_t free_pages;
+    
+    // ISR hand-off
+    uint32_t isr_requests_queued;   // Waiting for turso_process_pending
+    uint32_t isr_requests_dropped;  // Rejected because a ring was full
+    
+    // BTLE sync overflow
+    uint32_t sync_overflow_records;     // Queued behind the window (RAM batch and flash)
+    uint32_t sync_overflow_page_writes; // Batches programmed to flash
 } TursoDatabaseStats;
 
 bool turso_get_database_stats(TursoDatabaseStats* stats);
+// Lifetime erase count of each flash page; returns the number filled
+uint16_t turso_get_page_erase_counts(uint32_t* counts, uint16_t max_pages);
 
 // Error handling
 typedef enum {
@@ -181,7 +237,8 @@ typedef enum {
     TURSO_ERROR_SYNC_QUEUE_FULL = -4,
     TURSO_ERROR_INVALID_RECORD = -5,
     TURSO_ERROR_LOW_POWER_MODE = -6,
-    TURSO_ERROR_BTLE_DISCONNECTED = -7
+    TURSO_ERROR_BTLE_DISCONNECTED = -7,
+    TURSO_ERROR_FLASH_READ_FAILED = -8
 } TursoError;
 
 TursoError turso_get_last_error(void);
@@ -0,0 +1,443 @@
+#define _POSIX_C_SOURCE 200809L
+#include "combo_format.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TRACKER_FLAG_PAUSED        0x01
+#define TRACKER_FLAG_HAS_OBJECTIVE 0x02
+#define INTERVAL_FLAG_HAS_INTERVAL 0x01
+#define INTERVAL_FLAG_RUNNING      0x02
+#define INTERVAL_FLAG_ACTIVE       0x04
+
+// Byte writer
+void writer_init(ByteWriter* writer, size_t initial_capacity) {
+    writer->size = 0;
+    writer->failed = false;
+    writer->capacity = initial_capacity > 0 ? initial_capacity : 256;
+    writer->data = malloc(writer->capacity);
+    if (!writer->data) {
+        writer->capacity = 0;
+        writer->failed = true;
+    }
+}
+
+void writer_free(ByteWriter* writer) {
+    free(writer->data);
+    writer->data = NULL;
+    writer->size = 0;
+    writer->capacity = 0;
+}
+
+static bool writer_reserve(ByteWriter* writer, size_t extra) {
+    if (writer->failed) return false;
+    if (writer->size + extra <= writer->capacity) return true;
+
+    size_t capacity = writer->capacity * 2;
+    while (capacity < writer->size + extra) capacity *= 2;
+
+    uint8_t* data = realloc(writer->data, capacity);
+    if (!data) {
+        writer->failed = true;
+        return false;
+    }
+    writer->data = data;
+    writer->capacity = capacity;
+    return true;
+}
+
+static void writer_put_bytes(ByteWriter* writer, const void* bytes, size_t length) {
+    if (!writer_reserve(writer, length)) return;
+    memcpy(writer->data + writer->size, bytes, length);
+    writer->size += length;
+}
+
+void writer_put_u8(ByteWriter* writer, uint8_t value) {
+    if (!writer_reserve(writer, 1)) return;
+    writer->data[writer->size++] = value;
+}
+
+void writer_put_u32le(ByteWriter* writer, uint32_t value) {
+    if (!writer_reserve(writer, 4)) return;
+    for (int i = 0; i < 4; i++) {
+        writer->data[writer->size++] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+void writer_put_varint(ByteWriter* writer, uint64_t value) {
+    if (!writer_reserve(writer, 10)) return;
+    while (value >= 0x80) {
+        writer->data[writer->size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    writer->data[writer->size++] = (uint8_t)value;
+}
+
+void writer_put_svarint(ByteWriter* writer, int64_t value) {
+    // Zigzag so small negative numbers stay small
+    writer_put_varint(writer, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+void writer_put_float(ByteWriter* writer, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    writer_put_u32le(writer, bits);
+}
+
+void writer_put_string(ByteWriter* writer, const char* str) {
+    size_t length = strlen(str);
+    writer_put_varint(writer, length);
+    writer_put_bytes(writer, str, length);
+}
+
+// Byte reader
+void reader_init(ByteReader* reader, const uint8_t* data, size_t size) {
+    reader->data = data;
+    reader->size = size;
+    reader->pos = 0;
+    reader->failed = false;
+}
+
+uint8_t reader_get_u8(ByteReader* reader) {
+    if (reader->pos >= reader->size) {
+        reader->failed = true;
+        return 0;
+    }
+    return reader->data[reader->pos++];
+}
+
+uint32_t reader_get_u32le(ByteReader* reader) {
+    if (reader->pos > reader->size || reader->size - reader->pos < 4) {
+        reader->failed = true;
+        return 0;
+    }
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= (uint32_t)reader->data[reader->pos++] << (8 * i);
+    }
+    return value;
+}
+
+uint64_t reader_get_varint(ByteReader* reader) {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (reader->pos >= reader->size) break;
+        uint8_t byte = reader->data[reader->pos++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+    reader->failed = true;
+    return 0;
+}
+
+int64_t reader_get_svarint(ByteReader* reader) {
+    uint64_t raw = reader_get_varint(reader);
+    return (int64_t)(raw >> 1) ^ -(int64_t)(raw & 1);
+}
+
+float reader_get_float(ByteReader* reader) {
+    uint32_t bits = reader_get_u32le(reader);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void reader_get_string(ByteReader* reader, char* out, size_t out_size) {
+    uint64_t length = reader_get_varint(reader);
+    if (reader->failed || length > reader->size - reader->pos) {
+        reader->failed = true;
+        out[0] = '\0';
+        return;
+    }
+
+    size_t copy = length < out_size - 1 ? (size_t)length : out_size - 1;
+    memcpy(out, reader->data + reader->pos, copy);
+    out[copy] = '\0';
+    reader->pos += (size_t)length;
+}
+
+// CRC-32 (IEEE 802.3, reflected). The table is precomputed so concurrent
+// first calls (the persistence worker and the UI thread) need no setup.
+static const uint32_t crc32_table[256] = {
+    0x00000000u, 0x77073096u, 0xEE0E612Cu, 0x990951BAu, 0x076DC419u, 0x706AF48Fu,
+    0xE963A535u, 0x9E6495A3u, 0x0EDB8832u, 0x79DCB8A4u, 0xE0D5E91Eu, 0x97D2D988u,
+    0x09B64C2Bu, 0x7EB17CBDu, 0xE7B82D07u, 0x90BF1D91u, 0x1DB71064u, 0x6AB020F2u,
+    0xF3B97148u, 0x84BE41DEu, 0x1ADAD47Du, 0x6DDDE4EBu, 0xF4D4B551u, 0x83D385C7u,
+    0x136C9856u, 0x646BA8C0u, 0xFD62F97Au, 0x8A65C9ECu, 0x14015C4Fu, 0x63066CD9u,
+    0xFA0F3D63u, 0x8D080DF5u, 0x3B6E20C8u, 0x4C69105Eu, 0xD56041E4u, 0xA2677172u,
+    0x3C03E4D1u, 0x4B04D447u, 0xD20D85FDu, 0xA50AB56Bu, 0x35B5A8FAu, 0x42B2986Cu,
+    0xDBBBC9D6u, 0xACBCF940u, 0x32D86CE3u, 0x45DF5C75u, 0xDCD60DCFu, 0xABD13D59u,
+    0x26D930ACu, 0x51DE003Au, 0xC8D75180u, 0xBFD06116u, 0x21B4F4B5u, 0x56B3C423u,
+    0xCFBA9599u, 0xB8BDA50Fu, 0x2802B89Eu, 0x5F058808u, 0xC60CD9B2u, 0xB10BE924u,
+    0x2F6F7C87u, 0x58684C11u, 0xC1611DABu, 0xB6662D3Du, 0x76DC4190u, 0x01DB7106u,
+    0x98D220BCu, 0xEFD5102Au, 0x71B18589u, 0x06B6B51Fu, 0x9FBFE4A5u, 0xE8B8D433u,
+    0x7807C9A2u, 0x0F00F934u, 0x9609A88Eu, 0xE10E9818u, 0x7F6A0DBBu, 0x086D3D2Du,
+    0x91646C97u, 0xE6635C01u, 0x6B6B51F4u, 0x1C6C6162u, 0x856530D8u, 0xF262004Eu,
+    0x6C0695EDu, 0x1B01A57Bu, 0x8208F4C1u, 0xF50FC457u, 0x65B0D9C6u, 0x12B7E950u,
+    0x8BBEB8EAu, 0xFCB9887Cu, 0x62DD1DDFu, 0x15DA2D49u, 0x8CD37CF3u, 0xFBD44C65u,
+    0x4DB26158u, 0x3AB551CEu, 0xA3BC0074u, 0xD4BB30E2u, 0x4ADFA541u, 0x3DD895D7u,
+    0xA4D1C46Du, 0xD3D6F4FBu, 0x4369E96Au, 0x346ED9FCu, 0xAD678846u, 0xDA60B8D0u,
+    0x44042D73u, 0x33031DE5u, 0xAA0A4C5Fu, 0xDD0D7CC9u, 0x5005713Cu, 0x270241AAu,
+    0xBE0B1010u, 0xC90C2086u, 0x5768B525u, 0x206F85B3u, 0xB966D409u, 0xCE61E49Fu,
+    0x5EDEF90Eu, 0x29D9C998u, 0xB0D09822u, 0xC7D7A8B4u, 0x59B33D17u, 0x2EB40D81u,
+    0xB7BD5C3Bu, 0xC0BA6CADu, 0xEDB88320u, 0x9ABFB3B6u, 0x03B6E20Cu, 0x74B1D29Au,
+    0xEAD54739u, 0x9DD277AFu, 0x04DB2615u, 0x73DC1683u, 0xE3630B12u, 0x94643B84u,
+    0x0D6D6A3Eu, 0x7A6A5AA8u, 0xE40ECF0Bu, 0x9309FF9Du, 0x0A00AE27u, 0x7D079EB1u,
+    0xF00F9344u, 0x8708A3D2u, 0x1E01F268u, 0x6906C2FEu, 0xF762575Du, 0x806567CBu,
+    0x196C3671u, 0x6E6B06E7u, 0xFED41B76u, 0x89D32BE0u, 0x10DA7A5Au, 0x67DD4ACCu,
+    0xF9B9DF6Fu, 0x8EBEEFF9u, 0x17B7BE43u, 0x60B08ED5u, 0xD6D6A3E8u, 0xA1D1937Eu,
+    0x38D8C2C4u, 0x4FDFF252u, 0xD1BB67F1u, 0xA6BC5767u, 0x3FB506DDu, 0x48B2364Bu,
+    0xD80D2BDAu, 0xAF0A1B4Cu, 0x36034AF6u, 0x41047A60u, 0xDF60EFC3u, 0xA867DF55u,
+    0x316E8EEFu, 0x4669BE79u, 0xCB61B38Cu, 0xBC66831Au, 0x256FD2A0u, 0x5268E236u,
+    0xCC0C7795u, 0xBB0B4703u, 0x220216B9u, 0x5505262Fu, 0xC5BA3BBEu, 0xB2BD0B28u,
+    0x2BB45A92u, 0x5CB36A04u, 0xC2D7FFA7u, 0xB5D0CF31u, 0x2CD99E8Bu, 0x5BDEAE1Du,
+    0x9B64C2B0u, 0xEC63F226u, 0x756AA39Cu, 0x026D930Au, 0x9C0906A9u, 0xEB0E363Fu,
+    0x72076785u, 0x05005713u, 0x95BF4A82u, 0xE2B87A14u, 0x7BB12BAEu, 0x0CB61B38u,
+    0x92D28E9Bu, 0xE5D5BE0Du, 0x7CDCEFB7u, 0x0BDBDF21u, 0x86D3D2D4u, 0xF1D4E242u,
+    0x68DDB3F8u, 0x1FDA836Eu, 0x81BE16CDu, 0xF6B9265Bu, 0x6FB077E1u, 0x18B74777u,
+    0x88085AE6u, 0xFF0F6A70u, 0x66063BCAu, 0x11010B5Cu, 0x8F659EFFu, 0xF862AE69u,
+    0x616BFFD3u, 0x166CCF45u, 0xA00AE278u, 0xD70DD2EEu, 0x4E048354u, 0x3903B3C2u,
+    0xA7672661u, 0xD06016F7u, 0x4969474Du, 0x3E6E77DBu, 0xAED16A4Au, 0xD9D65ADCu,
+    0x40DF0B66u, 0x37D83BF0u, 0xA9BCAE53u, 0xDEBB9EC5u, 0x47B2CF7Fu, 0x30B5FFE9u,
+    0xBDBDF21Cu, 0xCABAC28Au, 0x53B39330u, 0x24B4A3A6u, 0xBAD03605u, 0xCDD70693u,
+    0x54DE5729u, 0x23D967BFu, 0xB3667A2Eu, 0xC4614AB8u, 0x5D681B02u, 0x2A6F2B94u,
+    0xB40BBE37u, 0xC30C8EA1u, 0x5A05DF1Bu, 0x2D02EF8Du
+};
+
+uint32_t combo_crc32(const uint8_t* data, size_t length) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+        crc = crc32_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// File helpers
+bool combo_format_write_file(const char* file, const ByteWriter* writer) {
+    if (writer->failed) return false;
+
+    FILE* f = fopen(file, "wb");
+    if (!f) return false;
+
+    // Flushed and synced before close so a caller that renames the file
+    // over an older copy only does so once the bytes are on disk
+    bool ok = fwrite(writer->data, 1, writer->size, f) == writer->size;
+    ok = ok && fflush(f) == 0 && fsync(fileno(f)) == 0;
+    ok = (fclose(f) == 0) && ok;
+    return ok;
+}
+
+uint8_t* combo_format_read_file(const char* file, size_t* size) {
+    FILE* f = fopen(file, "rb");
+    if (!f) return NULL;
+
+    long length = -1;
+    if (fseek(f, 0, SEEK_END) == 0) {
+        length = ftell(f);
+        fseek(f, 0, SEEK_SET);
+    }
+    if (length < 0) {
+        fclose(f);
+        return NULL;
+    }
+
+    uint8_t* data = malloc(length > 0 ? (size_t)length : 1);
+    if (data && fread(data, 1, (size_t)length, f) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+
+    if (data) *size = (size_t)length;
+    return data;
+}
+
+// Tracker records
+static void encode_tracker(ByteWriter* w, const ComboState* state, double now) {
+    // Combo and decay are stored as of the time of writing
+    int32_t combo;
+    float multiplier, decay_pause;
+    combo_peek(state, now, &combo, &multiplier, &decay_pause);
+
+    writer_put_string(w, state->label);
+    writer_put_svarint(w, state->score);
+    writer_put_svarint(w, combo);
+    writer_put_svarint(w, state->max_combo);
+    writer_put_u8(w, (state->paused ? TRACKER_FLAG_PAUSED : 0) |
+                     (state->has_objective ? TRACKER_FLAG_HAS_OBJECTIVE : 0));
+    writer_put_svarint(w, state->objective);
+    writer_put_svarint(w, state->completed_intervals);
+    writer_put_float(w, multiplier);
+    writer_put_float(w, decay_pause);
+    writer_put_varint(w, state->total_hits);
+    writer_put_varint(w, state->perfect_hits);
+    writer_put_varint(w, state->miss_hits);
+
+    uint32_t objective_count = state->objectives ? state->objective_count : 0;
+    writer_put_varint(w, objective_count);
+    writer_put_varint(w, state->active_objective_index);
+    for (uint32_t i = 0; i < objective_count; i++) {
+        const Objective* obj = &state->objectives[i];
+        writer_put_string(w, obj->name);
+        writer_put_string(w, obj->description);
+        writer_put_svarint(w, obj->target_score);
+        writer_put_svarint(w, obj->current_score);
+        writer_put_u8(w, obj->completed ? 1 : 0);
+    }
+
+    const IntervalTracker* it = &state->interval_tracker;
+    writer_put_u8(w, (it->has_interval ? INTERVAL_FLAG_HAS_INTERVAL : 0) |
+                     (it->is_running ? INTERVAL_FLAG_RUNNING : 0) |
+                     (it->interval_active ? INTERVAL_FLAG_ACTIVE : 0));
+    writer_put_float(w, it->current_time);
+    writer_put_svarint(w, it->current_rep);
+    writer_put_svarint(w, it->current_interval_index);
+    writer_put_string(w, it->current_interval.label);
+    writer_put_svarint(w, it->current_interval.duration);
+    writer_put_svarint(w, it->current_interval.reps);
+}
+
+static bool decode_tracker(ByteReader* r, ComboState* state, uint8_t version, ComboPool* pool) {
+    memset(state, 0, sizeof(ComboState));
+    state->pool = pool;
+    state->interval_tracker.pool = pool;
+
+    reader_get_string(r, state->label, MAX_LABEL_LENGTH);
+    state->score = (int)reader_get_svarint(r);
+    state->combo = (int)reader_get_svarint(r);
+    state->max_combo = (int)reader_get_svarint(r);
+    uint8_t flags = reader_get_u8(r);
+    state->paused = (flags & TRACKER_FLAG_PAUSED) != 0;
+    state->has_objective = (flags & TRACKER_FLAG_HAS_OBJECTIVE) != 0;
+    state->objective = (int)reader_get_svarint(r);
+    state->completed_intervals = (int)reader_get_svarint(r);
+    state->multiplier = reader_get_float(r);
+    state->decay_pause = reader_get_float(r);
+    state->last_hit_time = combo_clock_now();
+    state->total_hits = (uint32_t)reader_get_varint(r);
+    state->perfect_hits = (uint32_t)reader_get_varint(r);
+    state->miss_hits = (uint32_t)reader_get_varint(r);
+
+    uint64_t objective_count = reader_get_varint(r);
+    state->active_objective_index = (uint32_t)reader_get_varint(r);
+    // Each objective takes at least 5 bytes; reject counts the data cannot hold
+    if (r->failed || objective_count > (r->size - r->pos) / 5) return false;
+
+    if (objective_count > 0) {
+        state->objectives = combo_objectives_alloc(pool, (uint32_t)objective_count);
+        if (!state->objectives) return false;
+        state->objective_count = (uint32_t)objective_count;
+
+        for (uint32_t i = 0; i < state->objective_count; i++) {
+            Objective* obj = &state->objectives[i];
+            reader_get_string(r, obj->name, MAX_LABEL_LENGTH);
+            reader_get_string(r, obj->description, MAX_LABEL_LENGTH);
+            obj->target_score = (int)reader_get_svarint(r);
+            obj->current_score = (int)reader_get_svarint(r);
+            obj->completed = reader_get_u8(r) != 0;
+        }
+    }
+    if (state->active_objective_index >= state->objective_count) {
+        state->active_objective_index = 0;
+    }
+
+    IntervalTracker* it = &state->interval_tracker;
+    flags = reader_get_u8(r);
+    it->has_interval = (flags & INTERVAL_FLAG_HAS_INTERVAL) != 0;
+    it->is_running = (flags & INTERVAL_FLAG_RUNNING) != 0;
+    it->interval_active = (flags & INTERVAL_FLAG_ACTIVE) != 0;
+    // Version 1 stored whole seconds
+    it->current_time = version >= 2 ? reader_get_float(r) : (float)reader_get_svarint(r);
+    it->current_rep = (int)reader_get_svarint(r);
+    it->current_interval_index = (int)reader_get_svarint(r);
+    reader_get_string(r, it->current_interval.label, MAX_LABEL_LENGTH);
+    it->current_interval.duration = (int)reader_get_svarint(r);
+    it->current_interval.reps = (int)reader_get_svarint(r);
+
+    // The intervals array itself is not persisted (interval_count stays 0)
+
+    return !r->failed;
+}
+
+void combo_format_encode(ByteWriter* writer, const ComboState* trackers, int tracker_count,
+                         uint32_t generation) {
+    combo_format_encode_at(writer, trackers, tracker_count, generation, combo_clock_now());
+}
+
+void combo_format_encode_at(ByteWriter* writer, const ComboState* trackers, int tracker_count,
+                            uint32_t generation, double now) {
+    writer_put_bytes(writer, COMBO_FORMAT_MAGIC, 4);
+    writer_put_u8(writer, COMBO_FORMAT_VERSION);
+    writer_put_u8(writer, 0);  // Flags, reserved
+    writer_put_varint(writer, generation);
+    writer_put_varint(writer, tracker_count > 0 ? (uint64_t)tracker_count : 0);
+
+    for (int i = 0; i < tracker_count; i++) {
+        encode_tracker(writer, &trackers[i], now);
+    }
+
+    if (!writer->failed) {
+        writer_put_u32le(writer, combo_crc32(writer->data, writer->size));
+    }
+}
+
+bool combo_format_is_current(const uint8_t* data, size_t size) {
+    return size >= 6 && memcmp(data, COMBO_FORMAT_MAGIC, 4) == 0;
+}
+
+static bool read_header(ByteReader* r, uint8_t* version_out, uint32_t* generation, uint64_t* tracker_count) {
+    if (!combo_format_is_current(r->data, r->size)) return false;
+    r->pos = 4;
+
+    uint8_t version = reader_get_u8(r);
+    reader_get_u8(r);  // Flags
+    if (version < 1 || version > COMBO_FORMAT_VERSION) {
+        printf("Unsupported tracker file version %u\n", version);
+        return false;
+    }
+
+    *version_out = version;
+    *generation = (uint32_t)reader_get_varint(r);
+    *tracker_count = reader_get_varint(r);
+    return !r->failed;
+}
+
+bool combo_format_read_generation(const uint8_t* data, size_t size, uint32_t* generation) {
+    ByteReader r;
+    uint64_t tracker_count;
+    uint8_t version;
+    reader_init(&r, data, size);
+    return read_header(&r, &version, generation, &tracker_count);
+}
+
+int combo_format_decode(const uint8_t* data, size_t size, ComboState* trackers, int max_trackers,
+                        uint32_t* generation, ComboPool* pool) {
+    if (!combo_format_is_current(data, size) || size < 10) return -1;
+
+    uint32_t stored_crc = (uint32_t)data[size - 4] | ((uint32_t)data[size - 3] << 8) |
+                          ((uint32_t)data[size - 2] << 16) | ((uint32_t)data[size - 1] << 24);
+    if (combo_crc32(data, size - 4) != stored_crc) {
+        printf("Tracker file CRC mismatch, ignoring contents\n");
+        return -1;
+    }
+
+    ByteReader r;
+    uint64_t tracker_count;
+    uint32_t file_generation;
+    uint8_t version;
+    reader_init(&r, data, size - 4);
+    if (!read_header(&r, &version, &file_generation, &tracker_count)) return -1;
+    if (generation) *generation = file_generation;
+
+    int count = tracker_count > (uint64_t)max_trackers ? max_trackers : (int)tracker_count;
+    for (int i = 0; i < count; i++) {
+        if (!decode_tracker(&r, &trackers[i], version, pool)) {
+            // Keep what was fully decoded before the bad record
+            combo_objectives_free(pool, trackers[i].objectives, trackers[i].objective_count);
+            memset(&trackers[i], 0, sizeof(ComboState));
+            return i;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,75 @@
+#ifndef COMBO_FORMAT_H
+#define COMBO_FORMAT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "core.h"
+
+// Versioned on-disk format for tracker files:
+//
+//   "CMBO" | version u8 | flags u8 | generation varint | tracker_count varint
+//   tracker records (varint / zigzag ints, little-endian floats,
+//                    length-prefixed strings)
+//   CRC-32 of everything above, little-endian u32
+//
+// The whole file is built in memory and written with one fwrite, and read
+// back with one fread. Layout does not depend on the host's struct packing
+// or sizeof(size_t).
+
+#define COMBO_FORMAT_MAGIC "CMBO"
+#define COMBO_FORMAT_VERSION 2   // 2: interval current_time stored as float seconds
+#define COMBO_FORMAT_HEADER_MAX 16
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+    bool failed;        // Allocation failure; contents are unusable
+} ByteWriter;
+
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool failed;        // Read past the end or malformed value
+} ByteReader;
+
+void writer_init(ByteWriter* writer, size_t initial_capacity);
+void writer_free(ByteWriter* writer);
+void writer_put_u8(ByteWriter* writer, uint8_t value);
+void writer_put_u32le(ByteWriter* writer, uint32_t value);
+void writer_put_varint(ByteWriter* writer, uint64_t value);
+void writer_put_svarint(ByteWriter* writer, int64_t value);
+void writer_put_float(ByteWriter* writer, float value);
+void writer_put_string(ByteWriter* writer, const char* str);
+
+void reader_init(ByteReader* reader, const uint8_t* data, size_t size);
+uint8_t reader_get_u8(ByteReader* reader);
+uint32_t reader_get_u32le(ByteReader* reader);
+uint64_t reader_get_varint(ByteReader* reader);
+int64_t reader_get_svarint(ByteReader* reader);
+float reader_get_float(ByteReader* reader);
+void reader_get_string(ByteReader* reader, char* out, size_t out_size);
+
+uint32_t combo_crc32(const uint8_t* data, size_t length);
+
+// Whole-file helpers: single buffered write / read
+bool combo_format_write_file(const char* file, const ByteWriter* writer);
+uint8_t* combo_format_read_file(const char* file, size_t* size);
+
+// Tracker file encode/decode. decode returns the number of trackers
+// loaded, or -1 if the data is not in this format or fails its CRC.
+void combo_format_encode(ByteWriter* writer, const ComboState* trackers, int tracker_count,
+                         uint32_t generation);
+// Same, with combo and decay stored as of `now` on the combo clock
+void combo_format_encode_at(ByteWriter* writer, const ComboState* trackers, int tracker_count,
+                            uint32_t generation, double now);
+// Decoded objectives are allocated from `pool` (NULL for malloc) and the
+// trackers are left owned by it
+int combo_format_decode(const uint8_t* data, size_t size, ComboState* trackers, int max_trackers,
+                        uint32_t* generation, ComboPool* pool);
+bool combo_format_is_current(const uint8_t* data, size_t size);
+bool combo_format_read_generation(const uint8_t* data, size_t size, uint32_t* generation);
+
+#endif // COMBO_FORMAT_H
@@ -0,0 +1,187 @@
+#include "combo_pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define POOL_ALIGNMENT 16
+
+typedef struct FreeBlock {
+    struct FreeBlock* next;
+} FreeBlock;
+
+static int size_class(size_t size) {
+    int index = 0;
+    size_t block = COMBO_POOL_MIN_BLOCK;
+    while (block < size) {
+        block <<= 1;
+        index++;
+    }
+    return index;
+}
+
+static void set_region(ComboPool* pool, uint8_t* start, size_t size) {
+    uintptr_t aligned = ((uintptr_t)start + POOL_ALIGNMENT - 1) & ~(uintptr_t)(POOL_ALIGNMENT - 1);
+    size_t skip = (size_t)(aligned - (uintptr_t)start);
+    pool->cursor = (uint8_t*)aligned;
+    pool->end = size > skip ? (uint8_t*)aligned + (size - skip) : (uint8_t*)aligned;
+}
+
+static void note_reserved(ComboPool* pool, size_t bytes) {
+    pool->stats.reserved_bytes += bytes;
+    if (pool->stats.reserved_bytes > pool->stats.high_water_reserved) {
+        pool->stats.high_water_reserved = pool->stats.reserved_bytes;
+    }
+}
+
+// Move the carving region to the next heap slab, reusing slabs kept
+// across resets before allocating new ones
+static bool next_slab(ComboPool* pool) {
+    if (pool->buffer) return false;
+
+    if (pool->slabs_used == pool->slab_count) {
+        if (pool->max_bytes && (size_t)(pool->slab_count + 1) * COMBO_POOL_SLAB_SIZE > pool->max_bytes) {
+            return false;
+        }
+        if (pool->slab_count == pool->slab_capacity) {
+            uint32_t capacity = pool->slab_capacity ? pool->slab_capacity * 2 : 8;
+            uint8_t** slabs = realloc(pool->slabs, sizeof(uint8_t*) * capacity);
+            if (!slabs) return false;
+            pool->slabs = slabs;
+            pool->slab_capacity = capacity;
+        }
+        uint8_t* slab = malloc(COMBO_POOL_SLAB_SIZE);
+        if (!slab) return false;
+        pool->slabs[pool->slab_count++] = slab;
+    }
+
+    set_region(pool, pool->slabs[pool->slabs_used++], COMBO_POOL_SLAB_SIZE);
+    note_reserved(pool, COMBO_POOL_SLAB_SIZE);
+    return true;
+}
+
+void combo_pool_init(ComboPool* pool, size_t max_bytes) {
+    memset(pool, 0, sizeof(*pool));
+    pool->max_bytes = max_bytes;
+}
+
+void combo_pool_init_static(ComboPool* pool, void* buffer, size_t size) {
+    memset(pool, 0, sizeof(*pool));
+    pool->buffer = buffer;
+    pool->buffer_size = size;
+    set_region(pool, pool->buffer, size);
+}
+
+void combo_pool_destroy(ComboPool* pool) {
+    for (uint32_t i = 0; i < pool->slab_count; i++) {
+        free(pool->slabs[i]);
+    }
+    for (uint32_t i = 0; i < pool->large_count; i++) {
+        free(pool->large[i]);
+    }
+    free(pool->slabs);
+    free(pool->large);
+    memset(pool, 0, sizeof(*pool));
+}
+
+static void* alloc_large(ComboPool* pool, size_t size) {
+    if (pool->buffer) return NULL;
+    if (pool->large_count == pool->large_capacity) {
+        uint32_t capacity = pool->large_capacity ? pool->large_capacity * 2 : 4;
+        void** large = realloc(pool->large, sizeof(void*) * capacity);
+        if (!large) return NULL;
+        pool->large = large;
+        pool->large_capacity = capacity;
+    }
+    void* block = malloc(size);
+    if (block) {
+        pool->large[pool->large_count++] = block;
+    }
+    return block;
+}
+
+void* combo_pool_alloc(ComboPool* pool, size_t size) {
+    if (size == 0) size = 1;
+
+    void* block = NULL;
+    size_t block_size = size;
+    if (size > COMBO_POOL_MAX_BLOCK) {
+        block = alloc_large(pool, size);
+    } else {
+        int index = size_class(size);
+        block_size = (size_t)COMBO_POOL_MIN_BLOCK << index;
+        if (pool->free_lists[index]) {
+            FreeBlock* free_block = pool->free_lists[index];
+            pool->free_lists[index] = free_block->next;
+            block = free_block;
+        } else {
+            // Carve from the current region; the tail of a slab that is
+            // too short for this block is left unused
+            if ((size_t)(pool->end - pool->cursor) < block_size && !next_slab(pool)) {
+                pool->stats.failed_allocs++;
+                return NULL;
+            }
+            block = pool->cursor;
+            pool->cursor += block_size;
+            if (pool->buffer) note_reserved(pool, block_size);
+        }
+    }
+
+    if (!block) {
+        pool->stats.failed_allocs++;
+        return NULL;
+    }
+
+    ComboPoolStats* stats = &pool->stats;
+    stats->bytes_in_use += block_size;
+    stats->blocks_in_use++;
+    if (stats->bytes_in_use > stats->high_water_bytes) stats->high_water_bytes = stats->bytes_in_use;
+    if (stats->blocks_in_use > stats->high_water_blocks) stats->high_water_blocks = stats->blocks_in_use;
+    return block;
+}
+
+void combo_pool_free(ComboPool* pool, void* block, size_t size) {
+    if (!block) return;
+    if (size == 0) size = 1;
+
+    size_t block_size = size;
+    if (size > COMBO_POOL_MAX_BLOCK) {
+        for (uint32_t i = 0; i < pool->large_count; i++) {
+            if (pool->large[i] == block) {
+                pool->large[i] = pool->large[--pool->large_count];
+                break;
+            }
+        }
+        free(block);
+    } else {
+        int index = size_class(size);
+        block_size = (size_t)COMBO_POOL_MIN_BLOCK << index;
+        FreeBlock* free_block = block;
+        free_block->next = pool->free_lists[index];
+        pool->free_lists[index] = free_block;
+    }
+    pool->stats.bytes_in_use -= block_size;
+    pool->stats.blocks_in_use--;
+}
+
+void combo_pool_reset(ComboPool* pool) {
+    for (uint32_t i = 0; i < pool->large_count; i++) {
+        free(pool->large[i]);
+    }
+    pool->large_count = 0;
+    memset(pool->free_lists, 0, sizeof(pool->free_lists));
+
+    pool->slabs_used = 0;
+    if (pool->buffer) {
+        set_region(pool, pool->buffer, pool->buffer_size);
+    } else {
+        pool->cursor = pool->end = NULL;
+    }
+
+    pool->stats.bytes_in_use = 0;
+    pool->stats.blocks_in_use = 0;
+    pool->stats.reserved_bytes = 0;
+    pool->stats.resets++;
+}
+
+const ComboPoolStats* combo_pool_stats(const ComboPool* pool) {
+    return &pool->stats;
+}
@@ -0,0 +1,76 @@
+#ifndef COMBO_POOL_H
+#define COMBO_POOL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Slab pool for objective and interval arrays.
+//
+// Blocks come in power-of-two size classes (128 bytes to 8 KB) with a
+// free list per class. Storage is carved from 16 KB slabs, either
+// malloc'd on demand or taken from one caller-provided buffer (no heap at
+// all, for the embedded build). combo_pool_reset drops every block at once
+// and keeps the slabs for reuse, so reloading trackers does not churn the
+// allocator. Requests over 8 KB go to malloc on heap pools and fail on
+// static ones.
+//
+// A pool is not thread-safe.
+
+#define COMBO_POOL_CLASSES 7
+#define COMBO_POOL_MIN_BLOCK 128
+#define COMBO_POOL_MAX_BLOCK (COMBO_POOL_MIN_BLOCK << (COMBO_POOL_CLASSES - 1))
+#define COMBO_POOL_SLAB_SIZE 16384
+
+typedef struct {
+    size_t bytes_in_use;        // Block bytes handed out
+    size_t high_water_bytes;
+    size_t reserved_bytes;      // Slab (or static buffer) bytes carved so far
+    size_t high_water_reserved;
+    uint32_t blocks_in_use;
+    uint32_t high_water_blocks;
+    uint32_t failed_allocs;
+    uint32_t resets;
+} ComboPoolStats;
+
+typedef struct {
+    // Current carving region
+    uint8_t* cursor;
+    uint8_t* end;
+
+    // Static backing (NULL for heap pools)
+    uint8_t* buffer;
+    size_t buffer_size;
+
+    // Heap slabs; the first slabs_used are in use since the last reset
+    uint8_t** slabs;
+    uint32_t slab_count;
+    uint32_t slab_capacity;
+    uint32_t slabs_used;
+    size_t max_bytes;           // Heap slab limit, 0 for unlimited
+
+    // Oversized blocks, freed on reset
+    void** large;
+    uint32_t large_count;
+    uint32_t large_capacity;
+
+    void* free_lists[COMBO_POOL_CLASSES];
+    ComboPoolStats stats;
+} ComboPool;
+
+// Heap-backed pool; max_bytes caps slab memory (0 for no cap)
+void combo_pool_init(ComboPool* pool, size_t max_bytes);
+// Pool that only ever uses `buffer`
+void combo_pool_init_static(ComboPool* pool, void* buffer, size_t size);
+void combo_pool_destroy(ComboPool* pool);
+
+// Blocks are 16-byte aligned. `size` must be passed back to free.
+void* combo_pool_alloc(ComboPool* pool, size_t size);
+void combo_pool_free(ComboPool* pool, void* block, size_t size);
+
+// Release every block at once; slabs are kept for reuse
+void combo_pool_reset(ComboPool* pool);
+
+const ComboPoolStats* combo_pool_stats(const ComboPool* pool);
+
+#endif // COMBO_POOL_H
@@ -0,0 +1,458 @@
+#define _POSIX_C_SOURCE 200809L
+#include "combo_table.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Reallocate one column to new_capacity elements, keeping the first
+// `count` and the cache-line alignment
+static bool grow_column(void** column, size_t element_size, uint32_t count, uint32_t new_capacity) {
+    void* fresh = NULL;
+    if (posix_memalign(&fresh, COMBO_TABLE_ALIGNMENT, element_size * new_capacity) != 0) {
+        return false;
+    }
+    if (*column && count > 0) {
+        memcpy(fresh, *column, element_size * count);
+    }
+    free(*column);
+    *column = fresh;
+    return true;
+}
+
+bool combo_table_init(ComboStateTable* table, uint32_t initial_capacity) {
+    memset(table, 0, sizeof(*table));
+    combo_pool_init(&table->pool, 0);
+    return timer_wheel_init(&table->timers, COMBO_TABLE_TIMER_TICK, 0) &&
+           combo_table_reserve(table, initial_capacity);
+}
+
+void combo_table_free(ComboStateTable* table) {
+    free(table->score);
+    free(table->combo);
+    free(table->multiplier);
+    free(table->decay_pause);
+    free(table->paused);
+    free(table->last_hit_time);
+    free(table->max_combo);
+    free(table->total_hits);
+    free(table->perfect_hits);
+    free(table->miss_hits);
+    free(table->timing);
+    free(table->interval_time);
+    free(table->interval_duration);
+    free(table->interval_rep);
+    free(table->interval_reps);
+    free(table->interval_flags);
+    free(table->interval_timer);
+    free(table->cold);
+    timer_wheel_free(&table->timers);
+    combo_pool_destroy(&table->pool);
+    memset(table, 0, sizeof(*table));
+}
+
+bool combo_table_reserve(ComboStateTable* table, uint32_t capacity) {
+    if (capacity <= table->capacity) return true;
+    if (capacity < COMBO_TABLE_MIN_CAPACITY) capacity = COMBO_TABLE_MIN_CAPACITY;
+
+    uint32_t n = table->count;
+    bool ok = grow_column((void**)&table->score, sizeof(int32_t), n, capacity) &&
+              grow_column((void**)&table->combo, sizeof(int32_t), n, capacity) &&
+              grow_column((void**)&table->multiplier, sizeof(float), n, capacity) &&
+              grow_column((void**)&table->decay_pause, sizeof(float), n, capacity) &&
+              grow_column((void**)&table->paused, sizeof(uint8_t), n, capacity) &&
+              grow_column((void**)&table->last_hit_time, sizeof(double), n, capacity) &&
+              grow_column((void**)&table->max_combo, sizeof(int32_t), n, capacity) &&
+              grow_column((void**)&table->total_hits, sizeof(uint32_t), n, capacity) &&
+              grow_column((void**)&table->perfect_hits, sizeof(uint32_t), n, capacity) &&
+              grow_column((void**)&table->miss_hits, sizeof(uint32_t), n, capacity) &&
+              grow_column((void**)&table->timing, sizeof(HitStats), n, capacity) &&
+              grow_column((void**)&table->interval_time, sizeof(float), n, capacity) &&
+              grow_column((void**)&table->interval_timer, sizeof(int32_t), n, capacity) &&
+              grow_column((void**)&table->interval_duration, sizeof(float), n, capacity) &&
+              grow_column((void**)&table->interval_rep, sizeof(int32_t), n, capacity) &&
+              grow_column((void**)&table->interval_reps, sizeof(int32_t), n, capacity) &&
+              grow_column((void**)&table->interval_flags, sizeof(uint8_t), n, capacity) &&
+              grow_column((void**)&table->cold, sizeof(ComboColdData), n, capacity);
+    // Columns that did grow are still valid at the old capacity
+    if (ok) table->capacity = capacity;
+    return ok;
+}
+
+int combo_table_add(ComboStateTable* table, const char* label) {
+    if (table->count == table->capacity &&
+        !combo_table_reserve(table, table->capacity ? table->capacity * 2 : COMBO_TABLE_MIN_CAPACITY)) {
+        return -1;
+    }
+
+    uint32_t i = table->count++;
+    table->score[i] = 0;
+    table->combo[i] = 0;
+    table->multiplier[i] = BASE_MULTIPLIER;
+    table->decay_pause[i] = 0.0f;
+    table->paused[i] = 1;
+    table->last_hit_time[i] = 0.0;
+    table->max_combo[i] = 0;
+    table->total_hits[i] = 0;
+    table->perfect_hits[i] = 0;
+    table->miss_hits[i] = 0;
+    hit_stats_init(&table->timing[i]);
+    table->interval_time[i] = 0.0f;
+    table->interval_timer[i] = TIMER_WHEEL_INVALID;
+    table->interval_duration[i] = 0.0f;
+    table->interval_rep[i] = 0;
+    table->interval_reps[i] = 0;
+    table->interval_flags[i] = 0;
+
+    ComboColdData* cold = &table->cold[i];
+    memset(cold, 0, sizeof(*cold));
+    strncpy(cold->label, label, MAX_LABEL_LENGTH - 1);
+    return (int)i;
+}
+
+void combo_table_remove(ComboStateTable* table, uint32_t index) {
+    if (index >= table->count) return;
+
+    combo_objectives_free(&table->pool, table->cold[index].objectives, table->cold[index].objective_count);
+    timer_wheel_cancel(&table->timers, table->interval_timer[index]);
+    uint32_t last = --table->count;
+    if (index == last) return;
+
+    // The moved tracker's pending deadline must point at its new slot
+    timer_wheel_set_user(&table->timers, table->interval_timer[last], index);
+
+    table->score[index] = table->score[last];
+    table->combo[index] = table->combo[last];
+    table->multiplier[index] = table->multiplier[last];
+    table->decay_pause[index] = table->decay_pause[last];
+    table->paused[index] = table->paused[last];
+    table->last_hit_time[index] = table->last_hit_time[last];
+    table->max_combo[index] = table->max_combo[last];
+    table->total_hits[index] = table->total_hits[last];
+    table->perfect_hits[index] = table->perfect_hits[last];
+    table->miss_hits[index] = table->miss_hits[last];
+    table->timing[index] = table->timing[last];
+    table->interval_time[index] = table->interval_time[last];
+    table->interval_timer[index] = table->interval_timer[last];
+    table->interval_duration[index] = table->interval_duration[last];
+    table->interval_rep[index] = table->interval_rep[last];
+    table->interval_reps[index] = table->interval_reps[last];
+    table->interval_flags[index] = table->interval_flags[last];
+    table->cold[index] = table->cold[last];
+}
+
+void combo_table_clear(ComboStateTable* table) {
+    for (uint32_t i = 0; i < table->count; i++) {
+        timer_wheel_cancel(&table->timers, table->interval_timer[i]);
+    }
+    table->count = 0;
+    combo_pool_reset(&table->pool);
+}
+
+void combo_table_settle(ComboStateTable* table, uint32_t index, double now) {
+    if (index >= table->count || table->paused[index]) return;
+
+    float elapsed = (float)(now - table->last_hit_time[index]);
+    if (elapsed <= 0.0f) return;
+
+    table->last_hit_time[index] = now;
+    const ComboTuning* tuning = combo_tuning();
+    if (combo_decay_step(tuning, &table->combo[index], &table->decay_pause[index], elapsed) > 0) {
+        table->multiplier[index] = combo_multiplier_for(tuning, table->combo[index]);
+    }
+}
+
+void combo_table_increment(ComboStateTable* table, uint32_t index, uint32_t amount) {
+    if (index >= table->count || table->paused[index]) return;
+    double now = combo_clock_now();
+    combo_table_settle(table, index, now);
+
+    const ComboTuning* tuning = combo_tuning();
+    hit_stats_record(&table->timing[index], combo_time_ms(now), combo_deadline_ms(tuning));
+    table->total_hits[index]++;
+    table->perfect_hits[index]++;  // For now, all hits are perfect
+
+    table->score[index] += (uint32_t)(amount * table->multiplier[index]);
+
+    int32_t combo = ++table->combo[index];
+    if (combo > table->max_combo[index]) {
+        table->max_combo[index] = combo;
+    }
+
+    table->multiplier[index] = combo_multiplier_for(tuning, combo);
+    table->decay_pause[index] = tuning->decay_time;
+
+    // Objective progress is the only cold data a hit needs
+    ComboColdData* cold = &table->cold[index];
+    cold->objective_points += amount;
+    objectives_credit(cold->objectives, cold->objective_count, amount);
+}
+
+void combo_table_decrement(ComboStateTable* table, uint32_t index, uint32_t amount) {
+    if (index >= table->count || table->paused[index]) return;
+    combo_table_settle(table, index, combo_clock_now());
+
+    table->miss_hits[index]++;
+    if ((int64_t)table->score[index] >= (int64_t)amount) {
+        table->score[index] -= (int32_t)amount;
+    } else {
+        table->score[index] = 0;
+    }
+
+    table->combo[index] = 0;
+    table->multiplier[index] = BASE_MULTIPLIER;
+}
+
+float combo_table_interval_remaining(const ComboStateTable* table, uint32_t index) {
+    if (index >= table->count) return 0.0f;
+    if (table->interval_timer[index] != TIMER_WHEEL_INVALID) {
+        return (float)timer_wheel_remaining(&table->timers, table->interval_timer[index]);
+    }
+    return table->interval_time[index];
+}
+
+// Timer wheel callback; mirrors the interval branch of combo_update()
+static void combo_table_interval_due(void* context, uint32_t index, double deadline) {
+    ComboStateTable* table = context;
+    table->interval_timer[index] = TIMER_WHEEL_INVALID;
+    combo_table_settle(table, index, combo_clock_now());
+    table->score[index] += 10;
+    table->combo[index]++;
+
+    ComboColdData* cold = &table->cold[index];
+    if (cold->has_objective) {
+        cold->completed_intervals++;
+        if (cold->completed_intervals >= cold->objective) {
+            table->score[index] += 50;
+        }
+    }
+
+    if (table->interval_rep[index] < table->interval_reps[index]) {
+        // Schedule from the old deadline so late frames don't add drift
+        table->interval_rep[index]++;
+        table->interval_time[index] = table->interval_duration[index];
+        table->interval_timer[index] = timer_wheel_schedule_at(&table->timers,
+                                                               deadline + table->interval_duration[index],
+                                                               combo_table_interval_due, table, index);
+    } else {
+        table->interval_time[index] = 0.0f;
+        table->interval_flags[index] = 0;
+    }
+}
+
+void combo_table_increment_batch(ComboStateTable* table, uint32_t index,
+                                 const HitEvent* events, uint32_t count) {
+    if (index >= table->count || table->paused[index] || count == 0) return;
+
+    const ComboTuning* tuning = combo_tuning();
+    int32_t combo = table->combo[index];
+    int32_t max_combo = table->max_combo[index];
+    int32_t score = table->score[index];
+    float multiplier = table->multiplier[index];
+    float decay_pause = table->decay_pause[index];
+    double last_hit_time = table->last_hit_time[index];
+    HitStats* timing = &table->timing[index];
+    uint32_t deadline_ms = combo_deadline_ms(tuning);
+    uint32_t hits = 0, misses = 0;
+    uint64_t progress = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const HitEvent* event = &events[i];
+        if (event->time > last_hit_time) {
+            if (combo_decay_step(tuning, &combo, &decay_pause, (float)(event->time - last_hit_time)) > 0) {
+                multiplier = combo_multiplier_for(tuning, combo);
+            }
+            last_hit_time = event->time;
+        }
+
+        if (event->type == HIT_EVENT_MISS) {
+            misses++;
+            if ((int64_t)score >= (int64_t)event->amount) {
+                score -= (int32_t)event->amount;
+            } else {
+                score = 0;
+            }
+            combo = 0;
+            multiplier = BASE_MULTIPLIER;
+        } else {
+            hits++;
+            hit_stats_record(timing, combo_time_ms(event->time), deadline_ms);
+            progress += event->amount;
+            score += (uint32_t)(event->amount * multiplier);
+            combo++;
+            if (combo > max_combo) max_combo = combo;
+            multiplier = combo_multiplier_for(tuning, combo);
+            decay_pause = tuning->decay_time;
+        }
+    }
+
+    table->combo[index] = combo;
+    table->max_combo[index] = max_combo;
+    table->score[index] = score;
+    table->multiplier[index] = multiplier;
+    table->decay_pause[index] = decay_pause;
+    table->last_hit_time[index] = last_hit_time;
+    table->total_hits[index] += hits;
+    table->perfect_hits[index] += hits;
+    table->miss_hits[index] += misses;
+
+    if (hits > 0) {
+        ComboColdData* cold = &table->cold[index];
+        cold->objective_points += (uint32_t)progress;
+        objectives_credit(cold->objectives, cold->objective_count, (uint32_t)progress);
+    }
+}
+
+// Running intervals keep their deadline on the wheel; stopped ones keep
+// the remaining time in interval_time
+static void combo_table_start_interval(ComboStateTable* table, uint32_t index) {
+    table->interval_flags[index] |= COMBO_INTERVAL_RUNNING;
+    if (table->interval_timer[index] == TIMER_WHEEL_INVALID) {
+        table->interval_timer[index] = timer_wheel_schedule(&table->timers, table->interval_time[index],
+                                                            combo_table_interval_due, table, index);
+    }
+}
+
+static void combo_table_stop_interval(ComboStateTable* table, uint32_t index) {
+    table->interval_flags[index] &= (uint8_t)~COMBO_INTERVAL_RUNNING;
+    if (table->interval_timer[index] != TIMER_WHEEL_INVALID) {
+        table->interval_time[index] = combo_table_interval_remaining(table, index);
+        timer_wheel_cancel(&table->timers, table->interval_timer[index]);
+        table->interval_timer[index] = TIMER_WHEEL_INVALID;
+    }
+}
+
+void combo_table_pause(ComboStateTable* table, uint32_t index) {
+    if (index >= table->count) return;
+    combo_table_settle(table, index, combo_clock_now());
+    table->paused[index] = 1;
+    hit_stats_break(&table->timing[index]);
+    combo_table_stop_interval(table, index);
+}
+
+void combo_table_resume(ComboStateTable* table, uint32_t index) {
+    if (index >= table->count) return;
+    if (table->paused[index]) {
+        table->last_hit_time[index] = combo_clock_now();
+    }
+    table->paused[index] = 0;
+    if (table->interval_flags[index] & COMBO_INTERVAL_ACTIVE) {
+        combo_table_start_interval(table, index);
+    }
+}
+
+void combo_table_set_objectives(ComboStateTable* table, uint32_t index,
+                                const Objective* objectives, uint32_t count) {
+    if (index >= table->count) return;
+
+    ComboColdData* cold = &table->cold[index];
+    combo_objectives_free(&table->pool, cold->objectives, cold->objective_count);
+    cold->objectives = NULL;
+    cold->objective_count = 0;
+    cold->active_objective_index = 0;
+
+    if (count > 0) {
+        cold->objectives = combo_objectives_alloc(&table->pool, count);
+        if (!cold->objectives) return;
+        memcpy(cold->objectives, objectives, sizeof(Objective) * count);
+        cold->objective_count = count;
+    }
+}
+
+void combo_table_set_interval(ComboStateTable* table, uint32_t index, const char* label,
+                              int duration, int reps) {
+    if (index >= table->count) return;
+
+    combo_table_stop_interval(table, index);
+    ComboColdData* cold = &table->cold[index];
+    strncpy(cold->interval_label, label, MAX_LABEL_LENGTH - 1);
+    cold->interval_label[MAX_LABEL_LENGTH - 1] = '\0';
+    table->interval_duration[index] = (float)duration;
+    table->interval_time[index] = (float)duration;
+    table->interval_reps[index] = reps;
+    table->interval_rep[index] = 1;
+    table->interval_flags[index] = COMBO_INTERVAL_ACTIVE;
+}
+
+int combo_table_add_state(ComboStateTable* table, const ComboState* state) {
+    int index = combo_table_add(table, state->label);
+    if (index < 0) return -1;
+
+    uint32_t i = (uint32_t)index;
+    table->score[i] = state->score;
+    table->combo[i] = state->combo;
+    table->multiplier[i] = state->multiplier;
+    table->decay_pause[i] = state->decay_pause;
+    table->paused[i] = state->paused ? 1 : 0;
+    table->last_hit_time[i] = state->last_hit_time;
+    table->max_combo[i] = state->max_combo;
+    table->total_hits[i] = state->total_hits;
+    table->perfect_hits[i] = state->perfect_hits;
+    table->miss_hits[i] = state->miss_hits;
+    table->timing[i] = state->timing;
+
+    ComboColdData* cold = &table->cold[i];
+    cold->has_objective = state->has_objective;
+    cold->objective = state->objective;
+    cold->completed_intervals = state->completed_intervals;
+    cold->objective_points = state->objective_points;
+
+    const IntervalTracker* intervals = &state->interval_tracker;
+    memcpy(cold->interval_label, intervals->current_interval.label, MAX_LABEL_LENGTH);
+    cold->interval_label[MAX_LABEL_LENGTH - 1] = '\0';
+    table->interval_time[i] = (float)intervals->current_time;
+    table->interval_duration[i] = (float)intervals->current_interval.duration;
+    table->interval_rep[i] = intervals->current_rep;
+    table->interval_reps[i] = intervals->current_interval.reps;
+    table->interval_flags[i] = intervals->has_interval ? COMBO_INTERVAL_ACTIVE : 0;
+    if (intervals->has_interval && intervals->is_running && !state->paused) {
+        combo_table_start_interval(table, i);
+    }
+    if (state->objective_count > 0 && state->objectives) {
+        combo_table_set_objectives(table, i, state->objectives, state->objective_count);
+        cold->active_objective_index = state->active_objective_index;
+    }
+    return index;
+}
+
+void combo_table_get_state(const ComboStateTable* table, uint32_t index, ComboState* state) {
+    if (index >= table->count) return;
+
+    const ComboColdData* cold = &table->cold[index];
+    combo_init(state, cold->label);
+    state->score = table->score[index];
+    state->combo = table->combo[index];
+    state->multiplier = table->multiplier[index];
+    state->decay_pause = table->decay_pause[index];
+    state->paused = table->paused[index] != 0;
+    state->last_hit_time = table->last_hit_time[index];
+    state->max_combo = table->max_combo[index];
+    state->total_hits = table->total_hits[index];
+    state->perfect_hits = table->perfect_hits[index];
+    state->miss_hits = table->miss_hits[index];
+    state->timing = table->timing[index];
+    state->has_objective = cold->has_objective;
+    state->objective = cold->objective;
+    state->completed_intervals = cold->completed_intervals;
+    state->objective_points = cold->objective_points;
+
+    IntervalTracker* intervals = &state->interval_tracker;
+    memcpy(intervals->current_interval.label, cold->interval_label, MAX_LABEL_LENGTH);
+    intervals->current_interval.duration = (int)table->interval_duration[index];
+    intervals->current_interval.reps = table->interval_reps[index];
+    intervals->current_time = combo_table_interval_remaining(table, index);
+    intervals->current_rep = table->interval_rep[index];
+    intervals->has_interval = (table->interval_flags[index] & COMBO_INTERVAL_ACTIVE) != 0;
+    intervals->is_running = (table->interval_flags[index] & COMBO_INTERVAL_RUNNING) != 0;
+
+    if (cold->objective_count > 0) {
+        state->objectives = malloc(sizeof(Objective) * cold->objective_count);
+        if (state->objectives) {
+            memcpy(state->objectives, cold->objectives, sizeof(Objective) * cold->objective_count);
+            state->objective_count = cold->objective_count;
+            state->active_objective_index = cold->active_objective_index;
+        }
+    }
+}
+
+void combo_update_all(ComboStateTable* table, float dt) {
+    timer_wheel_advance(&table->timers, dt);
+}
@@ -0,0 +1,117 @@
+#ifndef COMBO_TABLE_H
+#define COMBO_TABLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "core.h"
+#include "timer_wheel.h"
+
+// Struct-of-arrays tracker storage for large tracker counts.
+// Each hot field lives in its own contiguous, cache-line aligned array so
+// bulk passes only pull in the fields they touch; labels, objectives and
+// interval definitions are kept apart in the cold array.
+// Semantics match the ComboState functions in core.h.
+
+#define COMBO_TABLE_ALIGNMENT 64
+#define COMBO_TABLE_MIN_CAPACITY 16
+#define COMBO_TABLE_TIMER_TICK 0.001   // Interval deadline resolution, seconds
+
+// interval_flags bits
+#define COMBO_INTERVAL_ACTIVE 0x01     // has_interval
+#define COMBO_INTERVAL_RUNNING 0x02    // is_running
+
+typedef struct {
+    char label[MAX_LABEL_LENGTH];
+    bool has_objective;
+    int objective;
+    int completed_intervals;
+    Objective* objectives;
+    uint32_t objective_count;
+    uint32_t active_objective_index;
+    uint32_t objective_points;
+    char interval_label[MAX_LABEL_LENGTH];
+} ComboColdData;
+
+typedef struct {
+    uint32_t count;
+    uint32_t capacity;
+
+    // Hot: touched by hits and per-frame updates
+    int32_t* score;
+    int32_t* combo;
+    float* multiplier;
+    float* decay_pause;         // As of last_hit_time; decay is applied lazily
+    uint8_t* paused;
+    double* last_hit_time;
+
+    // Warm: statistics, only touched by hits
+    int32_t* max_combo;
+    uint32_t* total_hits;
+    uint32_t* perfect_hits;
+    uint32_t* miss_hits;
+    HitStats* timing;
+
+    // Intervals. A running interval has a deadline on the timer wheel;
+    // interval_time holds the remaining seconds while it is stopped.
+    float* interval_time;
+    int32_t* interval_timer;
+    float* interval_duration;
+    int32_t* interval_rep;
+    int32_t* interval_reps;
+    uint8_t* interval_flags;
+
+    // Cold
+    ComboColdData* cold;
+
+    TimerWheel timers;
+    ComboPool pool;             // Owns every tracker's objectives
+} ComboStateTable;
+
+bool combo_table_init(ComboStateTable* table, uint32_t initial_capacity);
+void combo_table_free(ComboStateTable* table);
+bool combo_table_reserve(ComboStateTable* table, uint32_t capacity);
+
+// Returns the new tracker index, or -1 on allocation failure
+int combo_table_add(ComboStateTable* table, const char* label);
+// Removes by moving the last tracker into the freed slot
+void combo_table_remove(ComboStateTable* table, uint32_t index);
+// Drop every tracker, e.g. before a reload. Column and pool memory is
+// kept, and objective storage is released in one pool reset.
+void combo_table_clear(ComboStateTable* table);
+
+void combo_table_increment(ComboStateTable* table, uint32_t index, uint32_t amount);
+void combo_table_decrement(ComboStateTable* table, uint32_t index, uint32_t amount);
+// Same results as combo_increment_batch on the equivalent ComboState
+void combo_table_increment_batch(ComboStateTable* table, uint32_t index,
+                                 const HitEvent* events, uint32_t count);
+void combo_table_pause(ComboStateTable* table, uint32_t index);
+void combo_table_resume(ComboStateTable* table, uint32_t index);
+void combo_table_set_objectives(ComboStateTable* table, uint32_t index,
+                                const Objective* objectives, uint32_t count);
+void combo_table_set_interval(ComboStateTable* table, uint32_t index, const char* label,
+                              int duration, int reps);
+
+// Fold decay up to `now` into a tracker's combo columns (see combo_settle).
+// Hits do this themselves; call it before reading combo or multiplier.
+void combo_table_settle(ComboStateTable* table, uint32_t index, double now);
+// combo_table_settle for every tracker, e.g. before drawing the whole
+// table. Vectorized (AVX2 chosen at runtime, SSE2 baseline on x86-64);
+// the scalar version is the reference.
+void combo_table_settle_all(ComboStateTable* table, double now);
+void combo_table_settle_all_scalar(ComboStateTable* table, double now);
+// Kernel combo_table_settle_all runs: "avx2", "sse2" or "scalar"
+const char* combo_table_settle_isa(void);
+
+// Seconds left in the tracker's current interval rep
+float combo_table_interval_remaining(const ComboStateTable* table, uint32_t index);
+
+// Advance interval time by dt and complete every rep that came due.
+// Cost depends on the number of completions, not on the tracker count;
+// combo decay is computed lazily from last_hit_time.
+void combo_update_all(ComboStateTable* table, float dt);
+
+// Conversion to and from ComboState; objectives are deep-copied
+int combo_table_add_state(ComboStateTable* table, const ComboState* state);
+void combo_table_get_state(const ComboStateTable* table, uint32_t index, ComboState* state);
+
+#endif // COMBO_TABLE_H
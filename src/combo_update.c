@@ -0,0 +1,221 @@
+#include "combo_table.h"
+#include <string.h>
+
+// Bulk lazy-decay settle for ComboStateTable.
+//
+// Every lane does the arithmetic of combo_table_settle(): take the seconds
+// since last_hit_time, count decay_pause down by them, and once it runs out
+// drain one combo point per 1/decay_rate seconds, carrying the fractional
+// remainder in a negative decay_pause. The multiplier is recomputed only
+// for lanes that lost combo. Paused lanes and lanes with no elapsed time
+// are left untouched through masked stores.
+
+#if defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64)
+#define COMBO_SETTLE_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define COMBO_SETTLE_AVX2 1
+#include <immintrin.h>
+#endif
+#endif
+
+typedef void (*SettleKernel)(ComboStateTable* table, double now);
+
+void combo_table_settle_all_scalar(ComboStateTable* table, double now) {
+    for (uint32_t i = 0; i < table->count; i++) {
+        combo_table_settle(table, i, now);
+    }
+}
+
+#ifdef COMBO_SETTLE_SSE2
+// Widen four bytes to four 32-bit lanes
+static inline __m128i load_u8x4(const uint8_t* p) {
+    int32_t bytes;
+    memcpy(&bytes, p, sizeof(bytes));
+    __m128i zero = _mm_setzero_si128();
+    __m128i v = _mm_cvtsi32_si128(bytes);
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(v, zero), zero);
+}
+
+static inline __m128 select_ps(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128i select_si128(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static inline __m128d select_pd(__m128d mask, __m128d a, __m128d b) {
+    return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+
+static void settle_all_sse2(ComboStateTable* table, double now) {
+    const ComboTuning* tuning = combo_tuning();
+    const __m128d now2 = _mm_set1_pd(now);
+    const __m128 zero_ps = _mm_setzero_ps();
+    const __m128 rate = _mm_set1_ps(tuning->decay_rate);
+    const __m128 inv_rate = _mm_set1_ps(1.0f / tuning->decay_rate);
+    const __m128 max_span = _mm_set1_ps(COMBO_DECAY_MAX_SPAN);
+    const __m128 base = _mm_set1_ps(BASE_MULTIPLIER);
+    const __m128 increase = _mm_set1_ps(tuning->multiplier_increase);
+    const __m128 max_multiplier = _mm_set1_ps(tuning->max_multiplier);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi32(1);
+
+    uint32_t n = table->count;
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128d last_lo = _mm_load_pd(table->last_hit_time + i);
+        __m128d last_hi = _mm_load_pd(table->last_hit_time + i + 2);
+        __m128 elapsed = _mm_movelh_ps(_mm_cvtpd_ps(_mm_sub_pd(now2, last_lo)),
+                                       _mm_cvtpd_ps(_mm_sub_pd(now2, last_hi)));
+        __m128i unpaused = _mm_cmpeq_epi32(load_u8x4(table->paused + i), zero);
+        __m128 active = _mm_and_ps(_mm_castsi128_ps(unpaused), _mm_cmpgt_ps(elapsed, zero_ps));
+        int active_bits = _mm_movemask_ps(active);
+        if (!active_bits) continue;
+        __m128i active_si = _mm_castps_si128(active);
+
+        __m128 old_pause = _mm_load_ps(table->decay_pause + i);
+        __m128 pause = _mm_sub_ps(old_pause, elapsed);
+        __m128 over = _mm_min_ps(_mm_max_ps(_mm_sub_ps(zero_ps, pause), zero_ps), max_span);
+        __m128i lost = _mm_cvttps_epi32(_mm_mul_ps(over, rate));
+
+        __m128i old_combo = _mm_load_si128((const __m128i*)(table->combo + i));
+        __m128i combo = _mm_sub_epi32(old_combo, lost);
+        __m128i drained = _mm_cmplt_epi32(combo, one);
+        combo = _mm_andnot_si128(drained, combo);
+        pause = _mm_add_ps(pause, _mm_mul_ps(_mm_cvtepi32_ps(lost), inv_rate));
+        pause = _mm_andnot_ps(_mm_castsi128_ps(drained), pause);
+
+        _mm_store_ps(table->decay_pause + i, select_ps(active, pause, old_pause));
+        _mm_store_si128((__m128i*)(table->combo + i), select_si128(active_si, combo, old_combo));
+
+        // Each half of the double column takes two of the four lane masks
+        __m128d active_lo = _mm_castsi128_pd(_mm_unpacklo_epi32(active_si, active_si));
+        __m128d active_hi = _mm_castsi128_pd(_mm_unpackhi_epi32(active_si, active_si));
+        _mm_store_pd(table->last_hit_time + i, select_pd(active_lo, now2, last_lo));
+        _mm_store_pd(table->last_hit_time + i + 2, select_pd(active_hi, now2, last_hi));
+
+        __m128 changed = _mm_castsi128_ps(_mm_and_si128(active_si, _mm_cmpgt_epi32(lost, zero)));
+        if (_mm_movemask_ps(changed)) {
+            __m128 multiplier = _mm_min_ps(_mm_add_ps(base, _mm_mul_ps(increase, _mm_cvtepi32_ps(combo))),
+                                           max_multiplier);
+            __m128 old_multiplier = _mm_load_ps(table->multiplier + i);
+            _mm_store_ps(table->multiplier + i, select_ps(changed, multiplier, old_multiplier));
+        }
+    }
+    for (; i < n; i++) {
+        combo_table_settle(table, i, now);
+    }
+}
+#endif
+
+#ifdef COMBO_SETTLE_AVX2
+__attribute__((target("avx2")))
+static inline __m256i load_u8x8(const uint8_t* p) {
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)p));
+}
+
+__attribute__((target("avx2")))
+static void settle_all_avx2(ComboStateTable* table, double now) {
+    const ComboTuning* tuning = combo_tuning();
+    const __m256d now4 = _mm256_set1_pd(now);
+    const __m256 zero_ps = _mm256_setzero_ps();
+    const __m256 rate = _mm256_set1_ps(tuning->decay_rate);
+    const __m256 inv_rate = _mm256_set1_ps(1.0f / tuning->decay_rate);
+    const __m256 max_span = _mm256_set1_ps(COMBO_DECAY_MAX_SPAN);
+    const __m256 base = _mm256_set1_ps(BASE_MULTIPLIER);
+    const __m256 increase = _mm256_set1_ps(tuning->multiplier_increase);
+    const __m256 max_multiplier = _mm256_set1_ps(tuning->max_multiplier);
+    const __m256i zero = _mm256_setzero_si256();
+
+    uint32_t n = table->count;
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d last_lo = _mm256_load_pd(table->last_hit_time + i);
+        __m256d last_hi = _mm256_load_pd(table->last_hit_time + i + 4);
+        __m256 elapsed = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm256_cvtpd_ps(_mm256_sub_pd(now4, last_lo))),
+            _mm256_cvtpd_ps(_mm256_sub_pd(now4, last_hi)), 1);
+        __m256i unpaused = _mm256_cmpeq_epi32(load_u8x8(table->paused + i), zero);
+        __m256 active = _mm256_and_ps(_mm256_castsi256_ps(unpaused),
+                                      _mm256_cmp_ps(elapsed, zero_ps, _CMP_GT_OQ));
+        if (!_mm256_movemask_ps(active)) continue;
+        __m256i active_si = _mm256_castps_si256(active);
+
+        __m256 old_pause = _mm256_load_ps(table->decay_pause + i);
+        __m256 pause = _mm256_sub_ps(old_pause, elapsed);
+        __m256 over = _mm256_min_ps(_mm256_max_ps(_mm256_sub_ps(zero_ps, pause), zero_ps), max_span);
+        __m256i lost = _mm256_cvttps_epi32(_mm256_mul_ps(over, rate));
+
+        __m256i old_combo = _mm256_load_si256((const __m256i*)(table->combo + i));
+        __m256i combo = _mm256_sub_epi32(old_combo, lost);
+        __m256i drained = _mm256_cmpgt_epi32(_mm256_set1_epi32(1), combo);
+        combo = _mm256_andnot_si256(drained, combo);
+        pause = _mm256_add_ps(pause, _mm256_mul_ps(_mm256_cvtepi32_ps(lost), inv_rate));
+        pause = _mm256_andnot_ps(_mm256_castsi256_ps(drained), pause);
+
+        _mm256_store_ps(table->decay_pause + i, _mm256_blendv_ps(old_pause, pause, active));
+        _mm256_store_si256((__m256i*)(table->combo + i), _mm256_blendv_epi8(old_combo, combo, active_si));
+
+        // Widen each half of the lane mask to 64 bits for the double column
+        __m256i active_lo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(active_si));
+        __m256i active_hi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(active_si, 1));
+        _mm256_maskstore_pd(table->last_hit_time + i, active_lo, now4);
+        _mm256_maskstore_pd(table->last_hit_time + i + 4, active_hi, now4);
+
+        __m256 changed = _mm256_castsi256_ps(_mm256_and_si256(active_si, _mm256_cmpgt_epi32(lost, zero)));
+        if (_mm256_movemask_ps(changed)) {
+            __m256 multiplier = _mm256_min_ps(
+                _mm256_add_ps(base, _mm256_mul_ps(increase, _mm256_cvtepi32_ps(combo))), max_multiplier);
+            _mm256_maskstore_ps(table->multiplier + i, _mm256_castps_si256(changed), multiplier);
+        }
+    }
+    for (; i < n; i++) {
+        combo_table_settle(table, i, now);
+    }
+}
+#endif
+
+typedef struct {
+    SettleKernel run;
+    const char* name;
+} SettleKernelInfo;
+
+static const SettleKernelInfo* select_kernel(void) {
+#ifdef COMBO_SETTLE_AVX2
+    static const SettleKernelInfo avx2 = {settle_all_avx2, "avx2"};
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return &avx2;
+    }
+#endif
+#ifdef COMBO_SETTLE_SSE2
+    static const SettleKernelInfo sse2 = {settle_all_sse2, "sse2"};
+    return &sse2;
+#else
+    static const SettleKernelInfo scalar = {combo_table_settle_all_scalar, "scalar"};
+    return &scalar;
+#endif
+}
+
+// Chosen on first use. Threads racing on that first use select the same
+// kernel, and the kernel and its name are published together.
+static const SettleKernelInfo* g_kernel = NULL;
+
+static const SettleKernelInfo* settle_kernel(void) {
+    const SettleKernelInfo* kernel = __atomic_load_n(&g_kernel, __ATOMIC_ACQUIRE);
+    if (!kernel) {
+        kernel = select_kernel();
+        __atomic_store_n(&g_kernel, kernel, __ATOMIC_RELEASE);
+    }
+    return kernel;
+}
+
+void combo_table_settle_all(ComboStateTable* table, double now) {
+    settle_kernel()->run(table, now);
+}
+
+const char* combo_table_settle_isa(void) {
+    return settle_kernel()->name;
+}
@@ -1,14 +1,59 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include "core.h"
+#include "journal.h"
+#include "combo_format.h"
 
-// Constants for combo mechanics
-#define COMBO_DECAY_TIME 5.0f  // Time in seconds before combo starts decaying
-#define COMBO_DECAY_RATE 1.0f  // How many points lost per second
-#define BASE_MULTIPLIER 1.0f
-#define MULTIPLIER_INCREASE 0.1f
-#define MAX_MULTIPLIER 3.0f
+static double monotonic_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static __thread ComboClock g_clock = monotonic_seconds;
+
+static const ComboTuning g_default_tuning = COMBO_TUNING_DEFAULTS;
+static __thread const ComboTuning* g_tuning = &g_default_tuning;
+
+void combo_set_clock(ComboClock clock) {
+    g_clock = clock ? clock : monotonic_seconds;
+}
+
+double combo_clock_now(void) {
+    return g_clock();
+}
+
+void combo_set_tuning(const ComboTuning* tuning) {
+    g_tuning = tuning ? tuning : &g_default_tuning;
+}
+
+const ComboTuning* combo_tuning(void) {
+    return g_tuning;
+}
+
+void combo_peek(const ComboState* state, double now, int32_t* combo, float* multiplier,
+                float* decay_pause) {
+    *combo = state->combo;
+    *multiplier = state->multiplier;
+    *decay_pause = state->decay_pause;
+    if (state->paused || now <= state->last_hit_time) return;
+
+    if (combo_decay_step(g_tuning, combo, decay_pause, (float)(now - state->last_hit_time)) > 0) {
+        *multiplier = combo_multiplier_for(g_tuning, *combo);
+    }
+}
+
+void combo_settle(ComboState* state, double now) {
+    if (state->paused || now <= state->last_hit_time) return;
+
+    int32_t combo;
+    combo_peek(state, now, &combo, &state->multiplier, &state->decay_pause);
+    state->combo = combo;
+    state->last_hit_time = now;
+}
 
 void combo_init(ComboState* state, const char* label) {
     strncpy(state->label, label, MAX_LABEL_LENGTH - 1);
@@ -22,17 +67,23 @@ void combo_init(ComboState* state, const char* label) {
     state->completed_intervals = 0;
     state->multiplier = BASE_MULTIPLIER;
     state->decay_pause = 0.0f;
+    state->last_hit_time = combo_clock_now();
     state->total_hits = 0;
     state->perfect_hits = 0;
     state->miss_hits = 0;
     state->objectives = NULL;
     state->objective_count = 0;
     state->active_objective_index = 0;
+    state->pool = NULL;
     interval_tracker_init(&state->interval_tracker);
+    hit_stats_init(&state->timing);
 }
 
 void combo_increment(ComboState* state, uint32_t amount) {
     if (state->paused) return;
+    double now = combo_clock_now();
+    combo_settle(state, now);
+    hit_stats_record(&state->timing, combo_time_ms(now), combo_deadline_ms(g_tuning));
 
     state->total_hits++;
     state->perfect_hits++;  // For now, all hits are perfect
@@ -46,13 +97,10 @@ void combo_increment(ComboState* state, uint32_t amount) {
         state->max_combo = state->combo;
     }
     
-    state->multiplier = BASE_MULTIPLIER + (MULTIPLIER_INCREASE * state->combo);
-    if (state->multiplier > MAX_MULTIPLIER) {
-        state->multiplier = MAX_MULTIPLIER;
-    }
+    state->multiplier = combo_multiplier_for(g_tuning, state->combo);
     
-    // Reset decay timer
-    state->decay_pause = COMBO_DECAY_TIME;
+    // Reset decay timer (combo_settle moved last_hit_time to now)
+    state->decay_pause = g_tuning->decay_time;
     
     // Update objective progress if any
     combo_update_objective_progress(state, amount);
@@ -60,6 +108,7 @@ void combo_increment(ComboState* state, uint32_t amount) {
 
 void combo_decrement(ComboState* state, uint32_t amount) {
     if (state->paused) return;
+    combo_settle(state, combo_clock_now());
 
     state->miss_hits++;
     if (state->score >= amount) {
@@ -73,14 +122,82 @@ void combo_decrement(ComboState* state, uint32_t amount) {
     state->multiplier = BASE_MULTIPLIER;
 }
 
+void combo_increment_batch(ComboState* state, const HitEvent* events, uint32_t count) {
+    if (state->paused || count == 0) return;
+
+    const ComboTuning* tuning = g_tuning;
+    int32_t combo = state->combo;
+    int32_t max_combo = state->max_combo;
+    int score = state->score;
+    float multiplier = state->multiplier;
+    float decay_pause = state->decay_pause;
+    double last_hit_time = state->last_hit_time;
+    uint32_t deadline_ms = combo_deadline_ms(tuning);
+    uint32_t hits = 0, misses = 0;
+    uint64_t progress = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const HitEvent* event = &events[i];
+
+        // Same as combo_settle: out-of-order events don't move time back
+        if (event->time > last_hit_time) {
+            if (combo_decay_step(tuning, &combo, &decay_pause, (float)(event->time - last_hit_time)) > 0) {
+                multiplier = combo_multiplier_for(tuning, combo);
+            }
+            last_hit_time = event->time;
+        }
+
+        if (event->type == HIT_EVENT_MISS) {
+            misses++;
+            if ((uint32_t)score >= event->amount) {
+                score -= event->amount;
+            } else {
+                score = 0;
+            }
+            combo = 0;
+            multiplier = BASE_MULTIPLIER;
+        } else {
+            hits++;
+            hit_stats_record(&state->timing, combo_time_ms(event->time), deadline_ms);
+            progress += event->amount;
+            score += (uint32_t)(event->amount * multiplier);
+            combo++;
+            if (combo > max_combo) max_combo = combo;
+            multiplier = combo_multiplier_for(tuning, combo);
+            decay_pause = tuning->decay_time;
+        }
+    }
+
+    state->combo = combo;
+    state->max_combo = max_combo;
+    state->score = score;
+    state->multiplier = multiplier;
+    state->decay_pause = decay_pause;
+    state->last_hit_time = last_hit_time;
+    state->total_hits += hits;
+    state->perfect_hits += hits;  // For now, all hits are perfect
+    state->miss_hits += misses;
+
+    // Progress only accumulates, so one update gives the same completion
+    if (hits > 0) {
+        combo_update_objective_progress(state, (uint32_t)progress);
+    }
+}
+
 void combo_pause(ComboState* state) {
+    combo_settle(state, combo_clock_now());
     state->paused = true;
+    hit_stats_break(&state->timing);
     if (state->interval_tracker.has_interval) {
         state->interval_tracker.is_running = false;
     }
 }
 
 void combo_resume(ComboState* state) {
+    // Time spent paused does not count towards decay
+    if (state->paused) {
+        state->last_hit_time = combo_clock_now();
+    }
     state->paused = false;
     if (state->interval_tracker.has_interval) {
         state->interval_tracker.is_running = true;
@@ -95,6 +212,7 @@ void combo_update(ComboState* state, float dt) {
 
         if (state->interval_tracker.current_time <= 0) {
             // Interval completed
+            combo_settle(state, combo_clock_now());
             state->score += 10;
             state->combo++;
 
@@ -124,16 +242,68 @@ void combo_handle_focus_change(ComboState* state, bool focused) {
     }
 }
 
-void combo_set_objectives(ComboState* state, Objective* objectives, uint32_t count) {
-    // Free existing objectives if any
+Objective* combo_objectives_alloc(ComboPool* pool, uint32_t count) {
+    if (count == 0) return NULL;
+    return pool ? combo_pool_alloc(pool, sizeof(Objective) * count) : malloc(sizeof(Objective) * count);
+}
+
+void combo_objectives_free(ComboPool* pool, Objective* objectives, uint32_t count) {
+    if (!objectives) return;
+    if (pool) {
+        combo_pool_free(pool, objectives, sizeof(Objective) * count);
+    } else {
+        free(objectives);
+    }
+}
+
+void combo_set_pool(ComboState* state, ComboPool* pool) {
+    if (state->pool == pool) return;
+
     if (state->objectives) {
-        free(state->objectives);
+        Objective* moved = combo_objectives_alloc(pool, state->objective_count);
+        if (moved) {
+            memcpy(moved, state->objectives, sizeof(Objective) * state->objective_count);
+        }
+        combo_objectives_free(state->pool, state->objectives, state->objective_count);
+        state->objectives = moved;
+        if (!moved) state->objective_count = 0;
     }
+
+    IntervalTracker* tracker = &state->interval_tracker;
+    Interval* intervals = tracker->intervals;
+    int interval_count = tracker->interval_count;
+    tracker->intervals = NULL;
+    tracker->interval_count = 0;
+    ComboPool* old_pool = tracker->pool;
+    tracker->pool = pool;
+    if (intervals) {
+        interval_tracker_set_intervals(tracker, intervals, interval_count);
+        if (old_pool) {
+            combo_pool_free(old_pool, intervals, sizeof(Interval) * (size_t)interval_count);
+        } else {
+            free(intervals);
+        }
+    }
+    state->pool = pool;
+}
+
+void combo_release(ComboState* state) {
+    combo_objectives_free(state->pool, state->objectives, state->objective_count);
+    state->objectives = NULL;
+    state->objective_count = 0;
+    state->active_objective_index = 0;
+    interval_tracker_clear(&state->interval_tracker);
+}
+
+void combo_set_objectives(ComboState* state, Objective* objectives, uint32_t count) {
+    // Free existing objectives if any
+    combo_objectives_free(state->pool, state->objectives, state->objective_count);
     
     // Allocate and copy new objectives
-    state->objectives = malloc(sizeof(Objective) * count);
-    state->objective_count = count;
+    state->objectives = combo_objectives_alloc(state->pool, count);
+    state->objective_count = state->objectives ? count : 0;
     state->active_objective_index = 0;
+    count = state->objective_count;
     
     for (uint32_t i = 0; i < count; i++) {
         strcpy(state->objectives[i].name, objectives[i].name);
@@ -150,57 +320,69 @@ void combo_switch_objective(ComboState* state, uint32_t index) {
     }
 }
 
-void combo_update_objective_progress(ComboState* state, uint32_t score_increment) {
-    if (state->objective_count == 0) return;
-    
-    Objective* current = &state->objectives[state->active_objective_index];
-    current->current_score += score_increment;
-    
-    if (current->current_score >= current->target_score) {
-        current->completed = true;
+void objectives_credit(Objective* objectives, uint32_t count, uint32_t amount) {
+    for (uint32_t i = 0; i < count; i++) {
+        Objective* objective = &objectives[i];
+        objective->current_score += amount;
+        if (objective->current_score >= objective->target_score) {
+            objective->completed = true;
+        }
     }
 }
 
+void combo_update_objective_progress(ComboState* state, uint32_t score_increment) {
+    state->objective_points += score_increment;
+    objectives_credit(state->objectives, state->objective_count, score_increment);
+}
+
 void combo_save_state(ComboState* state, const char* file) {
-    FILE* f = fopen(file, "wb");
-    if (!f) return;
-    
-    // Write basic state
-    fwrite(state, sizeof(ComboState), 1, f);
-    
-    // Write label
-    size_t label_len = strlen(state->label);
-    fwrite(&label_len, sizeof(size_t), 1, f);
-    fwrite(state->label, 1, label_len, f);
-    
-    // Write objectives
-    for (uint32_t i = 0; i < state->objective_count; i++) {
-        Objective* obj = &state->objectives[i];
-        
-        size_t name_len = strlen(obj->name);
-        size_t desc_len = strlen(obj->description);
-        
-        fwrite(&name_len, sizeof(size_t), 1, f);
-        fwrite(obj->name, 1, name_len, f);
-        
-        fwrite(&desc_len, sizeof(size_t), 1, f);
-        fwrite(obj->description, 1, desc_len, f);
-        
-        fwrite(&obj->target_score, sizeof(uint32_t), 1, f);
-        fwrite(&obj->current_score, sizeof(uint32_t), 1, f);
-        fwrite(&obj->completed, sizeof(bool), 1, f);
-    }
-    
-    fclose(f);
+    ByteWriter writer;
+    writer_init(&writer, 256);
+    combo_format_encode(&writer, state, 1, 0);
+    combo_format_write_file(file, &writer);
+    writer_free(&writer);
 }
 
-void combo_load_state(ComboState* state, const char* file) {
-    FILE* f = fopen(file, "rb");
-    if (!f) return;
-    
+// IntervalTracker layout used by pre-versioned files (whole seconds)
+typedef struct {
+    bool has_interval;
+    bool is_running;
+    bool interval_active;
+    int current_time;
+    int current_rep;
+    Interval current_interval;
+    Interval* intervals;
+    int interval_count;
+    int current_interval_index;
+} LegacyIntervalTracker;
+
+// ComboState layout used by pre-versioned single tracker files
+typedef struct {
+    char label[MAX_LABEL_LENGTH];
+    int score;
+    int combo;
+    int max_combo;
+    bool paused;
+    bool has_objective;
+    int objective;
+    int completed_intervals;
+    float multiplier;
+    float decay_pause;
+    uint32_t total_hits;
+    uint32_t perfect_hits;
+    uint32_t miss_hits;
+    Objective* objectives;
+    uint32_t objective_count;
+    uint32_t active_objective_index;
+    LegacyIntervalTracker interval_tracker;
+} LegacyComboState;
+
+// Pre-versioned single tracker files: raw ComboState dump followed by
+// size_t-prefixed strings
+static void load_state_legacy(ComboState* state, FILE* f) {
     // Read basic state
-    ComboState temp;
-    if (fread(&temp, sizeof(ComboState), 1, f) != 1) {
+    LegacyComboState temp;
+    if (fread(&temp, sizeof(LegacyComboState), 1, f) != 1) {
         fclose(f);
         return;
     }
@@ -221,16 +403,40 @@ void combo_load_state(ComboState* state, const char* file) {
     label[label_len] = '\0';
     
     // Free existing state
-    if (state->objectives) {
-        free(state->objectives);
-    }
+    combo_objectives_free(state->pool, state->objectives, state->objective_count);
+    state->objectives = NULL;
+    interval_tracker_clear(&state->interval_tracker);
     
     // Copy new state
-    *state = temp;
+    state->score = temp.score;
+    state->combo = temp.combo;
+    state->max_combo = temp.max_combo;
+    state->paused = temp.paused;
+    state->has_objective = temp.has_objective;
+    state->objective = temp.objective;
+    state->completed_intervals = temp.completed_intervals;
+    state->multiplier = temp.multiplier;
+    state->decay_pause = temp.decay_pause;
+    state->last_hit_time = combo_clock_now();
+    state->total_hits = temp.total_hits;
+    state->perfect_hits = temp.perfect_hits;
+    state->miss_hits = temp.miss_hits;
+    state->objective_count = temp.objective_count;
+    state->active_objective_index = temp.active_objective_index;
+    state->interval_tracker.has_interval = temp.interval_tracker.has_interval;
+    state->interval_tracker.is_running = temp.interval_tracker.is_running;
+    state->interval_tracker.interval_active = temp.interval_tracker.interval_active;
+    state->interval_tracker.current_time = (float)temp.interval_tracker.current_time;
+    state->interval_tracker.current_rep = temp.interval_tracker.current_rep;
+    state->interval_tracker.current_interval = temp.interval_tracker.current_interval;
+    state->interval_tracker.intervals = NULL;
+    state->interval_tracker.interval_count = 0;
+    state->interval_tracker.current_interval_index = temp.interval_tracker.current_interval_index;
     strcpy(state->label, label);
     free(label);
     
-    state->objectives = malloc(sizeof(Objective) * state->objective_count);
+    state->objectives = combo_objectives_alloc(state->pool, state->objective_count);
+    if (!state->objectives) state->objective_count = 0;
     
     // Read objectives
     for (uint32_t i = 0; i < state->objective_count; i++) {
@@ -261,12 +467,37 @@ void combo_load_state(ComboState* state, const char* file) {
     fclose(f);
 }
 
+void combo_load_state(ComboState* state, const char* file) {
+    size_t size = 0;
+    uint8_t* data = combo_format_read_file(file, &size);
+    if (!data) return;
+    
+    if (!combo_format_is_current(data, size)) {
+        free(data);
+        FILE* f = fopen(file, "rb");
+        if (f) load_state_legacy(state, f);
+        return;
+    }
+    
+    ComboState loaded;
+    if (combo_format_decode(data, size, &loaded, 1, NULL, state->pool) == 1) {
+        combo_release(state);
+        *state = loaded;
+    }
+    free(data);
+}
+
 void interval_tracker_init(IntervalTracker* tracker) {
     tracker->has_interval = false;
     tracker->is_running = false;
+    tracker->interval_active = false;
     tracker->current_time = 0;
     tracker->current_rep = 0;
     memset(&tracker->current_interval, 0, sizeof(Interval));
+    tracker->intervals = NULL;
+    tracker->interval_count = 0;
+    tracker->current_interval_index = 0;
+    tracker->pool = NULL;
 }
 
 void interval_tracker_add(IntervalTracker* tracker, const char* label, int duration, int reps) {
@@ -310,13 +541,40 @@ void interval_tracker_update(IntervalTracker* tracker, float dt) {
 }
 
 void interval_tracker_clear(IntervalTracker* tracker) {
+    ComboPool* pool = tracker->pool;
     if (tracker->intervals) {
-        for (uint32_t i = 0; i < tracker->interval_count; i++) {
-            free(tracker->intervals[i].label);
+        // Labels are inline, so the array is the only allocation
+        if (pool) {
+            combo_pool_free(pool, tracker->intervals, sizeof(Interval) * (size_t)tracker->interval_count);
+        } else {
+            free(tracker->intervals);
         }
-        free(tracker->intervals);
     }
     interval_tracker_init(tracker);
+    tracker->pool = pool;
+}
+
+bool interval_tracker_set_intervals(IntervalTracker* tracker, const Interval* intervals, int count) {
+    Interval* fresh = NULL;
+    if (count > 0) {
+        size_t size = sizeof(Interval) * (size_t)count;
+        fresh = tracker->pool ? combo_pool_alloc(tracker->pool, size) : malloc(size);
+        if (!fresh) return false;
+        memcpy(fresh, intervals, size);
+    }
+
+    if (tracker->intervals) {
+        if (tracker->pool) {
+            combo_pool_free(tracker->pool, tracker->intervals, sizeof(Interval) * (size_t)tracker->interval_count);
+        } else {
+            free(tracker->intervals);
+        }
+    }
+    tracker->intervals = fresh;
+    tracker->interval_count = count > 0 ? count : 0;
+    tracker->current_interval_index = 0;
+    tracker->interval_active = false;
+    return true;
 }
 
 void objective_init(Objective* objective, const char* name, const char* description, int target_score) {
@@ -336,78 +594,47 @@ void objective_update(Objective* objective, int score) {
 
 // Multi-tracker save/load functions
 void combo_save_all_trackers(ComboState* trackers, int tracker_count, const char* file) {
-    FILE* f = fopen(file, "wb");
-    if (!f) return;
+    combo_save_snapshot(trackers, tracker_count, file, 0);
+}
+
+bool combo_save_snapshot(ComboState* trackers, int tracker_count, const char* file, uint32_t generation) {
+    // Encode everything into memory, then a single write
+    ByteWriter writer;
+    writer_init(&writer, 64 + (size_t)(tracker_count > 0 ? tracker_count : 0) * 128);
+    combo_format_encode(&writer, trackers, tracker_count, generation);
+    bool ok = combo_format_write_file(file, &writer);
+    writer_free(&writer);
+    return ok;
+}
+
+uint32_t combo_read_snapshot_generation(const char* file) {
+    FILE* f = fopen(file, "rb");
+    if (!f) return 0;
     
-    // Write tracker count
-    fwrite(&tracker_count, sizeof(int), 1, f);
+    uint32_t generation = 0;
+    uint8_t header[COMBO_FORMAT_HEADER_MAX];
+    size_t header_size = fread(header, 1, sizeof(header), f);
     
-    // Write each tracker
-    for (int i = 0; i < tracker_count; i++) {
-        ComboState* state = &trackers[i];
-        
-        // Write basic state (excluding pointers)
-        fwrite(&state->score, sizeof(int), 1, f);
-        fwrite(&state->combo, sizeof(int), 1, f);
-        fwrite(&state->max_combo, sizeof(int), 1, f);
-        fwrite(&state->paused, sizeof(bool), 1, f);
-        fwrite(&state->has_objective, sizeof(bool), 1, f);
-        fwrite(&state->objective, sizeof(int), 1, f);
-        fwrite(&state->completed_intervals, sizeof(int), 1, f);
-        fwrite(&state->multiplier, sizeof(float), 1, f);
-        fwrite(&state->decay_pause, sizeof(float), 1, f);
-        fwrite(&state->total_hits, sizeof(uint32_t), 1, f);
-        fwrite(&state->perfect_hits, sizeof(uint32_t), 1, f);
-        fwrite(&state->miss_hits, sizeof(uint32_t), 1, f);
-        fwrite(&state->objective_count, sizeof(uint32_t), 1, f);
-        fwrite(&state->active_objective_index, sizeof(uint32_t), 1, f);
-        
-        // Write label
-        size_t label_len = strlen(state->label);
-        fwrite(&label_len, sizeof(size_t), 1, f);
-        fwrite(state->label, 1, label_len, f);
-        
-        // Write objectives
-        for (uint32_t j = 0; j < state->objective_count; j++) {
-            Objective* obj = &state->objectives[j];
-            
-            size_t name_len = strlen(obj->name);
-            size_t desc_len = strlen(obj->description);
-            
-            fwrite(&name_len, sizeof(size_t), 1, f);
-            fwrite(obj->name, 1, name_len, f);
-            
-            fwrite(&desc_len, sizeof(size_t), 1, f);
-            fwrite(obj->description, 1, desc_len, f);
-            
-            fwrite(&obj->target_score, sizeof(int), 1, f);
-            fwrite(&obj->current_score, sizeof(int), 1, f);
-            fwrite(&obj->completed, sizeof(bool), 1, f);
+    if (combo_format_is_current(header, header_size)) {
+        combo_format_read_generation(header, header_size, &generation);
+    } else {
+        // Legacy files keep the generation in a trailer
+        uint32_t trailer[2] = {0, 0};
+        if (fseek(f, -(long)sizeof(trailer), SEEK_END) == 0 &&
+            fread(trailer, sizeof(uint32_t), 2, f) == 2 &&
+            trailer[0] == COMBO_SNAPSHOT_TRAILER_MAGIC) {
+            generation = trailer[1];
         }
-        
-        // Write interval tracker
-        fwrite(&state->interval_tracker.has_interval, sizeof(bool), 1, f);
-        fwrite(&state->interval_tracker.is_running, sizeof(bool), 1, f);
-        fwrite(&state->interval_tracker.interval_active, sizeof(bool), 1, f);
-        fwrite(&state->interval_tracker.current_time, sizeof(int), 1, f);
-        fwrite(&state->interval_tracker.current_rep, sizeof(int), 1, f);
-        fwrite(&state->interval_tracker.interval_count, sizeof(int), 1, f);
-        fwrite(&state->interval_tracker.current_interval_index, sizeof(int), 1, f);
-        
-        // Write current interval
-        size_t interval_label_len = strlen(state->interval_tracker.current_interval.label);
-        fwrite(&interval_label_len, sizeof(size_t), 1, f);
-        fwrite(state->interval_tracker.current_interval.label, 1, interval_label_len, f);
-        fwrite(&state->interval_tracker.current_interval.duration, sizeof(int), 1, f);
-        fwrite(&state->interval_tracker.current_interval.reps, sizeof(int), 1, f);
     }
-    
     fclose(f);
+    
+    return generation;
 }
 
-int combo_load_all_trackers(ComboState* trackers, int max_trackers, const char* file) {
-    FILE* f = fopen(file, "rb");
-    if (!f) return 0;
+// Pre-versioned tracker files: per-field native-endian ints with size_t
+// string lengths, optionally followed by a generation trailer
+static int load_all_trackers_legacy(ComboState* trackers, int max_trackers, FILE* f, uint32_t* generation,
+                                    ComboPool* pool) {
     
     int tracker_count;
     if (fread(&tracker_count, sizeof(int), 1, f) != 1) {
@@ -421,11 +648,15 @@ int combo_load_all_trackers(ComboState* trackers, int max_trackers, const char*
     }
     
     // Load each tracker
+    *generation = 0;
     for (int i = 0; i < tracker_count; i++) {
         ComboState* state = &trackers[i];
         
         // Initialize the state first
         memset(state, 0, sizeof(ComboState));
+        state->last_hit_time = combo_clock_now();
+        state->pool = pool;
+        state->interval_tracker.pool = pool;
         
         // Read basic state
         if (fread(&state->score, sizeof(int), 1, f) != 1) break;
@@ -452,7 +683,11 @@ int combo_load_all_trackers(ComboState* trackers, int max_trackers, const char*
         
         // Allocate and read objectives
         if (state->objective_count > 0) {
-            state->objectives = malloc(sizeof(Objective) * state->objective_count);
+            state->objectives = combo_objectives_alloc(pool, state->objective_count);
+            if (!state->objectives) {
+                state->objective_count = 0;
+                break;
+            }
             for (uint32_t j = 0; j < state->objective_count; j++) {
                 Objective* obj = &state->objectives[j];
                 
@@ -483,7 +718,9 @@ int combo_load_all_trackers(ComboState* trackers, int max_trackers, const char*
         if (fread(&state->interval_tracker.has_interval, sizeof(bool), 1, f) != 1) break;
         if (fread(&state->interval_tracker.is_running, sizeof(bool), 1, f) != 1) break;
         if (fread(&state->interval_tracker.interval_active, sizeof(bool), 1, f) != 1) break;
-        if (fread(&state->interval_tracker.current_time, sizeof(int), 1, f) != 1) break;
+        int current_time;
+        if (fread(&current_time, sizeof(int), 1, f) != 1) break;
+        state->interval_tracker.current_time = (float)current_time;
         if (fread(&state->interval_tracker.current_rep, sizeof(int), 1, f) != 1) break;
         if (fread(&state->interval_tracker.interval_count, sizeof(int), 1, f) != 1) break;
         if (fread(&state->interval_tracker.current_interval_index, sizeof(int), 1, f) != 1) break;
@@ -496,10 +733,76 @@ int combo_load_all_trackers(ComboState* trackers, int max_trackers, const char*
         state->interval_tracker.current_interval.label[interval_label_len] = '\0';
         if (fread(&state->interval_tracker.current_interval.duration, sizeof(int), 1, f) != 1) break;
         if (fread(&state->interval_tracker.current_interval.reps, sizeof(int), 1, f) != 1) break;
+        
+        // The intervals array is not persisted
+        state->interval_tracker.interval_count = 0;
+        
+        if (i == tracker_count - 1) {
+            uint32_t trailer[2];
+            if (fread(trailer, sizeof(uint32_t), 2, f) == 2 && trailer[0] == COMBO_SNAPSHOT_TRAILER_MAGIC) {
+                *generation = trailer[1];
+            }
+        }
     }
     
     fclose(f);
     return tracker_count;
 }
 
+int combo_load_all_trackers(ComboState* trackers, int max_trackers, const char* file) {
+    return combo_load_all_trackers_pooled(trackers, max_trackers, file, NULL);
+}
+
+int combo_load_all_trackers_pooled(ComboState* trackers, int max_trackers, const char* file,
+                                   ComboPool* pool) {
+    if (max_trackers <= 0) return 0;
+    size_t size = 0;
+    uint8_t* data = combo_format_read_file(file, &size);
+    if (!data) return 0;
+    
+    // Decode into scratch trackers with malloc'd storage; the caller's
+    // trackers and pool are only touched once the whole file has loaded
+    ComboState* loaded = calloc((size_t)max_trackers, sizeof(ComboState));
+    if (!loaded) {
+        free(data);
+        return 0;
+    }
+    
+    int tracker_count = 0;
+    uint32_t generation = 0;
+    if (combo_format_is_current(data, size)) {
+        tracker_count = combo_format_decode(data, size, loaded, max_trackers, &generation, NULL);
+    } else {
+        FILE* f = fopen(file, "rb");
+        if (f) {
+            tracker_count = load_all_trackers_legacy(loaded, max_trackers, f, &generation, NULL);
+        }
+    }
+    free(data);
+    
+    if (tracker_count <= 0) {
+        for (int i = 0; i < max_trackers; i++) {
+            combo_release(&loaded[i]);
+        }
+        free(loaded);
+        return 0;
+    }
+    
+    // The previous trackers' storage goes in one step
+    if (pool) combo_pool_reset(pool);
+    for (int i = 0; i < tracker_count; i++) {
+        combo_set_pool(&loaded[i], pool);
+        trackers[i] = loaded[i];
+    }
+    free(loaded);
+    
+    // Recover hits recorded after this snapshot was written
+    int replayed = journal_replay(trackers, tracker_count, file, generation);
+    if (replayed > 0) {
+        printf("Recovered %d journaled events for %s\n", replayed, file);
+    }
+    
+    return tracker_count;
+}
+
 // Server sync functions will be implemented later when we add the networking code
\ No newline at end of file
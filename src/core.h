@@ -3,11 +3,21 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "combo_pool.h"
+#include "hit_stats.h"
 
 #define MAX_LABEL_LENGTH 64
 #define MAX_TRACKERS 8
 #define MAX_BREAK_ACTIVITIES 16
 
+// Constants for combo mechanics
+#define COMBO_DECAY_TIME 5.0f  // Time in seconds before combo starts decaying
+#define COMBO_DECAY_RATE 1.0f  // How many points lost per second
+#define BASE_MULTIPLIER 1.0f
+#define MULTIPLIER_INCREASE 0.1f
+#define MAX_MULTIPLIER 3.0f
+#define COMBO_DECAY_MAX_SPAN 1.0e6f  // Clamp on elapsed decay, keeps float->int in range
+
 typedef struct {
     char label[MAX_LABEL_LENGTH];
     int duration;
@@ -18,12 +28,13 @@ typedef struct {
     bool has_interval;
     bool is_running;
     bool interval_active;
-    int current_time;
+    float current_time;   // Seconds left in the current rep
     int current_rep;
     Interval current_interval;
     Interval* intervals;
     int interval_count;
     int current_interval_index;
+    ComboPool* pool;            // Owns `intervals` when set, else malloc
 } IntervalTracker;
 
 typedef struct {
@@ -61,16 +72,94 @@ typedef struct {
     int objective;
     int completed_intervals;
     float multiplier;
-    float decay_pause;
+    float decay_pause;          // Seconds left before decay, as of last_hit_time
+    double last_hit_time;       // combo_clock_now() when decay_pause was last set
     uint32_t total_hits;
     uint32_t perfect_hits;
     uint32_t miss_hits;
     Objective* objectives;
     uint32_t objective_count;
-    uint32_t active_objective_index;
+    uint32_t active_objective_index;  // The objective the UI shows progress for
+    uint32_t objective_points;  // Hit amounts credited to objectives; not persisted
     IntervalTracker interval_tracker;
+    ComboPool* pool;            // Owns `objectives` when set, else malloc
+    HitStats timing;            // Gaps between hits; not persisted
 } ComboState;
 
+// A timestamped input for combo_increment_batch
+typedef enum {
+    HIT_EVENT_HIT,
+    HIT_EVENT_MISS
+} HitEventType;
+
+typedef struct {
+    double time;                // Combo clock seconds
+    uint32_t amount;
+    uint8_t type;               // HitEventType
+} HitEvent;
+
+// Combo clock, in seconds. Decay is computed from timestamps on this clock
+// when a tracker is read or hit, rather than ticked every frame. Defaults to
+// CLOCK_MONOTONIC; pass NULL to combo_set_clock to restore the default.
+// The clock is per thread, so replays can each run on their own.
+typedef double (*ComboClock)(void);
+void combo_set_clock(ComboClock clock);
+double combo_clock_now(void);
+
+// Scoring parameters. Defaults are the constants above; tools that
+// evaluate alternatives (src/param_sweep.c) install their own with
+// combo_set_tuning, which like the clock is per thread. NULL restores
+// the defaults.
+typedef struct {
+    float decay_time;           // COMBO_DECAY_TIME
+    float decay_rate;           // COMBO_DECAY_RATE, must be > 0
+    float multiplier_increase;  // MULTIPLIER_INCREASE
+    float max_multiplier;       // MAX_MULTIPLIER
+} ComboTuning;
+
+#define COMBO_TUNING_DEFAULTS {COMBO_DECAY_TIME, COMBO_DECAY_RATE, MULTIPLIER_INCREASE, MAX_MULTIPLIER}
+
+void combo_set_tuning(const ComboTuning* tuning);
+const ComboTuning* combo_tuning(void);
+
+// Apply `elapsed` seconds of decay: nothing happens until decay_pause runs
+// out, then one combo point is lost per 1/decay_rate seconds, with the
+// remainder carried as a negative decay_pause. Returns the points lost.
+static inline int32_t combo_decay_step(const ComboTuning* tuning, int32_t* combo, float* decay_pause,
+                                       float elapsed) {
+    float pause = *decay_pause - elapsed;
+    float over = -pause;
+    if (over < 0.0f) over = 0.0f;
+    if (over > COMBO_DECAY_MAX_SPAN) over = COMBO_DECAY_MAX_SPAN;
+    int32_t lost = (int32_t)(over * tuning->decay_rate);
+
+    int32_t remaining = *combo - lost;
+    if (remaining <= 0) {
+        remaining = 0;
+        pause = 0.0f;
+    } else {
+        pause = pause + (float)lost * (1.0f / tuning->decay_rate);
+    }
+    *combo = remaining;
+    *decay_pause = pause;
+    return lost;
+}
+
+static inline float combo_multiplier_for(const ComboTuning* tuning, int32_t combo) {
+    float multiplier = BASE_MULTIPLIER + tuning->multiplier_increase * (float)combo;
+    return multiplier > tuning->max_multiplier ? tuning->max_multiplier : multiplier;
+}
+
+// Hit timing (HitStats) runs on the combo clock in wrapping milliseconds.
+// A hit resets decay_pause to decay_time, so that is the next hit's deadline.
+static inline uint32_t combo_time_ms(double seconds) {
+    return (uint32_t)(uint64_t)(seconds * 1000.0);
+}
+
+static inline uint32_t combo_deadline_ms(const ComboTuning* tuning) {
+    return (uint32_t)(tuning->decay_time * 1000.0f);
+}
+
 // Core combo functions
 void combo_init(ComboState* state, const char* label);
 void combo_pause(ComboState* state);
@@ -78,8 +167,24 @@ void combo_resume(ComboState* state);
 void combo_update(ComboState* state, float dt);
 void combo_increment(ComboState* state, uint32_t amount);
 void combo_decrement(ComboState* state, uint32_t amount);
+
+// Apply events in order. The result is identical to calling combo_increment
+// or combo_decrement for each event with the clock at event.time, but the
+// tracker is only loaded and stored once and objective progress is applied
+// once per batch.
+void combo_increment_batch(ComboState* state, const HitEvent* events, uint32_t count);
+// Credit a hit's amount to every objective, not only the active one, and
+// add it to objective_points. Objectives complete once current_score
+// reaches target_score.
 void combo_update_objective_progress(ComboState* state, uint32_t score_increment);
 
+// Fold decay up to `now` into combo, multiplier and decay_pause.
+// Paused trackers do not decay. combo_peek returns the same values
+// without modifying the tracker.
+void combo_settle(ComboState* state, double now);
+void combo_peek(const ComboState* state, double now, int32_t* combo, float* multiplier,
+                float* decay_pause);
+
 // Interval tracker functions
 void interval_tracker_init(IntervalTracker* tracker);
 void interval_tracker_add(IntervalTracker* tracker, const char* label, int duration, int reps);
@@ -88,11 +193,23 @@ void interval_tracker_stop(IntervalTracker* tracker);
 void interval_tracker_reset(IntervalTracker* tracker);
 void interval_tracker_update(IntervalTracker* tracker, float dt);
 void interval_tracker_clear(IntervalTracker* tracker);
+// Replace the intervals array (allocated from tracker->pool)
+bool interval_tracker_set_intervals(IntervalTracker* tracker, const Interval* intervals, int count);
 
 // Objective functions
 void objective_init(Objective* objective, const char* name, const char* description, int target_score);
 void objective_update(Objective* objective, int score);
 void combo_set_objectives(ComboState* state, Objective* objectives, uint32_t count);
+void objectives_credit(Objective* objectives, uint32_t count, uint32_t amount);
+
+// Objective and interval storage. With a NULL pool these are malloc/free;
+// with a pool, storage comes from its slabs and is dropped in bulk by
+// combo_pool_reset. combo_set_pool moves existing storage into the pool.
+Objective* combo_objectives_alloc(ComboPool* pool, uint32_t count);
+void combo_objectives_free(ComboPool* pool, Objective* objectives, uint32_t count);
+void combo_set_pool(ComboState* state, ComboPool* pool);
+// Free a tracker's objectives and intervals through their owner
+void combo_release(ComboState* state);
 void combo_switch_objective(ComboState* state, uint32_t index);
 
 // Break activity functions
@@ -107,5 +224,18 @@ void combo_load_state(ComboState* state, const char* file);
 // Multi-tracker save/load functions
 void combo_save_all_trackers(ComboState* trackers, int tracker_count, const char* file);
 int combo_load_all_trackers(ComboState* trackers, int max_trackers, const char* file);
+// Reload into storage owned by `pool`. Once the file has decoded, the
+// pool is reset, which releases the previous trackers' objectives in one
+// step. On a missing, corrupt or truncated file 0 is returned and the
+// trackers and pool are left as they were.
+int combo_load_all_trackers_pooled(ComboState* trackers, int max_trackers, const char* file,
+                                   ComboPool* pool);
+
+// Snapshots written by the persistence worker carry a generation trailer
+// that ties them to the hit journal (see journal.h). Generation 0 = no journal.
+// combo_save_snapshot returns false if the file was not completely written.
+#define COMBO_SNAPSHOT_TRAILER_MAGIC 0x50534E43u  // "CNSP"
+bool combo_save_snapshot(ComboState* trackers, int tracker_count, const char* file, uint32_t generation);
+uint32_t combo_read_snapshot_generation(const char* file);
 
 #endif // CORE_H
@@ -0,0 +1,102 @@
+#define _POSIX_C_SOURCE 200809L
+#include "hit_queue.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool hit_queue_init(HitQueue* queue, uint32_t capacity) {
+    memset(queue, 0, sizeof(*queue));
+    uint64_t size = 2;
+    while (size < capacity) size <<= 1;
+
+    void* slots = NULL;
+    if (posix_memalign(&slots, HIT_QUEUE_CACHE_LINE, sizeof(HitQueueSlot) * size) != 0) {
+        return false;
+    }
+    queue->slots = slots;
+    queue->mask = size - 1;
+
+    // A slot is free for ticket t when its sequence equals t
+    for (uint64_t i = 0; i < size; i++) {
+        queue->slots[i].sequence = i;
+    }
+    return true;
+}
+
+void hit_queue_free(HitQueue* queue) {
+    free(queue->slots);
+    memset(queue, 0, sizeof(*queue));
+}
+
+bool hit_queue_push(HitQueue* queue, uint32_t tracker, const HitEvent* event) {
+    uint64_t tail = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+    for (;;) {
+        HitQueueSlot* slot = &queue->slots[tail & queue->mask];
+        uint64_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(sequence - tail);
+
+        if (diff == 0) {
+            // Slot is free for this ticket; claim it
+            if (__atomic_compare_exchange_n(&queue->tail, &tail, tail + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                slot->hit.tracker = tracker;
+                slot->hit.event = *event;
+                __atomic_store_n(&slot->sequence, tail + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+            // Lost the race; tail was reloaded by the failed CAS
+        } else if (diff < 0) {
+            // The consumer hasn't freed this slot yet: full
+            __atomic_fetch_add(&queue->dropped, 1, __ATOMIC_RELAXED);
+            return false;
+        } else {
+            tail = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+uint32_t hit_queue_pop(HitQueue* queue, QueuedHit* out, uint32_t max) {
+    uint64_t head = queue->head;
+    uint32_t popped = 0;
+    while (popped < max) {
+        HitQueueSlot* slot = &queue->slots[head & queue->mask];
+        uint64_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        // Not yet published: either empty or a producer is mid-write.
+        // Stop here so hits are consumed in ticket order.
+        if (sequence != head + 1) break;
+
+        out[popped++] = slot->hit;
+        // Hand the slot back to producers one lap ahead
+        __atomic_store_n(&slot->sequence, head + queue->mask + 1, __ATOMIC_RELEASE);
+        head++;
+    }
+    __atomic_store_n(&queue->head, head, __ATOMIC_RELAXED);
+    return popped;
+}
+
+uint32_t hit_queue_drain(HitQueue* queue, ComboStateTable* table) {
+    QueuedHit hits[HIT_QUEUE_DRAIN_CHUNK];
+    HitEvent events[HIT_QUEUE_DRAIN_CHUNK];
+    uint32_t total = 0;
+
+    uint32_t popped;
+    while ((popped = hit_queue_pop(queue, hits, HIT_QUEUE_DRAIN_CHUNK)) > 0) {
+        total += popped;
+        uint32_t run_start = 0;
+        while (run_start < popped) {
+            uint32_t tracker = hits[run_start].tracker;
+            uint32_t run_end = run_start;
+            while (run_end < popped && hits[run_end].tracker == tracker) {
+                events[run_end - run_start] = hits[run_end].event;
+                run_end++;
+            }
+            combo_table_increment_batch(table, tracker, events, run_end - run_start);
+            run_start = run_end;
+        }
+        if (popped < HIT_QUEUE_DRAIN_CHUNK) break;
+    }
+    return total;
+}
+
+uint64_t hit_queue_dropped(const HitQueue* queue) {
+    return __atomic_load_n(&queue->dropped, __ATOMIC_RELAXED);
+}
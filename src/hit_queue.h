@@ -0,0 +1,64 @@
+#ifndef HIT_QUEUE_H
+#define HIT_QUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "core.h"
+#include "combo_table.h"
+
+// Bounded multi-producer, single-consumer queue of timestamped hits.
+//
+// Input threads (keyboard hook, pedal reader, audio detector) push with
+// hit_queue_push; the simulation thread drains once per frame before
+// combo_update_all. Each slot carries a sequence number, so producers
+// claim a slot with one compare-and-swap on the tail and publish it with
+// a release store; the consumer never writes the tail. No locks.
+//
+// Hits are addressed by table index. Hits for an index that no longer
+// exists when the queue is drained are dropped.
+
+#define HIT_QUEUE_DEFAULT_CAPACITY 4096
+#define HIT_QUEUE_DRAIN_CHUNK 256
+#define HIT_QUEUE_CACHE_LINE 64
+
+typedef struct {
+    uint32_t tracker;
+    HitEvent event;
+} QueuedHit;
+
+typedef struct {
+    uint64_t sequence;
+    QueuedHit hit;
+} HitQueueSlot;
+
+typedef struct {
+    HitQueueSlot* slots;
+    uint64_t mask;
+
+    // Producer and consumer cursors on separate cache lines
+    uint8_t pad0[HIT_QUEUE_CACHE_LINE];
+    uint64_t tail;
+    uint64_t dropped;   // Pushes rejected because the ring was full
+    uint8_t pad1[HIT_QUEUE_CACHE_LINE - 2 * sizeof(uint64_t)];
+    uint64_t head;
+    uint8_t pad2[HIT_QUEUE_CACHE_LINE - sizeof(uint64_t)];
+} HitQueue;
+
+// Capacity is rounded up to a power of two
+bool hit_queue_init(HitQueue* queue, uint32_t capacity);
+void hit_queue_free(HitQueue* queue);
+
+// Safe from any thread. Returns false (and counts a drop) when full.
+bool hit_queue_push(HitQueue* queue, uint32_t tracker, const HitEvent* event);
+
+// Consumer thread only. Pops up to max hits in enqueue order.
+uint32_t hit_queue_pop(HitQueue* queue, QueuedHit* out, uint32_t max);
+
+// Consumer thread only. Pops everything currently queued and applies it
+// to the table, batching consecutive hits for the same tracker.
+// Returns the number of hits popped.
+uint32_t hit_queue_drain(HitQueue* queue, ComboStateTable* table);
+
+uint64_t hit_queue_dropped(const HitQueue* queue);
+
+#endif // HIT_QUEUE_H
@@ -0,0 +1,110 @@
+#include "hit_stats.h"
+#include <string.h>
+#include <math.h>
+
+static uint32_t bucket_of(uint32_t gap_ms) {
+    if (gap_ms < HIT_STATS_SUB_BUCKETS) return gap_ms;
+    uint32_t octave = 31u - (uint32_t)__builtin_clz(gap_ms);     // >= 3
+    uint32_t sub = (gap_ms >> (octave - 3)) - HIT_STATS_SUB_BUCKETS;
+    return HIT_STATS_SUB_BUCKETS + (octave - 3) * HIT_STATS_SUB_BUCKETS + sub;
+}
+
+// Midpoint of the gaps that land in a bucket
+static float bucket_value(uint32_t bucket) {
+    if (bucket < HIT_STATS_SUB_BUCKETS) return (float)bucket;
+    uint32_t octave = (bucket - HIT_STATS_SUB_BUCKETS) / HIT_STATS_SUB_BUCKETS + 3;
+    uint32_t sub = (bucket - HIT_STATS_SUB_BUCKETS) % HIT_STATS_SUB_BUCKETS;
+    uint32_t width = 1u << (octave - 3);
+    uint32_t low = (HIT_STATS_SUB_BUCKETS + sub) * width;
+    return (float)low + (float)(width - 1) * 0.5f;
+}
+
+void hit_stats_init(HitStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+}
+
+void hit_stats_break(HitStats* stats) {
+    stats->has_last_hit = false;
+}
+
+static void halve_buckets(HitStats* stats) {
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < HIT_STATS_BUCKETS; i++) {
+        stats->buckets[i] >>= 1;
+        total += stats->buckets[i];
+    }
+    stats->sketch_total = total;
+}
+
+void hit_stats_record(HitStats* stats, uint32_t now_ms, uint32_t deadline_ms) {
+    bool had_last = stats->has_last_hit;
+    uint32_t gap_ms = now_ms - stats->last_hit_ms;    // Wraps correctly
+    stats->last_hit_ms = now_ms;
+    stats->has_last_hit = true;
+    if (!had_last || gap_ms > HIT_STATS_MAX_GAP_MS) return;
+
+    stats->gaps++;
+    float x = (float)gap_ms;
+    float delta = x - stats->mean_ms;
+    stats->mean_ms += delta / (float)stats->gaps;
+    stats->m2 += delta * (x - stats->mean_ms);
+    if (stats->gaps == 1 || gap_ms < stats->min_ms) stats->min_ms = (uint16_t)gap_ms;
+    if (gap_ms > stats->max_ms) stats->max_ms = (uint16_t)gap_ms;
+
+    if (deadline_ms > 0) {
+        if (gap_ms > deadline_ms) {
+            stats->late++;
+        } else if ((uint64_t)gap_ms * 100 >= (uint64_t)deadline_ms * (100 - HIT_STATS_NEAR_DEADLINE_PERCENT)) {
+            stats->near_deadline++;
+        }
+    }
+
+    uint32_t bucket = bucket_of(gap_ms);
+    if (stats->buckets[bucket] == UINT16_MAX) halve_buckets(stats);
+    stats->buckets[bucket]++;
+    stats->sketch_total++;
+}
+
+float hit_stats_mean(const HitStats* stats) {
+    return stats->gaps > 0 ? stats->mean_ms : 0.0f;
+}
+
+float hit_stats_stddev(const HitStats* stats) {
+    if (stats->gaps < 2) return 0.0f;
+    return sqrtf(stats->m2 / (float)(stats->gaps - 1));
+}
+
+float hit_stats_quantile(const HitStats* stats, float q) {
+    if (stats->sketch_total == 0) return 0.0f;
+    if (q <= 0.0f) return (float)stats->min_ms;
+    if (q >= 1.0f) return (float)stats->max_ms;
+
+    // Smallest bucket holding the ceil(q * n)th gap
+    uint32_t rank = (uint32_t)ceilf(q * (float)stats->sketch_total);
+    if (rank == 0) rank = 1;
+    uint32_t seen = 0;
+    for (uint32_t i = 0; i < HIT_STATS_BUCKETS; i++) {
+        seen += stats->buckets[i];
+        if (seen >= rank) {
+            float value = bucket_value(i);
+            if (value < (float)stats->min_ms) value = (float)stats->min_ms;
+            if (value > (float)stats->max_ms) value = (float)stats->max_ms;
+            return value;
+        }
+    }
+    return (float)stats->max_ms;
+}
+
+void hit_stats_summary(const HitStats* stats, HitTimingSummary* summary) {
+    memset(summary, 0, sizeof(*summary));
+    summary->gaps = stats->gaps;
+    if (stats->gaps == 0) return;
+    summary->mean_ms = hit_stats_mean(stats);
+    summary->stddev_ms = hit_stats_stddev(stats);
+    summary->min_ms = (float)stats->min_ms;
+    summary->p50_ms = hit_stats_quantile(stats, 0.5f);
+    summary->p95_ms = hit_stats_quantile(stats, 0.95f);
+    summary->max_ms = (float)stats->max_ms;
+    summary->near_deadline_fraction = (float)stats->near_deadline / (float)stats->gaps;
+    summary->late_fraction = (float)stats->late / (float)stats->gaps;
+}
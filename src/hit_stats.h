@@ -0,0 +1,73 @@
+#ifndef HIT_STATS_H
+#define HIT_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Rhythm statistics for one tracker or counter: the distribution of the
+// gaps between consecutive hits, in milliseconds.
+//
+// Fixed memory and O(1) per hit, so it can live in every ComboState and
+// every embedded Counter. Mean and variance are kept exactly (Welford);
+// quantiles come from a log-linear histogram in the style of
+// HdrHistogram: exact below 8 ms, then 8 buckets per power of two, so a
+// reported quantile is within 6.25% of the true gap. When a bucket would
+// overflow, every bucket is halved, which keeps the shape and lets old
+// sessions fade slowly instead of saturating.
+//
+// Each hit also says how long it was allowed to take: gaps in the last
+// HIT_STATS_NEAR_DEADLINE_PERCENT of that window count as near the
+// deadline, gaps past it as late.
+//
+// Kept free of core.h so the embedded Counter can embed it.
+
+#define HIT_STATS_SUB_BUCKETS 8
+#define HIT_STATS_MAX_GAP_MS 65535u     // Longer gaps start a new run
+#define HIT_STATS_BUCKETS (HIT_STATS_SUB_BUCKETS * 14)
+#define HIT_STATS_NEAR_DEADLINE_PERCENT 20
+
+typedef struct {
+    uint32_t last_hit_ms;
+    bool has_last_hit;          // False until the first hit and after a break
+    uint32_t gaps;              // Gaps recorded
+    float mean_ms;              // Welford running mean
+    float m2;                   // Welford sum of squared deviations
+    uint16_t min_ms;
+    uint16_t max_ms;
+    uint32_t near_deadline;     // Gaps in the last stretch before the deadline
+    uint32_t late;              // Gaps past the deadline
+    uint32_t sketch_total;      // Sum of buckets (less than gaps after halving)
+    uint16_t buckets[HIT_STATS_BUCKETS];
+} HitStats;
+
+// What the stats screens show
+typedef struct {
+    uint32_t gaps;
+    float mean_ms;
+    float stddev_ms;
+    float min_ms;
+    float p50_ms;
+    float p95_ms;
+    float max_ms;
+    float near_deadline_fraction;
+    float late_fraction;
+} HitTimingSummary;
+
+void hit_stats_init(HitStats* stats);
+
+// A hit at `now_ms` on a wrapping millisecond clock. `deadline_ms` is how
+// long after the previous hit this one had to land before the combo
+// started decaying; 0 when nothing decays.
+void hit_stats_record(HitStats* stats, uint32_t now_ms, uint32_t deadline_ms);
+
+// Forget the previous hit, e.g. on pause, so the next gap isn't measured
+// across it
+void hit_stats_break(HitStats* stats);
+
+float hit_stats_mean(const HitStats* stats);
+float hit_stats_stddev(const HitStats* stats);
+// Gap at quantile q in [0, 1]; 0 when nothing has been recorded
+float hit_stats_quantile(const HitStats* stats, float q);
+void hit_stats_summary(const HitStats* stats, HitTimingSummary* summary);
+
+#endif // HIT_STATS_H
@@ -120,7 +120,7 @@ void handle_click(Clay_ElementId elementId, Clay_PointerData pointerData, intptr
         int tracker_index = atoi(id.chars + 18);
         if (tracker_index >= 0 && tracker_index < ui->tracker_count) {
             combo_increment(&ui->trackers[tracker_index], 1);
-            save_ui_state(ui);  // Save after increment
+            save_tracker_event(ui, tracker_index, JOURNAL_OP_HIT, 1);  // Save after increment
             printf("Incremented tracker %d\n", tracker_index);
         }
     }
@@ -128,21 +128,24 @@ void handle_click(Clay_ElementId elementId, Clay_PointerData pointerData, intptr
         int tracker_index = atoi(id.chars + 18);
         if (tracker_index >= 0 && tracker_index < ui->tracker_count) {
             combo_decrement(&ui->trackers[tracker_index], 1);
-            save_ui_state(ui);  // Save after decrement
+            save_tracker_event(ui, tracker_index, JOURNAL_OP_DECREMENT, 1);  // Save after decrement
             printf("Decremented tracker %d\n", tracker_index);
         }
     }
     else if (strncmp(id.chars, "tracker_pause_", 14) == 0) {
         int tracker_index = atoi(id.chars + 14);
         if (tracker_index >= 0 && tracker_index < ui->tracker_count) {
+            JournalOp op;
             if (ui->trackers[tracker_index].paused) {
                 combo_resume(&ui->trackers[tracker_index]);
+                op = JOURNAL_OP_RESUME;
                 printf("Resumed tracker %d\n", tracker_index);
             } else {
                 combo_pause(&ui->trackers[tracker_index]);
+                op = JOURNAL_OP_PAUSE;
                 printf("Paused tracker %d\n", tracker_index);
             }
-            save_ui_state(ui);  // Save after pause/resume
+            save_tracker_event(ui, tracker_index, op, 0);  // Save after pause/resume
         }
     }
 }
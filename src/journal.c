@@ -0,0 +1,207 @@
+#define _POSIX_C_SOURCE 200809L
+#include "journal.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define JOURNAL_REPLAY_BATCH 256
+
+// Version 1 record: the op alone, replayed without its time
+typedef struct {
+    uint16_t tracker;
+    uint8_t op;
+    uint8_t check;
+    uint32_t amount;
+} JournalRecordV1;
+
+static uint32_t float_bits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static uint8_t fold_check(uint32_t fold) {
+    fold ^= fold >> 16;
+    return (uint8_t)(fold ^ (fold >> 8));
+}
+
+static uint8_t record_check_v1(const JournalRecordV1* record) {
+    uint32_t fold = record->amount ^ (record->amount >> 16) ^
+                    ((uint32_t)record->tracker << 8) ^ record->op ^ 0xA5u;
+    return (uint8_t)(fold ^ (fold >> 8));
+}
+
+static uint8_t record_check(const JournalRecord* record) {
+    uint32_t fold = record->amount ^ ((uint32_t)record->tracker << 8) ^ record->op ^ 0xA5u;
+    fold ^= (uint32_t)record->score * 0x9E3779B1u;
+    fold ^= (uint32_t)record->combo * 0x85EBCA77u;
+    fold ^= float_bits(record->multiplier) * 0xC2B2AE3Du;
+    fold ^= float_bits(record->decay_pause) * 0x27D4EB2Fu;
+    return fold_check(fold);
+}
+
+void journal_path(char* out, size_t out_size, const char* snapshot_file) {
+    snprintf(out, out_size, "%s.journal", snapshot_file);
+}
+
+void journal_record_init(JournalRecord* record, int tracker, JournalOp op, uint32_t amount,
+                         const ComboState* state) {
+    memset(record, 0, sizeof(*record));
+    record->tracker = (uint16_t)tracker;
+    record->op = (uint8_t)op;
+    record->amount = amount;
+    record->score = state->score;
+    record->combo = state->combo;
+    record->multiplier = state->multiplier;
+    record->decay_pause = state->decay_pause;
+    record->check = record_check(record);
+}
+
+static void apply_op(ComboState* state, uint8_t op, uint32_t amount) {
+    switch (op) {
+        case JOURNAL_OP_HIT:
+            combo_increment(state, amount);
+            break;
+        case JOURNAL_OP_DECREMENT:
+            combo_decrement(state, amount);
+            break;
+        case JOURNAL_OP_PAUSE:
+            combo_pause(state);
+            break;
+        case JOURNAL_OP_RESUME:
+            combo_resume(state);
+            break;
+    }
+}
+
+void journal_apply(ComboState* trackers, int tracker_count, const JournalRecord* record) {
+    if (record->tracker >= tracker_count) return;
+
+    ComboState* state = &trackers[record->tracker];
+    int max_combo = state->max_combo;
+    apply_op(state, record->op, record->amount);
+
+    // Replayed back to back, hits would build a combo the user never had
+    state->score = record->score;
+    state->combo = record->combo;
+    state->max_combo = record->combo > max_combo ? record->combo : max_combo;
+    state->multiplier = record->multiplier;
+    state->decay_pause = record->decay_pause;
+    state->last_hit_time = combo_clock_now();
+}
+
+bool journal_reset(const char* snapshot_file, uint32_t generation) {
+    char path[JOURNAL_MAX_PATH];
+    journal_path(path, sizeof(path), snapshot_file);
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+
+    JournalHeader header = {
+        .magic = JOURNAL_MAGIC,
+        .version = JOURNAL_VERSION,
+        .reserved = 0,
+        .generation = generation
+    };
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    ok = (fflush(f) == 0) && ok;
+    fsync(fileno(f));
+    fclose(f);
+    return ok;
+}
+
+bool journal_append(const char* snapshot_file, const JournalRecord* records, int count) {
+    if (count <= 0) return true;
+
+    char path[JOURNAL_MAX_PATH];
+    journal_path(path, sizeof(path), snapshot_file);
+
+    FILE* f = fopen(path, "ab");
+    if (!f) return false;
+
+    // One write per batch of events instead of a full file rewrite
+    bool ok = fwrite(records, sizeof(JournalRecord), (size_t)count, f) == (size_t)count;
+    ok = (fflush(f) == 0) && ok;
+    fsync(fileno(f));
+    fclose(f);
+    return ok;
+}
+
+static bool read_header(FILE* f, JournalHeader* header) {
+    if (fread(header, sizeof(*header), 1, f) != 1) return false;
+    return header->magic == JOURNAL_MAGIC && header->version >= 1 &&
+           header->version <= JOURNAL_VERSION;
+}
+
+static int replay_v1(ComboState* trackers, int tracker_count, FILE* f) {
+    JournalRecordV1 batch[JOURNAL_REPLAY_BATCH];
+    int applied = 0;
+    size_t n;
+    while ((n = fread(batch, sizeof(JournalRecordV1), JOURNAL_REPLAY_BATCH, f)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            if (batch[i].check != record_check_v1(&batch[i])) {
+                printf("Journal: stopping replay at corrupt record %d\n", applied);
+                return applied;
+            }
+            if (batch[i].tracker < tracker_count) {
+                apply_op(&trackers[batch[i].tracker], batch[i].op, batch[i].amount);
+            }
+            applied++;
+        }
+    }
+    return applied;
+}
+
+uint32_t journal_read_generation(const char* snapshot_file) {
+    char path[JOURNAL_MAX_PATH];
+    journal_path(path, sizeof(path), snapshot_file);
+
+    FILE* f = fopen(path, "rb");
+    if (!f) return 0;
+
+    JournalHeader header;
+    uint32_t generation = read_header(f, &header) ? header.generation : 0;
+    fclose(f);
+    return generation;
+}
+
+int journal_replay(ComboState* trackers, int tracker_count, const char* snapshot_file,
+                   uint32_t snapshot_generation) {
+    if (snapshot_generation == 0) return 0;
+
+    char path[JOURNAL_MAX_PATH];
+    journal_path(path, sizeof(path), snapshot_file);
+
+    FILE* f = fopen(path, "rb");
+    if (!f) return 0;
+
+    JournalHeader header;
+    if (!read_header(f, &header) || header.generation != snapshot_generation) {
+        // Stale journal (e.g. crash between snapshot rename and journal reset)
+        fclose(f);
+        return 0;
+    }
+    if (header.version == 1) {
+        int applied = replay_v1(trackers, tracker_count, f);
+        fclose(f);
+        return applied;
+    }
+
+    JournalRecord batch[JOURNAL_REPLAY_BATCH];
+    int applied = 0;
+    size_t n;
+    while ((n = fread(batch, sizeof(JournalRecord), JOURNAL_REPLAY_BATCH, f)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            if (batch[i].check != record_check(&batch[i])) {
+                printf("Journal: stopping replay at corrupt record %d\n", applied);
+                fclose(f);
+                return applied;
+            }
+            journal_apply(trackers, tracker_count, &batch[i]);
+            applied++;
+        }
+    }
+
+    fclose(f);
+    return applied;
+}
@@ -0,0 +1,66 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "core.h"
+
+// Append-only hit journal stored next to the tracker snapshot
+// ("combo_trackers.dat" -> "combo_trackers.dat.journal").
+// Each event is one record; a snapshot with the same generation as the
+// journal header is the base the records are replayed onto. Records carry
+// the tracker's score and combo state right after the event, so replay
+// restores what the user saw instead of re-running hits without the time
+// that passed between them. Version 1 records held only the op and amount.
+
+#define JOURNAL_MAGIC 0x4C4E4A43u      // "CJNL"
+#define JOURNAL_VERSION 2
+#define JOURNAL_COMPACT_THRESHOLD 512  // Records before the journal is folded into a snapshot
+#define JOURNAL_MAX_PATH 264
+
+typedef enum {
+    JOURNAL_OP_HIT = 1,
+    JOURNAL_OP_DECREMENT = 2,
+    JOURNAL_OP_PAUSE = 3,
+    JOURNAL_OP_RESUME = 4
+} JournalOp;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t generation;
+} JournalHeader;
+
+typedef struct {
+    uint16_t tracker;
+    uint8_t op;
+    uint8_t check;      // Detects torn or garbage records at the tail
+    uint32_t amount;
+    int32_t score;      // Tracker state right after the event
+    int32_t combo;
+    float multiplier;
+    float decay_pause;
+} JournalRecord;
+
+void journal_path(char* out, size_t out_size, const char* snapshot_file);
+// `state` is the tracker after the event was applied to it
+void journal_record_init(JournalRecord* record, int tracker, JournalOp op, uint32_t amount,
+                         const ComboState* state);
+// Re-run the op for counters and objective progress, then restore the
+// recorded score and combo state. Decay restarts from the current time,
+// as it does for a loaded snapshot.
+void journal_apply(ComboState* trackers, int tracker_count, const JournalRecord* record);
+
+// Start an empty journal for a freshly written snapshot
+bool journal_reset(const char* snapshot_file, uint32_t generation);
+bool journal_append(const char* snapshot_file, const JournalRecord* records, int count);
+uint32_t journal_read_generation(const char* snapshot_file);
+
+// Replay records on top of a loaded snapshot. Returns the number applied;
+// records are skipped entirely if the journal belongs to another generation.
+int journal_replay(ComboState* trackers, int tracker_count, const char* snapshot_file,
+                   uint32_t snapshot_generation);
+
+#endif // JOURNAL_H
@@ -10,7 +10,12 @@
 #include "colors.h"
 #include "timer.h"
 #include "break_activities.h"
+#include "persistence.h"
+#include "combo_format.h"
+#include "session.h"
+#include "score_history.h"
 #include <string.h>
+#include <time.h>
 
 #define SCREEN_WIDTH 1280
 #define SCREEN_HEIGHT 720
@@ -63,6 +68,41 @@ int main(void) {
     
     // Load saved tracker state
     load_ui_state(&ui);
+
+    // Score history lives next to the tracker file
+    static ScoreHistoryStore history;
+    char history_file[SCORE_HISTORY_MAX_PATH];
+    score_history_path(history_file, sizeof(history_file), TRACKER_SAVE_FILE);
+    score_history_store_init(&history);
+    score_history_store_load(&history, history_file, ui.trackers, ui.tracker_count);
+    time_t last_history_save = time(NULL);
+
+    // Optional input recording for headless replay, starting from the loaded trackers
+    static SessionRecorder session;
+    const char* session_file = getenv("COMBO_SESSION_FILE");
+    if (session_file) {
+        // Settle and encode at one microsecond-exact time, the base time a
+        // replay decodes at, so live and replayed decay start identical
+        uint64_t base_time_us = (uint64_t)(combo_clock_now() * 1e6);
+        double base_time = (double)base_time_us / 1e6;
+        for (int i = 0; i < ui.tracker_count; i++) {
+            combo_settle(&ui.trackers[i], base_time);
+        }
+        ByteWriter base;
+        writer_init(&base, 1024);
+        combo_format_encode_at(&base, ui.trackers, ui.tracker_count, 0, base_time);
+        if (!base.failed &&
+            session_recorder_open(&session, session_file, SESSION_SOURCE_DESKTOP, base.data, (uint32_t)base.size,
+                                  base_time_us)) {
+            ui.session = &session;
+        } else {
+            printf("Failed to start session recording: %s\n", session_file);
+        }
+        writer_free(&base);
+    }
+
+    // Tracker saves happen on a background thread from here on
+    persistence_start(TRACKER_SAVE_FILE, PERSISTENCE_DEFAULT_DEBOUNCE_MS);
     
     // Set global UI context for widget access
     g_ui_context = &ui;
@@ -82,6 +122,9 @@ int main(void) {
         float dt = GetFrameTime();
         
         // Update trackers
+        if (ui.session) {
+            session_record_frame(ui.session, (uint64_t)(combo_clock_now() * 1e6), dt);
+        }
         for (int i = 0; i < ui.tracker_count; i++) {
             combo_update(&ui.trackers[i], dt);
         }
@@ -114,6 +157,9 @@ int main(void) {
             handle_input(&ui, KEY_BACKSPACE);
         }
 
+        // Objectives completed by this frame's input (or last frame's clicks)
+        handle_objective_events(&ui);
+
         // Global shortcuts
         if (IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL)) {
             if (IsKeyPressed(KEY_N)) {
@@ -133,6 +179,21 @@ int main(void) {
             }
         }
 
+        // Roll this frame's changes into the score history
+        time_t now = time(NULL);
+        score_history_store_observe(&history, (int64_t)now, ui.trackers, ui.tracker_count);
+        if (now - last_history_save >= SCORE_HISTORY_SAVE_INTERVAL) {
+            // Encoded here, written to disk by the persistence worker
+            ByteWriter encoded;
+            writer_init(&encoded, 4096);
+            if (score_history_store_encode(&history, &encoded) &&
+                !persistence_queue_write(history_file, &encoded)) {
+                combo_format_write_file(history_file, &encoded);
+            }
+            writer_free(&encoded);
+            last_history_save = now;
+        }
+
         // Handle mouse input
         Clay_Vector2 mousePos = { GetMouseX(), GetMouseY() };
         bool mousePressed = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
@@ -158,8 +219,17 @@ int main(void) {
         EndDrawing();
     }
     
-    // Save UI state before cleanup
+    // Save UI state before cleanup; stopping the worker flushes it to disk
     save_ui_state(&ui);
+    persistence_stop();
+    score_history_store_observe(&history, (int64_t)time(NULL), ui.trackers, ui.tracker_count);
+    score_history_store_save(&history, history_file);
+    score_history_store_free(&history);
+    objective_engine_free(&ui.objectives);
+    if (ui.session) {
+        session_recorder_close(ui.session);
+        ui.session = NULL;
+    }
     
     // Cleanup
     free(arena.memory);
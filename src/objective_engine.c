@@ -0,0 +1,236 @@
+#include "objective_engine.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    int32_t threshold;
+    uint32_t goal;
+} IndexEntry;
+
+static int compare_entries(const void* a, const void* b) {
+    const IndexEntry* x = a;
+    const IndexEntry* y = b;
+    if (x->threshold != y->threshold) return x->threshold < y->threshold ? -1 : 1;
+    return x->goal < y->goal ? -1 : (x->goal > y->goal);
+}
+
+bool objective_engine_init(ObjectiveEngine* engine, uint32_t tracker_count) {
+    memset(engine, 0, sizeof(*engine));
+    engine->indexes = calloc((size_t)tracker_count * OBJECTIVE_FIELD_COUNT, sizeof(ObjectiveIndex));
+    if (!engine->indexes && tracker_count > 0) return false;
+    engine->tracker_count = tracker_count;
+    return true;
+}
+
+void objective_engine_free(ObjectiveEngine* engine) {
+    for (uint32_t i = 0; i < engine->tracker_count * OBJECTIVE_FIELD_COUNT; i++) {
+        free(engine->indexes[i].thresholds);
+        free(engine->indexes[i].goals);
+    }
+    free(engine->indexes);
+    free(engine->goals);
+    free(engine->events);
+    memset(engine, 0, sizeof(*engine));
+}
+
+static ObjectiveIndex* index_for(ObjectiveEngine* engine, uint32_t tracker, uint32_t field) {
+    if (tracker >= engine->tracker_count || field >= OBJECTIVE_FIELD_COUNT) return NULL;
+    return &engine->indexes[tracker * OBJECTIVE_FIELD_COUNT + field];
+}
+
+int32_t objective_engine_add(ObjectiveEngine* engine, uint32_t tracker, ObjectiveField field,
+                             int32_t threshold, uint32_t user_id) {
+    ObjectiveIndex* index = index_for(engine, tracker, (uint32_t)field);
+    if (!index) return -1;
+
+    if (engine->goal_count == engine->goal_capacity) {
+        uint32_t capacity = engine->goal_capacity ? engine->goal_capacity * 2 : 64;
+        ObjectiveGoal* goals = realloc(engine->goals, capacity * sizeof(ObjectiveGoal));
+        if (!goals) return -1;
+        engine->goals = goals;
+        engine->goal_capacity = capacity;
+    }
+    if (index->count == index->capacity) {
+        uint32_t capacity = index->capacity ? index->capacity * 2 : 8;
+        int32_t* thresholds = realloc(index->thresholds, capacity * sizeof(int32_t));
+        if (!thresholds) return -1;
+        index->thresholds = thresholds;
+        uint32_t* goals = realloc(index->goals, capacity * sizeof(uint32_t));
+        if (!goals) return -1;
+        index->goals = goals;
+        index->capacity = capacity;
+    }
+
+    uint32_t id = engine->goal_count++;
+    ObjectiveGoal* goal = &engine->goals[id];
+    goal->tracker = tracker;
+    goal->user_id = user_id;
+    goal->threshold = threshold;
+    goal->field = (uint8_t)field;
+    goal->completed = false;
+
+    // Appended to the pending range; sorted before the next observation
+    index->thresholds[index->count] = threshold;
+    index->goals[index->count] = id;
+    index->count++;
+    index->unsorted = true;
+    return (int32_t)id;
+}
+
+uint32_t objective_engine_add_objectives(ObjectiveEngine* engine, uint32_t tracker,
+                                         const ComboState* state) {
+    uint32_t added = 0;
+    for (uint32_t i = 0; i < state->objective_count; i++) {
+        const Objective* objective = &state->objectives[i];
+        if (objective->completed) continue;
+        // Every pending objective is credited the same amounts, so each is
+        // due at a fixed objective_points value
+        int64_t threshold = (int64_t)state->objective_points + objective->target_score -
+                            objective->current_score;
+        if (threshold > INT32_MAX) threshold = INT32_MAX;
+        if (objective_engine_add(engine, tracker, OBJECTIVE_FIELD_PROGRESS, (int32_t)threshold, i) < 0) break;
+        added++;
+    }
+    return added;
+}
+
+void objective_engine_clear(ObjectiveEngine* engine) {
+    for (uint32_t i = 0; i < engine->tracker_count * OBJECTIVE_FIELD_COUNT; i++) {
+        engine->indexes[i].count = 0;
+        engine->indexes[i].next = 0;
+        engine->indexes[i].unsorted = false;
+    }
+    engine->goal_count = 0;
+    engine->event_head = 0;
+    engine->event_count = 0;
+}
+
+void objective_engine_rearm(ObjectiveEngine* engine, uint32_t tracker) {
+    for (uint32_t field = 0; field < OBJECTIVE_FIELD_COUNT; field++) {
+        ObjectiveIndex* index = index_for(engine, tracker, field);
+        if (!index) return;
+        for (uint32_t i = 0; i < index->next; i++) {
+            engine->goals[index->goals[i]].completed = false;
+        }
+        index->next = 0;
+        index->unsorted = index->count > 1;
+    }
+}
+
+static void index_sort_pending(ObjectiveIndex* index) {
+    index->unsorted = false;
+    uint32_t pending = index->count - index->next;
+    if (pending < 2) return;
+
+    IndexEntry* entries = malloc(pending * sizeof(IndexEntry));
+    if (!entries) {
+        index->unsorted = true;  // Retried on the next observation
+        return;
+    }
+    for (uint32_t i = 0; i < pending; i++) {
+        entries[i].threshold = index->thresholds[index->next + i];
+        entries[i].goal = index->goals[index->next + i];
+    }
+    qsort(entries, pending, sizeof(IndexEntry), compare_entries);
+    for (uint32_t i = 0; i < pending; i++) {
+        index->thresholds[index->next + i] = entries[i].threshold;
+        index->goals[index->next + i] = entries[i].goal;
+    }
+    free(entries);
+}
+
+static bool push_event(ObjectiveEngine* engine, const ObjectiveEvent* event) {
+    if (engine->event_count == engine->event_capacity) {
+        uint32_t capacity = engine->event_capacity ? engine->event_capacity * 2 : 32;
+        ObjectiveEvent* events = malloc(capacity * sizeof(ObjectiveEvent));
+        if (!events) return false;
+        for (uint32_t i = 0; i < engine->event_count; i++) {
+            events[i] = engine->events[(engine->event_head + i) % engine->event_capacity];
+        }
+        free(engine->events);
+        engine->events = events;
+        engine->event_capacity = capacity;
+        engine->event_head = 0;
+    }
+    uint32_t tail = (engine->event_head + engine->event_count) % engine->event_capacity;
+    engine->events[tail] = *event;
+    engine->event_count++;
+    return true;
+}
+
+uint32_t objective_engine_observe(ObjectiveEngine* engine, uint32_t tracker, ObjectiveField field,
+                                  int32_t value) {
+    ObjectiveIndex* index = index_for(engine, tracker, (uint32_t)field);
+    if (!index) return 0;
+    if (index->unsorted) index_sort_pending(index);
+
+    // Common case: the lowest pending threshold is still out of reach
+    engine->probes++;
+    if (index->next == index->count || index->thresholds[index->next] > value) return 0;
+
+    // First pending threshold above value
+    uint32_t low = index->next + 1;
+    uint32_t high = index->count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        engine->probes++;
+        if (index->thresholds[mid] <= value) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    uint32_t completed = 0;
+    for (uint32_t i = index->next; i < low; i++) {
+        ObjectiveGoal* goal = &engine->goals[index->goals[i]];
+        ObjectiveEvent event = {index->goals[i], tracker, goal->user_id, goal->threshold, value, goal->field};
+        if (!push_event(engine, &event)) break;  // Stays pending, fires next time
+        goal->completed = true;
+        completed++;
+    }
+    index->next += completed;
+    return completed;
+}
+
+static uint32_t observe_fields(ObjectiveEngine* engine, uint32_t tracker, int32_t score,
+                               int32_t max_combo, uint32_t total_hits, uint32_t perfect_hits,
+                               uint32_t miss_hits, uint32_t objective_points) {
+    uint32_t completed = 0;
+    completed += objective_engine_observe(engine, tracker, OBJECTIVE_FIELD_PROGRESS,
+                                          objective_points > INT32_MAX ? INT32_MAX : (int32_t)objective_points);
+    completed += objective_engine_observe(engine, tracker, OBJECTIVE_FIELD_SCORE, score);
+    completed += objective_engine_observe(engine, tracker, OBJECTIVE_FIELD_COMBO, max_combo);
+    completed += objective_engine_observe(engine, tracker, OBJECTIVE_FIELD_HITS, (int32_t)total_hits);
+
+    uint64_t attempts = (uint64_t)total_hits + miss_hits;
+    if (attempts >= OBJECTIVE_RATIO_MIN_ATTEMPTS) {
+        int32_t ratio = (int32_t)((uint64_t)perfect_hits * OBJECTIVE_RATIO_SCALE / attempts);
+        completed += objective_engine_observe(engine, tracker, OBJECTIVE_FIELD_HIT_RATIO, ratio);
+    }
+    return completed;
+}
+
+uint32_t objective_engine_observe_state(ObjectiveEngine* engine, uint32_t tracker,
+                                        const ComboState* state) {
+    return observe_fields(engine, tracker, state->score, state->max_combo, state->total_hits,
+                          state->perfect_hits, state->miss_hits, state->objective_points);
+}
+
+uint32_t objective_engine_observe_table(ObjectiveEngine* engine, uint32_t tracker,
+                                        const ComboStateTable* table, uint32_t index) {
+    if (index >= table->count) return 0;
+    return observe_fields(engine, tracker, table->score[index], table->max_combo[index],
+                          table->total_hits[index], table->perfect_hits[index],
+                          table->miss_hits[index], table->cold[index].objective_points);
+}
+
+uint32_t objective_engine_poll(ObjectiveEngine* engine, ObjectiveEvent* events, uint32_t max) {
+    uint32_t count = 0;
+    while (count < max && engine->event_count > 0) {
+        events[count++] = engine->events[engine->event_head];
+        engine->event_head = (engine->event_head + 1) % engine->event_capacity;
+        engine->event_count--;
+    }
+    return count;
+}
@@ -0,0 +1,106 @@
+#ifndef OBJECTIVE_ENGINE_H
+#define OBJECTIVE_ENGINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "core.h"
+#include "combo_table.h"
+
+// Evaluates every objective of every tracker on each change instead of
+// only the active one.
+//
+// Goals are "field reaches threshold" and complete once (until rearmed).
+// Each (tracker, field) pair has its own index of pending thresholds in
+// ascending order, so the goals a new value completes are always a prefix
+// of what is still pending: an observation costs one comparison when
+// nothing completes and a binary search when something does, however
+// many goals the tracker has. Completions are queued as events for the
+// UI to drain instead of flags it has to scan for.
+
+#define OBJECTIVE_RATIO_MIN_ATTEMPTS 20  // Hit ratio goals wait for this many attempts
+#define OBJECTIVE_RATIO_SCALE 1000       // Hit ratio thresholds are per-mille
+
+typedef enum {
+    OBJECTIVE_FIELD_SCORE,       // score
+    OBJECTIVE_FIELD_COMBO,       // max_combo, the longest combo reached
+    OBJECTIVE_FIELD_HITS,        // total_hits
+    OBJECTIVE_FIELD_HIT_RATIO,   // perfect_hits per (total_hits + miss_hits), per-mille
+    OBJECTIVE_FIELD_PROGRESS,    // objective_points, hit amounts credited to objectives
+    OBJECTIVE_FIELD_COUNT
+} ObjectiveField;
+
+typedef struct {
+    uint32_t tracker;
+    uint32_t user_id;       // Caller's handle, e.g. an index into its objective list
+    int32_t threshold;
+    uint8_t field;          // ObjectiveField
+    bool completed;
+} ObjectiveGoal;
+
+typedef struct {
+    uint32_t goal;          // Index returned by objective_engine_add
+    uint32_t tracker;
+    uint32_t user_id;
+    int32_t threshold;
+    int32_t value;          // Field value that completed it
+    uint8_t field;
+} ObjectiveEvent;
+
+// Pending thresholds for one (tracker, field); [0, next) have completed
+typedef struct {
+    int32_t* thresholds;
+    uint32_t* goals;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t next;
+    bool unsorted;          // Goals were added since the last observation
+} ObjectiveIndex;
+
+typedef struct {
+    ObjectiveGoal* goals;
+    uint32_t goal_count;
+    uint32_t goal_capacity;
+
+    ObjectiveIndex* indexes;    // tracker * OBJECTIVE_FIELD_COUNT + field
+    uint32_t tracker_count;
+
+    ObjectiveEvent* events;     // Ring, grows so completions are never lost
+    uint32_t event_head;
+    uint32_t event_count;
+    uint32_t event_capacity;
+
+    uint64_t probes;            // Threshold comparisons, for measuring
+} ObjectiveEngine;
+
+bool objective_engine_init(ObjectiveEngine* engine, uint32_t tracker_count);
+void objective_engine_free(ObjectiveEngine* engine);
+
+// Returns the goal index, or -1 if the tracker/field is out of range or
+// allocation fails
+int32_t objective_engine_add(ObjectiveEngine* engine, uint32_t tracker, ObjectiveField field,
+                             int32_t threshold, uint32_t user_id);
+// Add a PROGRESS goal for each of the tracker's objectives that is not
+// completed yet, due when its current_score reaches target_score; user_id
+// is the objective's index. Returns the number of goals added.
+uint32_t objective_engine_add_objectives(ObjectiveEngine* engine, uint32_t tracker,
+                                         const ComboState* state);
+// Drop every goal and pending event
+void objective_engine_clear(ObjectiveEngine* engine);
+// Mark a tracker's goals pending again, e.g. for a new session
+void objective_engine_rearm(ObjectiveEngine* engine, uint32_t tracker);
+
+// Report a field's current value; returns the number of goals completed
+uint32_t objective_engine_observe(ObjectiveEngine* engine, uint32_t tracker, ObjectiveField field,
+                                  int32_t value);
+// Observe every field of a tracker after a hit, miss or batch
+uint32_t objective_engine_observe_state(ObjectiveEngine* engine, uint32_t tracker,
+                                        const ComboState* state);
+// Same, reading row `index` of a table. Rows move when others are
+// removed, so keep the tracker ids separate from row indices.
+uint32_t objective_engine_observe_table(ObjectiveEngine* engine, uint32_t tracker,
+                                        const ComboStateTable* table, uint32_t index);
+
+// Copy out up to `max` completion events, oldest first
+uint32_t objective_engine_poll(ObjectiveEngine* engine, ObjectiveEvent* events, uint32_t max);
+
+#endif // OBJECTIVE_ENGINE_H
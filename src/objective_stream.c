@@ -0,0 +1,423 @@
+#include "objective_stream.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+enum {
+    LEX_NONE,
+    LEX_STRING,
+    LEX_SCALAR      // Number or literal, ended by the first other byte
+};
+
+enum {
+    TOKEN_BEGIN_OBJECT,
+    TOKEN_END_OBJECT,
+    TOKEN_BEGIN_ARRAY,
+    TOKEN_END_ARRAY,
+    TOKEN_COLON,
+    TOKEN_COMMA,
+    TOKEN_STRING,
+    TOKEN_NUMBER,
+    TOKEN_LITERAL
+};
+
+enum {
+    STATE_ROOT,
+    STATE_ROOT_KEY,
+    STATE_ROOT_COLON,
+    STATE_ROOT_VALUE,
+    STATE_ROOT_NEXT,
+    STATE_LIST_ITEM,
+    STATE_LIST_NEXT,
+    STATE_OBJECT_KEY,
+    STATE_OBJECT_COLON,
+    STATE_OBJECT_VALUE,
+    STATE_OBJECT_NEXT,
+    STATE_SKIP,
+    STATE_DONE
+};
+
+enum {
+    FIELD_OTHER,
+    FIELD_NAME,
+    FIELD_DESCRIPTION,
+    FIELD_TARGET_SCORE
+};
+
+void objective_stream_init(ObjectiveStream* stream, ObjectiveSink sink) {
+    memset(stream, 0, sizeof(*stream));
+    stream->sink = sink;
+    stream->lex = LEX_NONE;
+    stream->state = STATE_ROOT;
+}
+
+static void text_put(ObjectiveStream* stream, char c) {
+    // Longer strings are truncated like every other tracker string
+    if (stream->text_size < MAX_LABEL_LENGTH - 1) {
+        stream->text[stream->text_size++] = c;
+    }
+}
+
+static void text_put_utf8(ObjectiveStream* stream, uint32_t code) {
+    if (code >= 0xD800 && code <= 0xDFFF) {
+        text_put(stream, '?');  // Surrogate halves are not recombined
+    } else if (code < 0x80) {
+        text_put(stream, (char)code);
+    } else if (code < 0x800) {
+        text_put(stream, (char)(0xC0 | (code >> 6)));
+        text_put(stream, (char)(0x80 | (code & 0x3F)));
+    } else {
+        text_put(stream, (char)(0xE0 | (code >> 12)));
+        text_put(stream, (char)(0x80 | ((code >> 6) & 0x3F)));
+        text_put(stream, (char)(0x80 | (code & 0x3F)));
+    }
+}
+
+static void copy_text(char* out, const ObjectiveStream* stream) {
+    memcpy(out, stream->text, stream->text_size);
+    out[stream->text_size] = '\0';
+}
+
+static int text_to_int(ObjectiveStream* stream) {
+    stream->text[stream->text_size] = '\0';
+    long long value = strtoll(stream->text, NULL, 10);
+    if (value > INT_MAX) return INT_MAX;
+    if (value < INT_MIN) return INT_MIN;
+    return (int)value;
+}
+
+static void skip_value(ObjectiveStream* stream, uint8_t token, uint8_t next_state) {
+    switch (token) {
+        case TOKEN_BEGIN_OBJECT:
+        case TOKEN_BEGIN_ARRAY:
+            stream->skip_depth = 1;
+            stream->skip_return = next_state;
+            stream->state = STATE_SKIP;
+            break;
+        case TOKEN_STRING:
+        case TOKEN_NUMBER:
+        case TOKEN_LITERAL:
+            stream->state = next_state;
+            break;
+        default:
+            stream->failed = true;
+            break;
+    }
+}
+
+static void end_list(ObjectiveStream* stream) {
+    if (stream->sink.end_list) stream->sink.end_list(stream->sink.user);
+    stream->state = STATE_ROOT_NEXT;
+}
+
+static void end_objective(ObjectiveStream* stream) {
+    if (stream->sink.objective) stream->sink.objective(stream->sink.user, &stream->current);
+    stream->state = STATE_LIST_NEXT;
+}
+
+static void parse_token(ObjectiveStream* stream, uint8_t token) {
+    switch (stream->state) {
+        case STATE_ROOT:
+            if (token != TOKEN_BEGIN_OBJECT) break;
+            stream->state = STATE_ROOT_KEY;
+            return;
+
+        case STATE_ROOT_KEY:
+            if (token == TOKEN_STRING) {
+                copy_text(stream->label, stream);
+                stream->state = STATE_ROOT_COLON;
+                return;
+            }
+            if (token != TOKEN_END_OBJECT) break;
+            stream->state = STATE_DONE;
+            return;
+
+        case STATE_ROOT_COLON:
+            if (token != TOKEN_COLON) break;
+            stream->state = STATE_ROOT_VALUE;
+            return;
+
+        case STATE_ROOT_VALUE:
+            if (token == TOKEN_BEGIN_ARRAY) {
+                if (stream->sink.begin_list) stream->sink.begin_list(stream->sink.user, stream->label);
+                stream->state = STATE_LIST_ITEM;
+            } else {
+                skip_value(stream, token, STATE_ROOT_NEXT);
+            }
+            return;
+
+        case STATE_ROOT_NEXT:
+            if (token == TOKEN_COMMA) {
+                stream->state = STATE_ROOT_KEY;
+                return;
+            }
+            if (token != TOKEN_END_OBJECT) break;
+            stream->state = STATE_DONE;
+            return;
+
+        case STATE_LIST_ITEM:
+            if (token == TOKEN_BEGIN_OBJECT) {
+                memset(&stream->current, 0, sizeof(Objective));
+                stream->state = STATE_OBJECT_KEY;
+            } else if (token == TOKEN_END_ARRAY) {
+                end_list(stream);
+            } else {
+                skip_value(stream, token, STATE_LIST_NEXT);
+            }
+            return;
+
+        case STATE_LIST_NEXT:
+            if (token == TOKEN_COMMA) {
+                stream->state = STATE_LIST_ITEM;
+                return;
+            }
+            if (token != TOKEN_END_ARRAY) break;
+            end_list(stream);
+            return;
+
+        case STATE_OBJECT_KEY:
+            if (token == TOKEN_STRING) {
+                stream->text[stream->text_size] = '\0';
+                if (strcmp(stream->text, "name") == 0) {
+                    stream->field = FIELD_NAME;
+                } else if (strcmp(stream->text, "description") == 0) {
+                    stream->field = FIELD_DESCRIPTION;
+                } else if (strcmp(stream->text, "target_score") == 0) {
+                    stream->field = FIELD_TARGET_SCORE;
+                } else {
+                    stream->field = FIELD_OTHER;
+                }
+                stream->state = STATE_OBJECT_COLON;
+                return;
+            }
+            if (token != TOKEN_END_OBJECT) break;
+            end_objective(stream);
+            return;
+
+        case STATE_OBJECT_COLON:
+            if (token != TOKEN_COLON) break;
+            stream->state = STATE_OBJECT_VALUE;
+            return;
+
+        case STATE_OBJECT_VALUE:
+            if (token == TOKEN_STRING && stream->field == FIELD_NAME) {
+                copy_text(stream->current.name, stream);
+            } else if (token == TOKEN_STRING && stream->field == FIELD_DESCRIPTION) {
+                copy_text(stream->current.description, stream);
+            } else if (token == TOKEN_NUMBER && stream->field == FIELD_TARGET_SCORE) {
+                stream->current.target_score = text_to_int(stream);
+            }
+            skip_value(stream, token, STATE_OBJECT_NEXT);
+            return;
+
+        case STATE_OBJECT_NEXT:
+            if (token == TOKEN_COMMA) {
+                stream->state = STATE_OBJECT_KEY;
+                return;
+            }
+            if (token != TOKEN_END_OBJECT) break;
+            end_objective(stream);
+            return;
+
+        case STATE_SKIP:
+            if (token == TOKEN_BEGIN_OBJECT || token == TOKEN_BEGIN_ARRAY) {
+                stream->skip_depth++;
+            } else if (token == TOKEN_END_OBJECT || token == TOKEN_END_ARRAY) {
+                if (--stream->skip_depth == 0) stream->state = stream->skip_return;
+            }
+            return;
+
+        default:
+            break;
+    }
+    stream->failed = true;
+}
+
+static void end_scalar(ObjectiveStream* stream) {
+    stream->lex = LEX_NONE;
+    stream->text[stream->text_size] = '\0';
+    char first = stream->text[0];
+    if (first == '-' || (first >= '0' && first <= '9')) {
+        parse_token(stream, TOKEN_NUMBER);
+    } else if (strcmp(stream->text, "true") == 0 || strcmp(stream->text, "false") == 0 ||
+               strcmp(stream->text, "null") == 0) {
+        parse_token(stream, TOKEN_LITERAL);
+    } else {
+        stream->failed = true;
+    }
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static void string_byte(ObjectiveStream* stream, char c) {
+    if (stream->unicode_digits > 0) {
+        int digit = hex_value(c);
+        if (digit < 0) {
+            stream->failed = true;
+            return;
+        }
+        stream->unicode = (stream->unicode << 4) | (uint32_t)digit;
+        if (--stream->unicode_digits == 0) text_put_utf8(stream, stream->unicode);
+        return;
+    }
+    if (stream->escape) {
+        stream->escape = false;
+        switch (c) {
+            case '"': case '\\': case '/': text_put(stream, c); break;
+            case 'b': text_put(stream, '\b'); break;
+            case 'f': text_put(stream, '\f'); break;
+            case 'n': text_put(stream, '\n'); break;
+            case 'r': text_put(stream, '\r'); break;
+            case 't': text_put(stream, '\t'); break;
+            case 'u':
+                stream->unicode = 0;
+                stream->unicode_digits = 4;
+                break;
+            default: stream->failed = true; break;
+        }
+        return;
+    }
+    if (c == '\\') {
+        stream->escape = true;
+    } else if (c == '"') {
+        stream->lex = LEX_NONE;
+        parse_token(stream, TOKEN_STRING);
+    } else if ((unsigned char)c < 0x20) {
+        stream->failed = true;
+    } else {
+        text_put(stream, c);
+    }
+}
+
+static bool is_scalar_byte(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           c == '-' || c == '+' || c == '.';
+}
+
+bool objective_stream_feed(ObjectiveStream* stream, const char* data, size_t size) {
+    for (size_t i = 0; i < size && !stream->failed; i++) {
+        char c = data[i];
+        if (stream->lex == LEX_STRING) {
+            if (stream->escape || stream->unicode_digits > 0 || c == '\\' || c == '"') {
+                string_byte(stream, c);
+                continue;
+            }
+            // Copy the run of plain bytes up to the next quote or escape
+            size_t end = i;
+            while (end < size && data[end] != '"' && data[end] != '\\' &&
+                   (unsigned char)data[end] >= 0x20) {
+                end++;
+            }
+            if (end == i) {
+                string_byte(stream, c);  // Control byte: rejected
+                continue;
+            }
+            size_t room = MAX_LABEL_LENGTH - 1 - stream->text_size;
+            size_t run = end - i < room ? end - i : room;
+            memcpy(stream->text + stream->text_size, data + i, run);
+            stream->text_size += (uint32_t)run;
+            i = end - 1;
+            continue;
+        }
+        if (stream->lex == LEX_SCALAR) {
+            if (is_scalar_byte(c)) {
+                text_put(stream, c);
+                continue;
+            }
+            end_scalar(stream);
+            if (stream->failed) break;
+        }
+
+        switch (c) {
+            case ' ': case '\t': case '\r': case '\n': break;
+            case '{': parse_token(stream, TOKEN_BEGIN_OBJECT); break;
+            case '}': parse_token(stream, TOKEN_END_OBJECT); break;
+            case '[': parse_token(stream, TOKEN_BEGIN_ARRAY); break;
+            case ']': parse_token(stream, TOKEN_END_ARRAY); break;
+            case ':': parse_token(stream, TOKEN_COLON); break;
+            case ',': parse_token(stream, TOKEN_COMMA); break;
+            case '"':
+                stream->lex = LEX_STRING;
+                stream->text_size = 0;
+                break;
+            default:
+                if (!is_scalar_byte(c)) {
+                    stream->failed = true;
+                    break;
+                }
+                stream->lex = LEX_SCALAR;
+                stream->text_size = 0;
+                text_put(stream, c);
+                break;
+        }
+    }
+    return !stream->failed;
+}
+
+bool objective_stream_finish(ObjectiveStream* stream) {
+    if (!stream->failed && stream->lex == LEX_SCALAR) end_scalar(stream);
+    return !stream->failed && stream->lex == LEX_NONE && stream->state == STATE_DONE;
+}
+
+void objective_catalog_init(ObjectiveCatalog* catalog) {
+    memset(catalog, 0, sizeof(*catalog));
+}
+
+void objective_catalog_free(ObjectiveCatalog* catalog) {
+    free(catalog->lists);
+    free(catalog->objectives);
+    memset(catalog, 0, sizeof(*catalog));
+}
+
+static void catalog_begin_list(void* user, const char* label) {
+    ObjectiveCatalog* catalog = user;
+    if (catalog->failed) return;
+    if (catalog->list_count == catalog->list_capacity) {
+        uint32_t capacity = catalog->list_capacity ? catalog->list_capacity * 2 : 8;
+        ObjectiveList* lists = realloc(catalog->lists, capacity * sizeof(ObjectiveList));
+        if (!lists) {
+            catalog->failed = true;
+            return;
+        }
+        catalog->lists = lists;
+        catalog->list_capacity = capacity;
+    }
+    ObjectiveList* list = &catalog->lists[catalog->list_count++];
+    strcpy(list->label, label);
+    list->first = catalog->objective_count;
+    list->count = 0;
+}
+
+static void catalog_objective(void* user, const Objective* objective) {
+    ObjectiveCatalog* catalog = user;
+    if (catalog->failed) return;
+    if (catalog->objective_count == catalog->objective_capacity) {
+        uint32_t capacity = catalog->objective_capacity ? catalog->objective_capacity * 2 : 32;
+        Objective* objectives = realloc(catalog->objectives, capacity * sizeof(Objective));
+        if (!objectives) {
+            catalog->failed = true;
+            return;
+        }
+        catalog->objectives = objectives;
+        catalog->objective_capacity = capacity;
+    }
+    catalog->objectives[catalog->objective_count++] = *objective;
+    catalog->lists[catalog->list_count - 1].count++;
+}
+
+ObjectiveSink objective_catalog_sink(ObjectiveCatalog* catalog) {
+    ObjectiveSink sink = {catalog_begin_list, catalog_objective, NULL, catalog};
+    return sink;
+}
+
+const ObjectiveList* objective_catalog_find(const ObjectiveCatalog* catalog, const char* label) {
+    for (uint32_t i = 0; i < catalog->list_count; i++) {
+        if (strcmp(catalog->lists[i].label, label) == 0) return &catalog->lists[i];
+    }
+    return NULL;
+}
@@ -0,0 +1,77 @@
+#ifndef OBJECTIVE_STREAM_H
+#define OBJECTIVE_STREAM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "core.h"
+
+// Incremental decoder for fetched objective lists:
+//
+//   {"<tracker label>":[{"name":...,"description":...,"target_score":n}, ...], ...}
+//
+// Bytes can be fed in chunks of any size as they arrive; the decoder
+// keeps only its fixed-size state (one string token at a time, truncated
+// to MAX_LABEL_LENGTH - 1 like the rest of the tracker strings) and
+// hands each objective to a sink as soon as its closing brace is seen.
+// Unknown keys and values of any shape are skipped.
+
+typedef struct {
+    // label is only valid during the call
+    void (*begin_list)(void* user, const char* label);
+    void (*objective)(void* user, const Objective* objective);
+    void (*end_list)(void* user);
+    void* user;
+} ObjectiveSink;
+
+typedef struct {
+    ObjectiveSink sink;
+    bool failed;
+
+    // Tokenizer
+    uint8_t lex;
+    bool escape;
+    uint8_t unicode_digits;
+    uint32_t unicode;
+    char text[MAX_LABEL_LENGTH];
+    uint32_t text_size;
+
+    // Parser
+    uint8_t state;
+    uint8_t field;
+    uint32_t skip_depth;
+    uint8_t skip_return;
+    Objective current;
+    char label[MAX_LABEL_LENGTH];
+} ObjectiveStream;
+
+void objective_stream_init(ObjectiveStream* stream, ObjectiveSink sink);
+// Returns false once the input is malformed; later feeds are ignored
+bool objective_stream_feed(ObjectiveStream* stream, const char* data, size_t size);
+// True if a complete document was decoded
+bool objective_stream_finish(ObjectiveStream* stream);
+
+// Decoded lists kept in two flat arrays, for decoding off the
+// simulation thread and applying later
+typedef struct {
+    char label[MAX_LABEL_LENGTH];
+    uint32_t first;
+    uint32_t count;
+} ObjectiveList;
+
+typedef struct {
+    ObjectiveList* lists;
+    uint32_t list_count;
+    uint32_t list_capacity;
+    Objective* objectives;
+    uint32_t objective_count;
+    uint32_t objective_capacity;
+    bool failed;                // An allocation failed; lists are incomplete
+} ObjectiveCatalog;
+
+void objective_catalog_init(ObjectiveCatalog* catalog);
+void objective_catalog_free(ObjectiveCatalog* catalog);
+ObjectiveSink objective_catalog_sink(ObjectiveCatalog* catalog);
+const ObjectiveList* objective_catalog_find(const ObjectiveCatalog* catalog, const char* label);
+
+#endif // OBJECTIVE_STREAM_H
@@ -1,142 +1,90 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <curl/curl.h>
-#include <jansson.h>
 #include "core.h"
+#include "sync_worker.h"
+#include "objective_stream.h"
 
-// Callback for CURL to write response data
-static size_t write_callback(void *contents, size_t size, size_t nmemb, void *userp) {
-    size_t realsize = size * nmemb;
-    char **response_ptr = (char**)userp;
-    
-    *response_ptr = realloc(*response_ptr, realsize + 1);
-    if(*response_ptr == NULL) {
-        return 0;
-    }
-    
-    memcpy(*response_ptr, contents, realsize);
-    (*response_ptr)[realsize] = 0;
-    return realsize;
-}
+// Network transfers live in sync_worker.c; this file turns a fetched
+// objective list into tracker state on the simulation thread.
+
+// Decodes each list as it streams into one reusable scratch array, then
+// copies it into the tracker's own storage when the list closes, so a
+// truncated response never leaves a tracker half-updated
+typedef struct {
+    ComboState* trackers;
+    int tracker_count;
+    ComboState* target;
+    Objective* objectives;
+    uint32_t count;
+    uint32_t capacity;
+    int updated;
+} TrackerSink;
 
-void combo_set_objectives(ComboState* state, Objective* objectives, uint32_t count) {
-    if (state->objectives) {
-        // Free existing objectives
-        for (uint32_t i = 0; i < state->objective_count; i++) {
-            free(state->objectives[i].name);
-            free(state->objectives[i].description);
+static void tracker_sink_begin(void* user, const char* label) {
+    TrackerSink* sink = user;
+    sink->target = NULL;
+    sink->count = 0;
+    for (int t = 0; t < sink->tracker_count; t++) {
+        if (strcmp(sink->trackers[t].label, label) == 0) {
+            sink->target = &sink->trackers[t];
+            break;
         }
-        free(state->objectives);
-    }
-    
-    state->objectives = malloc(sizeof(Objective) * count);
-    state->objective_count = count;
-    state->active_objective_index = 0;
-    
-    for (uint32_t i = 0; i < count; i++) {
-        state->objectives[i] = objectives[i];
-        state->objectives[i].name = strdup(objectives[i].name);
-        state->objectives[i].description = strdup(objectives[i].description);
     }
 }
 
-void combo_switch_objective(ComboState* state, uint32_t index) {
-    if (index < state->objective_count) {
-        state->active_objective_index = index;
+static void tracker_sink_objective(void* user, const Objective* objective) {
+    TrackerSink* sink = user;
+    if (!sink->target) return;
+    if (sink->count == sink->capacity) {
+        uint32_t capacity = sink->capacity ? sink->capacity * 2 : 8;
+        Objective* grown = realloc(sink->objectives, capacity * sizeof(Objective));
+        if (!grown) {
+            sink->target = NULL;  // Keep the tracker's current list
+            return;
+        }
+        sink->objectives = grown;
+        sink->capacity = capacity;
     }
+    sink->objectives[sink->count++] = *objective;
 }
 
-void combo_update_objective_progress(ComboState* state, uint32_t score_increment) {
-    if (state->objective_count == 0) return;
-    
-    Objective* current = &state->objectives[state->active_objective_index];
-    current->current_score += score_increment;
-    
-    if (current->current_score >= current->target_score) {
-        current->completed = true;
+static void tracker_sink_end(void* user) {
+    TrackerSink* sink = user;
+    ComboState* state = sink->target;
+    if (!state) return;
+
+    Objective* objectives = NULL;
+    if (sink->count > 0) {
+        objectives = combo_objectives_alloc(state->pool, sink->count);
+        if (!objectives) return;
+        memcpy(objectives, sink->objectives, sink->count * sizeof(Objective));
     }
+    combo_objectives_free(state->pool, state->objectives, state->objective_count);
+    state->objectives = objectives;
+    state->objective_count = sink->count;
+    state->active_objective_index = 0;
+    sink->updated++;
 }
 
-void combo_sync_objectives(ComboState* state, const char* server_url) {
-    CURL *curl;
-    CURLcode res;
-    char *response = NULL;
-    
-    curl = curl_easy_init();
-    if (!curl) return;
-    
-    // Setup CURL request
-    curl_easy_setopt(curl, CURLOPT_URL, server_url);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-    
-    res = curl_easy_perform(curl);
-    
-    if (res == CURLE_OK && response) {
-        json_error_t error;
-        json_t *root = json_loads(response, 0, &error);
-        
-        if (root && json_is_array(root)) {
-            size_t count = json_array_size(root);
-            Objective *objectives = malloc(sizeof(Objective) * count);
-            
-            for (size_t i = 0; i < count; i++) {
-                json_t *obj = json_array_get(root, i);
-                objectives[i].name = strdup(json_string_value(json_object_get(obj, "name")));
-                objectives[i].description = strdup(json_string_value(json_object_get(obj, "description")));
-                objectives[i].target_score = json_integer_value(json_object_get(obj, "target_score"));
-                objectives[i].current_score = 0;
-                objectives[i].completed = false;
-            }
-            
-            combo_set_objectives(state, objectives, count);
-            free(objectives);
-        }
-        
-        json_decref(root);
-    }
-    
-    free(response);
-    curl_easy_cleanup(curl);
+int combo_sync_apply_objectives(ComboState* trackers, int tracker_count, const char* json, size_t size) {
+    TrackerSink tracker_sink = {trackers, tracker_count, NULL, NULL, 0, 0, 0};
+    ObjectiveSink sink = {tracker_sink_begin, tracker_sink_objective, tracker_sink_end, &tracker_sink};
+    ObjectiveStream stream;
+    objective_stream_init(&stream, sink);
+    objective_stream_feed(&stream, json, size);
+    bool complete = objective_stream_finish(&stream);
+    free(tracker_sink.objectives);
+    return complete ? tracker_sink.updated : -1;
 }
 
-void combo_sync_with_server(ComboState* state, const char* server_url) {
-    CURL *curl;
-    CURLcode res;
-    
-    curl = curl_easy_init();
-    if (!curl) return;
-    
-    // Create JSON payload
-    json_t *root = json_object();
-    json_t *objectives = json_array();
-    
-    for (uint32_t i = 0; i < state->objective_count; i++) {
-        json_t *obj = json_object();
-        json_object_set_new(obj, "name", json_string(state->objectives[i].name));
-        json_object_set_new(obj, "current_score", json_integer(state->objectives[i].current_score));
-        json_object_set_new(obj, "completed", json_boolean(state->objectives[i].completed));
-        json_array_append_new(objectives, obj);
+int combo_sync_apply_catalog(ComboState* trackers, int tracker_count, const ObjectiveCatalog* catalog) {
+    int updated = 0;
+    for (int t = 0; t < tracker_count; t++) {
+        const ObjectiveList* list = objective_catalog_find(catalog, trackers[t].label);
+        if (!list) continue;
+        combo_set_objectives(&trackers[t], &catalog->objectives[list->first], list->count);
+        updated++;
     }
-    
-    json_object_set_new(root, "objectives", objectives);
-    char *payload = json_dumps(root, JSON_COMPACT);
-    
-    // Setup CURL request
-    curl_easy_setopt(curl, CURLOPT_URL, server_url);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, payload);
-    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "POST");
-    
-    struct curl_slist *headers = NULL;
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    
-    res = curl_easy_perform(curl);
-    
-    // Cleanup
-    curl_slist_free_all(headers);
-    free(payload);
-    json_decref(root);
-    curl_easy_cleanup(curl);
-} 
\ No newline at end of file
+    return updated;
+}
@@ -0,0 +1,255 @@
+#define _POSIX_C_SOURCE 200809L
+#include "param_sweep.h"
+#include "session_replay.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct {
+    ParamSweep* sweep;
+    uint32_t index;
+} SweepWorker;
+
+static uint64_t pack_range(uint32_t next, uint32_t end) {
+    return ((uint64_t)next << 32) | end;
+}
+
+void param_sweep_init(ParamSweep* sweep) {
+    memset(sweep, 0, sizeof(*sweep));
+}
+
+void param_sweep_free(ParamSweep* sweep) {
+    for (uint32_t i = 0; i < sweep->session_count; i++) {
+        SweepSession* session = &sweep->sessions[i];
+        for (int t = 0; t < session->tracker_count; t++) {
+            combo_release(&session->trackers[t]);
+        }
+        session_log_free(&session->log);
+    }
+    free(sweep->sessions);
+    free(sweep->tunings);
+    free(sweep->scores);
+    free(sweep->queues);
+    memset(sweep, 0, sizeof(*sweep));
+}
+
+bool param_sweep_add_session(ParamSweep* sweep, const char* path) {
+    if (sweep->session_count == sweep->session_capacity) {
+        uint32_t capacity = sweep->session_capacity ? sweep->session_capacity * 2 : 64;
+        SweepSession* sessions = realloc(sweep->sessions, capacity * sizeof(SweepSession));
+        if (!sessions) return false;
+        sweep->sessions = sessions;
+        sweep->session_capacity = capacity;
+    }
+
+    SweepSession* session = &sweep->sessions[sweep->session_count];
+    if (!session_load(&session->log, path)) return false;
+    session->tracker_count = session_replay_load_base(&session->log, session->trackers, MAX_TRACKERS);
+    if (session->tracker_count < 0) {
+        session_log_free(&session->log);
+        return false;
+    }
+    sweep->session_count++;
+    return true;
+}
+
+bool param_sweep_add_tuning(ParamSweep* sweep, const ComboTuning* tuning) {
+    if (!(tuning->decay_rate > 0.0f)) return false;
+    if (sweep->tuning_count == sweep->tuning_capacity) {
+        uint32_t capacity = sweep->tuning_capacity ? sweep->tuning_capacity * 2 : 16;
+        ComboTuning* tunings = realloc(sweep->tunings, capacity * sizeof(ComboTuning));
+        if (!tunings) return false;
+        sweep->tunings = tunings;
+        sweep->tuning_capacity = capacity;
+    }
+    sweep->tunings[sweep->tuning_count++] = *tuning;
+    return true;
+}
+
+static void run_job(ParamSweep* sweep, uint32_t job) {
+    uint32_t session_index = job / sweep->tuning_count;
+    uint32_t tuning_index = job % sweep->tuning_count;
+    const SweepSession* session = &sweep->sessions[session_index];
+
+    // Objectives only track progress, so replays skip them and never
+    // write to storage shared with other workers
+    ComboState trackers[MAX_TRACKERS];
+    memcpy(trackers, session->trackers, (size_t)session->tracker_count * sizeof(ComboState));
+    for (int t = 0; t < session->tracker_count; t++) {
+        trackers[t].objectives = NULL;
+        trackers[t].objective_count = 0;
+    }
+
+    combo_set_tuning(&sweep->tunings[tuning_index]);
+    session_replay(&session->log, trackers, session->tracker_count, NULL);
+
+    int64_t score = 0;
+    for (int t = 0; t < session->tracker_count; t++) {
+        score += trackers[t].score;
+    }
+    sweep->scores[(size_t)tuning_index * sweep->session_count + session_index] = score;
+}
+
+// Owner end: take the next job from the front
+static bool take_front(SweepQueue* queue, uint32_t* job) {
+    uint64_t range = __atomic_load_n(&queue->range, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t next = (uint32_t)(range >> 32);
+        uint32_t end = (uint32_t)range;
+        if (next >= end) return false;
+        if (__atomic_compare_exchange_n(&queue->range, &range, pack_range(next + 1, end), true,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            *job = next;
+            return true;
+        }
+    }
+}
+
+// Thief end: take the back half of another worker's range
+static bool steal_back(SweepQueue* victim, uint32_t* begin, uint32_t* end) {
+    uint64_t range = __atomic_load_n(&victim->range, __ATOMIC_ACQUIRE);
+    for (;;) {
+        uint32_t next = (uint32_t)(range >> 32);
+        uint32_t last = (uint32_t)range;
+        if (next >= last) return false;
+        uint32_t split = last - (last - next + 1) / 2;
+        if (__atomic_compare_exchange_n(&victim->range, &range, pack_range(next, split), true,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            *begin = split;
+            *end = last;
+            return true;
+        }
+    }
+}
+
+static uint32_t remaining(const SweepQueue* queue) {
+    uint64_t range = __atomic_load_n(&queue->range, __ATOMIC_RELAXED);
+    uint32_t next = (uint32_t)(range >> 32);
+    uint32_t end = (uint32_t)range;
+    return next < end ? end - next : 0;
+}
+
+static void* worker_main(void* arg) {
+    SweepWorker* worker = arg;
+    ParamSweep* sweep = worker->sweep;
+    SweepQueue* own = &sweep->queues[worker->index];
+
+    for (;;) {
+        uint32_t job;
+        while (take_front(own, &job)) {
+            run_job(sweep, job);
+        }
+
+        // Own range is empty, so thieves leave it alone until it is refilled
+        bool stole = false;
+        for (;;) {
+            uint32_t victim = sweep->thread_count;
+            uint32_t most = 0;
+            for (uint32_t i = 0; i < sweep->thread_count; i++) {
+                uint32_t left = i == worker->index ? 0 : remaining(&sweep->queues[i]);
+                if (left > most) {
+                    most = left;
+                    victim = i;
+                }
+            }
+            if (victim == sweep->thread_count) break;  // Nothing left anywhere
+
+            uint32_t begin, end;
+            if (steal_back(&sweep->queues[victim], &begin, &end)) {
+                own->stolen += end - begin;
+                __atomic_fetch_add(&sweep->steals, 1, __ATOMIC_RELAXED);
+                __atomic_store_n(&own->range, pack_range(begin, end), __ATOMIC_RELEASE);
+                stole = true;
+                break;
+            }
+        }
+        if (!stole) break;
+    }
+
+    combo_set_tuning(NULL);
+    return NULL;
+}
+
+bool param_sweep_run(ParamSweep* sweep, uint32_t threads) {
+    uint64_t jobs = (uint64_t)sweep->session_count * sweep->tuning_count;
+    if (jobs == 0 || jobs > UINT32_MAX) return false;
+
+    if (threads == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cores > 0 ? (uint32_t)cores : 1;
+    }
+    if (threads > jobs) threads = (uint32_t)jobs;
+
+    free(sweep->scores);
+    free(sweep->queues);
+    sweep->scores = calloc(jobs, sizeof(int64_t));
+    void* queues = NULL;
+    if (posix_memalign(&queues, PARAM_SWEEP_CACHE_LINE, threads * sizeof(SweepQueue)) != 0) queues = NULL;
+    sweep->queues = queues;
+    SweepWorker* workers = malloc(threads * sizeof(SweepWorker));
+    pthread_t* handles = malloc(threads * sizeof(pthread_t));
+    if (!sweep->scores || !sweep->queues || !workers || !handles) {
+        free(workers);
+        free(handles);
+        return false;
+    }
+    sweep->thread_count = threads;
+    sweep->steals = 0;
+
+    // Even initial split; stealing evens out sessions of different lengths
+    for (uint32_t i = 0; i < threads; i++) {
+        uint32_t begin = (uint32_t)(jobs * i / threads);
+        uint32_t end = (uint32_t)(jobs * (i + 1) / threads);
+        memset(&sweep->queues[i], 0, sizeof(SweepQueue));
+        sweep->queues[i].range = pack_range(begin, end);
+        workers[i].sweep = sweep;
+        workers[i].index = i;
+    }
+
+    // Worker 0 runs on the calling thread
+    uint32_t started = 1;
+    for (uint32_t i = 1; i < threads; i++) {
+        if (pthread_create(&handles[i], NULL, worker_main, &workers[i]) != 0) break;
+        started++;
+    }
+    worker_main(&workers[0]);
+    for (uint32_t i = 1; i < started; i++) {
+        pthread_join(handles[i], NULL);
+    }
+
+    free(workers);
+    free(handles);
+    return true;
+}
+
+int64_t param_sweep_score(const ParamSweep* sweep, uint32_t tuning, uint32_t session) {
+    return sweep->scores[(size_t)tuning * sweep->session_count + session];
+}
+
+static int compare_scores(const void* a, const void* b) {
+    int64_t x = *(const int64_t*)a;
+    int64_t y = *(const int64_t*)b;
+    return x < y ? -1 : (x > y);
+}
+
+void param_sweep_distribution(const ParamSweep* sweep, uint32_t tuning, SweepDistribution* out) {
+    memset(out, 0, sizeof(*out));
+    uint32_t n = sweep->session_count;
+    if (n == 0 || tuning >= sweep->tuning_count) return;
+
+    int64_t* sorted = malloc(n * sizeof(int64_t));
+    if (!sorted) return;
+    memcpy(sorted, &sweep->scores[(size_t)tuning * n], n * sizeof(int64_t));
+    qsort(sorted, n, sizeof(int64_t), compare_scores);
+
+    double sum = 0.0;
+    for (uint32_t i = 0; i < n; i++) sum += (double)sorted[i];
+    out->mean = sum / n;
+    out->min = sorted[0];
+    out->p10 = sorted[(n - 1) * 10 / 100];
+    out->p50 = sorted[(n - 1) * 50 / 100];
+    out->p90 = sorted[(n - 1) * 90 / 100];
+    out->max = sorted[n - 1];
+    free(sorted);
+}
@@ -0,0 +1,75 @@
+#ifndef PARAM_SWEEP_H
+#define PARAM_SWEEP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "core.h"
+#include "session.h"
+
+// Replays every recorded session under every scoring parameter set and
+// collects the final scores, for tuning the constants in core.h.
+//
+// A job is one (session, tuning) replay. Jobs are split into contiguous
+// per-worker ranges, session-major so a worker reuses the same event log
+// while it is hot in cache. A worker takes jobs from the front of its own
+// range; when that runs dry it steals the back half of the fullest other
+// range. Each range is one 64-bit word (next << 32 | end) updated by
+// compare-and-swap from both ends, so there are no locks and sessions of
+// very different lengths still keep every core busy.
+
+#define PARAM_SWEEP_CACHE_LINE 64
+
+typedef struct {
+    SessionLog log;
+    ComboState trackers[MAX_TRACKERS];  // Decoded base; objectives stripped
+    int tracker_count;
+} SweepSession;
+
+typedef struct {
+    uint64_t range;
+    uint64_t stolen;                    // Jobs this worker took from others
+    uint8_t pad[PARAM_SWEEP_CACHE_LINE - 2 * sizeof(uint64_t)];
+} SweepQueue;
+
+typedef struct {
+    SweepSession* sessions;
+    uint32_t session_count;
+    uint32_t session_capacity;
+
+    ComboTuning* tunings;
+    uint32_t tuning_count;
+    uint32_t tuning_capacity;
+
+    int64_t* scores;                    // [tuning * session_count + session], summed over trackers
+    SweepQueue* queues;
+    uint32_t thread_count;
+    uint64_t steals;                    // Successful steals in the last run
+} ParamSweep;
+
+typedef struct {
+    double mean;
+    int64_t min;
+    int64_t p10;
+    int64_t p50;
+    int64_t p90;
+    int64_t max;
+} SweepDistribution;
+
+void param_sweep_init(ParamSweep* sweep);
+void param_sweep_free(ParamSweep* sweep);
+
+// Load a desktop session and decode its base at the session's recorded
+// base time, so scores never depend on the host clock. False if it
+// cannot be read.
+bool param_sweep_add_session(ParamSweep* sweep, const char* path);
+// False if decay_rate is not positive or allocation fails
+bool param_sweep_add_tuning(ParamSweep* sweep, const ComboTuning* tuning);
+
+// Replay every combination on `threads` workers (0 = one per core)
+bool param_sweep_run(ParamSweep* sweep, uint32_t threads);
+
+int64_t param_sweep_score(const ParamSweep* sweep, uint32_t tuning, uint32_t session);
+// Final score distribution across sessions for one tuning
+void param_sweep_distribution(const ParamSweep* sweep, uint32_t tuning, SweepDistribution* out);
+
+#endif // PARAM_SWEEP_H
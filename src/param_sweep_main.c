@@ -0,0 +1,184 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "param_sweep.h"
+
+// Scoring parameter sweep over recorded sessions.
+//
+//   combo_param_sweep [-j threads] [-t decay_time] [-r decay_rate]
+//                     [-i multiplier_increase] [-m max_multiplier]
+//                     [-g grid_file] session...
+//
+// Each of -t/-r/-i/-m takes a value or an inclusive start:stop:step range;
+// the grid is every combination, with unset parameters at their core.h
+// defaults. A grid file instead lists one "decay_time decay_rate
+// multiplier_increase max_multiplier" set per line (# comments allowed).
+// Prints one CSV row per set with the final-score distribution across
+// sessions (scores summed over each session's trackers).
+
+#define SWEEP_MAX_STEPS 4096
+
+typedef struct {
+    float values[SWEEP_MAX_STEPS];
+    uint32_t count;
+} SweepAxis;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static bool parse_axis(const char* text, SweepAxis* axis) {
+    float start, stop, step;
+    axis->count = 0;
+    int fields = sscanf(text, "%f:%f:%f", &start, &stop, &step);
+    if (fields == 1) {
+        axis->values[axis->count++] = start;
+        return true;
+    }
+    if (fields != 3 || step <= 0.0f || stop < start) return false;
+
+    // Stepping by index keeps the endpoint from being lost to rounding
+    for (uint32_t i = 0; axis->count < SWEEP_MAX_STEPS; i++) {
+        float value = start + step * (float)i;
+        if (value > stop + step * 1e-3f) break;
+        axis->values[axis->count++] = value;
+    }
+    return true;
+}
+
+static bool load_grid(ParamSweep* sweep, const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) return false;
+    char line[256];
+    int line_number = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), file)) {
+        line_number++;
+        char* comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+
+        ComboTuning tuning;
+        int fields = sscanf(line, "%f %f %f %f", &tuning.decay_time, &tuning.decay_rate,
+                            &tuning.multiplier_increase, &tuning.max_multiplier);
+        if (fields == EOF || fields == 0) continue;
+        if (fields != 4 || !param_sweep_add_tuning(sweep, &tuning)) {
+            fprintf(stderr, "%s:%d: expected four numbers with decay_rate > 0\n", path, line_number);
+            ok = false;
+        }
+    }
+    fclose(file);
+    return ok;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [-j threads] [-t decay_time] [-r decay_rate] [-i multiplier_increase]\n"
+            "          [-m max_multiplier] [-g grid_file] session...\n"
+            "Parameters take a value or start:stop:step.\n",
+            program);
+}
+
+int main(int argc, char** argv) {
+    static SweepAxis axes[4];
+    const ComboTuning defaults = COMBO_TUNING_DEFAULTS;
+    const float default_values[4] = {defaults.decay_time, defaults.decay_rate,
+                                     defaults.multiplier_increase, defaults.max_multiplier};
+    for (int a = 0; a < 4; a++) {
+        axes[a].values[0] = default_values[a];
+        axes[a].count = 1;
+    }
+
+    ParamSweep sweep;
+    param_sweep_init(&sweep);
+    uint32_t threads = 0;
+    const char* grid_file = NULL;
+
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-'; arg++) {
+        const char* flag = argv[arg];
+        if (arg + 1 >= argc || flag[1] == '\0' || flag[2] != '\0') {
+            usage(argv[0]);
+            return 1;
+        }
+        const char* value = argv[++arg];
+        int axis = -1;
+        switch (flag[1]) {
+            case 'j': threads = (uint32_t)atoi(value); break;
+            case 'g': grid_file = value; break;
+            case 't': axis = 0; break;
+            case 'r': axis = 1; break;
+            case 'i': axis = 2; break;
+            case 'm': axis = 3; break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+        if (axis >= 0 && !parse_axis(value, &axes[axis])) {
+            fprintf(stderr, "Bad value for %s: %s\n", flag, value);
+            return 1;
+        }
+    }
+    if (arg >= argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (grid_file) {
+        if (!load_grid(&sweep, grid_file)) {
+            fprintf(stderr, "Cannot use grid file %s\n", grid_file);
+            param_sweep_free(&sweep);
+            return 1;
+        }
+    } else {
+        for (uint32_t t = 0; t < axes[0].count; t++)
+            for (uint32_t r = 0; r < axes[1].count; r++)
+                for (uint32_t i = 0; i < axes[2].count; i++)
+                    for (uint32_t m = 0; m < axes[3].count; m++) {
+                        ComboTuning tuning = {axes[0].values[t], axes[1].values[r],
+                                              axes[2].values[i], axes[3].values[m]};
+                        if (!param_sweep_add_tuning(&sweep, &tuning)) {
+                            fprintf(stderr, "decay_rate must be positive\n");
+                            param_sweep_free(&sweep);
+                            return 1;
+                        }
+                    }
+    }
+
+    double start = now_seconds();
+    for (; arg < argc; arg++) {
+        if (!param_sweep_add_session(&sweep, argv[arg])) {
+            fprintf(stderr, "Skipping %s: not a desktop session file\n", argv[arg]);
+        }
+    }
+    double loaded = now_seconds();
+    if (!param_sweep_run(&sweep, threads)) {
+        fprintf(stderr, "Nothing to sweep\n");
+        param_sweep_free(&sweep);
+        return 1;
+    }
+    double finished = now_seconds();
+
+    uint64_t replays = (uint64_t)sweep.session_count * sweep.tuning_count;
+    fprintf(stderr, "%u sessions x %u parameter sets on %u threads: load %.2f s, replay %.2f s "
+            "(%.0f replays/s, %llu steals)\n",
+            sweep.session_count, sweep.tuning_count, sweep.thread_count, loaded - start,
+            finished - loaded, (double)replays / (finished - loaded), (unsigned long long)sweep.steals);
+
+    printf("decay_time,decay_rate,multiplier_increase,max_multiplier,sessions,mean,min,p10,p50,p90,max\n");
+    for (uint32_t t = 0; t < sweep.tuning_count; t++) {
+        const ComboTuning* tuning = &sweep.tunings[t];
+        SweepDistribution dist;
+        param_sweep_distribution(&sweep, t, &dist);
+        printf("%g,%g,%g,%g,%u,%.1f,%lld,%lld,%lld,%lld,%lld\n", tuning->decay_time, tuning->decay_rate,
+               tuning->multiplier_increase, tuning->max_multiplier, sweep.session_count, dist.mean,
+               (long long)dist.min, (long long)dist.p10, (long long)dist.p50, (long long)dist.p90,
+               (long long)dist.max);
+    }
+
+    param_sweep_free(&sweep);
+    return 0;
+}
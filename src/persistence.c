@@ -0,0 +1,406 @@
+#define _POSIX_C_SOURCE 200809L
+#include "persistence.h"
+#include "journal.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define PERSISTENCE_MAX_PATH 256
+
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;        // Signalled when trackers change or on stop/flush
+    pthread_cond_t written;     // Signalled after each completed write
+
+    char file[PERSISTENCE_MAX_PATH];
+    uint32_t debounce_ms;
+    bool running;
+    bool stop_requested;
+    bool flush_requested;
+
+    // Shadow copy of the trackers, owned by the worker
+    ComboState shadow[MAX_TRACKERS];
+    int shadow_count;
+    uint32_t dirty_mask;        // Trackers needing a full snapshot
+    uint64_t first_dirty_ms;
+    uint64_t last_dirty_ms;
+
+    // Events waiting to be appended to the journal
+    JournalRecord pending[JOURNAL_COMPACT_THRESHOLD];
+    int pending_count;
+
+    // Snapshot/journal pairing; only touched by the worker thread
+    uint32_t snapshot_generation;
+    int journal_count;
+    bool snapshot_required;
+    bool snapshot_failed;       // Last snapshot write failed; the older pair is still on disk
+    bool stop_fold_attempted;   // The exit fold is tried once, even if it fails
+
+    // Side file handed over by persistence_queue_write
+    char side_file[PERSISTENCE_MAX_PATH];
+    ByteWriter side_data;
+    bool side_pending;
+
+    // Change counters, used by persistence_flush()
+    uint64_t requested_seq;
+    uint64_t written_seq;
+} PersistenceWorker;
+
+static PersistenceWorker g_persist;
+
+static uint64_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static void ms_to_timespec(uint64_t ms, struct timespec* ts) {
+    ts->tv_sec = (time_t)(ms / 1000);
+    ts->tv_nsec = (long)(ms % 1000) * 1000000;
+}
+
+// Deep copy a tracker; dst must not own objectives (or they must already be freed)
+static void tracker_copy(ComboState* dst, const ComboState* src) {
+    *dst = *src;
+    dst->objectives = NULL;
+    dst->interval_tracker.intervals = NULL;
+    dst->interval_tracker.interval_count = 0;
+    dst->pool = NULL;
+    dst->interval_tracker.pool = NULL;
+
+    if (src->objective_count > 0 && src->objectives) {
+        dst->objectives = malloc(sizeof(Objective) * src->objective_count);
+        if (dst->objectives) {
+            memcpy(dst->objectives, src->objectives, sizeof(Objective) * src->objective_count);
+        } else {
+            dst->objective_count = 0;
+        }
+    }
+}
+
+static void tracker_release(ComboState* state) {
+    free(state->objectives);
+    state->objectives = NULL;
+    state->objective_count = 0;
+}
+
+// Write to a temp file and rename so a crash never leaves a torn file,
+// then start a fresh journal for the new generation. If the temp file
+// can't be fully written the old snapshot and its journal stay in place.
+static bool write_snapshot(const char* file, ComboState* trackers, int count, uint32_t generation) {
+    char tmp_file[PERSISTENCE_MAX_PATH + 8];
+    snprintf(tmp_file, sizeof(tmp_file), "%s.tmp", file);
+
+    if (!combo_save_snapshot(trackers, count, tmp_file, generation)) {
+        printf("Persistence: failed to write %s\n", tmp_file);
+        remove(tmp_file);
+        return false;
+    }
+    if (rename(tmp_file, file) != 0) {
+        printf("Persistence: failed to replace %s\n", file);
+        remove(tmp_file);
+        return false;
+    }
+    if (!journal_reset(file, generation)) {
+        printf("Persistence: failed to reset journal for %s\n", file);
+    }
+    return true;
+}
+
+static bool has_pending(void) {
+    return g_persist.dirty_mask != 0 || g_persist.pending_count > 0;
+}
+
+static void note_change(void) {
+    uint64_t now = now_ms();
+    if (!has_pending()) {
+        g_persist.first_dirty_ms = now;
+    }
+    g_persist.last_dirty_ms = now;
+    g_persist.requested_seq++;
+}
+
+static bool write_due(uint64_t now) {
+    if (!has_pending()) return false;
+    if (g_persist.flush_requested || g_persist.stop_requested) return true;
+
+    uint64_t quiet_deadline = g_persist.last_dirty_ms + g_persist.debounce_ms;
+    uint64_t max_deadline = g_persist.first_dirty_ms +
+                            (uint64_t)g_persist.debounce_ms * PERSISTENCE_MAX_DELAY_FACTOR;
+    return now >= quiet_deadline || now >= max_deadline;
+}
+
+static void* persistence_thread(void* arg) {
+    (void)arg;
+    static ComboState snapshot[MAX_TRACKERS];
+    static JournalRecord records[JOURNAL_COMPACT_THRESHOLD];
+
+    pthread_mutex_lock(&g_persist.lock);
+    for (;;) {
+        if (g_persist.side_pending) {
+            char path[PERSISTENCE_MAX_PATH];
+            memcpy(path, g_persist.side_file, sizeof(path));
+            ByteWriter data = g_persist.side_data;
+            memset(&g_persist.side_data, 0, sizeof(g_persist.side_data));
+            g_persist.side_pending = false;
+            pthread_mutex_unlock(&g_persist.lock);
+
+            if (!combo_format_write_file(path, &data)) {
+                printf("Persistence: failed to write %s\n", path);
+            }
+            writer_free(&data);
+            pthread_mutex_lock(&g_persist.lock);
+            pthread_cond_broadcast(&g_persist.written);
+            continue;
+        }
+
+        uint64_t now = now_ms();
+
+        // Fold the journal (or a snapshot that failed to write) into a new
+        // snapshot on a clean exit
+        if (g_persist.stop_requested && !g_persist.stop_fold_attempted &&
+            (g_persist.journal_count > 0 || g_persist.snapshot_failed)) {
+            g_persist.stop_fold_attempted = true;
+            g_persist.dirty_mask |= 1u << MAX_TRACKERS;
+        }
+
+        if (!write_due(now)) {
+            if (g_persist.stop_requested) break;
+
+            if (g_persist.flush_requested) {
+                // Nothing dirty: everything requested is already on disk
+                g_persist.flush_requested = false;
+                pthread_cond_broadcast(&g_persist.written);
+            }
+
+            if (!has_pending()) {
+                pthread_cond_wait(&g_persist.wake, &g_persist.lock);
+            } else {
+                uint64_t deadline = g_persist.last_dirty_ms + g_persist.debounce_ms;
+                uint64_t max_deadline = g_persist.first_dirty_ms +
+                                        (uint64_t)g_persist.debounce_ms * PERSISTENCE_MAX_DELAY_FACTOR;
+                if (max_deadline < deadline) deadline = max_deadline;
+
+                struct timespec ts;
+                ms_to_timespec(deadline, &ts);
+                pthread_cond_timedwait(&g_persist.wake, &g_persist.lock, &ts);
+            }
+            continue;
+        }
+
+        // A snapshot is needed for structural changes, for the first write
+        // of a session, and once the journal has grown past the threshold.
+        // Otherwise only the new events are appended.
+        bool full = g_persist.dirty_mask != 0 || g_persist.snapshot_required ||
+                    g_persist.journal_count + g_persist.pending_count >= JOURNAL_COMPACT_THRESHOLD;
+
+        // Take a private copy so the disk write happens without the lock.
+        // The shadow already includes every pending event.
+        int count = 0;
+        int record_count = 0;
+        if (full) {
+            count = g_persist.shadow_count;
+            for (int i = 0; i < count; i++) {
+                tracker_copy(&snapshot[i], &g_persist.shadow[i]);
+            }
+        } else {
+            record_count = g_persist.pending_count;
+            memcpy(records, g_persist.pending, sizeof(JournalRecord) * record_count);
+        }
+        uint64_t seq = g_persist.requested_seq;
+        g_persist.dirty_mask = 0;
+        g_persist.pending_count = 0;
+        g_persist.flush_requested = false;
+        pthread_mutex_unlock(&g_persist.lock);
+
+        if (full) {
+            g_persist.snapshot_generation++;
+            bool written = write_snapshot(g_persist.file, snapshot, count, g_persist.snapshot_generation);
+            for (int i = 0; i < count; i++) {
+                tracker_release(&snapshot[i]);
+            }
+            // On failure the old snapshot and journal still pair up; the
+            // shadow keeps every change, so the next write retries in full
+            if (written) {
+                g_persist.journal_count = 0;
+            }
+            g_persist.snapshot_required = !written;
+            g_persist.snapshot_failed = !written;
+        } else if (journal_append(g_persist.file, records, record_count)) {
+            g_persist.journal_count += record_count;
+        } else {
+            // Fall back to a snapshot on the next write
+            g_persist.snapshot_required = true;
+        }
+
+        pthread_mutex_lock(&g_persist.lock);
+        g_persist.written_seq = seq;
+        pthread_cond_broadcast(&g_persist.written);
+    }
+    pthread_mutex_unlock(&g_persist.lock);
+    return NULL;
+}
+
+bool persistence_start(const char* file, uint32_t debounce_ms) {
+    if (g_persist.running || !file) return g_persist.running;
+
+    memset(&g_persist, 0, sizeof(g_persist));
+    strncpy(g_persist.file, file, PERSISTENCE_MAX_PATH - 1);
+    g_persist.file[PERSISTENCE_MAX_PATH - 1] = '\0';
+    g_persist.debounce_ms = debounce_ms;
+
+    // Continue past both files' generations so an old journal can never
+    // be mistaken for one belonging to a snapshot written by this session
+    uint32_t snapshot_generation = combo_read_snapshot_generation(file);
+    uint32_t journal_generation = journal_read_generation(file);
+    g_persist.snapshot_generation = snapshot_generation > journal_generation ?
+                                    snapshot_generation : journal_generation;
+    g_persist.snapshot_required = true;
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_mutex_init(&g_persist.lock, NULL);
+    pthread_cond_init(&g_persist.wake, &attr);
+    pthread_cond_init(&g_persist.written, NULL);
+    pthread_condattr_destroy(&attr);
+
+    if (pthread_create(&g_persist.thread, NULL, persistence_thread, NULL) != 0) {
+        printf("Persistence: failed to start worker, saving synchronously\n");
+        pthread_cond_destroy(&g_persist.wake);
+        pthread_cond_destroy(&g_persist.written);
+        pthread_mutex_destroy(&g_persist.lock);
+        return false;
+    }
+
+    g_persist.running = true;
+    return true;
+}
+
+void persistence_stop(void) {
+    if (!g_persist.running) return;
+
+    // The worker writes anything still dirty before it exits
+    pthread_mutex_lock(&g_persist.lock);
+    g_persist.stop_requested = true;
+    pthread_cond_signal(&g_persist.wake);
+    pthread_mutex_unlock(&g_persist.lock);
+
+    pthread_join(g_persist.thread, NULL);
+
+    for (int i = 0; i < MAX_TRACKERS; i++) {
+        tracker_release(&g_persist.shadow[i]);
+    }
+    writer_free(&g_persist.side_data);
+    pthread_cond_destroy(&g_persist.wake);
+    pthread_cond_destroy(&g_persist.written);
+    pthread_mutex_destroy(&g_persist.lock);
+    g_persist.running = false;
+}
+
+bool persistence_is_running(void) {
+    return g_persist.running;
+}
+
+void persistence_set_debounce(uint32_t debounce_ms) {
+    if (!g_persist.running) return;
+
+    pthread_mutex_lock(&g_persist.lock);
+    g_persist.debounce_ms = debounce_ms;
+    pthread_cond_signal(&g_persist.wake);
+    pthread_mutex_unlock(&g_persist.lock);
+}
+
+void persistence_mark_dirty(const ComboState* trackers, int tracker_count, int index) {
+    if (!g_persist.running || !trackers) return;
+    if (tracker_count > MAX_TRACKERS) tracker_count = MAX_TRACKERS;
+    if (tracker_count < 0) tracker_count = 0;
+
+    pthread_mutex_lock(&g_persist.lock);
+
+    // A changed tracker count means the whole file layout changed
+    if (tracker_count != g_persist.shadow_count) {
+        index = -1;
+    }
+
+    int first = (index < 0) ? 0 : index;
+    int last = (index < 0) ? tracker_count : index + 1;
+    if (last > tracker_count) last = tracker_count;
+
+    for (int i = first; i < last; i++) {
+        tracker_release(&g_persist.shadow[i]);
+        tracker_copy(&g_persist.shadow[i], &trackers[i]);
+        g_persist.dirty_mask |= 1u << i;
+    }
+    for (int i = tracker_count; i < g_persist.shadow_count; i++) {
+        tracker_release(&g_persist.shadow[i]);
+    }
+    if (tracker_count != g_persist.shadow_count) {
+        // Shrinking to zero trackers still needs a write
+        g_persist.dirty_mask |= 1u << MAX_TRACKERS;
+    }
+    g_persist.shadow_count = tracker_count;
+    note_change();
+
+    pthread_cond_signal(&g_persist.wake);
+    pthread_mutex_unlock(&g_persist.lock);
+}
+
+void persistence_record_event(const ComboState* trackers, int tracker_count, int index,
+                              JournalOp op, uint32_t amount) {
+    if (!g_persist.running || !trackers) return;
+    if (index < 0 || index >= tracker_count || index >= MAX_TRACKERS) return;
+
+    pthread_mutex_lock(&g_persist.lock);
+    if (tracker_count != g_persist.shadow_count || g_persist.pending_count >= JOURNAL_COMPACT_THRESHOLD) {
+        // Layout changed or the buffer is full: take a snapshot instead
+        pthread_mutex_unlock(&g_persist.lock);
+        persistence_mark_dirty(trackers, tracker_count, -1);
+        return;
+    }
+
+    // Keep the shadow current so a snapshot can replace the journal at any time
+    tracker_release(&g_persist.shadow[index]);
+    tracker_copy(&g_persist.shadow[index], &trackers[index]);
+
+    note_change();
+    journal_record_init(&g_persist.pending[g_persist.pending_count++], index, op, amount, &trackers[index]);
+
+    pthread_cond_signal(&g_persist.wake);
+    pthread_mutex_unlock(&g_persist.lock);
+}
+
+bool persistence_queue_write(const char* file, ByteWriter* data) {
+    if (!g_persist.running || !file || strlen(file) >= PERSISTENCE_MAX_PATH) return false;
+
+    pthread_mutex_lock(&g_persist.lock);
+    // One side file is queued at a time; another file waits for the worker
+    while (g_persist.side_pending && strcmp(g_persist.side_file, file) != 0) {
+        pthread_cond_signal(&g_persist.wake);
+        pthread_cond_wait(&g_persist.written, &g_persist.lock);
+    }
+    writer_free(&g_persist.side_data);
+    strcpy(g_persist.side_file, file);
+    g_persist.side_data = *data;
+    g_persist.side_pending = true;
+    memset(data, 0, sizeof(*data));
+    pthread_cond_signal(&g_persist.wake);
+    pthread_mutex_unlock(&g_persist.lock);
+    return true;
+}
+
+void persistence_flush(void) {
+    if (!g_persist.running) return;
+
+    pthread_mutex_lock(&g_persist.lock);
+    uint64_t target = g_persist.requested_seq;
+    while (g_persist.written_seq < target) {
+        g_persist.flush_requested = true;
+        pthread_cond_signal(&g_persist.wake);
+        pthread_cond_wait(&g_persist.written, &g_persist.lock);
+    }
+    pthread_mutex_unlock(&g_persist.lock);
+}
@@ -0,0 +1,45 @@
+#ifndef PERSISTENCE_H
+#define PERSISTENCE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "core.h"
+#include "journal.h"
+#include "combo_format.h"
+
+// Default debounce window: a write happens once the trackers have been
+// quiet for this long (or after PERSISTENCE_MAX_DELAY_FACTOR windows of
+// continuous changes, so hammering a key still reaches the disk).
+#define PERSISTENCE_DEFAULT_DEBOUNCE_MS 250
+#define PERSISTENCE_MAX_DELAY_FACTOR 4
+
+// Background write-behind persistence for the tracker file.
+// The UI thread only copies changed trackers into a shadow buffer;
+// the worker thread appends events to the hit journal and periodically
+// compacts it into a full snapshot.
+bool persistence_start(const char* file, uint32_t debounce_ms);
+void persistence_stop(void);
+bool persistence_is_running(void);
+void persistence_set_debounce(uint32_t debounce_ms);
+
+// Mark trackers as changed. index < 0 marks every tracker dirty
+// (use after adding/removing trackers); otherwise only that tracker
+// is copied into the shadow buffer.
+void persistence_mark_dirty(const ComboState* trackers, int tracker_count, int index);
+
+// Record a single event (already applied to trackers[index]). Costs a
+// small journal append instead of a full rewrite.
+void persistence_record_event(const ComboState* trackers, int tracker_count, int index,
+                              JournalOp op, uint32_t amount);
+
+// Block until everything marked dirty so far is on disk
+void persistence_flush(void);
+
+// Have the worker write `data` to `file`, e.g. the score history, so the
+// caller's thread never waits on the disk. The worker takes the buffer
+// (data is left empty); a newer write for the same file replaces one
+// still queued. Returns false, leaving data alone, if the worker is not
+// running.
+bool persistence_queue_write(const char* file, ByteWriter* data);
+
+#endif // PERSISTENCE_H
@@ -0,0 +1,284 @@
+#include "score_history.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const uint32_t g_widths[HISTORY_RESOLUTION_COUNT] = {1, 60, 3600};
+static const uint32_t g_slots[HISTORY_RESOLUTION_COUNT] = {
+    SCORE_HISTORY_SECOND_SLOTS, SCORE_HISTORY_MINUTE_SLOTS, SCORE_HISTORY_HOUR_SLOTS
+};
+
+static HistoryBucket* ring_for(ScoreHistory* history, HistoryResolution resolution) {
+    switch (resolution) {
+        case HISTORY_SECONDS: return history->seconds;
+        case HISTORY_MINUTES: return history->minutes;
+        default: return history->hours;
+    }
+}
+
+static const HistoryBucket* ring_for_const(const ScoreHistory* history, HistoryResolution resolution) {
+    return ring_for((ScoreHistory*)history, resolution);
+}
+
+static uint32_t period_of(int64_t time, HistoryResolution resolution) {
+    return time > 0 ? (uint32_t)(time / g_widths[resolution]) : 0;
+}
+
+void score_history_init(ScoreHistory* history, const char* label) {
+    memset(history, 0, sizeof(*history));
+    snprintf(history->label, sizeof(history->label), "%s", label);
+}
+
+void score_history_record(ScoreHistory* history, int64_t now, int32_t score, int32_t combo, uint32_t hits) {
+    for (int r = 0; r < HISTORY_RESOLUTION_COUNT; r++) {
+        uint32_t period = period_of(now, (HistoryResolution)r);
+        HistoryBucket* bucket = &ring_for(history, (HistoryResolution)r)[period % g_slots[r]];
+        if (bucket->period != period) {
+            // Slot still holds a period from an earlier lap
+            memset(bucket, 0, sizeof(*bucket));
+            bucket->period = period;
+        }
+        bucket->score += score;
+        bucket->hits += hits;
+        if (combo > bucket->max_combo) bucket->max_combo = combo;
+    }
+}
+
+void score_history_observe(ScoreHistory* history, int64_t now, const ComboState* state) {
+    if (!history->primed) {
+        history->primed = true;
+        history->last_score = state->score;
+        history->last_hits = state->total_hits;
+        return;
+    }
+    int32_t score = state->score - history->last_score;
+    uint32_t hits = state->total_hits - history->last_hits;
+    if (score == 0 && hits == 0) return;
+
+    history->last_score = state->score;
+    history->last_hits = state->total_hits;
+    score_history_record(history, now, score, state->combo, hits);
+}
+
+uint32_t score_history_width(HistoryResolution resolution) {
+    return g_widths[resolution];
+}
+
+uint32_t score_history_retention(HistoryResolution resolution) {
+    return g_widths[resolution] * g_slots[resolution];
+}
+
+HistoryResolution score_history_resolution_for(int64_t from, int64_t now) {
+    int64_t age = now - from;
+    for (int r = 0; r < HISTORY_RESOLUTION_COUNT - 1; r++) {
+        // The oldest bucket in a ring is partly overwritten, so stay one short
+        if (age < (int64_t)score_history_retention((HistoryResolution)r) - (int64_t)g_widths[r]) {
+            return (HistoryResolution)r;
+        }
+    }
+    return HISTORY_HOURS;
+}
+
+uint32_t score_history_query(const ScoreHistory* history, HistoryResolution resolution,
+                             int64_t from, int64_t to, HistoryPoint* points, uint32_t max) {
+    if (to <= from || from <= 0) return 0;
+    const HistoryBucket* ring = ring_for_const(history, resolution);
+    uint32_t width = g_widths[resolution];
+    uint32_t first = period_of(from, resolution);
+    uint32_t last = period_of(to - 1, resolution);
+
+    // Never more than one lap of the ring
+    uint32_t span = last - first + 1;
+    if (span > g_slots[resolution]) {
+        first = last - g_slots[resolution] + 1;
+        span = g_slots[resolution];
+    }
+    if (span > max) span = max;
+
+    for (uint32_t i = 0; i < span; i++) {
+        uint32_t period = first + i;
+        const HistoryBucket* bucket = &ring[period % g_slots[resolution]];
+        HistoryPoint* point = &points[i];
+        point->start = (int64_t)period * width;
+        if (bucket->period == period) {
+            point->score = bucket->score;
+            point->max_combo = bucket->max_combo;
+            point->hits = bucket->hits;
+        } else {
+            point->score = 0;
+            point->max_combo = 0;
+            point->hits = 0;
+        }
+    }
+    return span;
+}
+
+void score_history_total(const ScoreHistory* history, int64_t from, int64_t to, int64_t now,
+                         HistoryPoint* total) {
+    memset(total, 0, sizeof(*total));
+    total->start = from;
+    if (to > now + 1) to = now + 1;     // Nothing is recorded ahead of now
+    if (to <= from || from <= 0) return;
+
+    HistoryResolution resolution = score_history_resolution_for(from, now);
+    const HistoryBucket* ring = ring_for_const(history, resolution);
+    uint32_t first = period_of(from, resolution);
+    uint32_t span = period_of(to - 1, resolution) - first + 1;
+    if (span > g_slots[resolution]) {
+        first += span - g_slots[resolution];
+        span = g_slots[resolution];
+    }
+
+    for (uint32_t i = 0; i < span; i++) {
+        uint32_t period = first + i;
+        const HistoryBucket* bucket = &ring[period % g_slots[resolution]];
+        if (bucket->period != period) continue;
+        total->score += bucket->score;
+        total->hits += bucket->hits;
+        if (bucket->max_combo > total->max_combo) total->max_combo = bucket->max_combo;
+    }
+}
+
+void score_history_store_init(ScoreHistoryStore* store) {
+    memset(store, 0, sizeof(*store));
+}
+
+void score_history_store_free(ScoreHistoryStore* store) {
+    for (int i = 0; i < MAX_TRACKERS; i++) {
+        free(store->trackers[i]);
+    }
+    memset(store, 0, sizeof(*store));
+}
+
+ScoreHistory* score_history_store_get(ScoreHistoryStore* store, int index, const char* label) {
+    if (index < 0 || index >= MAX_TRACKERS) return NULL;
+    if (!store->trackers[index]) {
+        store->trackers[index] = malloc(sizeof(ScoreHistory));
+        if (!store->trackers[index]) return NULL;
+        score_history_init(store->trackers[index], label);
+    }
+    return store->trackers[index];
+}
+
+void score_history_store_observe(ScoreHistoryStore* store, int64_t now, const ComboState* trackers,
+                                 int tracker_count) {
+    for (int i = 0; i < tracker_count && i < MAX_TRACKERS; i++) {
+        ScoreHistory* history = score_history_store_get(store, i, trackers[i].label);
+        if (history) score_history_observe(history, now, &trackers[i]);
+    }
+}
+
+void score_history_path(char* out, size_t out_size, const char* snapshot_file) {
+    snprintf(out, out_size, "%s.history", snapshot_file);
+}
+
+static void encode_ring(ByteWriter* writer, const HistoryBucket* ring, uint32_t slots) {
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < slots; i++) {
+        if (ring[i].period != 0) used++;
+    }
+    writer_put_varint(writer, used);
+    for (uint32_t i = 0; i < slots; i++) {
+        if (ring[i].period == 0) continue;
+        writer_put_varint(writer, ring[i].period);
+        writer_put_svarint(writer, ring[i].score);
+        writer_put_svarint(writer, ring[i].max_combo);
+        writer_put_varint(writer, ring[i].hits);
+    }
+}
+
+bool score_history_store_encode(const ScoreHistoryStore* store, ByteWriter* writer) {
+    uint32_t count = 0;
+    for (int i = 0; i < MAX_TRACKERS; i++) {
+        if (store->trackers[i]) count++;
+    }
+
+    for (int i = 0; i < 4; i++) writer_put_u8(writer, (uint8_t)SCORE_HISTORY_MAGIC[i]);
+    writer_put_u8(writer, SCORE_HISTORY_VERSION);
+    writer_put_varint(writer, count);
+    for (int i = 0; i < MAX_TRACKERS; i++) {
+        const ScoreHistory* history = store->trackers[i];
+        if (!history) continue;
+        writer_put_string(writer, history->label);
+        for (int r = 0; r < HISTORY_RESOLUTION_COUNT; r++) {
+            encode_ring(writer, ring_for_const(history, (HistoryResolution)r), g_slots[r]);
+        }
+    }
+    if (!writer->failed) {
+        writer_put_u32le(writer, combo_crc32(writer->data, writer->size));
+    }
+    return !writer->failed;
+}
+
+bool score_history_store_save(const ScoreHistoryStore* store, const char* file) {
+    ByteWriter writer;
+    writer_init(&writer, 4096);
+    bool ok = score_history_store_encode(store, &writer) && combo_format_write_file(file, &writer);
+    writer_free(&writer);
+    return ok;
+}
+
+static bool decode_ring(ByteReader* reader, HistoryBucket* ring, uint32_t slots) {
+    uint64_t used = reader_get_varint(reader);
+    if (reader->failed || used > slots) return false;
+    for (uint64_t i = 0; i < used; i++) {
+        HistoryBucket bucket;
+        bucket.period = (uint32_t)reader_get_varint(reader);
+        bucket.score = (int32_t)reader_get_svarint(reader);
+        bucket.max_combo = (int32_t)reader_get_svarint(reader);
+        bucket.hits = (uint32_t)reader_get_varint(reader);
+        if (reader->failed || bucket.period == 0) return false;
+        ring[bucket.period % slots] = bucket;
+    }
+    return true;
+}
+
+int score_history_store_load(ScoreHistoryStore* store, const char* file, const ComboState* trackers,
+                             int tracker_count) {
+    size_t size = 0;
+    uint8_t* data = combo_format_read_file(file, &size);
+    if (!data) return -1;
+    if (size < 10 || memcmp(data, SCORE_HISTORY_MAGIC, 4) != 0 || data[4] != SCORE_HISTORY_VERSION) {
+        free(data);
+        return -1;
+    }
+    uint32_t stored_crc = (uint32_t)data[size - 4] | ((uint32_t)data[size - 3] << 8) |
+                          ((uint32_t)data[size - 2] << 16) | ((uint32_t)data[size - 1] << 24);
+    if (combo_crc32(data, size - 4) != stored_crc) {
+        printf("Score history CRC mismatch, ignoring contents\n");
+        free(data);
+        return -1;
+    }
+
+    ByteReader reader;
+    reader_init(&reader, data + 5, size - 9);
+    uint64_t count = reader_get_varint(&reader);
+    ScoreHistory* scratch = malloc(sizeof(ScoreHistory));
+    bool taken[MAX_TRACKERS] = {false};
+    int restored = 0;
+    for (uint64_t n = 0; scratch && n < count && !reader.failed; n++) {
+        char label[MAX_LABEL_LENGTH];
+        reader_get_string(&reader, label, sizeof(label));
+        score_history_init(scratch, label);
+        bool ok = true;
+        for (int r = 0; r < HISTORY_RESOLUTION_COUNT && ok; r++) {
+            ok = decode_ring(&reader, ring_for(scratch, (HistoryResolution)r), g_slots[r]);
+        }
+        if (!ok) break;
+
+        // Labels are unique in practice; the first tracker not yet restored wins.
+        // The restored history takes its baseline on the first observation.
+        for (int i = 0; i < tracker_count && i < MAX_TRACKERS; i++) {
+            if (taken[i] || strcmp(trackers[i].label, label) != 0) continue;
+            ScoreHistory* history = score_history_store_get(store, i, label);
+            if (!history) break;
+            *history = *scratch;
+            taken[i] = true;
+            restored++;
+            break;
+        }
+    }
+    free(scratch);
+    free(data);
+    return restored;
+}
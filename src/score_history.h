@@ -0,0 +1,119 @@
+#ifndef SCORE_HISTORY_H
+#define SCORE_HISTORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "core.h"
+#include "combo_format.h"
+
+// Score history per tracker, kept as round-robin rollups at three
+// resolutions so progress can be charted without an external log.
+//
+// Each resolution is a fixed ring of buckets indexed by time / width;
+// a bucket holds the score gained, the highest combo seen and the hit
+// count for its period, and remembers which period that is, so a slot
+// left over from an earlier lap reads as empty. Recording touches one
+// bucket per ring, and a range query reads the buckets it covers, never
+// more than one ring's worth.
+//
+// Stored next to the tracker snapshot
+// ("combo_trackers.dat" -> "combo_trackers.dat.history"):
+//
+//   "CHST" | version u8 | tracker_count varint
+//   per tracker: label, then per resolution a count of non-empty buckets
+//   and each bucket's period varint, score svarint, max_combo svarint,
+//   hits varint
+//   CRC-32 of everything above, little-endian u32
+//
+// Times are wall-clock seconds (time(NULL)) so history survives restarts.
+
+#define SCORE_HISTORY_MAGIC "CHST"
+#define SCORE_HISTORY_VERSION 1
+#define SCORE_HISTORY_MAX_PATH 264
+#define SCORE_HISTORY_SAVE_INTERVAL 60     // Seconds between saves while running
+
+#define SCORE_HISTORY_SECOND_SLOTS 600     // 10 minutes
+#define SCORE_HISTORY_MINUTE_SLOTS 1440    // 1 day
+#define SCORE_HISTORY_HOUR_SLOTS 2160      // 90 days
+
+typedef enum {
+    HISTORY_SECONDS,
+    HISTORY_MINUTES,
+    HISTORY_HOURS,
+    HISTORY_RESOLUTION_COUNT
+} HistoryResolution;
+
+typedef struct {
+    uint32_t period;        // time / width; 0 is never a live period
+    int32_t score;          // Score gained, negative after misses
+    int32_t max_combo;
+    uint32_t hits;
+} HistoryBucket;
+
+// One bucket as returned by queries
+typedef struct {
+    int64_t start;          // Seconds
+    int32_t score;
+    int32_t max_combo;
+    uint32_t hits;
+} HistoryPoint;
+
+typedef struct {
+    char label[MAX_LABEL_LENGTH];
+    bool primed;            // last_score / last_hits hold an observed state
+    int32_t last_score;
+    uint32_t last_hits;
+    HistoryBucket seconds[SCORE_HISTORY_SECOND_SLOTS];
+    HistoryBucket minutes[SCORE_HISTORY_MINUTE_SLOTS];
+    HistoryBucket hours[SCORE_HISTORY_HOUR_SLOTS];
+} ScoreHistory;
+
+// Histories for the UI's trackers, by tracker index
+typedef struct {
+    ScoreHistory* trackers[MAX_TRACKERS];
+} ScoreHistoryStore;
+
+void score_history_init(ScoreHistory* history, const char* label);
+
+// Add a change directly: score gained, current combo, hits made
+void score_history_record(ScoreHistory* history, int64_t now, int32_t score, int32_t combo, uint32_t hits);
+// Record whatever changed since the previous observation of this tracker.
+// Cheap when nothing did, so it can run every frame; the first call only
+// takes a baseline.
+void score_history_observe(ScoreHistory* history, int64_t now, const ComboState* state);
+
+// Bucket width and how far back a resolution reaches, in seconds
+uint32_t score_history_width(HistoryResolution resolution);
+uint32_t score_history_retention(HistoryResolution resolution);
+// Finest resolution that still holds `from`
+HistoryResolution score_history_resolution_for(int64_t from, int64_t now);
+
+// Buckets starting in [from, to) at one resolution, oldest first, empty
+// periods included as zeros. Returns the number written, at most `max`.
+uint32_t score_history_query(const ScoreHistory* history, HistoryResolution resolution,
+                             int64_t from, int64_t to, HistoryPoint* points, uint32_t max);
+// Totals over [from, to) at the finest resolution that reaches back to
+// `from`; partial buckets at the edges count in full
+void score_history_total(const ScoreHistory* history, int64_t from, int64_t to, int64_t now,
+                         HistoryPoint* total);
+
+void score_history_store_init(ScoreHistoryStore* store);
+void score_history_store_free(ScoreHistoryStore* store);
+// History for tracker `index`, created on first use; NULL if out of range
+// or out of memory
+ScoreHistory* score_history_store_get(ScoreHistoryStore* store, int index, const char* label);
+void score_history_store_observe(ScoreHistoryStore* store, int64_t now, const ComboState* trackers,
+                                 int tracker_count);
+
+void score_history_path(char* out, size_t out_size, const char* snapshot_file);
+// The file contents, e.g. to hand to persistence_queue_write; false if
+// the writer ran out of memory
+bool score_history_store_encode(const ScoreHistoryStore* store, ByteWriter* writer);
+bool score_history_store_save(const ScoreHistoryStore* store, const char* file);
+// Histories are matched to trackers by label; returns how many were
+// restored, or -1 if the file is missing or corrupt
+int score_history_store_load(ScoreHistoryStore* store, const char* file, const ComboState* trackers,
+                             int tracker_count);
+
+#endif // SCORE_HISTORY_H
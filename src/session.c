@@ -0,0 +1,201 @@
+#include "session.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SESSION_HEADER_SIZE 20
+#define SESSION_V1_HEADER_SIZE 12
+#define SESSION_MAX_RECORD (1 + 10 + 10 + 10)
+
+static void put_u32le(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t get_u32le(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+static void put_u64le(uint8_t* out, uint64_t value) {
+    put_u32le(out, (uint32_t)value);
+    put_u32le(out + 4, (uint32_t)(value >> 32));
+}
+
+static uint64_t get_u64le(const uint8_t* in) {
+    return (uint64_t)get_u32le(in) | ((uint64_t)get_u32le(in + 4) << 32);
+}
+
+static size_t put_varint(uint8_t* out, uint64_t value) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = (uint8_t)value;
+    return n;
+}
+
+// Returns false at the end of the data (torn record) or on overlong input
+static bool get_varint(const uint8_t* data, size_t size, size_t* pos, uint64_t* value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (*pos >= size) return false;
+        uint8_t byte = data[(*pos)++];
+        result |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void recorder_flush(SessionRecorder* recorder) {
+    if (recorder->size == 0) return;
+    if (fwrite(recorder->buffer, 1, recorder->size, recorder->file) != recorder->size) {
+        recorder->failed = true;
+    }
+    recorder->size = 0;
+}
+
+bool session_recorder_open(SessionRecorder* recorder, const char* path, SessionSource source,
+                           const void* base, uint32_t base_size, uint64_t base_time_us) {
+    memset(recorder, 0, sizeof(*recorder));
+    recorder->file = fopen(path, "wb");
+    if (!recorder->file) return false;
+
+    uint8_t header[SESSION_HEADER_SIZE];
+    put_u32le(header, SESSION_MAGIC);
+    header[4] = SESSION_VERSION;
+    header[5] = (uint8_t)source;
+    header[6] = 0;
+    header[7] = 0;
+    put_u32le(header + 8, base_size);
+    put_u64le(header + 12, base_time_us);
+    if (fwrite(header, 1, sizeof(header), recorder->file) != sizeof(header) ||
+        (base_size > 0 && fwrite(base, 1, base_size, recorder->file) != base_size)) {
+        fclose(recorder->file);
+        recorder->file = NULL;
+        return false;
+    }
+    return true;
+}
+
+void session_record(SessionRecorder* recorder, const SessionEvent* event) {
+    if (!recorder->file) return;
+    if (recorder->size + SESSION_MAX_RECORD > SESSION_BUFFER_SIZE) {
+        recorder_flush(recorder);
+    }
+
+    uint64_t delta = event->time_us > recorder->last_time_us ? event->time_us - recorder->last_time_us : 0;
+    recorder->last_time_us += delta;
+
+    uint8_t* out = recorder->buffer + recorder->size;
+    size_t n = 0;
+    out[n++] = (uint8_t)((event->op & 0x0F) | (event->quality << 4));
+    n += put_varint(out + n, event->tracker);
+    n += put_varint(out + n, delta);
+    n += put_varint(out + n, event->amount);
+    recorder->size += n;
+    recorder->event_count++;
+}
+
+void session_record_frame(SessionRecorder* recorder, uint64_t time_us, float dt) {
+    SessionEvent event = {time_us, 0, 0, SESSION_OP_FRAME, 0};
+    memcpy(&event.amount, &dt, sizeof(float));
+    session_record(recorder, &event);
+}
+
+bool session_recorder_close(SessionRecorder* recorder) {
+    if (!recorder->file) return false;
+    recorder_flush(recorder);
+    if (fclose(recorder->file) != 0) recorder->failed = true;
+    recorder->file = NULL;
+    return !recorder->failed;
+}
+
+float session_frame_dt(const SessionEvent* event) {
+    float dt;
+    memcpy(&dt, &event->amount, sizeof(float));
+    return dt;
+}
+
+bool session_load(SessionLog* log, const char* path) {
+    memset(log, 0, sizeof(*log));
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (file_size < SESSION_V1_HEADER_SIZE) {
+        fclose(file);
+        return false;
+    }
+    uint8_t* data = malloc((size_t)file_size);
+    if (!data || fread(data, 1, (size_t)file_size, file) != (size_t)file_size) {
+        free(data);
+        fclose(file);
+        return false;
+    }
+    fclose(file);
+
+    size_t size = (size_t)file_size;
+    uint8_t version = data[4];
+    size_t header_size = version == 1 ? SESSION_V1_HEADER_SIZE : SESSION_HEADER_SIZE;
+    uint32_t base_size = get_u32le(data + 8);
+    if (get_u32le(data) != SESSION_MAGIC || version < 1 || version > SESSION_VERSION ||
+        size < header_size || base_size > size - header_size) {
+        free(data);
+        return false;
+    }
+    log->source = data[5];
+    bool has_base_time = version >= 2;
+    if (has_base_time) log->base_time_us = get_u64le(data + 12);
+    if (base_size > 0) {
+        log->base = malloc(base_size);
+        if (!log->base) {
+            free(data);
+            return false;
+        }
+        memcpy(log->base, data + header_size, base_size);
+        log->base_size = base_size;
+    }
+
+    // Every record is at least 4 bytes, which bounds the event count
+    size_t pos = header_size + base_size;
+    size_t capacity = (size - pos) / 4 + 1;
+    log->events = malloc(capacity * sizeof(SessionEvent));
+    if (!log->events) {
+        free(data);
+        session_log_free(log);
+        return false;
+    }
+
+    uint64_t time_us = 0;
+    while (pos < size) {
+        SessionEvent event;
+        uint8_t tag = data[pos++];
+        uint64_t tracker, delta, amount;
+        if (!get_varint(data, size, &pos, &tracker) || !get_varint(data, size, &pos, &delta) ||
+            !get_varint(data, size, &pos, &amount)) {
+            break;  // Torn tail
+        }
+        time_us += delta;
+        event.time_us = time_us;
+        event.op = tag & 0x0F;
+        event.quality = tag >> 4;
+        event.tracker = (uint16_t)tracker;
+        event.amount = (uint32_t)amount;
+        log->events[log->count++] = event;
+    }
+    free(data);
+    if (!has_base_time && log->count > 0) log->base_time_us = log->events[0].time_us;
+    return true;
+}
+
+void session_log_free(SessionLog* log) {
+    free(log->base);
+    free(log->events);
+    memset(log, 0, sizeof(*log));
+}
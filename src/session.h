@@ -0,0 +1,84 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Recorded input sessions, for regression replays and profiling.
+//
+//   "CNSS" u32le | version u8 | source u8 | reserved u16
+//   base_size u32le | base_time_us u64le
+//   base (tracker state the session starts from)
+//   events: op | quality << 4 (u8), tracker varint,
+//           microseconds since the previous event varint, amount varint
+//
+// The base is opaque here: the desktop app stores a combo_format tracker
+// file, the embedded simulator its ComboDevice. FRAME events carry the
+// per-frame dt as raw float bits so update steps replay exactly. A torn
+// final record (crash while recording) is ignored on load. base_time_us is
+// the clock the base was captured at, on the same clock as the events, so
+// a replay can restore the base's decay timers exactly. Version 1 files
+// have no base time; the first event's time stands in for it.
+//
+// Kept free of core.h so the embedded simulator, whose core has its own
+// limits, can record and replay with the same file format.
+
+#define SESSION_MAGIC 0x53534E43u   // "CNSS"
+#define SESSION_VERSION 2
+#define SESSION_BUFFER_SIZE 4096
+
+typedef enum {
+    SESSION_SOURCE_DESKTOP = 1,
+    SESSION_SOURCE_EMBEDDED = 2
+} SessionSource;
+
+// 1-4 match JournalOp
+typedef enum {
+    SESSION_OP_HIT = 1,         // amount = points (desktop) / unused (embedded)
+    SESSION_OP_DECREMENT = 2,   // amount = points
+    SESSION_OP_PAUSE = 3,
+    SESSION_OP_RESUME = 4,
+    SESSION_OP_FRAME = 5,       // amount = dt seconds as float bits, all trackers
+    SESSION_OP_RESET = 6        // Counter reset (embedded settings screen)
+} SessionOp;
+
+typedef struct {
+    uint64_t time_us;           // Monotonic; earlier times are stored as no gap
+    uint32_t amount;
+    uint16_t tracker;
+    uint8_t op;                 // SessionOp
+    uint8_t quality;            // Embedded ActionQuality; 0 on desktop
+} SessionEvent;
+
+typedef struct {
+    FILE* file;
+    uint8_t buffer[SESSION_BUFFER_SIZE];
+    size_t size;
+    uint64_t last_time_us;
+    uint32_t event_count;
+    bool failed;
+} SessionRecorder;
+
+typedef struct {
+    uint8_t source;             // SessionSource
+    uint8_t* base;
+    uint32_t base_size;
+    uint64_t base_time_us;      // Clock time the base was captured at
+    SessionEvent* events;
+    uint32_t count;
+} SessionLog;
+
+bool session_recorder_open(SessionRecorder* recorder, const char* path, SessionSource source,
+                           const void* base, uint32_t base_size, uint64_t base_time_us);
+void session_record(SessionRecorder* recorder, const SessionEvent* event);
+void session_record_frame(SessionRecorder* recorder, uint64_t time_us, float dt);
+// Flushes and closes; false if any write failed
+bool session_recorder_close(SessionRecorder* recorder);
+
+bool session_load(SessionLog* log, const char* path);
+void session_log_free(SessionLog* log);
+float session_frame_dt(const SessionEvent* event);
+
+#endif // SESSION_H
@@ -0,0 +1,99 @@
+#include "session_replay.h"
+#include "combo_format.h"
+#include <string.h>
+
+static __thread double replay_time;  // Per thread, like the combo clock
+
+static double replay_clock(void) {
+    return replay_time;
+}
+
+int session_replay_load_base(const SessionLog* log, ComboState* trackers, int max_trackers) {
+    if (log->source != SESSION_SOURCE_DESKTOP || log->base_size == 0) return -1;
+
+    // Decoded trackers take last_hit_time from the combo clock, so the base
+    // is decoded at the time it was captured, not the host's current uptime
+    replay_time = (double)log->base_time_us / 1e6;
+    combo_set_clock(replay_clock);
+    int count = combo_format_decode(log->base, log->base_size, trackers, max_trackers, NULL, NULL);
+    combo_set_clock(NULL);
+    return count;
+}
+
+void session_replay(const SessionLog* log, ComboState* trackers, int tracker_count,
+                    SessionReplayStats* stats) {
+    SessionReplayStats local;
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+    if (log->count > 0) {
+        stats->session_seconds = (double)(log->events[log->count - 1].time_us - log->events[0].time_us) / 1e6;
+    }
+
+    combo_set_clock(replay_clock);
+    for (uint32_t i = 0; i < log->count; i++) {
+        const SessionEvent* event = &log->events[i];
+        replay_time = (double)event->time_us / 1e6;
+
+        if (event->op == SESSION_OP_FRAME) {
+            float dt = session_frame_dt(event);
+            for (int t = 0; t < tracker_count; t++) {
+                combo_update(&trackers[t], dt);
+            }
+            stats->frames++;
+            continue;
+        }
+        if (event->tracker >= tracker_count) {
+            stats->skipped++;
+            continue;
+        }
+
+        ComboState* state = &trackers[event->tracker];
+        switch (event->op) {
+            case SESSION_OP_HIT:
+                combo_increment(state, event->amount);
+                stats->hits++;
+                break;
+            case SESSION_OP_DECREMENT:
+                combo_decrement(state, event->amount);
+                stats->decrements++;
+                break;
+            case SESSION_OP_PAUSE:
+                combo_pause(state);
+                break;
+            case SESSION_OP_RESUME:
+                combo_resume(state);
+                break;
+            default:
+                stats->skipped++;
+                break;
+        }
+    }
+    combo_set_clock(NULL);
+}
+
+static uint64_t digest_bytes(uint64_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t session_state_digest(const ComboState* trackers, int tracker_count) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (int i = 0; i < tracker_count; i++) {
+        const ComboState* state = &trackers[i];
+        hash = digest_bytes(hash, &state->combo, sizeof(state->combo));
+        hash = digest_bytes(hash, &state->max_combo, sizeof(state->max_combo));
+        hash = digest_bytes(hash, &state->score, sizeof(state->score));
+        hash = digest_bytes(hash, &state->total_hits, sizeof(state->total_hits));
+        hash = digest_bytes(hash, &state->perfect_hits, sizeof(state->perfect_hits));
+        hash = digest_bytes(hash, &state->miss_hits, sizeof(state->miss_hits));
+        hash = digest_bytes(hash, &state->multiplier, sizeof(state->multiplier));
+        hash = digest_bytes(hash, &state->decay_pause, sizeof(state->decay_pause));
+        hash = digest_bytes(hash, &state->paused, sizeof(state->paused));
+        hash = digest_bytes(hash, &state->completed_intervals, sizeof(state->completed_intervals));
+    }
+    return hash;
+}
@@ -0,0 +1,34 @@
+#ifndef SESSION_REPLAY_H
+#define SESSION_REPLAY_H
+
+#include <stdint.h>
+#include "core.h"
+#include "session.h"
+
+// Headless replay of a recorded desktop session. The combo clock is
+// driven from the event timestamps instead of the wall clock, so decay
+// and hit timing come out as they did live while the session runs as
+// fast as the trackers can be updated. Scoring follows the calling thread's
+// combo_set_tuning, and replays on different threads do not interfere.
+
+typedef struct {
+    uint32_t hits;
+    uint32_t decrements;
+    uint32_t frames;
+    uint32_t skipped;           // Unknown tracker or op
+    double session_seconds;     // First to last event timestamp
+} SessionReplayStats;
+
+// Decode the session's base into `trackers` as of the session's base time;
+// returns the tracker count or -1 if the session has no usable base.
+// Restores the default combo clock on return.
+int session_replay_load_base(const SessionLog* log, ComboState* trackers, int max_trackers);
+
+// Apply every event to `trackers`. Restores the default combo clock on return.
+void session_replay(const SessionLog* log, ComboState* trackers, int tracker_count,
+                    SessionReplayStats* stats);
+
+// FNV-1a over the replay-visible tracker fields, for regression comparisons
+uint64_t session_state_digest(const ComboState* trackers, int tracker_count);
+
+#endif // SESSION_REPLAY_H
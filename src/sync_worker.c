@@ -0,0 +1,567 @@
+#define _POSIX_C_SOURCE 200809L
+#include "sync_worker.h"
+#include "combo_format.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <curl/curl.h>
+
+typedef struct {
+    char* data;
+    size_t size;
+    size_t capacity;
+    bool failed;
+
+    // Fetches: successful responses are decoded as they arrive instead
+    CURL* easy;
+    ObjectiveStream* stream;
+    size_t streamed;
+} ResponseBuffer;
+
+// Appends every chunk; curl may deliver a body in many pieces
+static size_t write_callback(void* contents, size_t size, size_t nmemb, void* userp) {
+    ResponseBuffer* buffer = userp;
+    size_t chunk = size * nmemb;
+    if (buffer->stream) {
+        long status = 0;
+        curl_easy_getinfo(buffer->easy, CURLINFO_RESPONSE_CODE, &status);
+        if (status == 200) {
+            if (!objective_stream_feed(buffer->stream, contents, chunk)) return 0;
+            buffer->streamed += chunk;
+            return chunk;
+        }
+    }
+    if (buffer->size + chunk + 1 > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity : 1024;
+        while (capacity < buffer->size + chunk + 1) capacity *= 2;
+        char* data = realloc(buffer->data, capacity);
+        if (!data) {
+            buffer->failed = true;
+            return 0;
+        }
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->data + buffer->size, contents, chunk);
+    buffer->size += chunk;
+    buffer->data[buffer->size] = '\0';
+    return chunk;
+}
+
+// Captures the ETag response header into a SYNC_WORKER_MAX_ETAG buffer
+static size_t header_callback(char* line, size_t size, size_t nitems, void* userp) {
+    char* etag = userp;
+    size_t length = size * nitems;
+    if (length > 5 && strncasecmp(line, "ETag:", 5) == 0) {
+        const char* value = line + 5;
+        const char* end = line + length;
+        while (value < end && (*value == ' ' || *value == '\t')) value++;
+        while (end > value && (end[-1] == '\r' || end[-1] == '\n' || end[-1] == ' ')) end--;
+        size_t n = (size_t)(end - value);
+        if (n < SYNC_WORKER_MAX_ETAG) {
+            memcpy(etag, value, n);
+            etag[n] = '\0';
+        }
+    }
+    return length;
+}
+
+static void json_put_raw(ByteWriter* w, const char* text) {
+    while (*text) writer_put_u8(w, (uint8_t)*text++);
+}
+
+static void json_put_string(ByteWriter* w, const char* text) {
+    writer_put_u8(w, '"');
+    for (const unsigned char* c = (const unsigned char*)text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            writer_put_u8(w, '\\');
+            writer_put_u8(w, *c);
+        } else if (*c < 0x20) {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", *c);
+            json_put_raw(w, escape);
+        } else {
+            writer_put_u8(w, *c);
+        }
+    }
+    writer_put_u8(w, '"');
+}
+
+static void json_put_int(ByteWriter* w, long long value) {
+    char number[24];
+    snprintf(number, sizeof(number), "%lld", value);
+    json_put_raw(w, number);
+}
+
+static uint32_t fnv1a(const char* text) {
+    uint32_t hash = 2166136261u;
+    while (*text) {
+        hash ^= (uint8_t)*text++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Slot holding `key`, or the empty slot where it would go
+static SyncAck* ack_slot(SyncAck* acks, uint32_t capacity, uint64_t key) {
+    uint32_t mask = capacity - 1;
+    uint32_t i = (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 40) & mask;
+    while (acks[i].used && acks[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    return &acks[i];
+}
+
+static const SyncAck* ack_find(const SyncWorker* worker, uint64_t key) {
+    if (worker->ack_capacity == 0) return NULL;
+    SyncAck* ack = ack_slot(worker->acks, worker->ack_capacity, key);
+    return ack->used ? ack : NULL;
+}
+
+static void ack_store(SyncWorker* worker, const SyncAck* change) {
+    // Keep the table under 70% full
+    if ((worker->ack_count + 1) * 10 > worker->ack_capacity * 7) {
+        uint32_t capacity = worker->ack_capacity ? worker->ack_capacity * 2 : 64;
+        SyncAck* acks = calloc(capacity, sizeof(SyncAck));
+        if (!acks) return;  // Unrecorded acks are simply sent again
+        for (uint32_t i = 0; i < worker->ack_capacity; i++) {
+            if (worker->acks[i].used) {
+                *ack_slot(acks, capacity, worker->acks[i].key) = worker->acks[i];
+            }
+        }
+        free(worker->acks);
+        worker->acks = acks;
+        worker->ack_capacity = capacity;
+    }
+    SyncAck* ack = ack_slot(worker->acks, worker->ack_capacity, change->key);
+    if (!ack->used) worker->ack_count++;
+    *ack = *change;
+    ack->used = true;
+}
+
+static bool snapshot_append(SyncSnapshot* snapshot, uint32_t* capacity, const SyncAck* change) {
+    if (snapshot->count == *capacity) {
+        uint32_t grown = *capacity ? *capacity * 2 : 16;
+        SyncAck* changes = realloc(snapshot->changes, grown * sizeof(SyncAck));
+        if (!changes) return false;
+        snapshot->changes = changes;
+        *capacity = grown;
+    }
+    snapshot->changes[snapshot->count++] = *change;
+    return true;
+}
+
+// With `worker` set, only objectives that differ from its acks are written
+// and recorded in `snapshot`; returns NULL with *size 0 if none differ.
+static char* encode_trackers(const ComboState* trackers, int tracker_count,
+                             const SyncWorker* worker, SyncSnapshot* snapshot, size_t* size) {
+    ByteWriter w;
+    writer_init(&w, 256);
+    json_put_raw(&w, "{\"trackers\":[");
+    uint32_t snapshot_capacity = 0;
+    uint32_t written_trackers = 0;
+    bool failed = false;
+
+    for (int t = 0; t < tracker_count && !failed; t++) {
+        const ComboState* state = &trackers[t];
+        uint64_t label_hash = (uint64_t)fnv1a(state->label) << 32;
+        uint32_t written = 0;
+
+        for (uint32_t i = 0; i < state->objective_count; i++) {
+            const Objective* obj = &state->objectives[i];
+            SyncAck change = {label_hash | fnv1a(obj->name), obj->current_score, obj->completed, true};
+            if (worker) {
+                const SyncAck* ack = ack_find(worker, change.key);
+                if (ack && ack->score == change.score && ack->completed == change.completed) continue;
+                if (!snapshot_append(snapshot, &snapshot_capacity, &change)) {
+                    failed = true;
+                    break;
+                }
+            }
+
+            if (written == 0) {
+                if (written_trackers > 0) writer_put_u8(&w, ',');
+                json_put_raw(&w, "{\"label\":");
+                json_put_string(&w, state->label);
+                json_put_raw(&w, ",\"objectives\":[");
+                written_trackers++;
+            } else {
+                writer_put_u8(&w, ',');
+            }
+            json_put_raw(&w, "{\"name\":");
+            json_put_string(&w, obj->name);
+            json_put_raw(&w, ",\"current_score\":");
+            json_put_int(&w, obj->current_score);
+            json_put_raw(&w, obj->completed ? ",\"completed\":true}" : ",\"completed\":false}");
+            written++;
+        }
+        if (written > 0) json_put_raw(&w, "]}");
+    }
+    json_put_raw(&w, "]}");
+    writer_put_u8(&w, '\0');
+
+    *size = 0;
+    if (failed || w.failed || (worker && written_trackers == 0)) {
+        writer_free(&w);
+        return NULL;
+    }
+    *size = w.size - 1;
+    return (char*)w.data;
+}
+
+char* sync_encode_progress(const ComboState* trackers, int tracker_count, size_t* size) {
+    return encode_trackers(trackers, tracker_count, NULL, NULL, size);
+}
+
+static void snapshot_drop(SyncWorker* worker, uint32_t index) {
+    free(worker->snapshots[index].changes);
+    worker->snapshot_count--;
+    memmove(&worker->snapshots[index], &worker->snapshots[index + 1],
+            (worker->snapshot_count - index) * sizeof(SyncSnapshot));
+}
+
+// Results arrive in submission order, so anything older than `sequence`
+// was superseded or its result was dropped
+static void snapshot_resolve(SyncWorker* worker, uint32_t sequence, bool acknowledged) {
+    while (worker->snapshot_count > 0 && worker->snapshots[0].sequence <= sequence) {
+        SyncSnapshot* snapshot = &worker->snapshots[0];
+        if (snapshot->sequence == sequence && acknowledged) {
+            for (uint32_t i = 0; i < snapshot->count; i++) {
+                ack_store(worker, &snapshot->changes[i]);
+            }
+        }
+        snapshot_drop(worker, 0);
+    }
+}
+
+static void push_result(SyncWorker* worker, const SyncResult* result) {
+    pthread_mutex_lock(&worker->lock);
+    if (worker->result_count == SYNC_WORKER_RESULT_CAPACITY) {
+        // Keep the newest results; the simulation thread has fallen behind
+        sync_result_free(&worker->results[worker->result_head]);
+        worker->result_head = (worker->result_head + 1) % SYNC_WORKER_RESULT_CAPACITY;
+        worker->result_count--;
+        worker->stats.results_dropped++;
+    }
+    uint32_t tail = (worker->result_head + worker->result_count) % SYNC_WORKER_RESULT_CAPACITY;
+    worker->results[tail] = *result;
+    worker->result_count++;
+    pthread_mutex_unlock(&worker->lock);
+}
+
+static bool should_stop(SyncWorker* worker) {
+    return __atomic_load_n(&worker->stop, __ATOMIC_ACQUIRE);
+}
+
+static void run_job(SyncWorker* worker, SyncJobKind kind, uint32_t sequence, char* body, size_t body_size) {
+    CURLM* multi = worker->multi;
+    CURL* easy = worker->easy;
+    ResponseBuffer response = {0};
+    struct curl_slist* headers = NULL;
+    char etag[SYNC_WORKER_MAX_ETAG] = "";
+    ObjectiveCatalog* catalog = NULL;
+    ObjectiveStream stream;
+    if (kind == SYNC_JOB_FETCH) {
+        catalog = malloc(sizeof(ObjectiveCatalog));
+        if (catalog) {
+            objective_catalog_init(catalog);
+            objective_stream_init(&stream, objective_catalog_sink(catalog));
+            response.easy = easy;
+            response.stream = &stream;
+        }
+    }
+
+    curl_easy_setopt(easy, CURLOPT_URL, worker->url);
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, write_callback);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, &response);
+    curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, header_callback);
+    curl_easy_setopt(easy, CURLOPT_HEADERDATA, (void*)etag);
+    if (kind == SYNC_JOB_PUSH) {
+        headers = curl_slist_append(headers, "Content-Type: application/json");
+        curl_easy_setopt(easy, CURLOPT_POSTFIELDS, body);
+        curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, (long)body_size);
+    } else {
+        if (worker->etag[0]) {
+            char condition[SYNC_WORKER_MAX_ETAG + 16];
+            snprintf(condition, sizeof(condition), "If-None-Match: %s", worker->etag);
+            headers = curl_slist_append(headers, condition);
+        }
+        curl_easy_setopt(easy, CURLOPT_HTTPGET, 1L);
+    }
+    curl_easy_setopt(easy, CURLOPT_HTTPHEADER, headers);
+
+    SyncResult result = {0};
+    result.kind = kind;
+    result.sequence = sequence;
+    result.curl_code = CURLE_OK;
+
+    curl_multi_add_handle(multi, easy);
+    int running = 1;
+    while (running) {
+        CURLMcode mc = curl_multi_perform(multi, &running);
+        if (mc != CURLM_OK) {
+            result.curl_code = CURLE_FAILED_INIT;
+            break;
+        }
+        if (!running) break;
+        if (should_stop(worker)) {
+            result.curl_code = CURLE_ABORTED_BY_CALLBACK;
+            break;
+        }
+        curl_multi_poll(multi, NULL, 0, SYNC_WORKER_POLL_MS, NULL);
+    }
+
+    CURLMsg* msg;
+    int remaining;
+    while ((msg = curl_multi_info_read(multi, &remaining))) {
+        if (msg->msg == CURLMSG_DONE && msg->easy_handle == easy) {
+            result.curl_code = msg->data.result;
+        }
+    }
+    if (result.curl_code == CURLE_OK) {
+        curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &result.http_status);
+    }
+    if (response.failed) {
+        result.curl_code = CURLE_WRITE_ERROR;
+    }
+    if (catalog && result.http_status == 200 && result.curl_code == CURLE_OK) {
+        if (objective_stream_finish(&stream) && !catalog->failed) {
+            result.catalog = catalog;
+            catalog = NULL;
+            memcpy(worker->etag, etag, sizeof(etag));
+        } else {
+            result.curl_code = CURLE_WRITE_ERROR;
+        }
+    }
+    if (catalog) {
+        objective_catalog_free(catalog);
+        free(catalog);
+    }
+
+    long new_connections = 0;
+    curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &new_connections);
+    // Removing the easy handle leaves its connection in the multi's pool
+    curl_multi_remove_handle(multi, easy);
+    curl_slist_free_all(headers);
+    free(body);
+
+    result.body = response.data;
+    result.body_size = response.size;
+    if (!result.body) {
+        result.body = calloc(1, 1);
+    }
+
+    pthread_mutex_lock(&worker->lock);
+    worker->stats.requests++;
+    worker->stats.new_connections += (uint32_t)new_connections;
+    worker->stats.bytes_sent += body_size;
+    worker->stats.bytes_received += response.size + response.streamed;
+    if (result.http_status == 304) worker->stats.not_modified++;
+    pthread_mutex_unlock(&worker->lock);
+
+    push_result(worker, &result);
+}
+
+static void* worker_main(void* arg) {
+    SyncWorker* worker = arg;
+
+    for (;;) {
+        pthread_mutex_lock(&worker->lock);
+        while (!worker->stop && !worker->pending[SYNC_JOB_PUSH] && !worker->pending[SYNC_JOB_FETCH]) {
+            pthread_cond_wait(&worker->wake, &worker->lock);
+        }
+        if (worker->stop) {
+            pthread_mutex_unlock(&worker->lock);
+            break;
+        }
+
+        // Oldest job first
+        SyncJobKind kind = SYNC_JOB_PUSH;
+        if (!worker->pending[SYNC_JOB_PUSH] ||
+            (worker->pending[SYNC_JOB_FETCH] &&
+             worker->pending_sequence[SYNC_JOB_FETCH] < worker->pending_sequence[SYNC_JOB_PUSH])) {
+            kind = SYNC_JOB_FETCH;
+        }
+        uint32_t sequence = worker->pending_sequence[kind];
+        char* body = worker->pending_body[kind];
+        size_t body_size = worker->pending_size[kind];
+        worker->pending[kind] = false;
+        worker->pending_body[kind] = NULL;
+        pthread_mutex_unlock(&worker->lock);
+
+        run_job(worker, kind, sequence, body, body_size);
+    }
+    return NULL;
+}
+
+bool sync_worker_start(SyncWorker* worker, const char* url) {
+    memset(worker, 0, sizeof(*worker));
+    strncpy(worker->url, url, SYNC_WORKER_MAX_URL - 1);
+    worker->next_sequence = 1;
+
+    // Not thread-safe; done here on the caller's thread
+    if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) return false;
+
+    CURLM* multi = curl_multi_init();
+    CURL* easy = curl_easy_init();
+    if (!multi || !easy) {
+        if (easy) curl_easy_cleanup(easy);
+        if (multi) curl_multi_cleanup(multi);
+        curl_global_cleanup();
+        return false;
+    }
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+    worker->multi = multi;
+    worker->easy = easy;
+
+    pthread_mutex_init(&worker->lock, NULL);
+    pthread_cond_init(&worker->wake, NULL);
+    if (pthread_create(&worker->thread, NULL, worker_main, worker) != 0) {
+        pthread_cond_destroy(&worker->wake);
+        pthread_mutex_destroy(&worker->lock);
+        curl_easy_cleanup(easy);
+        curl_multi_cleanup(multi);
+        curl_global_cleanup();
+        return false;
+    }
+    worker->started = true;
+    return true;
+}
+
+void sync_worker_stop(SyncWorker* worker) {
+    if (!worker->started) return;
+
+    pthread_mutex_lock(&worker->lock);
+    __atomic_store_n(&worker->stop, true, __ATOMIC_RELEASE);
+    pthread_cond_signal(&worker->wake);
+    pthread_mutex_unlock(&worker->lock);
+    curl_multi_wakeup(worker->multi);
+    pthread_join(worker->thread, NULL);
+
+    for (int kind = 0; kind < SYNC_JOB_KINDS; kind++) {
+        free(worker->pending_body[kind]);
+    }
+    SyncResult result;
+    while (sync_worker_poll(worker, &result)) {
+        sync_result_free(&result);
+    }
+    while (worker->snapshot_count > 0) {
+        snapshot_drop(worker, 0);
+    }
+    free(worker->acks);
+    worker->acks = NULL;
+    worker->ack_capacity = 0;
+    worker->ack_count = 0;
+
+    curl_easy_cleanup(worker->easy);
+    curl_multi_cleanup(worker->multi);
+    curl_global_cleanup();
+    pthread_cond_destroy(&worker->wake);
+    pthread_mutex_destroy(&worker->lock);
+    worker->started = false;
+}
+
+// Sets *superseded to the sequence of a pending job this one replaced
+static uint32_t submit(SyncWorker* worker, SyncJobKind kind, char* body, size_t body_size,
+                       uint32_t* superseded) {
+    *superseded = 0;
+    pthread_mutex_lock(&worker->lock);
+    if (worker->pending[kind]) {
+        // Not started yet: the newer request supersedes it
+        free(worker->pending_body[kind]);
+        *superseded = worker->pending_sequence[kind];
+        if (kind == SYNC_JOB_PUSH) worker->stats.coalesced++;
+    }
+    uint32_t sequence = worker->next_sequence++;
+    worker->pending[kind] = true;
+    worker->pending_body[kind] = body;
+    worker->pending_size[kind] = body_size;
+    worker->pending_sequence[kind] = sequence;
+    pthread_cond_signal(&worker->wake);
+    pthread_mutex_unlock(&worker->lock);
+    return sequence;
+}
+
+uint32_t sync_worker_push(SyncWorker* worker, const ComboState* trackers, int tracker_count) {
+    if (!worker->started) return 0;
+    SyncSnapshot snapshot = {0};
+    size_t size = 0;
+    char* body = encode_trackers(trackers, tracker_count, worker, &snapshot, &size);
+    if (!body) {
+        free(snapshot.changes);
+        return 0;
+    }
+
+    // The new body already carries everything a superseded push did
+    uint32_t superseded;
+    snapshot.sequence = submit(worker, SYNC_JOB_PUSH, body, size, &superseded);
+    for (uint32_t i = 0; i < worker->snapshot_count; i++) {
+        if (worker->snapshots[i].sequence == superseded) {
+            snapshot_drop(worker, i);
+            break;
+        }
+    }
+    if (worker->snapshot_count == SYNC_WORKER_MAX_SNAPSHOTS) {
+        snapshot_drop(worker, 0);  // Its values will just be sent again
+    }
+    worker->snapshots[worker->snapshot_count++] = snapshot;
+
+    pthread_mutex_lock(&worker->lock);
+    worker->stats.objectives_sent += snapshot.count;
+    pthread_mutex_unlock(&worker->lock);
+    return snapshot.sequence;
+}
+
+void sync_worker_resync(SyncWorker* worker) {
+    while (worker->snapshot_count > 0) {
+        snapshot_drop(worker, 0);
+    }
+    if (worker->acks) {
+        memset(worker->acks, 0, worker->ack_capacity * sizeof(SyncAck));
+    }
+    worker->ack_count = 0;
+}
+
+uint32_t sync_worker_fetch(SyncWorker* worker) {
+    if (!worker->started) return 0;
+    uint32_t superseded;
+    return submit(worker, SYNC_JOB_FETCH, NULL, 0, &superseded);
+}
+
+bool sync_worker_poll(SyncWorker* worker, SyncResult* result) {
+    pthread_mutex_lock(&worker->lock);
+    bool ready = worker->result_count > 0;
+    if (ready) {
+        *result = worker->results[worker->result_head];
+        worker->result_head = (worker->result_head + 1) % SYNC_WORKER_RESULT_CAPACITY;
+        worker->result_count--;
+    }
+    pthread_mutex_unlock(&worker->lock);
+
+    if (ready && result->kind == SYNC_JOB_PUSH) {
+        bool acknowledged = result->curl_code == CURLE_OK &&
+                            result->http_status >= 200 && result->http_status < 300;
+        snapshot_resolve(worker, result->sequence, acknowledged);
+    }
+    return ready;
+}
+
+void sync_result_free(SyncResult* result) {
+    free(result->body);
+    result->body = NULL;
+    result->body_size = 0;
+    if (result->catalog) {
+        objective_catalog_free(result->catalog);
+        free(result->catalog);
+        result->catalog = NULL;
+    }
+}
+
+SyncWorkerStats sync_worker_stats(SyncWorker* worker) {
+    pthread_mutex_lock(&worker->lock);
+    SyncWorkerStats stats = worker->stats;
+    pthread_mutex_unlock(&worker->lock);
+    return stats;
+}
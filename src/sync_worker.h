@@ -0,0 +1,148 @@
+#ifndef SYNC_WORKER_H
+#define SYNC_WORKER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "core.h"
+#include "objective_stream.h"
+
+// Background objective sync.
+//
+// One worker thread owns a curl multi handle and a single reused easy
+// handle, so every request goes over the same kept-alive connection
+// instead of a fresh TCP/TLS handshake per tracker. Submitting never
+// blocks on the network: sync_worker_push encodes all trackers' objective
+// changes into one request body and queues it; a push that has not
+// started yet is replaced by a newer one. Responses come back through a
+// result queue that the simulation thread polls once per frame.
+//
+// Pushes are deltas. The worker remembers the last score/completed value
+// the server acknowledged (2xx) for each (tracker label, objective name)
+// and only sends objectives that differ; objectives left out are
+// unchanged. Fetches send If-None-Match with the last ETag, so an
+// unchanged list comes back as an empty 304 that needs no parsing.
+//
+//   push:  POST url  {"trackers":[{"label":...,"objectives":[
+//                      {"name":...,"current_score":n,"completed":b}]}]}
+//   fetch: GET  url  (200: decoded while it downloads into
+//                     result.catalog, applied with combo_sync_apply_catalog;
+//                     304: nothing changed)
+
+#define SYNC_WORKER_MAX_URL 256
+#define SYNC_WORKER_RESULT_CAPACITY 16
+#define SYNC_WORKER_POLL_MS 100
+#define SYNC_WORKER_MAX_ETAG 128
+#define SYNC_WORKER_MAX_SNAPSHOTS (SYNC_WORKER_RESULT_CAPACITY + 2)
+
+typedef enum {
+    SYNC_JOB_PUSH,
+    SYNC_JOB_FETCH,
+    SYNC_JOB_KINDS
+} SyncJobKind;
+
+typedef struct {
+    SyncJobKind kind;
+    uint32_t sequence;      // Value returned by the submit call
+    int curl_code;          // CURLcode; 0 on success
+    long http_status;       // 0 if no response arrived
+    char* body;             // NUL-terminated response, freed by sync_result_free;
+    size_t body_size;       // empty when a fetch was decoded into catalog
+    ObjectiveCatalog* catalog;  // Fetches answered 200 with a valid list, else NULL
+} SyncResult;
+
+typedef struct {
+    uint32_t requests;
+    uint32_t new_connections;   // Connections opened (rest were reused)
+    uint32_t coalesced;         // Pushes replaced before they were sent
+    uint32_t results_dropped;   // Oldest results discarded while the queue was full
+    uint32_t not_modified;      // Fetches answered 304
+    uint32_t objectives_sent;   // Objective entries across all pushes
+    uint64_t bytes_sent;
+    uint64_t bytes_received;
+} SyncWorkerStats;
+
+// Last acknowledged value of one objective; key mixes label and name hashes
+typedef struct {
+    uint64_t key;
+    int32_t score;
+    bool completed;
+    bool used;
+} SyncAck;
+
+// Values carried by one push, promoted to acks when it succeeds
+typedef struct {
+    uint32_t sequence;
+    SyncAck* changes;
+    uint32_t count;
+} SyncSnapshot;
+
+typedef struct {
+    char url[SYNC_WORKER_MAX_URL];
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    bool started;
+    bool stop;
+
+    // Jobs waiting for the worker, at most one per kind
+    bool pending[SYNC_JOB_KINDS];
+    char* pending_body[SYNC_JOB_KINDS];
+    size_t pending_size[SYNC_JOB_KINDS];
+    uint32_t pending_sequence[SYNC_JOB_KINDS];
+    uint32_t next_sequence;
+
+    SyncResult results[SYNC_WORKER_RESULT_CAPACITY];
+    uint32_t result_head;
+    uint32_t result_count;
+
+    SyncWorkerStats stats;
+
+    // Worker thread only (CURLM*, CURL*)
+    void* multi;
+    void* easy;
+    char etag[SYNC_WORKER_MAX_ETAG];
+
+    // Simulation thread only: acknowledged values (open addressing,
+    // power-of-two capacity) and pushes still awaiting a result
+    SyncAck* acks;
+    uint32_t ack_capacity;
+    uint32_t ack_count;
+    SyncSnapshot snapshots[SYNC_WORKER_MAX_SNAPSHOTS];
+    uint32_t snapshot_count;
+} SyncWorker;
+
+bool sync_worker_start(SyncWorker* worker, const char* url);
+// Cancels any transfer in flight, joins the thread and frees queued results
+void sync_worker_stop(SyncWorker* worker);
+
+// Queue an upload of the objectives that changed since the server last
+// acknowledged them. Returns the job sequence number, or 0 if nothing
+// changed or the request could not be built.
+uint32_t sync_worker_push(SyncWorker* worker, const ComboState* trackers, int tracker_count);
+// Forget acknowledged values so the next push sends every objective
+void sync_worker_resync(SyncWorker* worker);
+// Queue a download of the objective lists
+uint32_t sync_worker_fetch(SyncWorker* worker);
+
+// Non-blocking; returns false when no result is ready. Polling a push
+// result is what records its values as acknowledged.
+bool sync_worker_poll(SyncWorker* worker, SyncResult* result);
+void sync_result_free(SyncResult* result);
+
+SyncWorkerStats sync_worker_stats(SyncWorker* worker);
+
+// Encode every objective of every tracker as a push body (malloc'd)
+char* sync_encode_progress(const ComboState* trackers, int tracker_count, size_t* size);
+
+// Apply a fetch response, {"<tracker label>":[{"name":...,"description":...,
+// "target_score":n}, ...], ...}, to the matching trackers, decoding it in
+// one pass without building a document tree. Returns the number of
+// trackers updated, or -1 if the JSON is invalid (lists that were
+// complete before the error are still applied).
+int combo_sync_apply_objectives(ComboState* trackers, int tracker_count, const char* json, size_t size);
+// Apply the lists a fetch decoded; returns the number of trackers updated
+int combo_sync_apply_catalog(ComboState* trackers, int tracker_count, const ObjectiveCatalog* catalog);
+
+#endif // SYNC_WORKER_H
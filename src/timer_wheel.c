@@ -0,0 +1,242 @@
+#include "timer_wheel.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define TIMER_WHEEL_MIN_CAPACITY 64
+#define TICK_EPSILON 1e-9   // Absorbs rounding in deadline / tick_seconds
+
+static void link_timer(TimerWheel* wheel, int32_t id, uint8_t level, uint8_t slot) {
+    TimerEntry* timer = &wheel->timers[id];
+    int32_t head = wheel->slots[level][slot];
+    timer->level = level;
+    timer->slot = slot;
+    timer->prev = TIMER_WHEEL_INVALID;
+    timer->next = head;
+    if (head != TIMER_WHEEL_INVALID) {
+        wheel->timers[head].prev = id;
+    }
+    wheel->slots[level][slot] = id;
+    wheel->occupied[level] |= (uint64_t)1 << slot;
+}
+
+static void unlink_timer(TimerWheel* wheel, int32_t id) {
+    TimerEntry* timer = &wheel->timers[id];
+    if (timer->prev != TIMER_WHEEL_INVALID) {
+        wheel->timers[timer->prev].next = timer->next;
+    } else {
+        wheel->slots[timer->level][timer->slot] = timer->next;
+        if (timer->next == TIMER_WHEEL_INVALID) {
+            wheel->occupied[timer->level] &= ~((uint64_t)1 << timer->slot);
+        }
+    }
+    if (timer->next != TIMER_WHEEL_INVALID) {
+        wheel->timers[timer->next].prev = timer->prev;
+    }
+    timer->next = timer->prev = TIMER_WHEEL_INVALID;
+}
+
+// Place a timer on the lowest level whose span still contains its deadline
+static void place_timer(TimerWheel* wheel, int32_t id) {
+    uint64_t tick = wheel->timers[id].deadline_tick;
+    if (tick <= wheel->current_tick) {
+        tick = wheel->current_tick + 1;
+    }
+
+    uint8_t level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 &&
+           (tick >> (TIMER_WHEEL_SLOT_BITS * (level + 1))) !=
+           (wheel->current_tick >> (TIMER_WHEEL_SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    // Beyond the top level's span the timer is re-placed each time its
+    // top-level slot comes round
+    uint8_t slot = (uint8_t)((tick >> (TIMER_WHEEL_SLOT_BITS * level)) & (TIMER_WHEEL_SLOTS - 1));
+    link_timer(wheel, id, level, slot);
+}
+
+static bool grow_pool(TimerWheel* wheel) {
+    uint32_t capacity = wheel->capacity ? wheel->capacity * 2 : TIMER_WHEEL_MIN_CAPACITY;
+    TimerEntry* timers = realloc(wheel->timers, sizeof(TimerEntry) * capacity);
+    if (!timers) return false;
+
+    // Thread the new entries onto the free list, lowest id first
+    for (uint32_t i = capacity; i-- > wheel->capacity;) {
+        memset(&timers[i], 0, sizeof(TimerEntry));
+        timers[i].next = wheel->free_list;
+        wheel->free_list = (int32_t)i;
+    }
+    wheel->timers = timers;
+    wheel->capacity = capacity;
+    return true;
+}
+
+bool timer_wheel_init(TimerWheel* wheel, double tick_seconds, uint32_t initial_capacity) {
+    memset(wheel, 0, sizeof(*wheel));
+    wheel->tick_seconds = tick_seconds > 0.0 ? tick_seconds : 0.001;
+    wheel->free_list = TIMER_WHEEL_INVALID;
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (int slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+            wheel->slots[level][slot] = TIMER_WHEEL_INVALID;
+        }
+    }
+    while (wheel->capacity < initial_capacity) {
+        if (!grow_pool(wheel)) return false;
+    }
+    return true;
+}
+
+void timer_wheel_free(TimerWheel* wheel) {
+    free(wheel->timers);
+    memset(wheel, 0, sizeof(*wheel));
+}
+
+int32_t timer_wheel_schedule_at(TimerWheel* wheel, double deadline, TimerCallback callback,
+                                void* context, uint32_t user) {
+    if (wheel->free_list == TIMER_WHEEL_INVALID && !grow_pool(wheel)) {
+        return TIMER_WHEEL_INVALID;
+    }
+
+    int32_t id = wheel->free_list;
+    TimerEntry* timer = &wheel->timers[id];
+    wheel->free_list = timer->next;
+
+    double ticks = ceil(deadline / wheel->tick_seconds - TICK_EPSILON);
+    timer->deadline = deadline;
+    timer->deadline_tick = ticks > 0.0 ? (uint64_t)ticks : 0;
+    timer->callback = callback;
+    timer->context = context;
+    timer->user = user;
+    timer->active = true;
+    place_timer(wheel, id);
+    wheel->active_count++;
+    return id;
+}
+
+int32_t timer_wheel_schedule(TimerWheel* wheel, double delay, TimerCallback callback,
+                             void* context, uint32_t user) {
+    return timer_wheel_schedule_at(wheel, wheel->now + delay, callback, context, user);
+}
+
+static void release_timer(TimerWheel* wheel, int32_t id) {
+    TimerEntry* timer = &wheel->timers[id];
+    timer->active = false;
+    timer->next = wheel->free_list;
+    wheel->free_list = id;
+    wheel->active_count--;
+}
+
+bool timer_wheel_cancel(TimerWheel* wheel, int32_t id) {
+    if (!timer_wheel_is_active(wheel, id)) return false;
+    unlink_timer(wheel, id);
+    release_timer(wheel, id);
+    return true;
+}
+
+bool timer_wheel_is_active(const TimerWheel* wheel, int32_t id) {
+    return id >= 0 && (uint32_t)id < wheel->capacity && wheel->timers[id].active;
+}
+
+void timer_wheel_set_user(TimerWheel* wheel, int32_t id, uint32_t user) {
+    if (timer_wheel_is_active(wheel, id)) {
+        wheel->timers[id].user = user;
+    }
+}
+
+double timer_wheel_remaining(const TimerWheel* wheel, int32_t id) {
+    if (!timer_wheel_is_active(wheel, id)) return -1.0;
+    double remaining = wheel->timers[id].deadline - wheel->now;
+    return remaining > 0.0 ? remaining : 0.0;
+}
+
+// Move every timer in a higher-level slot down towards level 0
+static void cascade(TimerWheel* wheel, int level, int slot) {
+    int32_t id = wheel->slots[level][slot];
+    wheel->slots[level][slot] = TIMER_WHEEL_INVALID;
+    wheel->occupied[level] &= ~((uint64_t)1 << slot);
+    while (id != TIMER_WHEEL_INVALID) {
+        int32_t next = wheel->timers[id].next;
+        place_timer(wheel, id);
+        id = next;
+    }
+}
+
+static uint32_t fire_slot(TimerWheel* wheel, int slot) {
+    uint32_t fired = 0;
+    // Pop one at a time: callbacks may cancel other timers in this slot
+    while (wheel->slots[0][slot] != TIMER_WHEEL_INVALID) {
+        int32_t id = wheel->slots[0][slot];
+        unlink_timer(wheel, id);
+
+        TimerEntry* timer = &wheel->timers[id];
+        if (timer->deadline_tick > wheel->current_tick) {
+            place_timer(wheel, id);
+            continue;
+        }
+
+        // Release first so the callback can reuse the entry
+        TimerCallback callback = timer->callback;
+        void* context = timer->context;
+        uint32_t user = timer->user;
+        double deadline = timer->deadline;
+        release_timer(wheel, id);
+        fired++;
+        if (callback) {
+            callback(context, user, deadline);
+        }
+    }
+    return fired;
+}
+
+// The first tick after current_tick that fires an occupied level-0 slot
+// or cascades an occupied higher-level slot; UINT64_MAX if none is
+static uint64_t next_event_tick(const TimerWheel* wheel) {
+    uint64_t best = UINT64_MAX;
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        uint64_t bits = wheel->occupied[level];
+        if (!bits) continue;
+
+        int shift = TIMER_WHEEL_SLOT_BITS * level;
+        int span_shift = shift + TIMER_WHEEL_SLOT_BITS;
+        uint64_t index = (wheel->current_tick >> shift) & (TIMER_WHEEL_SLOTS - 1);
+        uint64_t span_base = (wheel->current_tick >> span_shift) << span_shift;
+        uint64_t ahead = index == TIMER_WHEEL_SLOTS - 1 ? 0 : bits & (~(uint64_t)0 << (index + 1));
+
+        uint64_t tick;
+        if (ahead) {
+            tick = span_base + ((uint64_t)__builtin_ctzll(ahead) << shift);
+        } else {
+            // Only comes round again in the next rotation of this level
+            tick = span_base + ((uint64_t)1 << span_shift) + ((uint64_t)__builtin_ctzll(bits) << shift);
+        }
+        if (tick < best) best = tick;
+    }
+    return best;
+}
+
+uint32_t timer_wheel_advance(TimerWheel* wheel, double dt) {
+    wheel->now += dt;
+    double target_ticks = floor(wheel->now / wheel->tick_seconds + TICK_EPSILON);
+    uint64_t target = target_ticks > 0.0 ? (uint64_t)target_ticks : 0;
+
+    uint32_t fired = 0;
+    while (wheel->current_tick < target) {
+        // Ticks in between have empty slots and nothing to cascade
+        uint64_t next = next_event_tick(wheel);
+        if (next > target) {
+            wheel->current_tick = target;
+            break;
+        }
+
+        wheel->current_tick = next;
+        wheel->visited_ticks++;
+        for (int level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+            uint64_t mask = ((uint64_t)1 << (TIMER_WHEEL_SLOT_BITS * level)) - 1;
+            if (wheel->current_tick & mask) break;
+            cascade(wheel, level,
+                    (int)((wheel->current_tick >> (TIMER_WHEEL_SLOT_BITS * level)) & (TIMER_WHEEL_SLOTS - 1)));
+        }
+        fired += fire_slot(wheel, (int)(wheel->current_tick & (TIMER_WHEEL_SLOTS - 1)));
+    }
+    return fired;
+}
@@ -0,0 +1,72 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Hierarchical timer wheel. Deadlines are kept in seconds (double) and
+// bucketed by tick; each level has 64 slots and covers 64x the span of
+// the level below. A bitmap per level marks the occupied slots, and
+// advancing jumps straight to the next tick that fires a level-0 slot or
+// cascades an occupied higher-level slot. The cost of timer_wheel_advance
+// depends on expired and cascaded timers, not on elapsed ticks or on how
+// many timers are pending.
+//
+// Timers live in a growable pool and are addressed by index; cancelling
+// is O(1). Callbacks may schedule or cancel timers, including their own.
+
+#define TIMER_WHEEL_LEVELS 5
+#define TIMER_WHEEL_SLOT_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_INVALID (-1)
+
+// `deadline` is the time the timer was due, which may be slightly before
+// the wheel's current time; reschedule from it to avoid drift
+typedef void (*TimerCallback)(void* context, uint32_t user, double deadline);
+
+typedef struct {
+    double deadline;
+    uint64_t deadline_tick;
+    int32_t next;
+    int32_t prev;
+    TimerCallback callback;
+    void* context;
+    uint32_t user;
+    uint8_t level;
+    uint8_t slot;
+    bool active;
+} TimerEntry;
+
+typedef struct {
+    double tick_seconds;
+    double now;
+    uint64_t current_tick;
+    int32_t slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    uint64_t occupied[TIMER_WHEEL_LEVELS];  // Bit per non-empty slot
+    TimerEntry* timers;
+    uint32_t capacity;
+    int32_t free_list;
+    uint32_t active_count;
+    uint64_t visited_ticks;     // Ticks advance stopped at, for measuring
+} TimerWheel;
+
+bool timer_wheel_init(TimerWheel* wheel, double tick_seconds, uint32_t initial_capacity);
+void timer_wheel_free(TimerWheel* wheel);
+
+// Returns the timer id, or TIMER_WHEEL_INVALID on allocation failure.
+// Deadlines already in the past fire on the next advance.
+int32_t timer_wheel_schedule_at(TimerWheel* wheel, double deadline, TimerCallback callback,
+                                void* context, uint32_t user);
+int32_t timer_wheel_schedule(TimerWheel* wheel, double delay, TimerCallback callback,
+                             void* context, uint32_t user);
+bool timer_wheel_cancel(TimerWheel* wheel, int32_t id);
+bool timer_wheel_is_active(const TimerWheel* wheel, int32_t id);
+void timer_wheel_set_user(TimerWheel* wheel, int32_t id, uint32_t user);
+
+// Seconds until the timer fires (0 if due), or -1 for an inactive id
+double timer_wheel_remaining(const TimerWheel* wheel, int32_t id);
+
+// Move time forward and fire everything due. Returns timers fired.
+uint32_t timer_wheel_advance(TimerWheel* wheel, double dt);
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,275 @@
+#define _POSIX_C_SOURCE 200809L
+#include "tracker_store.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define TRACKER_STORE_MIN_CAPACITY 16
+#define TRACKER_STORE_MAX_PATH 264
+
+typedef char tracker_store_header_is_64_bytes[sizeof(TrackerStoreHeader) == 64 ? 1 : -1];
+typedef char tracker_record_is_128_bytes[sizeof(TrackerRecord) == 128 ? 1 : -1];
+
+static size_t store_file_size(uint32_t capacity) {
+    return sizeof(TrackerStoreHeader) + (size_t)capacity * sizeof(TrackerRecord);
+}
+
+static void mark_range(TrackerStore* store, size_t start, size_t end) {
+    if (store->dirty_end == 0) {
+        store->dirty_start = start;
+        store->dirty_end = end;
+        return;
+    }
+    if (start < store->dirty_start) store->dirty_start = start;
+    if (end > store->dirty_end) store->dirty_end = end;
+}
+
+static bool map_file(TrackerStore* store, size_t size) {
+    void* base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, store->fd, 0);
+    if (base == MAP_FAILED) {
+        perror("Failed to map tracker store");
+        return false;
+    }
+    store->base = base;
+    store->mapped_size = size;
+    store->header = (TrackerStoreHeader*)store->base;
+    store->records = (TrackerRecord*)(store->base + sizeof(TrackerStoreHeader));
+    return true;
+}
+
+static bool header_valid(const TrackerStoreHeader* header, size_t file_size) {
+    return memcmp(header->magic, TRACKER_STORE_MAGIC, 4) == 0 &&
+           header->version == TRACKER_STORE_VERSION &&
+           header->record_size == sizeof(TrackerRecord) &&
+           header->count <= header->capacity &&
+           store_file_size(header->capacity) <= file_size;
+}
+
+// Move an unreadable file to "<path>.invalid" so a new store can take its
+// place without destroying whatever it was
+static bool set_aside(const char* path) {
+    char aside[TRACKER_STORE_MAX_PATH];
+    if (snprintf(aside, sizeof(aside), "%s.invalid", path) >= (int)sizeof(aside)) return false;
+    if (rename(path, aside) != 0) {
+        perror("Failed to set aside invalid tracker store");
+        return false;
+    }
+    fprintf(stderr, "Tracker store %s is not valid, moved to %s\n", path, aside);
+    return true;
+}
+
+bool tracker_store_open(TrackerStore* store, const char* path, uint32_t initial_capacity) {
+    memset(store, 0, sizeof(*store));
+    store->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (store->fd < 0) {
+        perror("Failed to open tracker store");
+        return false;
+    }
+    store->sync_batch = TRACKER_STORE_SYNC_BATCH;
+
+    struct stat st;
+    if (fstat(store->fd, &st) != 0) {
+        close(store->fd);
+        store->fd = -1;
+        return false;
+    }
+
+    // Existing store: map it as-is, no parsing beyond the header check
+    if ((size_t)st.st_size >= sizeof(TrackerStoreHeader)) {
+        if (!map_file(store, (size_t)st.st_size)) {
+            close(store->fd);
+            store->fd = -1;
+            return false;
+        }
+        if (header_valid(store->header, (size_t)st.st_size)) {
+            return true;
+        }
+        bool newer = memcmp(store->header->magic, TRACKER_STORE_MAGIC, 4) == 0 &&
+                     store->header->version > TRACKER_STORE_VERSION;
+        munmap(store->base, store->mapped_size);
+        store->base = NULL;
+        if (newer) {
+            // Written by a newer build; leave it for that build
+            fprintf(stderr, "Tracker store %s has unsupported version\n", path);
+            close(store->fd);
+            store->fd = -1;
+            return false;
+        }
+    }
+
+    // Anything that is not an empty file is kept instead of truncated
+    if (st.st_size > 0) {
+        close(store->fd);
+        store->fd = -1;
+        if (!set_aside(path)) return false;
+        store->fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0644);
+        if (store->fd < 0) {
+            perror("Failed to create tracker store");
+            return false;
+        }
+    }
+
+    if (initial_capacity < TRACKER_STORE_MIN_CAPACITY) {
+        initial_capacity = TRACKER_STORE_MIN_CAPACITY;
+    }
+    size_t size = store_file_size(initial_capacity);
+    if (ftruncate(store->fd, (off_t)size) != 0 || !map_file(store, size)) {
+        close(store->fd);
+        store->fd = -1;
+        return false;
+    }
+
+    memcpy(store->header->magic, TRACKER_STORE_MAGIC, 4);
+    store->header->version = TRACKER_STORE_VERSION;
+    store->header->record_size = sizeof(TrackerRecord);
+    store->header->capacity = initial_capacity;
+    store->header->count = 0;
+
+    // The file size changed, so this one needs the metadata sync too
+    mark_range(store, 0, sizeof(TrackerStoreHeader));
+    if (!tracker_store_sync(store, true) || fdatasync(store->fd) != 0) {
+        tracker_store_close(store);
+        return false;
+    }
+    return true;
+}
+
+void tracker_store_close(TrackerStore* store) {
+    if (store->base) {
+        tracker_store_sync(store, true);
+        munmap(store->base, store->mapped_size);
+    }
+    if (store->fd >= 0) {
+        close(store->fd);
+    }
+    memset(store, 0, sizeof(*store));
+    store->fd = -1;
+}
+
+static bool grow(TrackerStore* store) {
+    // Flush what we have before the mapping goes away
+    if (!tracker_store_sync(store, true)) return false;
+
+    uint32_t capacity = store->header->capacity * 2;
+    size_t size = store_file_size(capacity);
+    munmap(store->base, store->mapped_size);
+    store->base = NULL;
+
+    if (ftruncate(store->fd, (off_t)size) != 0 || !map_file(store, size)) {
+        perror("Failed to grow tracker store");
+        return false;
+    }
+    store->header->capacity = capacity;
+    mark_range(store, 0, sizeof(TrackerStoreHeader));
+    return tracker_store_sync(store, true) && fdatasync(store->fd) == 0;
+}
+
+int tracker_store_add(TrackerStore* store, const char* label) {
+    if (!store->base) return -1;
+    if (store->header->count == store->header->capacity && !grow(store)) {
+        return -1;
+    }
+
+    uint32_t index = store->header->count;
+    TrackerRecord* record = &store->records[index];
+    memset(record, 0, sizeof(*record));
+    strncpy(record->label, label, MAX_LABEL_LENGTH - 1);
+    record->multiplier = 1.0f;
+    record->flags = TRACKER_RECORD_FLAG_IN_USE | TRACKER_RECORD_FLAG_PAUSED;
+    tracker_store_touch(store, index);
+
+    // Publish the record before the count that makes it visible
+    store->header->count = index + 1;
+    mark_range(store, 0, sizeof(TrackerStoreHeader));
+    return (int)index;
+}
+
+uint32_t tracker_store_count(const TrackerStore* store) {
+    return store->base ? store->header->count : 0;
+}
+
+TrackerRecord* tracker_store_record(TrackerStore* store, uint32_t index) {
+    if (!store->base || index >= store->header->count) return NULL;
+    return &store->records[index];
+}
+
+void tracker_store_touch(TrackerStore* store, uint32_t index) {
+    size_t start = sizeof(TrackerStoreHeader) + (size_t)index * sizeof(TrackerRecord);
+    mark_range(store, start, start + sizeof(TrackerRecord));
+    store->pending_updates++;
+    if (store->pending_updates >= store->sync_batch) {
+        tracker_store_sync(store, false);
+    }
+}
+
+void tracker_store_put(TrackerStore* store, uint32_t index, const ComboState* state) {
+    TrackerRecord* record = tracker_store_record(store, index);
+    if (!record) return;
+
+    // Records hold combo and decay as of the time of writing
+    int32_t combo;
+    float multiplier, decay_pause;
+    combo_peek(state, combo_clock_now(), &combo, &multiplier, &decay_pause);
+
+    record->score = state->score;
+    record->combo = combo;
+    record->max_combo = state->max_combo;
+    record->multiplier = multiplier;
+    record->decay_pause = decay_pause;
+    record->total_hits = state->total_hits;
+    record->perfect_hits = state->perfect_hits;
+    record->miss_hits = state->miss_hits;
+    record->objective = state->objective;
+    record->completed_intervals = state->completed_intervals;
+    record->flags = TRACKER_RECORD_FLAG_IN_USE;
+    if (state->paused) record->flags |= TRACKER_RECORD_FLAG_PAUSED;
+    if (state->has_objective) record->flags |= TRACKER_RECORD_FLAG_HAS_OBJECTIVE;
+    if (strncmp(record->label, state->label, MAX_LABEL_LENGTH) != 0) {
+        strncpy(record->label, state->label, MAX_LABEL_LENGTH - 1);
+        record->label[MAX_LABEL_LENGTH - 1] = '\0';
+    }
+    tracker_store_touch(store, index);
+}
+
+void tracker_store_get(const TrackerStore* store, uint32_t index, ComboState* state) {
+    if (!store->base || index >= store->header->count) return;
+    const TrackerRecord* record = &store->records[index];
+
+    combo_init(state, record->label);
+    state->score = record->score;
+    state->combo = record->combo;
+    state->max_combo = record->max_combo;
+    state->multiplier = record->multiplier;
+    state->decay_pause = record->decay_pause;
+    state->total_hits = record->total_hits;
+    state->perfect_hits = record->perfect_hits;
+    state->miss_hits = record->miss_hits;
+    state->objective = record->objective;
+    state->completed_intervals = record->completed_intervals;
+    state->paused = (record->flags & TRACKER_RECORD_FLAG_PAUSED) != 0;
+    state->has_objective = (record->flags & TRACKER_RECORD_FLAG_HAS_OBJECTIVE) != 0;
+}
+
+bool tracker_store_sync(TrackerStore* store, bool force) {
+    if (!store->base || store->dirty_end == 0) return true;
+    if (!force && store->pending_updates < store->sync_batch) return true;
+
+    // msync needs a page-aligned start; only the touched pages are written
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t start = store->dirty_start & ~(page - 1);
+    size_t end = store->dirty_end;
+    if (end > store->mapped_size) end = store->mapped_size;
+
+    bool ok = msync(store->base + start, end - start, MS_SYNC) == 0;
+    if (!ok) {
+        perror("Failed to sync tracker store");
+        return false;
+    }
+    store->dirty_start = 0;
+    store->dirty_end = 0;
+    store->pending_updates = 0;
+    return true;
+}
@@ -0,0 +1,88 @@
+#ifndef TRACKER_STORE_H
+#define TRACKER_STORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "core.h"
+
+// Optional memory-mapped tracker store for deployments with many trackers.
+// The file is a 64-byte header followed by fixed-size 128-byte records;
+// records are used in place through the mapping, so opening the store
+// needs no parse step. Counters are updated directly in the record and
+// made durable by batched msync of the dirty pages.
+//
+// Objectives and interval definitions are not part of the record; they
+// stay in the regular tracker file.
+
+#define TRACKER_STORE_MAGIC "CMBM"
+#define TRACKER_STORE_VERSION 1
+#define TRACKER_STORE_SYNC_BATCH 64     // Updates between automatic msyncs
+#define TRACKER_RECORD_FLAG_PAUSED 0x01
+#define TRACKER_RECORD_FLAG_HAS_OBJECTIVE 0x02
+#define TRACKER_RECORD_FLAG_IN_USE 0x80
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t reserved[11];
+} TrackerStoreHeader;   // 64 bytes
+
+typedef struct {
+    // First cache line: everything a hit touches
+    int32_t score;
+    int32_t combo;
+    int32_t max_combo;
+    uint32_t flags;
+    float multiplier;
+    float decay_pause;
+    uint32_t total_hits;
+    uint32_t perfect_hits;
+    uint32_t miss_hits;
+    int32_t objective;
+    int32_t completed_intervals;
+    uint32_t reserved[5];
+    // Second cache line: cold data
+    char label[MAX_LABEL_LENGTH];
+} TrackerRecord;        // 128 bytes
+
+typedef struct {
+    int fd;
+    uint8_t* base;
+    size_t mapped_size;
+    TrackerStoreHeader* header;
+    TrackerRecord* records;
+    size_t dirty_start;     // Byte range touched since the last sync
+    size_t dirty_end;
+    uint32_t pending_updates;
+    uint32_t sync_batch;
+} TrackerStore;
+
+// Creates the store if `path` is missing or empty. A file that is not a
+// valid store is renamed to "<path>.invalid" and a new store is created;
+// a store from a newer version is left alone and open fails.
+bool tracker_store_open(TrackerStore* store, const char* path, uint32_t initial_capacity);
+void tracker_store_close(TrackerStore* store);
+
+// Returns the new record index, or -1. May remap the file, which
+// invalidates record pointers obtained earlier.
+int tracker_store_add(TrackerStore* store, const char* label);
+uint32_t tracker_store_count(const TrackerStore* store);
+
+// Direct access to a mapped record; call tracker_store_touch after
+// modifying it so the change is included in the next sync
+TrackerRecord* tracker_store_record(TrackerStore* store, uint32_t index);
+void tracker_store_touch(TrackerStore* store, uint32_t index);
+
+// Convenience conversions to and from the in-memory tracker
+void tracker_store_put(TrackerStore* store, uint32_t index, const ComboState* state);
+void tracker_store_get(const TrackerStore* store, uint32_t index, ComboState* state);
+
+// Flush dirty pages. Without force this only syncs once
+// sync_batch updates have accumulated.
+bool tracker_store_sync(TrackerStore* store, bool force);
+
+#endif // TRACKER_STORE_H
@@ -2,6 +2,8 @@
 #include "forms.h"
 #include "widgets.h"
 #include "colors.h"
+#include "persistence.h"
+#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include "clay.h"
@@ -147,6 +149,7 @@ void add_new_tracker(ComboUI* ui) {
     // Initialize new tracker
     combo_init(&ui->trackers[ui->tracker_count], ui->tracker_form.label_buffer);
     ui->tracker_count++;
+    rebuild_objective_goals(ui);
 
     // Hide form and clear error
     ui->tracker_form.form_visible = false;
@@ -197,10 +200,63 @@ void add_new_interval(ComboUI* ui) {
 
 void save_ui_state(ComboUI* ui) {
     if (ui->tracker_count > 0) {
-        combo_save_all_trackers(ui->trackers, ui->tracker_count, "combo_trackers.dat");
+        if (persistence_is_running()) {
+            persistence_mark_dirty(ui->trackers, ui->tracker_count, -1);
+        } else {
+            combo_save_all_trackers(ui->trackers, ui->tracker_count, TRACKER_SAVE_FILE);
+        }
+    }
+}
+
+// Save after an event on a single tracker (increment, decrement, pause).
+// With the worker running this is a journal append, not a full rewrite.
+void save_tracker_event(ComboUI* ui, int tracker_index, JournalOp op, uint32_t amount) {
+    if (ui->session) {
+        SessionEvent event = {(uint64_t)(combo_clock_now() * 1e6), amount, (uint16_t)tracker_index, (uint8_t)op, 0};
+        session_record(ui->session, &event);
+    }
+    objective_engine_observe_state(&ui->objectives, (uint32_t)tracker_index, &ui->trackers[tracker_index]);
+    if (persistence_is_running()) {
+        persistence_record_event(ui->trackers, ui->tracker_count, tracker_index, op, amount);
+    } else {
+        save_ui_state(ui);
     }
 }
 
 void load_ui_state(ComboUI* ui) {
-    ui->tracker_count = combo_load_all_trackers(ui->trackers, MAX_TRACKERS, "combo_trackers.dat");
+    ui->tracker_count = combo_load_all_trackers(ui->trackers, MAX_TRACKERS, TRACKER_SAVE_FILE);
+    rebuild_objective_goals(ui);
+}
+
+void rebuild_objective_goals(ComboUI* ui) {
+    if (!ui->objectives.indexes) {
+        if (!objective_engine_init(&ui->objectives, MAX_TRACKERS)) return;
+    } else {
+        objective_engine_clear(&ui->objectives);
+    }
+    for (int i = 0; i < ui->tracker_count; i++) {
+        objective_engine_add_objectives(&ui->objectives, (uint32_t)i, &ui->trackers[i]);
+    }
+}
+
+void handle_objective_events(ComboUI* ui) {
+    bool switched = false;
+    ObjectiveEvent event;
+    while (objective_engine_poll(&ui->objectives, &event, 1)) {
+        if (event.tracker >= (uint32_t)ui->tracker_count) continue;
+        ComboState* tracker = &ui->trackers[event.tracker];
+        if (event.user_id >= tracker->objective_count) continue;
+        printf("Objective completed: %s / %s\n", tracker->label, tracker->objectives[event.user_id].name);
+
+        if (event.user_id != tracker->active_objective_index) continue;
+        for (uint32_t i = 1; i < tracker->objective_count; i++) {
+            uint32_t next = (event.user_id + i) % tracker->objective_count;
+            if (!tracker->objectives[next].completed) {
+                combo_switch_objective(tracker, next);
+                switched = true;
+                break;
+            }
+        }
+    }
+    if (switched) save_ui_state(ui);
 }
\ No newline at end of file
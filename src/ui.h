@@ -3,12 +3,22 @@
 
 #include "ui_types.h"
 #include "clay.h"
+#include "journal.h"
+
+#define TRACKER_SAVE_FILE "combo_trackers.dat"
 
 void init_ui(ComboUI* ui);
 Clay_RenderCommandArray combo_ui_render(ComboUI* ui);
 void add_new_tracker(ComboUI* ui);
 void add_new_interval(ComboUI* ui);
 void save_ui_state(ComboUI* ui);
+void save_tracker_event(ComboUI* ui, int tracker_index, JournalOp op, uint32_t amount);
 void load_ui_state(ComboUI* ui);
+// Register every tracker's pending objectives with ui->objectives, e.g.
+// after trackers are loaded or added
+void rebuild_objective_goals(ComboUI* ui);
+// Drain objective completion events; a completed active objective moves
+// the tracker on to its next pending one
+void handle_objective_events(ComboUI* ui);
 
 #endif // UI_H
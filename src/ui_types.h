@@ -3,6 +3,8 @@
 
 #include "core.h"
 #include "clay.h"
+#include "session.h"
+#include "objective_engine.h"
 
 #define MAX_TRACKERS 8
 #define MAX_LABEL_LENGTH 64
@@ -44,6 +46,8 @@ typedef struct {
     IntervalForm interval_form;
     float current_time;
     float best_time;
+    SessionRecorder* session;   // Input recording (COMBO_SESSION_FILE), or NULL
+    ObjectiveEngine objectives; // Pending objectives of every tracker
 } ComboUI;
 
 #endif // UI_TYPES_H 
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "timer.h"
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 
 #define CLAY_IMPLEMENTATION
 #include "clay.h"
@@ -182,7 +183,7 @@ void widget_interval_tracker(IntervalTracker* intervals, int index, Clay_Color a
         })
     ) {
         char timer_text[32];
-        const char* formatted_time = format_time(intervals->current_time);
+        const char* formatted_time = format_time((int)ceilf(intervals->current_time));
         strncpy(timer_text, formatted_time, sizeof(timer_text) - 1);
         timer_text[sizeof(timer_text) - 1] = '\0';
 
@@ -218,6 +219,31 @@ void widget_interval_tracker(IntervalTracker* intervals, int index, Clay_Color a
     }
 }
 
+// Rhythm line: median and slow-end gap, and how often hits cut it close
+void widget_hit_timing(const ComboState* tracker, int index, Clay_Color text_color) {
+    HitTimingSummary timing;
+    hit_stats_summary(&tracker->timing, &timing);
+    if (timing.gaps == 0) return;
+
+    char timing_text[96];
+    snprintf(timing_text, sizeof(timing_text), "Gap %.2fs, p95 %.2fs, %.0f%% close, %.0f%% late",
+             timing.p50_ms / 1000.0f, timing.p95_ms / 1000.0f,
+             timing.near_deadline_fraction * 100.0f, timing.late_fraction * 100.0f);
+
+    char timing_id[64];
+    snprintf(timing_id, sizeof(timing_id), "tracker_timing_%d", index);
+    CLAY(
+        CLAY_ID(timing_id),
+        CLAY_TEXT(
+            make_clay_string(timing_text),
+            CLAY_TEXT_CONFIG(CLAY__INIT(Clay_TextElementConfig) {
+                .fontSize = 14,
+                .textColor = text_color
+            })
+        )
+    );
+}
+
 void widget_tracker_card(ComboState* tracker, int index, Clay_Color active_color, Clay_Color paused_color, Clay_Color perfect_color) {
     char id_buffer[64];
     extern ComboUI* g_ui_context;
@@ -368,6 +394,8 @@ void widget_tracker_card(ComboState* tracker, int index, Clay_Color active_color
         // Objective progress
         widget_objective_progress(tracker, index, active_color, perfect_color, paused_color);
 
+        widget_hit_timing(tracker, index, paused_color);
+
         // Interval tracker if active
         if (tracker->interval_tracker.has_interval) {
             widget_interval_tracker(&tracker->interval_tracker, index, active_color, paused_color);
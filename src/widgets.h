@@ -7,6 +7,7 @@
 void widget_break_menu(BreakMenu* menu, ComboUI* ui);
 void widget_objective_progress(ComboState* tracker, int index, Clay_Color objective_color, Clay_Color completed_color, Clay_Color paused_color);
 void widget_interval_tracker(IntervalTracker* intervals, int index, Clay_Color active_color, Clay_Color paused_color);
+void widget_hit_timing(const ComboState* tracker, int index, Clay_Color text_color);
 void widget_tracker_card(ComboState* tracker, int index, Clay_Color active_color, Clay_Color paused_color, Clay_Color perfect_color);
 void widget_controls_panel(int index, Clay_Color active_color, Clay_Color paused_color, Clay_Color break_color);
 
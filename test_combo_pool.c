@@ -0,0 +1,204 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "src/combo_pool.h"
+#include "src/core.h"
+#include "src/combo_table.h"
+#include "src/combo_format.h"
+
+void test_size_classes_and_reuse() {
+    printf("Test 1: Size classes, free lists and high-water marks\n");
+
+    ComboPool pool;
+    combo_pool_init(&pool, 0);
+
+    void* a = combo_pool_alloc(&pool, 100);
+    void* b = combo_pool_alloc(&pool, 129);
+    void* c = combo_pool_alloc(&pool, COMBO_POOL_MAX_BLOCK);
+    assert(a && b && c);
+    assert(((uintptr_t)a % 16) == 0 && ((uintptr_t)b % 16) == 0);
+    memset(a, 0xAA, 100);
+    memset(b, 0xBB, 129);
+    memset(c, 0xCC, COMBO_POOL_MAX_BLOCK);
+
+    const ComboPoolStats* stats = combo_pool_stats(&pool);
+    assert(stats->blocks_in_use == 3);
+    assert(stats->bytes_in_use == 128 + 256 + COMBO_POOL_MAX_BLOCK);
+    assert(stats->reserved_bytes == COMBO_POOL_SLAB_SIZE);
+
+    // A freed block is handed out again for the same class
+    combo_pool_free(&pool, b, 129);
+    assert(combo_pool_alloc(&pool, 200) == b);
+    combo_pool_free(&pool, a, 100);
+    combo_pool_free(&pool, b, 200);
+    assert(stats->blocks_in_use == 1);
+    assert(stats->high_water_blocks == 3);
+    assert(stats->high_water_bytes == 128 + 256 + COMBO_POOL_MAX_BLOCK);
+
+    // Oversized requests fall back to malloc and are released on reset
+    void* big = combo_pool_alloc(&pool, COMBO_POOL_MAX_BLOCK * 3);
+    assert(big && pool.large_count == 1);
+    combo_pool_reset(&pool);
+    assert(pool.large_count == 0 && stats->bytes_in_use == 0 && stats->resets == 1);
+
+    // Slabs survive the reset and are reused before any new malloc
+    uint32_t slabs = pool.slab_count;
+    for (int i = 0; i < 100; i++) {
+        assert(combo_pool_alloc(&pool, 128));
+    }
+    assert(pool.slab_count == slabs);
+
+    combo_pool_destroy(&pool);
+    printf("  ✓ Blocks are recycled and usage is tracked\n");
+}
+
+void test_static_and_capped() {
+    printf("Test 2: Static buffer and capped heap pools\n");
+
+    static uint8_t buffer[4096 + 15];
+    ComboPool pool;
+    combo_pool_init_static(&pool, buffer, sizeof(buffer));
+
+    uint32_t count = 0;
+    while (combo_pool_alloc(&pool, 512)) count++;
+    assert(count == 8);
+    assert(combo_pool_stats(&pool)->failed_allocs == 1);
+    assert(!combo_pool_alloc(&pool, COMBO_POOL_MAX_BLOCK + 1));
+
+    combo_pool_reset(&pool);
+    assert(combo_pool_alloc(&pool, 512));
+    combo_pool_destroy(&pool);
+
+    combo_pool_init(&pool, COMBO_POOL_SLAB_SIZE * 2);
+    count = 0;
+    while (combo_pool_alloc(&pool, 4096)) count++;
+    assert(count == 8 && pool.slab_count == 2);
+    combo_pool_destroy(&pool);
+    printf("  ✓ Pools stop at their limit without touching the heap\n");
+}
+
+void test_tracker_storage() {
+    printf("Test 3: Tracker objectives and intervals in a pool\n");
+
+    ComboPool pool;
+    combo_pool_init(&pool, 0);
+
+    Objective goals[3];
+    objective_init(&goals[0], "A", "First", 10);
+    objective_init(&goals[1], "B", "Second", 20);
+    objective_init(&goals[2], "C", "Third", 30);
+    Interval plan[2] = {{"Work", 30, 4}, {"Rest", 10, 4}};
+
+    ComboState trackers[MAX_TRACKERS];
+    for (int i = 0; i < 4; i++) {
+        combo_init(&trackers[i], "Pooled");
+        combo_set_objectives(&trackers[i], goals, 3);
+        combo_set_pool(&trackers[i], &pool);
+        assert(trackers[i].objective_count == 3);
+        assert(strcmp(trackers[i].objectives[2].name, "C") == 0);
+        assert(interval_tracker_set_intervals(&trackers[i].interval_tracker, plan, 2));
+        combo_resume(&trackers[i]);
+        combo_increment(&trackers[i], (uint32_t)i + 1);
+    }
+    const ComboPoolStats* stats = combo_pool_stats(&pool);
+    assert(stats->blocks_in_use == 8);
+
+    // Objective syncs recycle the same blocks
+    for (int round = 0; round < 50; round++) {
+        combo_set_objectives(&trackers[round % 4], goals, 1 + round % 3);
+    }
+    assert(stats->high_water_blocks <= 9);
+
+    interval_tracker_start(&trackers[0].interval_tracker);
+    interval_tracker_update(&trackers[0].interval_tracker, 31.0f);
+    assert(trackers[0].interval_tracker.current_interval_index == 1);
+    combo_release(&trackers[3]);
+    assert(trackers[3].interval_tracker.pool == &pool);
+
+    // Reloads reset the pool instead of freeing tracker by tracker
+    combo_save_all_trackers(trackers, 4, "test_pool.dat");
+    size_t reserved = stats->high_water_reserved;
+    for (int reload = 0; reload < 20; reload++) {
+        int loaded = combo_load_all_trackers_pooled(trackers, MAX_TRACKERS, "test_pool.dat", &pool);
+        assert(loaded == 4);
+        assert(trackers[1].pool == &pool && trackers[1].score == 2);
+    }
+    assert(stats->resets == 20);
+    assert(stats->high_water_reserved == reserved);
+    printf("  High water: %zu bytes in %u blocks, %zu bytes reserved\n",
+           stats->high_water_bytes, stats->high_water_blocks, stats->high_water_reserved);
+
+    // A corrupt or truncated file leaves the loaded trackers usable
+    uint32_t objective_count = trackers[1].objective_count;
+    char last_name[MAX_LABEL_LENGTH];
+    assert(objective_count > 0);
+    strcpy(last_name, trackers[1].objectives[objective_count - 1].name);
+    size_t size = 0;
+    uint8_t* data = combo_format_read_file("test_pool.dat", &size);
+    assert(data);
+    data[size / 2] ^= 0x40;
+    FILE* f = fopen("test_pool.dat", "wb");
+    fwrite(data, 1, size, f);
+    fclose(f);
+    assert(combo_load_all_trackers_pooled(trackers, MAX_TRACKERS, "test_pool.dat", &pool) == 0);
+    data[size / 2] ^= 0x40;
+    f = fopen("test_pool.dat", "wb");
+    fwrite(data, 1, size - 7, f);
+    fclose(f);
+    assert(combo_load_all_trackers_pooled(trackers, MAX_TRACKERS, "test_pool.dat", &pool) == 0);
+    free(data);
+    assert(stats->resets == 20 && stats->blocks_in_use > 0);
+    assert(trackers[1].score == 2 && trackers[1].objective_count == objective_count);
+    assert(strcmp(trackers[1].objectives[objective_count - 1].name, last_name) == 0);
+    combo_set_objectives(&trackers[1], goals, 2);
+    remove("test_pool.dat");
+
+    combo_pool_destroy(&pool);
+    printf("  ✓ 20 reloads reuse the same slab memory\n");
+}
+
+void test_table_clear() {
+    printf("Test 4: Table objective storage and clear\n");
+
+    Objective goal;
+    objective_init(&goal, "Goal", "Table goal", 50);
+
+    ComboStateTable table;
+    assert(combo_table_init(&table, 0));
+    for (int round = 0; round < 3; round++) {
+        for (uint32_t i = 0; i < 1000; i++) {
+            combo_table_add(&table, "Row");
+            combo_table_set_objectives(&table, i, &goal, 1);
+            combo_table_set_interval(&table, i, "Set", 5, 2);
+            combo_table_resume(&table, i);
+        }
+        assert(table.pool.stats.blocks_in_use == 1000);
+        combo_table_remove(&table, 10);
+        assert(table.pool.stats.blocks_in_use == 999);
+        combo_table_clear(&table);
+        assert(table.count == 0 && table.timers.active_count == 0);
+    }
+    assert(table.pool.stats.high_water_blocks == 1000);
+    combo_table_free(&table);
+    printf("  ✓ Clearing releases objectives and timers in bulk\n");
+}
+
+int main() {
+    printf("Running combo pool tests...\n\n");
+
+    test_size_classes_and_reuse();
+    printf("\n");
+
+    test_static_and_capped();
+    printf("\n");
+
+    test_tracker_storage();
+    printf("\n");
+
+    test_table_clear();
+    printf("\n");
+
+    printf("🎉 All combo pool tests passed!\n");
+    return 0;
+}
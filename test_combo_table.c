@@ -0,0 +1,382 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "src/core.h"
+#include "src/combo_table.h"
+
+static double g_test_now = 0.0;
+static double test_clock(void) { return g_test_now; }
+
+static void assert_matches(const ComboStateTable* table, uint32_t index, const ComboState* state) {
+    assert(table->score[index] == state->score);
+    assert(table->combo[index] == state->combo);
+    assert(table->multiplier[index] == state->multiplier);
+    assert(table->decay_pause[index] == state->decay_pause);
+    assert((table->paused[index] != 0) == state->paused);
+    assert(table->max_combo[index] == state->max_combo);
+    assert(table->total_hits[index] == state->total_hits);
+    assert(table->miss_hits[index] == state->miss_hits);
+}
+
+void test_matches_combo_state() {
+    printf("Test 1: Table operations match ComboState\n");
+
+    combo_set_clock(test_clock);
+    g_test_now = 0.0;
+    ComboStateTable table;
+    assert(combo_table_init(&table, 0));
+
+    ComboState states[4];
+    for (int i = 0; i < 4; i++) {
+        char label[MAX_LABEL_LENGTH];
+        snprintf(label, sizeof(label), "Tracker %d", i);
+        combo_init(&states[i], label);
+        assert(combo_table_add(&table, label) == i);
+    }
+
+    srand(42);
+    for (int step = 0; step < 5000; step++) {
+        g_test_now += (double)(rand() % 100) / 50.0;
+        uint32_t i = (uint32_t)(rand() % 4);
+        uint32_t amount = (uint32_t)(rand() % 10);
+        switch (rand() % 10) {
+            case 0:
+                combo_pause(&states[i]);
+                combo_table_pause(&table, i);
+                break;
+            case 1:
+            case 2:
+                combo_resume(&states[i]);
+                combo_table_resume(&table, i);
+                break;
+            case 3:
+                combo_decrement(&states[i], amount);
+                combo_table_decrement(&table, i, amount);
+                break;
+            default:
+                combo_increment(&states[i], amount);
+                combo_table_increment(&table, i, amount);
+                break;
+        }
+        assert_matches(&table, i, &states[i]);
+    }
+    for (int i = 0; i < 4; i++) {
+        printf("  %s: score %d, max combo %d\n", table.cold[i].label, table.score[i], table.max_combo[i]);
+    }
+
+    combo_table_free(&table);
+    combo_set_clock(NULL);
+    printf("  ✓ 5000 random operations agree\n");
+}
+
+void test_conversion_and_objectives() {
+    printf("Test 2: ComboState conversion and objectives\n");
+
+    ComboState state;
+    combo_init(&state, "Reading");
+    Objective objectives[2];
+    objective_init(&objectives[0], "Chapter", "Finish a chapter", 10);
+    objective_init(&objectives[1], "Book", "Finish the book", 100);
+    combo_set_objectives(&state, objectives, 2);
+    combo_resume(&state);
+    combo_increment(&state, 4);
+
+    ComboStateTable table;
+    assert(combo_table_init(&table, 4));
+    int index = combo_table_add_state(&table, &state);
+    assert(index == 0);
+    combo_table_increment(&table, 0, 8);
+    combo_increment(&state, 8);
+    assert(table.cold[0].objectives != state.objectives);
+    assert(table.cold[0].objectives[0].completed);
+
+    ComboState out;
+    combo_table_get_state(&table, 0, &out);
+    assert(strcmp(out.label, "Reading") == 0);
+    assert(out.score == state.score);
+    assert(out.objective_count == 2);
+    assert(out.objectives[0].current_score == state.objectives[0].current_score);
+    printf("  ✓ Round trip keeps score %d and objectives\n", out.score);
+
+    free(out.objectives);
+    free(state.objectives);
+    combo_table_free(&table);
+}
+
+void test_scale_and_remove() {
+    printf("Test 3: 100k trackers and removal\n");
+
+    ComboStateTable table;
+    assert(combo_table_init(&table, 0));
+    for (int i = 0; i < 100000; i++) {
+        char label[MAX_LABEL_LENGTH];
+        snprintf(label, sizeof(label), "T%d", i);
+        assert(combo_table_add(&table, label) == i);
+        combo_table_resume(&table, (uint32_t)i);
+        combo_table_increment(&table, (uint32_t)i, (uint32_t)(i % 7));
+    }
+    assert(table.count == 100000);
+    assert(((uintptr_t)table.score % COMBO_TABLE_ALIGNMENT) == 0);
+    assert(((uintptr_t)table.multiplier % COMBO_TABLE_ALIGNMENT) == 0);
+
+    long long total = 0;
+    for (uint32_t i = 0; i < table.count; i++) {
+        total += table.score[i];
+    }
+    printf("  Total score across %u trackers: %lld\n", table.count, total);
+
+    // Removing moves the last tracker into the hole
+    combo_table_remove(&table, 10);
+    assert(table.count == 99999);
+    assert(strcmp(table.cold[10].label, "T99999") == 0);
+    assert(table.score[10] == 99999 % 7);
+
+    combo_table_free(&table);
+    printf("  ✓ Table scales and removes in O(1)\n");
+}
+
+static void fill_random(ComboState* states, uint32_t count, unsigned seed) {
+    srand(seed);
+    for (uint32_t i = 0; i < count; i++) {
+        combo_init(&states[i], "Bulk");
+        if (rand() % 4) combo_resume(&states[i]);
+        if (rand() % 3 == 0) {
+            interval_tracker_add(&states[i].interval_tracker, "Set", 1 + rand() % 3, 1 + rand() % 3);
+            if (!states[i].paused) combo_resume(&states[i]);
+        }
+        int hits = rand() % 12;
+        for (int h = 0; h < hits; h++) {
+            combo_increment(&states[i], 1 + (uint32_t)(rand() % 5));
+        }
+    }
+}
+
+void test_update_all_semantics() {
+    printf("Test 4: Lazy decay and combo_update_all intervals\n");
+
+    combo_set_clock(test_clock);
+    g_test_now = 100.0;
+    ComboStateTable table;
+    assert(combo_table_init(&table, 0));
+    combo_table_add(&table, "Decay");
+    combo_table_resume(&table, 0);
+    for (int i = 0; i < 4; i++) {
+        combo_table_increment(&table, 0, 1);
+    }
+    assert(table.combo[0] == 4);
+
+    // Frame updates never touch an idle tracker's combo
+    for (int frame = 0; frame < 600; frame++) {
+        combo_update_all(&table, 0.125f);
+    }
+    assert(table.combo[0] == 4 && table.decay_pause[0] == COMBO_DECAY_TIME);
+
+    // Decay is applied from the timestamp when the tracker is settled
+    g_test_now += COMBO_DECAY_TIME + 2.5;
+    combo_table_settle(&table, 0, combo_clock_now());
+    printf("  Combo after 7.5s idle: %d, multiplier %.2f\n", table.combo[0], table.multiplier[0]);
+    assert(table.combo[0] == 2);
+    assert(table.multiplier[0] > 1.19f && table.multiplier[0] < 1.21f);
+    g_test_now += 10.0;
+    combo_table_increment(&table, 0, 1);
+    assert(table.combo[0] == 1);
+
+    // Interval: two reps of one second each
+    combo_table_add(&table, "Interval");
+    combo_table_set_interval(&table, 1, "Plank", 1, 2);
+    combo_table_resume(&table, 1);
+    for (int frame = 0; frame < 17; frame++) {
+        combo_update_all(&table, 0.125f);
+    }
+    assert(table.score[1] == 20);
+    assert(table.interval_flags[1] == 0);
+    assert(table.timers.active_count == 0);
+    printf("  ✓ Lazy decay and interval completion work\n");
+    combo_table_free(&table);
+    combo_set_clock(NULL);
+}
+
+static void assert_intervals_match(ComboStateTable* table, ComboState* states, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        combo_settle(&states[i], combo_clock_now());
+        combo_table_settle(table, i, combo_clock_now());
+        const IntervalTracker* it = &states[i].interval_tracker;
+        assert(table->score[i] == states[i].score);
+        assert(table->combo[i] == states[i].combo);
+        assert(table->interval_rep[i] == it->current_rep);
+        assert(((table->interval_flags[i] & COMBO_INTERVAL_ACTIVE) != 0) == it->has_interval);
+        if (it->has_interval) {
+            float remaining = combo_table_interval_remaining(table, i);
+            assert(remaining > it->current_time - 0.001f && remaining < it->current_time + 0.001f);
+        }
+    }
+}
+
+void test_timer_wheel_matches_polling() {
+    printf("Test 5: Timer wheel intervals match per-tracker polling\n");
+
+    combo_set_clock(test_clock);
+    g_test_now = 0.0;
+
+    uint32_t count = 1003;
+    ComboState* states = malloc(sizeof(ComboState) * count);
+    fill_random(states, count, 7);
+    ComboStateTable table;
+    assert(combo_table_init(&table, 0));
+    for (uint32_t i = 0; i < count; i++) {
+        combo_table_add_state(&table, &states[i]);
+    }
+
+    // 1/8s frames keep both sides on exact deadlines
+    const float dt = 0.125f;
+    for (int frame = 1; frame <= 600; frame++) {
+        g_test_now += dt;
+        for (uint32_t i = 0; i < count; i++) {
+            combo_update(&states[i], dt);
+        }
+        combo_update_all(&table, dt);
+
+        uint32_t pick = (uint32_t)(frame * 7919) % count;
+        if (frame % 10 == 0) {
+            if (states[pick].paused) {
+                combo_resume(&states[pick]);
+                combo_table_resume(&table, pick);
+            } else {
+                combo_pause(&states[pick]);
+                combo_table_pause(&table, pick);
+            }
+        }
+        if (frame % 25 == 0) {
+            // Swap-remove on both sides; the moved tracker keeps its deadline
+            free(states[pick].objectives);
+            states[pick] = states[--count];
+            combo_table_remove(&table, pick);
+        }
+        if (frame % 8 == 0) {
+            assert_intervals_match(&table, states, count);
+        }
+    }
+
+    assert(table.count == count);
+    assert_intervals_match(&table, states, count);
+    for (uint32_t i = 0; i < count; i++) {
+        free(states[i].objectives);
+    }
+    printf("  ✓ %u trackers agree every 8 frames for 600 frames\n", count);
+    combo_set_clock(NULL);
+    combo_table_free(&table);
+    free(states);
+}
+
+void test_increment_batch() {
+    printf("Test 6: Table batch matches ComboState batch\n");
+
+    combo_set_clock(test_clock);
+    g_test_now = 10.0;
+    Objective goal;
+    objective_init(&goal, "Goal", "Reach 300", 300);
+
+    ComboState state;
+    combo_init(&state, "Batch");
+    combo_set_objectives(&state, &goal, 1);
+    combo_resume(&state);
+    ComboStateTable table;
+    assert(combo_table_init(&table, 0));
+    combo_table_add_state(&table, &state);
+
+    HitEvent events[500];
+    srand(5);
+    double t = g_test_now;
+    for (int i = 0; i < 500; i++) {
+        t += (rand() % 40 == 0) ? 8.0 : 0.2;
+        events[i] = (HitEvent){t, 1 + (uint32_t)(rand() % 6),
+                               (rand() % 20 == 0) ? HIT_EVENT_MISS : HIT_EVENT_HIT};
+    }
+    combo_increment_batch(&state, events, 500);
+    combo_table_increment_batch(&table, 0, events, 250);
+    combo_table_increment_batch(&table, 0, events + 250, 250);
+    assert_matches(&table, 0, &state);
+    assert(table.last_hit_time[0] == state.last_hit_time);
+    assert(table.cold[0].objectives[0].current_score == state.objectives[0].current_score);
+    assert(table.cold[0].objectives[0].completed && state.objectives[0].completed);
+
+    free(state.objectives);
+    combo_table_free(&table);
+    combo_set_clock(NULL);
+    printf("  ✓ Score %d, combo %d on both\n", state.score, state.combo);
+}
+
+void test_settle_all_matches_scalar() {
+    printf("Test 7: Bulk settle matches per-tracker settle\n");
+
+    combo_set_clock(test_clock);
+    g_test_now = 0.0;
+
+    // Odd count so the vector loop leaves a scalar tail
+    uint32_t count = 1003;
+    ComboState* states = malloc(sizeof(ComboState) * count);
+    fill_random(states, count, 11);
+    ComboStateTable bulk, reference;
+    assert(combo_table_init(&bulk, 0) && combo_table_init(&reference, 0));
+    for (uint32_t i = 0; i < count; i++) {
+        combo_table_add_state(&bulk, &states[i]);
+        combo_table_add_state(&reference, &states[i]);
+    }
+
+    srand(13);
+    for (int step = 0; step < 400; step++) {
+        g_test_now += (double)(rand() % 300) / 100.0;
+        uint32_t pick = (uint32_t)rand() % count;
+        if (rand() % 3 == 0) {
+            uint32_t amount = 1 + (uint32_t)(rand() % 5);
+            combo_table_increment(&bulk, pick, amount);
+            combo_table_increment(&reference, pick, amount);
+        }
+        combo_table_settle_all(&bulk, combo_clock_now());
+        combo_table_settle_all_scalar(&reference, combo_clock_now());
+        for (uint32_t i = 0; i < count; i++) {
+            assert(bulk.combo[i] == reference.combo[i]);
+            assert(bulk.multiplier[i] == reference.multiplier[i]);
+            assert(bulk.decay_pause[i] == reference.decay_pause[i]);
+            assert(bulk.last_hit_time[i] == reference.last_hit_time[i]);
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        free(states[i].objectives);
+    }
+    printf("  ✓ %u trackers agree over 400 settles (%s)\n", count, combo_table_settle_isa());
+    combo_set_clock(NULL);
+    combo_table_free(&bulk);
+    combo_table_free(&reference);
+    free(states);
+}
+
+int main() {
+    printf("Running combo table tests...\n\n");
+
+    test_matches_combo_state();
+    printf("\n");
+
+    test_conversion_and_objectives();
+    printf("\n");
+
+    test_scale_and_remove();
+    printf("\n");
+
+    test_update_all_semantics();
+    printf("\n");
+
+    test_timer_wheel_matches_polling();
+    printf("\n");
+
+    test_increment_batch();
+    printf("\n");
+
+    test_settle_all_matches_scalar();
+    printf("\n");
+
+    printf("🎉 All combo table tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,168 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include "src/hit_queue.h"
+
+#define PRODUCERS 4
+#define HITS_PER_PRODUCER 250000
+
+typedef struct {
+    HitQueue* queue;
+    uint32_t producer;
+    uint32_t retries;
+} ProducerArgs;
+
+static volatile int g_start = 0;
+
+// Each hit carries its producer in `tracker` and a sequence number in `amount`
+static void* producer_main(void* arg) {
+    ProducerArgs* args = arg;
+    while (!__atomic_load_n(&g_start, __ATOMIC_ACQUIRE)) {}
+
+    for (uint32_t seq = 0; seq < HITS_PER_PRODUCER; seq++) {
+        HitEvent event = {(double)seq, seq, HIT_EVENT_HIT};
+        while (!hit_queue_push(args->queue, args->producer, &event)) {
+            args->retries++;
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+void test_full_queue() {
+    printf("Test 1: Full ring rejects and counts drops\n");
+
+    HitQueue queue;
+    assert(hit_queue_init(&queue, 5));
+    assert(queue.mask == 7);
+
+    HitEvent event = {1.0, 1, HIT_EVENT_HIT};
+    for (uint32_t i = 0; i < 8; i++) {
+        assert(hit_queue_push(&queue, i, &event));
+    }
+    assert(!hit_queue_push(&queue, 8, &event));
+    assert(hit_queue_dropped(&queue) == 1);
+
+    // Wrap around a few laps
+    QueuedHit out[8];
+    for (uint32_t lap = 0; lap < 5; lap++) {
+        assert(hit_queue_pop(&queue, out, 3) == 3);
+        assert(out[0].tracker == lap * 3);
+        for (uint32_t i = 0; i < 3; i++) {
+            assert(hit_queue_push(&queue, 8 + lap * 3 + i, &event));
+        }
+    }
+    assert(hit_queue_pop(&queue, out, 8) == 8);
+    assert(hit_queue_pop(&queue, out, 8) == 0);
+
+    hit_queue_free(&queue);
+    printf("  ✓ Ring wraps and reports drops\n");
+}
+
+void test_concurrent_producers() {
+    printf("Test 2: %d producers, one consumer\n", PRODUCERS);
+
+    HitQueue queue;
+    // Small ring so producers regularly find it full
+    assert(hit_queue_init(&queue, 1024));
+
+    pthread_t threads[PRODUCERS];
+    ProducerArgs args[PRODUCERS];
+    for (uint32_t p = 0; p < PRODUCERS; p++) {
+        args[p] = (ProducerArgs){&queue, p, 0};
+        assert(pthread_create(&threads[p], NULL, producer_main, &args[p]) == 0);
+    }
+    __atomic_store_n(&g_start, 1, __ATOMIC_RELEASE);
+
+    // Per-producer sequences must arrive exactly once and in order
+    uint32_t next_seq[PRODUCERS] = {0};
+    uint64_t received = 0;
+    const uint64_t expected = (uint64_t)PRODUCERS * HITS_PER_PRODUCER;
+    QueuedHit batch[HIT_QUEUE_DRAIN_CHUNK];
+    while (received < expected) {
+        uint32_t n = hit_queue_pop(&queue, batch, HIT_QUEUE_DRAIN_CHUNK);
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t p = batch[i].tracker;
+            assert(p < PRODUCERS);
+            assert(batch[i].event.amount == next_seq[p]);
+            next_seq[p]++;
+        }
+        received += n;
+    }
+
+    uint32_t retries = 0;
+    for (uint32_t p = 0; p < PRODUCERS; p++) {
+        pthread_join(threads[p], NULL);
+        assert(next_seq[p] == HITS_PER_PRODUCER);
+        retries += args[p].retries;
+    }
+    assert(hit_queue_pop(&queue, batch, HIT_QUEUE_DRAIN_CHUNK) == 0);
+    assert(hit_queue_dropped(&queue) == retries);
+
+    hit_queue_free(&queue);
+    printf("  ✓ %llu hits, none lost or duplicated (%u full-ring retries)\n",
+           (unsigned long long)received, retries);
+}
+
+void test_drain_into_table() {
+    printf("Test 3: Draining into a ComboStateTable\n");
+
+    g_start = 0;
+    ComboStateTable table;
+    assert(combo_table_init(&table, PRODUCERS));
+    for (uint32_t p = 0; p < PRODUCERS; p++) {
+        combo_table_add(&table, "Input");
+        combo_table_resume(&table, p);
+    }
+
+    HitQueue queue;
+    assert(hit_queue_init(&queue, HIT_QUEUE_DEFAULT_CAPACITY));
+    pthread_t threads[PRODUCERS];
+    ProducerArgs args[PRODUCERS];
+    for (uint32_t p = 0; p < PRODUCERS; p++) {
+        args[p] = (ProducerArgs){&queue, p, 0};
+        assert(pthread_create(&threads[p], NULL, producer_main, &args[p]) == 0);
+    }
+    __atomic_store_n(&g_start, 1, __ATOMIC_RELEASE);
+
+    // Simulation loop: drain, then update
+    uint64_t drained = 0;
+    const uint64_t expected = (uint64_t)PRODUCERS * HITS_PER_PRODUCER;
+    while (drained < expected) {
+        drained += hit_queue_drain(&queue, &table);
+        combo_update_all(&table, 1.0f / 60.0f);
+    }
+    for (uint32_t p = 0; p < PRODUCERS; p++) {
+        pthread_join(threads[p], NULL);
+    }
+
+    for (uint32_t p = 0; p < PRODUCERS; p++) {
+        assert(table.total_hits[p] == HITS_PER_PRODUCER);
+        // One hit per second never outlasts the decay pause
+        assert(table.max_combo[p] == HITS_PER_PRODUCER);
+    }
+
+    hit_queue_free(&queue);
+    combo_table_free(&table);
+    printf("  ✓ Every tracker received all %d hits\n", HITS_PER_PRODUCER);
+}
+
+int main() {
+    printf("Running hit queue tests...\n\n");
+
+    test_full_queue();
+    printf("\n");
+
+    test_concurrent_producers();
+    printf("\n");
+
+    test_drain_into_table();
+    printf("\n");
+
+    printf("🎉 All hit queue tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include "src/hit_stats.h"
+#include "src/core.h"
+#include "src/combo_table.h"
+
+#define REFERENCE_GAPS 20000
+
+static double fake_time = 0.0;
+static double fake_clock(void) { return fake_time; }
+
+static int compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return x < y ? -1 : (x > y);
+}
+
+void test_small_gaps_exact() {
+    printf("Test 1: Short gaps are exact, mean and variance match\n");
+
+    HitStats stats;
+    hit_stats_init(&stats);
+    assert(hit_stats_quantile(&stats, 0.5f) == 0.0f);
+
+    // First hit only starts the run
+    uint32_t now = 1000;
+    hit_stats_record(&stats, now, 0);
+    assert(stats.gaps == 0);
+
+    const uint32_t gaps[] = {3, 5, 1, 7, 5, 2};
+    double sum = 0.0;
+    for (int i = 0; i < 6; i++) {
+        now += gaps[i];
+        hit_stats_record(&stats, now, 0);
+        sum += gaps[i];
+    }
+    double mean = sum / 6.0;
+    double m2 = 0.0;
+    for (int i = 0; i < 6; i++) m2 += (gaps[i] - mean) * (gaps[i] - mean);
+
+    assert(stats.gaps == 6 && stats.min_ms == 1 && stats.max_ms == 7);
+    assert(fabs(hit_stats_mean(&stats) - mean) < 1e-4);
+    assert(fabs(hit_stats_stddev(&stats) - sqrt(m2 / 5.0)) < 1e-3);
+    assert(hit_stats_quantile(&stats, 0.5f) == 3.0f);
+    assert(hit_stats_quantile(&stats, 1.0f) == 7.0f);
+    assert(hit_stats_quantile(&stats, 0.0f) == 1.0f);
+    printf("  ✓ p50 3 ms, mean %.2f ms, stddev %.2f ms\n", hit_stats_mean(&stats), hit_stats_stddev(&stats));
+}
+
+void test_quantile_error_bound() {
+    printf("Test 2: Quantiles stay within 6.25%% of the sorted reference\n");
+
+    srand(19);
+    static uint32_t reference[REFERENCE_GAPS];
+    HitStats stats;
+    hit_stats_init(&stats);
+
+    // Mostly a steady rhythm around 600 ms with occasional long rests
+    uint32_t now = 0;
+    hit_stats_record(&stats, now, 0);
+    for (int i = 0; i < REFERENCE_GAPS; i++) {
+        uint32_t gap = 450 + (uint32_t)(rand() % 300);
+        if (rand() % 20 == 0) gap = 2000 + (uint32_t)(rand() % 8000);
+        reference[i] = gap;
+        now += gap;
+        hit_stats_record(&stats, now, 0);
+    }
+    qsort(reference, REFERENCE_GAPS, sizeof(uint32_t), compare_u32);
+
+    const float quantiles[] = {0.01f, 0.1f, 0.5f, 0.9f, 0.95f, 0.99f};
+    for (int i = 0; i < 6; i++) {
+        float q = quantiles[i];
+        uint32_t rank = (uint32_t)ceilf(q * REFERENCE_GAPS);
+        float expected = (float)reference[rank - 1];
+        float actual = hit_stats_quantile(&stats, q);
+        assert(fabsf(actual - expected) <= expected * 0.0625f + 0.5f);
+    }
+    printf("  ✓ p50 %.0f ms (exact %u), p95 %.0f ms (exact %u)\n",
+           hit_stats_quantile(&stats, 0.5f), reference[REFERENCE_GAPS / 2 - 1],
+           hit_stats_quantile(&stats, 0.95f), reference[(uint32_t)ceilf(0.95f * REFERENCE_GAPS) - 1]);
+}
+
+void test_deadline_break_and_wrap() {
+    printf("Test 3: Deadline bands, breaks, long gaps and clock wrap\n");
+
+    HitStats stats;
+    hit_stats_init(&stats);
+
+    // 1000 ms deadline: 800..1000 is close, past 1000 is late
+    uint32_t now = UINT32_MAX - 1500;       // Wraps during the run
+    hit_stats_record(&stats, now, 1000);
+    now += 500;  hit_stats_record(&stats, now, 1000);
+    now += 800;  hit_stats_record(&stats, now, 1000);
+    now += 1000; hit_stats_record(&stats, now, 1000);
+    now += 1001; hit_stats_record(&stats, now, 1000);
+    assert(stats.gaps == 4 && stats.near_deadline == 2 && stats.late == 1);
+    assert(stats.min_ms == 500 && stats.max_ms == 1001);
+
+    // No gap across a break or past the cap
+    hit_stats_break(&stats);
+    now += 30;
+    hit_stats_record(&stats, now, 1000);
+    now += HIT_STATS_MAX_GAP_MS + 1;
+    hit_stats_record(&stats, now, 1000);
+    assert(stats.gaps == 4);
+    now += 600;
+    hit_stats_record(&stats, now, 0);
+    assert(stats.gaps == 5 && stats.late == 1);
+
+    HitTimingSummary summary;
+    hit_stats_summary(&stats, &summary);
+    assert(summary.gaps == 5);
+    assert(fabsf(summary.near_deadline_fraction - 0.4f) < 1e-6f);
+    assert(fabsf(summary.late_fraction - 0.2f) < 1e-6f);
+    printf("  ✓ 2 close and 1 late out of 5, nothing across the break\n");
+}
+
+void test_halving_keeps_shape() {
+    printf("Test 4: Saturated buckets are halved, quantiles hold\n");
+
+    HitStats stats;
+    hit_stats_init(&stats);
+    uint32_t now = 0;
+    hit_stats_record(&stats, now, 0);
+    // 3:1 mix of 400 ms and 1200 ms gaps, well past a bucket's capacity
+    for (uint32_t i = 0; i < 300000; i++) {
+        now += (i % 4 == 3) ? 1200 : 400;
+        hit_stats_record(&stats, now, 0);
+    }
+    assert(stats.gaps == 300000);
+    assert(stats.sketch_total < stats.gaps);
+    assert(fabsf(hit_stats_quantile(&stats, 0.5f) - 400.0f) <= 400.0f * 0.0625f);
+    assert(fabsf(hit_stats_quantile(&stats, 0.9f) - 1200.0f) <= 1200.0f * 0.0625f);
+    assert(fabsf(hit_stats_mean(&stats) - 600.0f) < 1.0f);
+    printf("  ✓ %u gaps in a %u-count sketch, p50 %.0f, p90 %.0f\n", stats.gaps, stats.sketch_total,
+           hit_stats_quantile(&stats, 0.5f), hit_stats_quantile(&stats, 0.9f));
+}
+
+void test_tracker_timing() {
+    printf("Test 5: Trackers and table rows record the same gaps\n");
+
+    combo_set_clock(fake_clock);
+    fake_time = 100.0;
+
+    ComboState single, batched;
+    combo_init(&single, "Single");
+    combo_init(&batched, "Batched");
+    combo_resume(&single);
+    combo_resume(&batched);
+
+    ComboStateTable table;
+    assert(combo_table_init(&table, 0));
+    int row = combo_table_add(&table, "Row");
+    combo_table_resume(&table, (uint32_t)row);
+
+    HitEvent events[6];
+    const double gaps[] = {0.0, 1.0, 4.5, 0.5, 6.0, 2.0};
+    double t = 100.0;
+    for (int i = 0; i < 6; i++) {
+        t += gaps[i];
+        fake_time = t;
+        combo_increment(&single, 1);
+        combo_table_increment(&table, (uint32_t)row, 1);
+        events[i] = (HitEvent){t, 1, HIT_EVENT_HIT};
+    }
+    combo_increment_batch(&batched, events, 6);
+
+    // Deadline is decay_time (5 s): 4.5 s is close, 6 s is late
+    assert(single.timing.gaps == 5 && single.timing.near_deadline == 1 && single.timing.late == 1);
+    assert(memcmp(&single.timing, &batched.timing, sizeof(HitStats)) == 0);
+    assert(memcmp(&single.timing, &table.timing[row], sizeof(HitStats)) == 0);
+
+    // Pausing ends the run; the first hit after resuming has no gap
+    combo_pause(&single);
+    fake_time += 60.0;
+    combo_resume(&single);
+    combo_increment(&single, 1);
+    assert(single.timing.gaps == 5);
+    fake_time += 1.0;
+    combo_increment(&single, 1);
+    assert(single.timing.gaps == 6);
+
+    // Round trip through the table keeps the stats
+    ComboState copy;
+    combo_table_add_state(&table, &single);
+    combo_table_get_state(&table, 1, &copy);
+    assert(memcmp(&copy.timing, &single.timing, sizeof(HitStats)) == 0);
+    combo_release(&copy);
+
+    combo_table_free(&table);
+    combo_release(&single);
+    combo_release(&batched);
+    combo_set_clock(NULL);
+    printf("  ✓ Single hits, batches and table rows agree\n");
+}
+
+int main() {
+    printf("Running hit timing tests...\n\n");
+
+    test_small_gaps_exact();
+    printf("\n");
+
+    test_quantile_error_bound();
+    printf("\n");
+
+    test_deadline_break_and_wrap();
+    printf("\n");
+
+    test_halving_keeps_shape();
+    printf("\n");
+
+    test_tracker_timing();
+    printf("\n");
+
+    printf("🎉 All hit timing tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,316 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "src/core.h"
+#include "src/journal.h"
+#include "src/persistence.h"
+#include "src/combo_format.h"
+
+static long file_size(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+static double g_test_now = 0.0;
+
+static double test_clock(void) {
+    return g_test_now;
+}
+
+static void free_trackers(ComboState* trackers, int count) {
+    for (int i = 0; i < count; i++) {
+        if (trackers[i].objectives) {
+            free(trackers[i].objectives);
+        }
+    }
+}
+
+void test_replay_after_crash() {
+    printf("Test 1: Journal replay on load\n");
+
+    ComboState trackers[2];
+    combo_init(&trackers[0], "Push-ups");
+    combo_init(&trackers[1], "Squats");
+    combo_resume(&trackers[0]);
+    combo_increment(&trackers[0], 5);
+
+    // Snapshot, then events that only made it into the journal
+    combo_save_snapshot(trackers, 2, "test_journal.dat", 7);
+    assert(combo_read_snapshot_generation("test_journal.dat") == 7);
+    assert(journal_reset("test_journal.dat", 7));
+
+    JournalRecord records[4];
+    combo_increment(&trackers[0], 3);
+    journal_record_init(&records[0], 0, JOURNAL_OP_HIT, 3, &trackers[0]);
+    combo_resume(&trackers[1]);
+    journal_record_init(&records[1], 1, JOURNAL_OP_RESUME, 0, &trackers[1]);
+    combo_increment(&trackers[1], 10);
+    journal_record_init(&records[2], 1, JOURNAL_OP_HIT, 10, &trackers[1]);
+    combo_decrement(&trackers[0], 1);
+    journal_record_init(&records[3], 0, JOURNAL_OP_DECREMENT, 1, &trackers[0]);
+    assert(journal_append("test_journal.dat", records, 4));
+
+    ComboState loaded[8];
+    memset(loaded, 0, sizeof(loaded));
+    int count = combo_load_all_trackers(loaded, 8, "test_journal.dat");
+    assert(count == 2);
+    for (int i = 0; i < 2; i++) {
+        printf("  %s: score %d (expected %d), combo %d\n",
+               loaded[i].label, loaded[i].score, trackers[i].score, loaded[i].combo);
+        assert(loaded[i].score == trackers[i].score);
+        assert(loaded[i].combo == trackers[i].combo);
+        assert(loaded[i].paused == trackers[i].paused);
+        assert(loaded[i].total_hits == trackers[i].total_hits);
+    }
+    free_trackers(loaded, count);
+    printf("  ✓ Journaled events recovered\n");
+}
+
+void test_stale_and_torn_journal() {
+    printf("Test 2: Stale and torn journals\n");
+
+    ComboState trackers[1];
+    combo_init(&trackers[0], "Reading");
+    combo_resume(&trackers[0]);
+    combo_increment(&trackers[0], 4);
+
+    // Journal from an older generation must not be replayed
+    combo_save_snapshot(trackers, 1, "test_journal.dat", 3);
+    assert(journal_reset("test_journal.dat", 2));
+    combo_increment(&trackers[0], 100);
+    JournalRecord record;
+    journal_record_init(&record, 0, JOURNAL_OP_HIT, 100, &trackers[0]);
+    assert(journal_append("test_journal.dat", &record, 1));
+
+    ComboState loaded[8];
+    memset(loaded, 0, sizeof(loaded));
+    combo_load_all_trackers(loaded, 8, "test_journal.dat");
+    assert(loaded[0].score == 4);
+    free_trackers(loaded, 1);
+    printf("  ✓ Stale journal ignored\n");
+
+    // A half-written record at the tail is dropped, earlier ones are kept
+    assert(journal_reset("test_journal.dat", 3));
+    assert(journal_append("test_journal.dat", &record, 1));
+    FILE* f = fopen("test_journal.dat.journal", "ab");
+    fwrite(&record, 1, sizeof(record) / 2, f);
+    fclose(f);
+
+    memset(loaded, 0, sizeof(loaded));
+    combo_load_all_trackers(loaded, 8, "test_journal.dat");
+    printf("  Score after torn tail: %d\n", loaded[0].score);
+    assert(loaded[0].score == trackers[0].score && loaded[0].total_hits == 2);
+    free_trackers(loaded, 1);
+    printf("  ✓ Torn tail ignored\n");
+}
+
+void test_worker_appends_and_compacts() {
+    printf("Test 3: Worker appends events and compacts on exit\n");
+
+    remove("test_journal.dat");
+    remove("test_journal.dat.journal");
+
+    ComboState trackers[3];
+    combo_init(&trackers[0], "A");
+    combo_init(&trackers[1], "B");
+    combo_init(&trackers[2], "C");
+
+    assert(persistence_start("test_journal.dat", 1));
+    persistence_mark_dirty(trackers, 3, -1);
+    persistence_flush();
+    long snapshot_size = file_size("test_journal.dat");
+    assert(snapshot_size > 0);
+
+    for (int i = 0; i < 3; i++) {
+        combo_resume(&trackers[i]);
+        persistence_record_event(trackers, 3, i, JOURNAL_OP_RESUME, 0);
+    }
+    for (int hit = 0; hit < 90; hit++) {
+        int index = hit % 3;
+        combo_increment(&trackers[index], 1);
+        persistence_record_event(trackers, 3, index, JOURNAL_OP_HIT, 1);
+    }
+    persistence_flush();
+
+    // Events went to the journal; the snapshot was not rewritten
+    long journal_size = file_size("test_journal.dat.journal");
+    printf("  Snapshot %ld bytes, journal %ld bytes\n", snapshot_size, journal_size);
+    assert(journal_size == (long)(sizeof(JournalHeader) + 93 * sizeof(JournalRecord)));
+    assert(file_size("test_journal.dat") == snapshot_size);
+
+    ComboState loaded[8];
+    memset(loaded, 0, sizeof(loaded));
+    int count = combo_load_all_trackers(loaded, 8, "test_journal.dat");
+    assert(count == 3);
+    for (int i = 0; i < 3; i++) {
+        assert(loaded[i].score == trackers[i].score);
+    }
+    free_trackers(loaded, count);
+
+    // Stopping folds the journal into a new snapshot
+    persistence_stop();
+    assert(file_size("test_journal.dat.journal") == (long)sizeof(JournalHeader));
+
+    memset(loaded, 0, sizeof(loaded));
+    count = combo_load_all_trackers(loaded, 8, "test_journal.dat");
+    for (int i = 0; i < 3; i++) {
+        assert(loaded[i].score == trackers[i].score);
+        assert(loaded[i].combo == trackers[i].combo);
+    }
+    free_trackers(loaded, count);
+    printf("  ✓ Worker journal and compaction work\n");
+}
+
+void test_failed_snapshot_keeps_old_pair() {
+    printf("Test 4: A failed snapshot write keeps the old snapshot and journal\n");
+
+    remove("test_journal.dat");
+    remove("test_journal.dat.journal");
+
+    ComboState trackers[2];
+    combo_init(&trackers[0], "A");
+    combo_init(&trackers[1], "B");
+    combo_resume(&trackers[0]);
+
+    assert(persistence_start("test_journal.dat", 1));
+    persistence_mark_dirty(trackers, 2, -1);
+    persistence_flush();
+    for (int hit = 0; hit < 5; hit++) {
+        combo_increment(&trackers[0], 1);
+        persistence_record_event(trackers, 2, 0, JOURNAL_OP_HIT, 1);
+    }
+    persistence_flush();
+    long snapshot_size = file_size("test_journal.dat");
+    long journal_size = file_size("test_journal.dat.journal");
+    int saved_score = trackers[0].score;
+
+    // A non-empty directory in the temp file's place makes every snapshot
+    // write fail
+    assert(mkdir("test_journal.dat.tmp", 0700) == 0);
+    FILE* blocker = fopen("test_journal.dat.tmp/blocker", "wb");
+    assert(blocker);
+    fclose(blocker);
+    combo_increment(&trackers[1], 7);
+    persistence_mark_dirty(trackers, 2, -1);
+    persistence_flush();
+    assert(file_size("test_journal.dat") == snapshot_size);
+    assert(file_size("test_journal.dat.journal") == journal_size);
+
+    ComboState loaded[8];
+    memset(loaded, 0, sizeof(loaded));
+    int count = combo_load_all_trackers(loaded, 8, "test_journal.dat");
+    assert(count == 2 && loaded[0].score == saved_score && loaded[1].score == 0);
+    free_trackers(loaded, count);
+
+    // Once the disk recovers the exit fold writes everything
+    assert(remove("test_journal.dat.tmp/blocker") == 0 && rmdir("test_journal.dat.tmp") == 0);
+    persistence_stop();
+    memset(loaded, 0, sizeof(loaded));
+    count = combo_load_all_trackers(loaded, 8, "test_journal.dat");
+    assert(count == 2 && loaded[0].score == saved_score && loaded[1].score == trackers[1].score);
+    free_trackers(loaded, count);
+    printf("  ✓ Score %d survived the failed write, the exit fold saved the rest\n", saved_score);
+}
+
+void test_replay_keeps_hit_timing() {
+    printf("Test 5: Replay does not credit combo that decayed between hits\n");
+
+    remove("test_journal.dat");
+    remove("test_journal.dat.journal");
+    combo_set_clock(test_clock);
+    g_test_now = 100.0;
+
+    ComboState trackers[1];
+    combo_init(&trackers[0], "Sprints");
+    combo_resume(&trackers[0]);
+    combo_save_snapshot(trackers, 1, "test_journal.dat", 11);
+    assert(journal_reset("test_journal.dat", 11));
+
+    // Bursts of hits with pauses long enough for the combo to drain
+    JournalRecord records[30];
+    for (int i = 0; i < 30; i++) {
+        g_test_now += (i % 6 == 0) ? 20.0 : 0.5;
+        combo_increment(&trackers[0], 2);
+        journal_record_init(&records[i], 0, JOURNAL_OP_HIT, 2, &trackers[0]);
+    }
+    assert(journal_append("test_journal.dat", records, 30));
+    assert(trackers[0].max_combo == 6);
+
+    // Recovered much later: the crash gap does not decay anything either
+    g_test_now = 5000.0;
+    ComboState loaded[8];
+    memset(loaded, 0, sizeof(loaded));
+    assert(combo_load_all_trackers(loaded, 8, "test_journal.dat") == 1);
+    printf("  Score %d (expected %d), max combo %d\n", loaded[0].score, trackers[0].score,
+           loaded[0].max_combo);
+    assert(loaded[0].score == trackers[0].score);
+    assert(loaded[0].combo == trackers[0].combo);
+    assert(loaded[0].max_combo == trackers[0].max_combo);
+    assert(loaded[0].multiplier == trackers[0].multiplier);
+    assert(loaded[0].total_hits == 30);
+    free_trackers(loaded, 1);
+    combo_set_clock(NULL);
+    printf("  ✓ Recovered score matches the live one\n");
+}
+
+void test_queued_side_write() {
+    printf("Test 6: The worker writes queued side files\n");
+
+    remove("test_journal.dat");
+    remove("test_journal.dat.journal");
+    remove("test_journal.side");
+
+    ByteWriter data;
+    writer_init(&data, 16);
+    writer_put_string(&data, "history");
+    size_t size = data.size;
+    assert(!persistence_queue_write("test_journal.side", &data));
+    assert(data.data != NULL);
+
+    assert(persistence_start("test_journal.dat", 1));
+    assert(persistence_queue_write("test_journal.side", &data));
+    assert(data.data == NULL && data.size == 0);
+    persistence_stop();
+
+    assert(file_size("test_journal.side") == (long)size);
+    // A side write alone does not write tracker files
+    assert(file_size("test_journal.dat") == -1);
+    remove("test_journal.side");
+    printf("  ✓ Side file written off the caller's thread\n");
+}
+
+int main() {
+    printf("Running hit journal tests...\n\n");
+
+    test_replay_after_crash();
+    printf("\n");
+
+    test_stale_and_torn_journal();
+    printf("\n");
+
+    test_worker_appends_and_compacts();
+    printf("\n");
+
+    test_failed_snapshot_keeps_old_pair();
+    printf("\n");
+
+    test_replay_keeps_hit_timing();
+    printf("\n");
+
+    test_queued_side_write();
+    printf("\n");
+
+    printf("🎉 All journal tests passed!\n");
+
+    remove("test_journal.dat");
+    remove("test_journal.dat.journal");
+    return 0;
+}
@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "src/objective_engine.h"
+
+#define FUZZ_TRACKERS 6
+#define FUZZ_GOALS 3000
+
+void test_prefix_completion() {
+    printf("Test 1: Thresholds complete in order, once\n");
+
+    ObjectiveEngine engine;
+    assert(objective_engine_init(&engine, 2));
+    int32_t a = objective_engine_add(&engine, 0, OBJECTIVE_FIELD_SCORE, 100, 10);
+    int32_t b = objective_engine_add(&engine, 0, OBJECTIVE_FIELD_SCORE, 50, 11);
+    int32_t c = objective_engine_add(&engine, 0, OBJECTIVE_FIELD_SCORE, 100, 12);
+    int32_t d = objective_engine_add(&engine, 1, OBJECTIVE_FIELD_SCORE, 10, 13);
+    assert(a >= 0 && b >= 0 && c >= 0 && d >= 0);
+    assert(objective_engine_add(&engine, 2, OBJECTIVE_FIELD_SCORE, 1, 0) == -1);
+
+    assert(objective_engine_observe(&engine, 0, OBJECTIVE_FIELD_SCORE, 49) == 0);
+    assert(objective_engine_observe(&engine, 0, OBJECTIVE_FIELD_COMBO, 500) == 0);
+    assert(objective_engine_observe(&engine, 0, OBJECTIVE_FIELD_SCORE, 120) == 3);
+    assert(objective_engine_observe(&engine, 0, OBJECTIVE_FIELD_SCORE, 500) == 0);
+    assert(engine.goals[a].completed && engine.goals[b].completed && !engine.goals[d].completed);
+
+    ObjectiveEvent events[8];
+    assert(objective_engine_poll(&engine, events, 8) == 3);
+    assert(events[0].goal == (uint32_t)b && events[0].user_id == 11 && events[0].value == 120);
+    assert(events[1].goal == (uint32_t)a && events[2].goal == (uint32_t)c);
+    assert(objective_engine_poll(&engine, events, 8) == 0);
+
+    // Rearming makes them pending again; goals added later join in order
+    objective_engine_rearm(&engine, 0);
+    objective_engine_add(&engine, 0, OBJECTIVE_FIELD_SCORE, 75, 14);
+    assert(objective_engine_observe(&engine, 0, OBJECTIVE_FIELD_SCORE, 80) == 2);
+    assert(objective_engine_poll(&engine, events, 8) == 2);
+    assert(events[0].user_id == 11 && events[1].user_id == 14);
+
+    objective_engine_clear(&engine);
+    assert(objective_engine_observe(&engine, 1, OBJECTIVE_FIELD_SCORE, 100) == 0);
+    objective_engine_free(&engine);
+    printf("  ✓ Events arrive in threshold order\n");
+}
+
+void test_tracker_fields() {
+    printf("Test 2: Score, combo, hit and hit-ratio goals from tracker state\n");
+
+    ObjectiveEngine engine;
+    assert(objective_engine_init(&engine, 1));
+    objective_engine_add(&engine, 0, OBJECTIVE_FIELD_SCORE, 30, 0);
+    objective_engine_add(&engine, 0, OBJECTIVE_FIELD_COMBO, 10, 1);
+    objective_engine_add(&engine, 0, OBJECTIVE_FIELD_HITS, 25, 2);
+    objective_engine_add(&engine, 0, OBJECTIVE_FIELD_HIT_RATIO, 900, 3);
+
+    ComboState state;
+    combo_init(&state, "Engine");
+    combo_resume(&state);
+    uint32_t seen = 0;
+    bool fired[4] = {false};
+    for (int i = 0; i < 40; i++) {
+        if (i == 5) {
+            combo_decrement(&state, 1);
+        } else {
+            combo_increment(&state, 1);
+        }
+        objective_engine_observe_state(&engine, 0, &state);
+
+        ObjectiveEvent event;
+        while (objective_engine_poll(&engine, &event, 1)) {
+            fired[event.user_id] = true;
+            seen++;
+            if (event.field == OBJECTIVE_FIELD_HIT_RATIO) {
+                // Not before enough attempts to be meaningful
+                assert(state.total_hits + state.miss_hits >= OBJECTIVE_RATIO_MIN_ATTEMPTS);
+                assert(event.value >= 900);
+            }
+            if (event.field == OBJECTIVE_FIELD_COMBO) assert(state.max_combo == 10);
+            if (event.field == OBJECTIVE_FIELD_HITS) assert(state.total_hits == 25);
+        }
+    }
+    assert(seen == 4 && fired[0] && fired[1] && fired[2] && fired[3]);
+
+    // Table rows report the same fields
+    ComboStateTable table;
+    assert(combo_table_init(&table, 0));
+    combo_table_add_state(&table, &state);
+    objective_engine_rearm(&engine, 0);
+    assert(objective_engine_observe_table(&engine, 0, &table, 0) == 4);
+    combo_table_free(&table);
+
+    combo_release(&state);
+    objective_engine_free(&engine);
+    printf("  ✓ Every objective kind completes from observed state\n");
+}
+
+void test_matches_linear_scan() {
+    printf("Test 3: Indexed evaluation matches scanning every goal\n");
+
+    srand(77);
+    ObjectiveEngine engine;
+    assert(objective_engine_init(&engine, FUZZ_TRACKERS));
+    static uint8_t expected[FUZZ_GOALS];
+    memset(expected, 0, sizeof(expected));
+
+    int32_t values[FUZZ_TRACKERS][OBJECTIVE_FIELD_COUNT];
+    memset(values, 0, sizeof(values));
+    uint64_t observations = 0;
+    uint32_t completions = 0;
+
+    for (int step = 0; step < 20000; step++) {
+        // Goals keep arriving while values move both ways
+        if (engine.goal_count < FUZZ_GOALS && rand() % 4 == 0) {
+            uint32_t tracker = (uint32_t)(rand() % FUZZ_TRACKERS);
+            ObjectiveField field = (ObjectiveField)(rand() % OBJECTIVE_FIELD_COUNT);
+            objective_engine_add(&engine, tracker, field, rand() % 5000, 0);
+        }
+        uint32_t tracker = (uint32_t)(rand() % FUZZ_TRACKERS);
+        uint32_t field = (uint32_t)(rand() % OBJECTIVE_FIELD_COUNT);
+        values[tracker][field] += rand() % 60 - 20;
+        int32_t value = values[tracker][field];
+        objective_engine_observe(&engine, tracker, (ObjectiveField)field, value);
+        observations++;
+
+        // Reference: look at every goal
+        for (uint32_t g = 0; g < engine.goal_count; g++) {
+            const ObjectiveGoal* goal = &engine.goals[g];
+            if (!expected[g] && goal->tracker == tracker && goal->field == field &&
+                goal->threshold <= value) {
+                expected[g] = 1;
+            }
+        }
+        ObjectiveEvent event;
+        while (objective_engine_poll(&engine, &event, 1)) {
+            assert(expected[event.goal] == 1);
+            assert(event.threshold <= event.value);
+            expected[event.goal] = 2;
+            completions++;
+        }
+        for (uint32_t g = 0; g < engine.goal_count; g++) {
+            assert(engine.goals[g].completed == (expected[g] == 2));
+            assert(expected[g] != 1);
+        }
+    }
+
+    printf("  %u goals, %u completed, %.2f probes per observation\n",
+           engine.goal_count, completions, (double)engine.probes / (double)observations);
+    assert(engine.probes < observations * 4);
+    objective_engine_free(&engine);
+    printf("  ✓ Same completions with a handful of comparisons per change\n");
+}
+
+void test_tracker_objectives() {
+    printf("Test 4: Every objective of a tracker is credited and completes\n");
+
+    Objective goals[3];
+    objective_init(&goals[0], "Warm up", "5 reps", 5);
+    objective_init(&goals[1], "Carry over", "8 reps", 8);
+    objective_init(&goals[2], "Main set", "20 reps", 20);
+    goals[1].current_score = 6;
+
+    ComboState state;
+    combo_init(&state, "Objectives");
+    combo_set_objectives(&state, goals, 3);
+    combo_resume(&state);
+
+    ObjectiveEngine engine;
+    assert(objective_engine_init(&engine, 1));
+    assert(objective_engine_add_objectives(&engine, 0, &state) == 3);
+
+    uint32_t order[3];
+    uint32_t seen = 0;
+    for (int i = 1; i <= 20; i++) {
+        combo_increment(&state, 1);
+        objective_engine_observe_state(&engine, 0, &state);
+
+        ObjectiveEvent event;
+        while (objective_engine_poll(&engine, &event, 1)) {
+            assert(event.field == OBJECTIVE_FIELD_PROGRESS && event.user_id < 3);
+            // The event arrives with the hit that set the flag
+            assert(state.objectives[event.user_id].completed);
+            order[seen++] = event.user_id;
+        }
+        for (uint32_t j = 0; j < 3; j++) {
+            bool fired = false;
+            for (uint32_t k = 0; k < seen; k++) fired |= order[k] == j;
+            assert(fired == state.objectives[j].completed);
+        }
+    }
+    // Not only the active objective progresses
+    assert(state.active_objective_index == 0);
+    assert(seen == 3 && order[0] == 1 && order[1] == 0 && order[2] == 2);
+    assert(state.objectives[1].current_score == 26 && state.objectives[2].current_score == 20);
+
+    // Completed objectives are left out when goals are rebuilt
+    objective_engine_clear(&engine);
+    assert(objective_engine_add_objectives(&engine, 0, &state) == 0);
+
+    // Table rows credit and report the same progress
+    Objective fresh[2];
+    objective_init(&fresh[0], "Short", "3 reps", 3);
+    objective_init(&fresh[1], "Long", "6 reps", 6);
+    combo_set_objectives(&state, fresh, 2);
+    ComboStateTable table;
+    assert(combo_table_init(&table, 0));
+    assert(combo_table_add_state(&table, &state) == 0);
+    assert(objective_engine_add_objectives(&engine, 0, &state) == 2);
+    for (int i = 0; i < 6; i++) {
+        combo_table_increment(&table, 0, 1);
+        objective_engine_observe_table(&engine, 0, &table, 0);
+    }
+    ObjectiveEvent events[4];
+    assert(objective_engine_poll(&engine, events, 4) == 2);
+    assert(events[0].user_id == 0 && events[1].user_id == 1);
+    assert(table.cold[0].objectives[0].completed && table.cold[0].objectives[1].completed);
+    combo_table_free(&table);
+
+    combo_release(&state);
+    objective_engine_free(&engine);
+    printf("  ✓ Objective completions arrive as events, in order\n");
+}
+
+int main() {
+    printf("Running objective engine tests...\n\n");
+
+    test_prefix_completion();
+    printf("\n");
+
+    test_tracker_fields();
+    printf("\n");
+
+    test_matches_linear_scan();
+    printf("\n");
+
+    test_tracker_objectives();
+    printf("\n");
+
+    printf("🎉 All objective engine tests passed!\n");
+    return 0;
+}
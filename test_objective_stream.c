@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "src/objective_stream.h"
+#include "src/sync_worker.h"
+
+static const char* SAMPLE =
+    "{ \"Pushups\" : [ {\"name\":\"Sets\",\"description\":\"Do \\\"sets\\\"\",\"target_score\":40},\n"
+    "                 {\"target_score\":-5,\"extra\":{\"nested\":[1,{\"x\":null}]},\"name\":\"Caf\\u00e9 \\/\"} ],\n"
+    "  \"ignored\" : {\"not\":\"a list\"},\n"
+    "  \"Squats\" : [],\n"
+    "  \"Long\" : [ {\"name\":\"0123456789012345678901234567890123456789012345678901234567890123456789\","
+    "\"target_score\":1e3, \"completed\": true} ] }";
+
+static ObjectiveCatalog decode_in_chunks(const char* json, size_t chunk) {
+    ObjectiveCatalog catalog;
+    objective_catalog_init(&catalog);
+    ObjectiveStream stream;
+    objective_stream_init(&stream, objective_catalog_sink(&catalog));
+    size_t size = strlen(json);
+    for (size_t at = 0; at < size; at += chunk) {
+        size_t n = size - at < chunk ? size - at : chunk;
+        assert(objective_stream_feed(&stream, json + at, n));
+    }
+    assert(objective_stream_finish(&stream));
+    return catalog;
+}
+
+void test_decode_any_split() {
+    printf("Test 1: Same result for every chunk size\n");
+
+    ObjectiveCatalog whole = decode_in_chunks(SAMPLE, strlen(SAMPLE));
+    assert(whole.list_count == 3 && whole.objective_count == 3);
+
+    const ObjectiveList* pushups = objective_catalog_find(&whole, "Pushups");
+    assert(pushups && pushups->count == 2);
+    const Objective* sets = &whole.objectives[pushups->first];
+    assert(strcmp(sets->name, "Sets") == 0);
+    assert(strcmp(sets->description, "Do \"sets\"") == 0);
+    assert(sets->target_score == 40 && sets->current_score == 0 && !sets->completed);
+    assert(strcmp(sets[1].name, "Caf\xc3\xa9 /") == 0 && sets[1].target_score == -5);
+
+    const ObjectiveList* squats = objective_catalog_find(&whole, "Squats");
+    assert(squats && squats->count == 0);
+    assert(!objective_catalog_find(&whole, "ignored"));
+
+    // Strings are cut to the tracker field size
+    const Objective* longest = &whole.objectives[objective_catalog_find(&whole, "Long")->first];
+    assert(strlen(longest->name) == MAX_LABEL_LENGTH - 1);
+
+    for (size_t chunk = 1; chunk < 40; chunk++) {
+        ObjectiveCatalog split = decode_in_chunks(SAMPLE, chunk);
+        assert(split.list_count == whole.list_count);
+        assert(split.objective_count == whole.objective_count);
+        assert(memcmp(split.lists, whole.lists, whole.list_count * sizeof(ObjectiveList)) == 0);
+        for (uint32_t i = 0; i < whole.objective_count; i++) {
+            assert(strcmp(split.objectives[i].name, whole.objectives[i].name) == 0);
+            assert(strcmp(split.objectives[i].description, whole.objectives[i].description) == 0);
+            assert(split.objectives[i].target_score == whole.objectives[i].target_score);
+        }
+        objective_catalog_free(&split);
+    }
+    objective_catalog_free(&whole);
+    printf("  ✓ Chunk boundaries inside strings, escapes and numbers are handled\n");
+}
+
+void test_malformed() {
+    printf("Test 2: Malformed input is rejected\n");
+
+    const char* bad[] = {
+        "[]",
+        "{\"a\":[{\"name\" \"x\"}]}",
+        "{\"a\":[{\"name\":\"x\"]}",
+        "{\"a\":[{\"name\":\"\\q\"}]}",
+        "{\"a\":[{\"name\":\"\\u12G4\"}]}",
+        "{\"a\":[{\"target_score\":nope}]}",
+        "{\"a\":[]} {",
+        "{\"a\":[1,2}",
+    };
+    for (size_t i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        ObjectiveCatalog catalog;
+        objective_catalog_init(&catalog);
+        ObjectiveStream stream;
+        objective_stream_init(&stream, objective_catalog_sink(&catalog));
+        objective_stream_feed(&stream, bad[i], strlen(bad[i]));
+        assert(!objective_stream_finish(&stream));
+        objective_catalog_free(&catalog);
+    }
+
+    // Truncated documents are incomplete, not errors, until finished
+    ObjectiveStream stream;
+    ObjectiveSink none = {0};
+    objective_stream_init(&stream, none);
+    assert(objective_stream_feed(&stream, "{\"a\":[{\"name\":\"x", 16));
+    assert(!objective_stream_finish(&stream));
+    printf("  ✓ %zu malformed documents rejected\n", sizeof(bad) / sizeof(bad[0]));
+}
+
+void test_apply_to_trackers() {
+    printf("Test 3: Decoding straight into tracker storage\n");
+
+    ComboPool pool;
+    combo_pool_init(&pool, 0);
+    ComboState trackers[3];
+    combo_init(&trackers[0], "Pushups");
+    combo_init(&trackers[1], "Squats");
+    combo_init(&trackers[2], "Untouched");
+    combo_set_pool(&trackers[0], &pool);
+
+    Objective keep;
+    objective_init(&keep, "Keep", "Not in the response", 3);
+    combo_set_objectives(&trackers[1], &keep, 1);
+    combo_set_objectives(&trackers[2], &keep, 1);
+
+    assert(combo_sync_apply_objectives(trackers, 3, SAMPLE, strlen(SAMPLE)) == 2);
+    assert(trackers[0].objective_count == 2 && trackers[0].objectives[0].target_score == 40);
+    assert(trackers[1].objective_count == 0 && trackers[1].objectives == NULL);
+    assert(trackers[2].objective_count == 1);
+    assert(pool.stats.blocks_in_use == 1);
+
+    // Lists completed before an error are applied; the broken one is not
+    const char* partial = "{\"Squats\":[{\"name\":\"New\",\"target_score\":9}],\"Pushups\":[{\"name\":\"Half\"";
+    assert(combo_sync_apply_objectives(trackers, 3, partial, strlen(partial)) == -1);
+    assert(trackers[1].objective_count == 1 && strcmp(trackers[1].objectives[0].name, "New") == 0);
+    assert(trackers[0].objective_count == 2 && strcmp(trackers[0].objectives[0].name, "Sets") == 0);
+
+    // A catalog decoded elsewhere applies the same way
+    ObjectiveCatalog catalog = decode_in_chunks(SAMPLE, 7);
+    assert(combo_sync_apply_catalog(trackers, 3, &catalog) == 2);
+    assert(trackers[1].objective_count == 0);
+    objective_catalog_free(&catalog);
+
+    for (int i = 0; i < 3; i++) combo_release(&trackers[i]);
+    assert(pool.stats.blocks_in_use == 0);
+    combo_pool_destroy(&pool);
+    printf("  ✓ Objectives land in each tracker's own allocator\n");
+}
+
+int main() {
+    printf("Running objective stream tests...\n\n");
+
+    test_decode_any_split();
+    printf("\n");
+
+    test_malformed();
+    printf("\n");
+
+    test_apply_to_trackers();
+    printf("\n");
+
+    printf("🎉 All objective stream tests passed!\n");
+    return 0;
+}
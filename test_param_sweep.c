@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "src/param_sweep.h"
+#include "src/session_replay.h"
+#include "src/combo_format.h"
+
+#define SWEEP_SESSIONS 12
+#define SWEEP_TRACKERS 3
+
+static void session_path(char* out, size_t size, int index) {
+    snprintf(out, size, "test_sweep_%d.bin", index);
+}
+
+static double g_host_time;
+static double host_clock(void) { return g_host_time; }
+
+// Sessions of very different lengths so the work has to be rebalanced.
+// Every base starts with a running combo, which is what makes the base
+// time matter.
+static void write_session(int index) {
+    ComboState trackers[SWEEP_TRACKERS];
+    combo_set_clock(host_clock);
+    g_host_time = 0.0;
+    for (int t = 0; t < SWEEP_TRACKERS; t++) {
+        combo_init(&trackers[t], "Sweep");
+        combo_resume(&trackers[t]);
+        for (int hit = 0; hit < 4 + t; hit++) combo_increment(&trackers[t], 1);
+    }
+    ByteWriter base;
+    writer_init(&base, 512);
+    combo_format_encode_at(&base, trackers, SWEEP_TRACKERS, 0, 0.0);
+    for (int t = 0; t < SWEEP_TRACKERS; t++) combo_release(&trackers[t]);
+    combo_set_clock(NULL);
+
+    char path[64];
+    session_path(path, sizeof(path), index);
+    SessionRecorder recorder;
+    assert(session_recorder_open(&recorder, path, SESSION_SOURCE_DESKTOP, base.data, (uint32_t)base.size, 0));
+    writer_free(&base);
+
+    srand(100 + index);
+    int frames = index % 4 == 0 ? 40000 : 1000 + index * 100;
+    uint64_t time_us = 0;
+    for (int frame = 0; frame < frames; frame++) {
+        time_us += 16667;
+        session_record_frame(&recorder, time_us, 0.016667f);
+        if (rand() % (4 + index) == 0) {
+            SessionEvent event = {time_us, 1 + rand() % 3, (uint16_t)(rand() % SWEEP_TRACKERS),
+                                  rand() % 6 == 0 ? SESSION_OP_DECREMENT : SESSION_OP_HIT, 0};
+            session_record(&recorder, &event);
+        }
+    }
+    assert(session_recorder_close(&recorder));
+}
+
+static int64_t replay_alone(const char* path, const ComboTuning* tuning) {
+    SessionLog log;
+    assert(session_load(&log, path));
+    ComboState trackers[MAX_TRACKERS];
+    int count = session_replay_load_base(&log, trackers, MAX_TRACKERS);
+    assert(count == SWEEP_TRACKERS);
+    combo_set_tuning(tuning);
+    session_replay(&log, trackers, count, NULL);
+    combo_set_tuning(NULL);
+
+    int64_t score = 0;
+    for (int t = 0; t < count; t++) {
+        score += trackers[t].score;
+        combo_release(&trackers[t]);
+    }
+    session_log_free(&log);
+    return score;
+}
+
+static void build_sweep(ParamSweep* sweep) {
+    param_sweep_init(sweep);
+    for (int i = 0; i < SWEEP_SESSIONS; i++) {
+        char path[64];
+        session_path(path, sizeof(path), i);
+        assert(param_sweep_add_session(sweep, path));
+    }
+    for (int t = 0; t < 6; t++) {
+        for (int m = 0; m < 4; m++) {
+            ComboTuning tuning = {1.0f + t, 0.5f + 0.25f * t, 0.05f + 0.05f * m, 2.0f + m};
+            assert(param_sweep_add_tuning(sweep, &tuning));
+        }
+    }
+}
+
+void test_matches_sequential_replay() {
+    printf("Test 1: Parallel sweep scores match replaying each pair alone\n");
+
+    ParamSweep sweep;
+    build_sweep(&sweep);
+    ComboTuning bad = {5.0f, 0.0f, 0.1f, 3.0f};
+    assert(!param_sweep_add_tuning(&sweep, &bad));
+    assert(!param_sweep_add_session(&sweep, "does_not_exist.bin"));
+
+    assert(param_sweep_run(&sweep, 8));
+    printf("  %u jobs on %u threads, %llu steals\n", sweep.session_count * sweep.tuning_count,
+           sweep.thread_count, (unsigned long long)sweep.steals);
+
+    for (uint32_t t = 0; t < sweep.tuning_count; t += 5) {
+        for (uint32_t s = 0; s < sweep.session_count; s++) {
+            char path[64];
+            session_path(path, sizeof(path), (int)s);
+            assert(param_sweep_score(&sweep, t, s) == replay_alone(path, &sweep.tunings[t]));
+        }
+    }
+
+    // Parameters change the outcome
+    bool differs = false;
+    for (uint32_t t = 1; t < sweep.tuning_count; t++) {
+        if (param_sweep_score(&sweep, t, 0) != param_sweep_score(&sweep, 0, 0)) differs = true;
+    }
+    assert(differs);
+
+    param_sweep_free(&sweep);
+    printf("  ✓ Every (session, tuning) score is the sequential one\n");
+}
+
+void test_thread_count_independent() {
+    printf("Test 2: Results do not depend on the number of workers\n");
+
+    ParamSweep one, many;
+    build_sweep(&one);
+    build_sweep(&many);
+    assert(param_sweep_run(&one, 1));
+    assert(param_sweep_run(&many, 16));
+    assert(one.steals == 0);
+    for (uint32_t t = 0; t < one.tuning_count; t++) {
+        for (uint32_t s = 0; s < one.session_count; s++) {
+            assert(param_sweep_score(&one, t, s) == param_sweep_score(&many, t, s));
+        }
+        SweepDistribution a, b;
+        param_sweep_distribution(&one, t, &a);
+        param_sweep_distribution(&many, t, &b);
+        assert(a.mean == b.mean && a.p50 == b.p50 && a.max == b.max);
+        assert(a.min <= a.p10 && a.p10 <= a.p50 && a.p50 <= a.p90 && a.p90 <= a.max);
+    }
+
+    // The default tuning is exactly what the app scores with
+    ParamSweep defaults;
+    param_sweep_init(&defaults);
+    char path[64];
+    session_path(path, sizeof(path), 3);
+    assert(param_sweep_add_session(&defaults, path));
+    ComboTuning tuning = COMBO_TUNING_DEFAULTS;
+    assert(param_sweep_add_tuning(&defaults, &tuning));
+    assert(param_sweep_run(&defaults, 0));
+    assert(param_sweep_score(&defaults, 0, 0) == replay_alone(path, NULL));
+
+    param_sweep_free(&defaults);
+    param_sweep_free(&one);
+    param_sweep_free(&many);
+    printf("  ✓ 1 and 16 workers agree, defaults match the app\n");
+}
+
+void test_independent_of_host_clock() {
+    printf("Test 3: Sweeps of the same sessions agree whatever the host clock reads\n");
+
+    // Build each sweep while the calling thread's clock reads a different
+    // uptime; bases are decoded at their own recorded time regardless
+    const double uptimes[2] = {0.5, 86400.0};
+    ParamSweep sweeps[2];
+    for (int run = 0; run < 2; run++) {
+        combo_set_clock(host_clock);
+        g_host_time = uptimes[run];
+        build_sweep(&sweeps[run]);
+        combo_set_clock(NULL);
+        assert(param_sweep_run(&sweeps[run], 4));
+    }
+    for (uint32_t t = 0; t < sweeps[0].tuning_count; t++) {
+        for (uint32_t s = 0; s < sweeps[0].session_count; s++) {
+            assert(param_sweep_score(&sweeps[0], t, s) == param_sweep_score(&sweeps[1], t, s));
+        }
+    }
+    param_sweep_free(&sweeps[0]);
+    param_sweep_free(&sweeps[1]);
+    printf("  ✓ Same scores at %.1f s and %.0f s of uptime\n", uptimes[0], uptimes[1]);
+}
+
+int main() {
+    printf("Running parameter sweep tests...\n\n");
+    for (int i = 0; i < SWEEP_SESSIONS; i++) write_session(i);
+
+    test_matches_sequential_replay();
+    printf("\n");
+
+    test_thread_count_independent();
+    printf("\n");
+
+    test_independent_of_host_clock();
+    printf("\n");
+
+    for (int i = 0; i < SWEEP_SESSIONS; i++) {
+        char path[64];
+        session_path(path, sizeof(path), i);
+        remove(path);
+    }
+    printf("🎉 All parameter sweep tests passed!\n");
+    return 0;
+}
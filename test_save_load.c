@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <assert.h>
 #include "src/core.h"
+#include "src/combo_format.h"
 
 void test_single_tracker_save_load() {
     printf("Testing single tracker save/load...\n");
@@ -232,6 +233,61 @@ void test_persistence_simulation() {
     printf("✓ App restart simulation test passed!\n");
 }
 
+void test_versioned_format() {
+    printf("Testing versioned tracker format...\n");
+    
+    ComboState trackers[2];
+    combo_init(&trackers[0], "Objectives");
+    combo_init(&trackers[1], "Intervals");
+    
+    Objective objectives[2];
+    objective_init(&objectives[0], "Warm up", "10 easy reps", 10);
+    objective_init(&objectives[1], "Main set", "50 reps", 50);
+    combo_set_objectives(&trackers[0], objectives, 2);
+    combo_resume(&trackers[0]);
+    combo_increment(&trackers[0], 12);
+    combo_decrement(&trackers[0], 3);
+    interval_tracker_add(&trackers[1].interval_tracker, "Plank", 45, 3);
+    
+    combo_save_all_trackers(trackers, 2, "test_format.dat");
+    
+    size_t size = 0;
+    uint8_t* data = combo_format_read_file("test_format.dat", &size);
+    assert(data && combo_format_is_current(data, size));
+    printf("  File size: %zu bytes\n", size);
+    
+    ComboState loaded[8];
+    memset(loaded, 0, sizeof(loaded));
+    assert(combo_load_all_trackers(loaded, 8, "test_format.dat") == 2);
+    assert(loaded[0].score == trackers[0].score);
+    assert(loaded[0].miss_hits == 1);
+    assert(loaded[0].multiplier == trackers[0].multiplier);
+    assert(loaded[0].objective_count == 2);
+    assert(strcmp(loaded[0].objectives[1].description, "50 reps") == 0);
+    assert(loaded[0].objectives[0].current_score == 12);
+    assert(loaded[0].objectives[0].completed);
+    assert(loaded[1].interval_tracker.has_interval);
+    assert(loaded[1].interval_tracker.current_interval.duration == 45);
+    assert(strcmp(loaded[1].interval_tracker.current_interval.label, "Plank") == 0);
+    printf("✓ Objectives and interval state round-trip\n");
+    
+    // A flipped byte must be caught by the CRC
+    data[size / 2] ^= 0x40;
+    FILE* f = fopen("test_format.dat", "wb");
+    fwrite(data, 1, size, f);
+    fclose(f);
+    free(data);
+    
+    ComboState corrupt[8];
+    memset(corrupt, 0, sizeof(corrupt));
+    assert(combo_load_all_trackers(corrupt, 8, "test_format.dat") == 0);
+    printf("✓ Corrupted file rejected\n");
+    
+    free(loaded[0].objectives);
+    free(trackers[0].objectives);
+    remove("test_format.dat");
+}
+
 int main() {
     printf("Running ComboCounter save/load tests...\n\n");
     
@@ -244,6 +300,9 @@ int main() {
     test_empty_file_load();
     printf("\n");
     
+    test_versioned_format();
+    printf("\n");
+    
     test_persistence_simulation();
     printf("\n");
     
@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "src/score_history.h"
+
+#define TEST_HISTORY_FILE "test_score_history.dat.history"
+#define T0 1700000000       // Any wall-clock time; not aligned to a minute
+
+void test_rollups() {
+    printf("Test 1: One record lands in every resolution\n");
+
+    static ScoreHistory history;
+    score_history_init(&history, "Rollups");
+
+    int64_t t = T0;
+    score_history_record(&history, t, 10, 3, 1);
+    score_history_record(&history, t, 5, 7, 1);         // Same second
+    score_history_record(&history, t + 1, -4, 0, 0);    // Miss
+    score_history_record(&history, t + 75, 20, 2, 2);   // Next minute
+
+    HistoryPoint points[4];
+    assert(score_history_query(&history, HISTORY_SECONDS, t, t + 2, points, 4) == 2);
+    assert(points[0].start == t && points[0].score == 15 && points[0].max_combo == 7 && points[0].hits == 2);
+    assert(points[1].score == -4 && points[1].hits == 0);
+
+    int64_t minute = t - t % 60;
+    assert(score_history_query(&history, HISTORY_MINUTES, minute, minute + 180, points, 4) == 3);
+    assert(points[0].start == minute && points[0].score == 11 && points[0].max_combo == 7);
+    assert(points[1].score == 20 && points[1].hits == 2);
+    assert(points[2].score == 0 && points[2].hits == 0);
+
+    HistoryPoint total;
+    score_history_total(&history, t, t + 3600, t + 100, &total);
+    assert(total.score == 31 && total.max_combo == 7 && total.hits == 4);
+    printf("  ✓ Seconds, minutes and hours agree\n");
+}
+
+void test_laps_and_resolution() {
+    printf("Test 2: Old laps read as empty, long ranges use coarse buckets\n");
+
+    static ScoreHistory history;
+    score_history_init(&history, "Laps");
+
+    // One hit a minute for two days
+    int64_t t = T0;
+    for (int i = 0; i < 2 * 24 * 60; i++) {
+        score_history_record(&history, t + i * 60, 1, i % 50, 1);
+    }
+    int64_t now = t + 2 * 24 * 60 * 60;
+
+    // The second ring lapped long ago; only the last 10 minutes remain
+    HistoryPoint points[SCORE_HISTORY_SECOND_SLOTS];
+    uint32_t n = score_history_query(&history, HISTORY_SECONDS, t, t + 600, points, SCORE_HISTORY_SECOND_SLOTS);
+    for (uint32_t i = 0; i < n; i++) assert(points[i].hits == 0);
+
+    assert(score_history_resolution_for(now - 300, now) == HISTORY_SECONDS);
+    assert(score_history_resolution_for(now - 3 * 3600, now) == HISTORY_MINUTES);
+    assert(score_history_resolution_for(now - 2 * 86400, now) == HISTORY_HOURS);
+
+    // Last hour from minutes, whole run from hours
+    HistoryPoint total;
+    score_history_total(&history, now - 3600, now, now, &total);
+    assert(total.hits == 60);
+    score_history_total(&history, t, now, now, &total);
+    assert(total.hits == 2 * 24 * 60 && total.score == 2 * 24 * 60 && total.max_combo == 49);
+
+    // A range longer than a ring is cut to its newest lap
+    n = score_history_query(&history, HISTORY_MINUTES, t, now, NULL, 0);
+    assert(n == 0);
+    static HistoryPoint minutes[SCORE_HISTORY_MINUTE_SLOTS];
+    n = score_history_query(&history, HISTORY_MINUTES, t, now, minutes, SCORE_HISTORY_MINUTE_SLOTS);
+    assert(n == SCORE_HISTORY_MINUTE_SLOTS);
+    assert(minutes[n - 1].start == (now - 1) - (now - 1) % 60);
+    // Every minute had its hit except the current one, not reached yet
+    for (uint32_t i = 0; i + 1 < n; i++) assert(minutes[i].hits == 1);
+    assert(minutes[n - 1].hits == 0);
+    printf("  ✓ %u minute buckets, 2880 hits from the hour ring\n", n);
+}
+
+void test_observe() {
+    printf("Test 3: Observing a tracker records only changes\n");
+
+    static ScoreHistory history;
+    score_history_init(&history, "Observed");
+    ComboState state;
+    memset(&state, 0, sizeof(state));
+    state.score = 100;
+    state.total_hits = 9;
+
+    // Baseline first: what was there before isn't new
+    score_history_observe(&history, T0, &state);
+    score_history_observe(&history, T0 + 1, &state);
+    HistoryPoint total;
+    score_history_total(&history, T0, T0 + 10, T0 + 10, &total);
+    assert(total.score == 0 && total.hits == 0);
+
+    state.score = 130;
+    state.total_hits = 12;
+    state.combo = 3;
+    score_history_observe(&history, T0 + 2, &state);
+    state.score = 120;      // Miss
+    state.combo = 0;
+    score_history_observe(&history, T0 + 3, &state);
+    score_history_total(&history, T0, T0 + 10, T0 + 10, &total);
+    assert(total.score == 20 && total.hits == 3 && total.max_combo == 3);
+    printf("  ✓ +30 over 3 hits, then -10\n");
+}
+
+void test_store_round_trip() {
+    printf("Test 4: Store saves and reloads by label\n");
+
+    ComboState trackers[3];
+    memset(trackers, 0, sizeof(trackers));
+    strcpy(trackers[0].label, "Pushups");
+    strcpy(trackers[1].label, "Reading");
+    strcpy(trackers[2].label, "Water");
+
+    ScoreHistoryStore store;
+    score_history_store_init(&store);
+    score_history_store_observe(&store, T0, trackers, 2);
+    for (int i = 0; i < 50; i++) {
+        trackers[0].score += 2;
+        trackers[0].total_hits++;
+        trackers[0].combo = i;
+        trackers[1].score += 1;
+        trackers[1].total_hits++;
+        score_history_store_observe(&store, T0 + i * 90, trackers, 2);
+    }
+    assert(score_history_store_save(&store, TEST_HISTORY_FILE));
+
+    // Reloaded with the trackers in a different order plus a new one
+    ComboState reordered[3] = {trackers[2], trackers[1], trackers[0]};
+    ScoreHistoryStore loaded;
+    score_history_store_init(&loaded);
+    assert(score_history_store_load(&loaded, TEST_HISTORY_FILE, reordered, 3) == 2);
+    assert(loaded.trackers[0] == NULL);
+    const ScoreHistory* saved = store.trackers[0];
+    const ScoreHistory* restored = loaded.trackers[2];
+    assert(memcmp(saved->seconds, restored->seconds, sizeof(saved->seconds)) == 0);
+    assert(memcmp(saved->minutes, restored->minutes, sizeof(saved->minutes)) == 0);
+    assert(memcmp(saved->hours, restored->hours, sizeof(saved->hours)) == 0);
+    HistoryPoint total;
+    score_history_total(loaded.trackers[1], T0, T0 + 86400, T0 + 86400, &total);
+    assert(total.hits == 50 && total.score == 50);
+
+    // Baseline is retaken after loading, not carried over
+    score_history_store_observe(&loaded, T0 + 5000, reordered, 3);
+    score_history_total(loaded.trackers[2], T0, T0 + 86400, T0 + 86400, &total);
+    assert(total.hits == 50 && total.score == 100);
+
+    // A damaged file is ignored
+    FILE* f = fopen(TEST_HISTORY_FILE, "r+b");
+    fseek(f, 20, SEEK_SET);
+    fputc(0x5A, f);
+    fclose(f);
+    ScoreHistoryStore damaged;
+    score_history_store_init(&damaged);
+    assert(score_history_store_load(&damaged, TEST_HISTORY_FILE, trackers, 3) == -1);
+    assert(score_history_store_load(&damaged, "missing.history", trackers, 3) == -1);
+
+    score_history_store_free(&damaged);
+    score_history_store_free(&loaded);
+    score_history_store_free(&store);
+    remove(TEST_HISTORY_FILE);
+    printf("  ✓ Histories follow their labels\n");
+}
+
+int main() {
+    printf("Running score history tests...\n\n");
+
+    test_rollups();
+    printf("\n");
+
+    test_laps_and_resolution();
+    printf("\n");
+
+    test_observe();
+    printf("\n");
+
+    test_store_round_trip();
+    printf("\n");
+
+    printf("🎉 All score history tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,247 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include "src/session.h"
+#include "src/session_replay.h"
+#include "src/combo_format.h"
+
+#define TEST_FILE "test_session.bin"
+#define LIVE_TRACKERS 3
+
+static double live_time;
+
+static double live_clock(void) {
+    return live_time;
+}
+
+void test_round_trip() {
+    printf("Test 1: Events round-trip through the session file\n");
+
+    srand(5);
+    static SessionEvent events[5000];
+    const char base[] = "starting state";
+    SessionRecorder recorder;
+    assert(session_recorder_open(&recorder, TEST_FILE, SESSION_SOURCE_EMBEDDED, base, sizeof(base), 42));
+
+    uint64_t time_us = 90000000000ULL;  // Monotonic clocks rarely start at zero
+    for (int i = 0; i < 5000; i++) {
+        time_us += (uint64_t)(rand() % 200000);
+        events[i].time_us = time_us;
+        events[i].tracker = (uint16_t)(rand() % 8);
+        events[i].op = (uint8_t)(1 + rand() % 6);
+        events[i].quality = (uint8_t)(rand() % 4);
+        events[i].amount = (i % 7 == 0) ? 0xFFFFFFFFu : (uint32_t)(rand() % 10);
+        session_record(&recorder, &events[i]);
+    }
+    assert(session_recorder_close(&recorder));
+
+    SessionLog log;
+    assert(session_load(&log, TEST_FILE));
+    assert(log.source == SESSION_SOURCE_EMBEDDED);
+    assert(log.base_size == sizeof(base) && memcmp(log.base, base, sizeof(base)) == 0);
+    assert(log.base_time_us == 42);
+    assert(log.count == 5000);
+    for (int i = 0; i < 5000; i++) {
+        assert(log.events[i].time_us == events[i].time_us);
+        assert(log.events[i].tracker == events[i].tracker);
+        assert(log.events[i].op == events[i].op);
+        assert(log.events[i].quality == events[i].quality);
+        assert(log.events[i].amount == events[i].amount);
+    }
+    session_log_free(&log);
+
+    // A crash mid-write leaves a torn last record, which is dropped
+    FILE* file = fopen(TEST_FILE, "rb");
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    assert(truncate(TEST_FILE, size - 1) == 0);
+    assert(session_load(&log, TEST_FILE));
+    assert(log.count == 4999);
+    session_log_free(&log);
+
+    printf("  %ld bytes for 5000 events\n", size);
+    assert(size < 5000 * 12);
+    printf("  ✓ Timestamps, ops and base survive, torn tail ignored\n");
+}
+
+void test_replay_matches_live() {
+    printf("Test 2: Replay reproduces the live session\n");
+
+    srand(11);
+    ComboState live[LIVE_TRACKERS];
+    combo_set_clock(live_clock);
+    live_time = 1000.0;
+    combo_init(&live[0], "Reps");
+    combo_init(&live[1], "Sets");
+    combo_init(&live[2], "Form");
+    combo_resume(&live[0]);
+    combo_resume(&live[1]);
+
+    ByteWriter base;
+    writer_init(&base, 1024);
+    combo_format_encode(&base, live, LIVE_TRACKERS, 0);
+    assert(!base.failed);
+    SessionRecorder recorder;
+    assert(session_recorder_open(&recorder, TEST_FILE, SESSION_SOURCE_DESKTOP, base.data, (uint32_t)base.size,
+                                 1000000000ULL));
+    writer_free(&base);
+
+    // Roughly what main.c and save_tracker_event record: a frame per
+    // loop, inputs in between
+    uint64_t time_us = 1000000000ULL;
+    for (int frame = 0; frame < 6000; frame++) {
+        float dt = 1.0f / 60.0f + (float)(rand() % 100) / 100000.0f;
+        time_us += (uint64_t)(dt * 1e6f);
+        live_time = (double)time_us / 1e6;
+        session_record_frame(&recorder, time_us, dt);
+        for (int t = 0; t < LIVE_TRACKERS; t++) {
+            combo_update(&live[t], dt);
+        }
+
+        if (rand() % 8 == 0) {
+            uint16_t tracker = (uint16_t)(rand() % LIVE_TRACKERS);
+            int roll = rand() % 20;
+            SessionEvent event = {time_us, 1, tracker, SESSION_OP_HIT, 0};
+            if (roll == 0) {
+                event.op = live[tracker].paused ? SESSION_OP_RESUME : SESSION_OP_PAUSE;
+                event.amount = 0;
+                if (event.op == SESSION_OP_PAUSE) combo_pause(&live[tracker]);
+                else combo_resume(&live[tracker]);
+            } else if (roll < 4) {
+                event.op = SESSION_OP_DECREMENT;
+                combo_decrement(&live[tracker], 1);
+            } else {
+                combo_increment(&live[tracker], 1);
+            }
+            session_record(&recorder, &event);
+        }
+    }
+    assert(session_recorder_close(&recorder));
+    combo_set_clock(NULL);
+    uint64_t live_digest = session_state_digest(live, LIVE_TRACKERS);
+
+    SessionLog log;
+    assert(session_load(&log, TEST_FILE));
+    uint64_t digests[2];
+    for (int run = 0; run < 2; run++) {
+        ComboState replayed[LIVE_TRACKERS];
+        assert(session_replay_load_base(&log, replayed, LIVE_TRACKERS) == LIVE_TRACKERS);
+        SessionReplayStats stats;
+        session_replay(&log, replayed, LIVE_TRACKERS, &stats);
+        assert(stats.frames == 6000 && stats.skipped == 0);
+        assert(stats.hits > 0 && stats.decrements > 0);
+        for (int t = 0; t < LIVE_TRACKERS; t++) {
+            assert(replayed[t].score == live[t].score);
+            assert(replayed[t].combo == live[t].combo);
+            assert(replayed[t].max_combo == live[t].max_combo);
+            assert(replayed[t].paused == live[t].paused);
+            combo_release(&replayed[t]);
+        }
+        digests[run] = session_state_digest(replayed, LIVE_TRACKERS);
+    }
+    assert(digests[0] == live_digest && digests[1] == live_digest);
+
+    for (int t = 0; t < LIVE_TRACKERS; t++) combo_release(&live[t]);
+    session_log_free(&log);
+    printf("  ✓ Same trackers, same digest, every run\n");
+}
+
+void test_replay_from_running_combo() {
+    printf("Test 3: Replay from a base with a running combo\n");
+
+    // Ten hits before recording starts, then the session opens the way
+    // main.c does: settle and encode at the base time
+    ComboState live[1];
+    combo_set_clock(live_clock);
+    live_time = 500.0;
+    combo_init(&live[0], "Warm");
+    combo_resume(&live[0]);
+    for (int i = 0; i < 10; i++) {
+        live_time += 0.25;
+        combo_increment(&live[0], 1);
+    }
+    live_time += 0.5;
+    uint64_t base_time_us = (uint64_t)(live_time * 1e6);
+    combo_settle(&live[0], live_time);
+    ByteWriter base;
+    writer_init(&base, 256);
+    combo_format_encode_at(&base, live, 1, 0, live_time);
+    SessionRecorder recorder;
+    assert(session_recorder_open(&recorder, TEST_FILE, SESSION_SOURCE_DESKTOP, base.data, (uint32_t)base.size,
+                                 base_time_us));
+    writer_free(&base);
+
+    // An 8 s gap lets the combo decay, then one more hit
+    live_time += 8.0;
+    uint64_t time_us = (uint64_t)(live_time * 1e6);
+    session_record_frame(&recorder, time_us, 8.0f);
+    combo_update(&live[0], 8.0f);
+    SessionEvent hit = {time_us, 1, 0, SESSION_OP_HIT, 0};
+    session_record(&recorder, &hit);
+    combo_increment(&live[0], 1);
+    assert(session_recorder_close(&recorder));
+    combo_set_clock(NULL);
+    printf("  Live: combo %d, score %d\n", live[0].combo, live[0].score);
+    assert(live[0].combo < 10);
+
+    // The replaying host's clock plays no part
+    SessionLog log;
+    assert(session_load(&log, TEST_FILE));
+    assert(log.base_time_us == base_time_us);
+    ComboState replayed[1];
+    assert(session_replay_load_base(&log, replayed, 1) == 1);
+    assert(replayed[0].combo == 10);
+    session_replay(&log, replayed, 1, NULL);
+    assert(replayed[0].combo == live[0].combo && replayed[0].score == live[0].score);
+    assert(session_state_digest(replayed, 1) == session_state_digest(live, 1));
+
+    combo_release(&replayed[0]);
+    combo_release(&live[0]);
+    session_log_free(&log);
+    printf("  ✓ Replay decays the base combo exactly as the live run did\n");
+}
+
+void test_rejects_foreign_files() {
+    printf("Test 4: Non-session files are rejected\n");
+
+    FILE* file = fopen(TEST_FILE, "wb");
+    fputs("CMBO not a session file", file);
+    fclose(file);
+    SessionLog log;
+    assert(!session_load(&log, TEST_FILE));
+    assert(!session_load(&log, "does_not_exist.bin"));
+
+    // Embedded sessions have no desktop base
+    SessionRecorder recorder;
+    assert(session_recorder_open(&recorder, TEST_FILE, SESSION_SOURCE_EMBEDDED, NULL, 0, 0));
+    assert(session_recorder_close(&recorder));
+    assert(session_load(&log, TEST_FILE) && log.count == 0);
+    ComboState trackers[1];
+    assert(session_replay_load_base(&log, trackers, 1) == -1);
+    session_log_free(&log);
+    printf("  ✓ Bad magic and missing bases are reported\n");
+}
+
+int main() {
+    printf("Running session tests...\n\n");
+
+    test_round_trip();
+    printf("\n");
+
+    test_replay_matches_live();
+    printf("\n");
+
+    test_replay_from_running_combo();
+    printf("\n");
+
+    test_rejects_foreign_files();
+    printf("\n");
+
+    remove(TEST_FILE);
+    printf("🎉 All session tests passed!\n");
+    return 0;
+}
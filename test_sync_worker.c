@@ -0,0 +1,480 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "src/sync_worker.h"
+
+// Stand-in for the sync server: HTTP/1.1 with keep-alive on loopback,
+// counting connections and requests.
+
+#define SERVER_MAX_CLIENTS 8
+#define SERVER_BUFFER 65536
+
+typedef struct {
+    int fd;
+    char buffer[SERVER_BUFFER];
+    size_t size;
+} ServerClient;
+
+typedef struct {
+    int listen_fd;
+    uint16_t port;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    int stop;
+    int delay_ms;               // Held before each response
+    const char* fetch_response;
+    const char* etag;           // Sent with fetches; NULL for none
+    bool fail_posts;            // Answer pushes with 500
+
+    int connections;
+    int posts;
+    int gets;
+    char last_body[SERVER_BUFFER];
+    ServerClient clients[SERVER_MAX_CLIENTS];
+} StandInServer;
+
+static void sleep_ms(int ms) {
+    struct timespec ts = {ms / 1000, (long)(ms % 1000) * 1000000L};
+    nanosleep(&ts, NULL);
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec / 1e6;
+}
+
+static void send_all(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent <= 0) return;
+        data += sent;
+        size -= (size_t)sent;
+    }
+}
+
+// Answer every complete request in the client's buffer
+static void serve_requests(StandInServer* server, ServerClient* client) {
+    for (;;) {
+        client->buffer[client->size] = '\0';
+        char* header_end = strstr(client->buffer, "\r\n\r\n");
+        if (!header_end) return;
+
+        size_t header_size = (size_t)(header_end - client->buffer) + 4;
+        size_t content_length = 0;
+        char* length = strstr(client->buffer, "Content-Length:");
+        if (length && length < header_end) {
+            content_length = (size_t)strtoul(length + 15, NULL, 10);
+        }
+        if (client->size < header_size + content_length) return;
+
+        bool is_post = strncmp(client->buffer, "POST", 4) == 0;
+
+        pthread_mutex_lock(&server->lock);
+        const char* status = "200 OK";
+        const char* reply = is_post ? "{\"ok\":true}" : server->fetch_response;
+        char etag_header[160] = "";
+        if (is_post) {
+            server->posts++;
+            memcpy(server->last_body, client->buffer + header_size, content_length);
+            server->last_body[content_length] = '\0';
+            if (server->fail_posts) {
+                status = "500 Internal Server Error";
+                reply = "";
+            }
+        } else {
+            server->gets++;
+            if (server->etag) {
+                char* condition = strstr(client->buffer, "If-None-Match: ");
+                if (condition && condition < header_end &&
+                    strncmp(condition + 15, server->etag, strlen(server->etag)) == 0) {
+                    status = "304 Not Modified";
+                    reply = "";
+                }
+                snprintf(etag_header, sizeof(etag_header), "ETag: %s\r\n", server->etag);
+            }
+        }
+        int delay = server->delay_ms;
+        pthread_mutex_unlock(&server->lock);
+        if (delay > 0) sleep_ms(delay);
+
+        char head[512];
+        int head_size = snprintf(head, sizeof(head),
+                                 "HTTP/1.1 %s\r\nContent-Type: application/json\r\n%s"
+                                 "Content-Length: %zu\r\n\r\n", status, etag_header, strlen(reply));
+        send_all(client->fd, head, (size_t)head_size);
+        send_all(client->fd, reply, strlen(reply));
+
+        size_t consumed = header_size + content_length;
+        memmove(client->buffer, client->buffer + consumed, client->size - consumed);
+        client->size -= consumed;
+    }
+}
+
+static void* server_main(void* arg) {
+    StandInServer* server = arg;
+    while (!__atomic_load_n(&server->stop, __ATOMIC_ACQUIRE)) {
+        struct pollfd fds[SERVER_MAX_CLIENTS + 1];
+        fds[0] = (struct pollfd){server->listen_fd, POLLIN, 0};
+        for (int i = 0; i < SERVER_MAX_CLIENTS; i++) {
+            fds[i + 1] = (struct pollfd){server->clients[i].fd, POLLIN, 0};
+        }
+        if (poll(fds, SERVER_MAX_CLIENTS + 1, 20) <= 0) continue;
+
+        if (fds[0].revents & POLLIN) {
+            int fd = accept(server->listen_fd, NULL, NULL);
+            for (int i = 0; fd >= 0 && i < SERVER_MAX_CLIENTS; i++) {
+                if (server->clients[i].fd < 0) {
+                    server->clients[i].fd = fd;
+                    server->clients[i].size = 0;
+                    pthread_mutex_lock(&server->lock);
+                    server->connections++;
+                    pthread_mutex_unlock(&server->lock);
+                    fd = -1;
+                }
+            }
+            if (fd >= 0) close(fd);
+        }
+        for (int i = 0; i < SERVER_MAX_CLIENTS; i++) {
+            ServerClient* client = &server->clients[i];
+            if (client->fd < 0 || !(fds[i + 1].revents & (POLLIN | POLLHUP))) continue;
+            ssize_t got = recv(client->fd, client->buffer + client->size,
+                               SERVER_BUFFER - 1 - client->size, 0);
+            if (got <= 0) {
+                close(client->fd);
+                client->fd = -1;
+                continue;
+            }
+            client->size += (size_t)got;
+            serve_requests(server, client);
+        }
+    }
+    return NULL;
+}
+
+static void server_start(StandInServer* server, const char* fetch_response) {
+    memset(server, 0, sizeof(*server));
+    for (int i = 0; i < SERVER_MAX_CLIENTS; i++) server->clients[i].fd = -1;
+    server->fetch_response = fetch_response;
+    pthread_mutex_init(&server->lock, NULL);
+
+    server->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    assert(server->listen_fd >= 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    assert(bind(server->listen_fd, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    assert(listen(server->listen_fd, 8) == 0);
+    socklen_t len = sizeof(addr);
+    getsockname(server->listen_fd, (struct sockaddr*)&addr, &len);
+    server->port = ntohs(addr.sin_port);
+
+    assert(pthread_create(&server->thread, NULL, server_main, server) == 0);
+}
+
+static void server_stop(StandInServer* server) {
+    __atomic_store_n(&server->stop, 1, __ATOMIC_RELEASE);
+    pthread_join(server->thread, NULL);
+    for (int i = 0; i < SERVER_MAX_CLIENTS; i++) {
+        if (server->clients[i].fd >= 0) close(server->clients[i].fd);
+    }
+    close(server->listen_fd);
+    pthread_mutex_destroy(&server->lock);
+}
+
+static SyncResult wait_result(SyncWorker* worker) {
+    SyncResult result;
+    double deadline = now_ms() + 5000.0;
+    while (!sync_worker_poll(worker, &result)) {
+        assert(now_ms() < deadline);
+        sleep_ms(1);
+    }
+    return result;
+}
+
+static void make_trackers(ComboState* trackers, int count) {
+    Objective goals[2];
+    objective_init(&goals[0], "Sets", "Finish sets", 10);
+    objective_init(&goals[1], "Quote \"q\"", "Escaping", 5);
+    for (int i = 0; i < count; i++) {
+        char label[MAX_LABEL_LENGTH];
+        snprintf(label, sizeof(label), "Tracker %d", i);
+        combo_init(&trackers[i], label);
+        combo_set_objectives(&trackers[i], goals, 2);
+    }
+}
+
+void test_batched_push_and_fetch() {
+    printf("Test 1: One request for all trackers over one connection\n");
+
+    StandInServer server;
+    server_start(&server, "{\"Tracker 0\":[{\"name\":\"Remote\",\"target_score\":40}]}");
+    char url[64];
+    snprintf(url, sizeof(url), "http://127.0.0.1:%u/sync", server.port);
+
+    SyncWorker worker;
+    assert(sync_worker_start(&worker, url));
+
+    ComboState trackers[4];
+    make_trackers(trackers, 4);
+
+    for (int round = 0; round < 5; round++) {
+        trackers[2].objectives[1].current_score = 7 + round;
+        uint32_t seq = sync_worker_push(&worker, trackers, 4);
+        assert(seq != 0);
+        SyncResult result = wait_result(&worker);
+        assert(result.kind == SYNC_JOB_PUSH && result.sequence == seq);
+        assert(result.curl_code == 0 && result.http_status == 200);
+        assert(strcmp(result.body, "{\"ok\":true}") == 0);
+        sync_result_free(&result);
+
+        seq = sync_worker_fetch(&worker);
+        result = wait_result(&worker);
+        assert(result.kind == SYNC_JOB_FETCH && result.sequence == seq);
+        const ObjectiveList* list = objective_catalog_find(result.catalog, "Tracker 0");
+        assert(list && list->count == 1);
+        assert(strcmp(result.catalog->objectives[list->first].name, "Remote") == 0);
+        sync_result_free(&result);
+    }
+
+    pthread_mutex_lock(&server.lock);
+    assert(server.posts == 5 && server.gets == 5);
+    assert(server.connections == 1);
+    assert(strstr(server.last_body, "\"label\":\"Tracker 2\"") != NULL);
+    assert(strstr(server.last_body, "\"current_score\":11") != NULL);
+    assert(strstr(server.last_body, "Quote \\\"q\\\"") != NULL);
+    pthread_mutex_unlock(&server.lock);
+
+    SyncWorkerStats stats = sync_worker_stats(&worker);
+    printf("  %u requests, %u new connection(s), %llu bytes sent\n",
+           stats.requests, stats.new_connections, (unsigned long long)stats.bytes_sent);
+    assert(stats.requests == 10 && stats.new_connections == 1);
+
+    sync_worker_stop(&worker);
+    server_stop(&server);
+    for (int i = 0; i < 4; i++) combo_release(&trackers[i]);
+    printf("  ✓ Connection reused for every sync\n");
+}
+
+void test_submit_does_not_block() {
+    printf("Test 2: Slow server never blocks the caller\n");
+
+    StandInServer server;
+    server_start(&server, "{}");
+    pthread_mutex_lock(&server.lock);
+    server.delay_ms = 200;
+    pthread_mutex_unlock(&server.lock);
+    char url[64];
+    snprintf(url, sizeof(url), "http://127.0.0.1:%u/sync", server.port);
+
+    SyncWorker worker;
+    assert(sync_worker_start(&worker, url));
+    ComboState trackers[2];
+    make_trackers(trackers, 2);
+
+    // A push per "frame" while the server takes 200ms per request
+    double start = now_ms();
+    uint32_t last = 0;
+    for (int frame = 0; frame < 20; frame++) {
+        trackers[0].objectives[0].current_score = frame;
+        last = sync_worker_push(&worker, trackers, 2);
+    }
+    double submit_ms = now_ms() - start;
+    printf("  20 submits took %.2f ms\n", submit_ms);
+    assert(submit_ms < 100.0);
+
+    // Pending pushes collapse into the latest state
+    SyncResult result;
+    do {
+        result = wait_result(&worker);
+        sync_result_free(&result);
+    } while (result.sequence != last);
+
+    SyncWorkerStats stats = sync_worker_stats(&worker);
+    assert(stats.requests < 20 && stats.coalesced > 0);
+    pthread_mutex_lock(&server.lock);
+    assert(strstr(server.last_body, "\"current_score\":19") != NULL);
+    pthread_mutex_unlock(&server.lock);
+
+    // Stopping mid-request returns promptly
+    trackers[1].objectives[0].current_score = 20;
+    sync_worker_push(&worker, trackers, 2);
+    sleep_ms(20);
+    start = now_ms();
+    sync_worker_stop(&worker);
+    assert(now_ms() - start < 150.0);
+
+    server_stop(&server);
+    for (int i = 0; i < 2; i++) combo_release(&trackers[i]);
+    printf("  ✓ %u requests sent, %u pushes coalesced\n", stats.requests, stats.coalesced);
+}
+
+// Copy of the last push body, taken under the server lock
+static const char* last_body(StandInServer* server) {
+    static char body[SERVER_BUFFER];
+    pthread_mutex_lock(&server->lock);
+    memcpy(body, server->last_body, sizeof(body));
+    pthread_mutex_unlock(&server->lock);
+    return body;
+}
+
+static int count_matches(const char* text, const char* needle) {
+    int count = 0;
+    for (const char* at = strstr(text, needle); at; at = strstr(at + 1, needle)) count++;
+    return count;
+}
+
+static void push_and_wait(SyncWorker* worker, ComboState* trackers, int count, long status) {
+    uint32_t seq = sync_worker_push(worker, trackers, count);
+    assert(seq != 0);
+    SyncResult result = wait_result(worker);
+    assert(result.sequence == seq && result.http_status == status);
+    sync_result_free(&result);
+}
+
+void test_delta_push() {
+    printf("Test 3: Pushes carry only unacknowledged changes\n");
+
+    StandInServer server;
+    server_start(&server, "{}");
+    char url[64];
+    snprintf(url, sizeof(url), "http://127.0.0.1:%u/sync", server.port);
+    SyncWorker worker;
+    assert(sync_worker_start(&worker, url));
+
+    enum { TRACKERS = 8, OBJECTIVES = 64 };
+    ComboState trackers[TRACKERS];
+    Objective goals[OBJECTIVES];
+    for (int i = 0; i < OBJECTIVES; i++) {
+        char name[MAX_LABEL_LENGTH];
+        snprintf(name, sizeof(name), "Goal %d", i);
+        objective_init(&goals[i], name, "", 100);
+    }
+    for (int t = 0; t < TRACKERS; t++) {
+        char label[MAX_LABEL_LENGTH];
+        snprintf(label, sizeof(label), "Tracker %d", t);
+        combo_init(&trackers[t], label);
+        combo_set_objectives(&trackers[t], goals, OBJECTIVES);
+    }
+
+    // First push has no baseline and sends everything
+    push_and_wait(&worker, trackers, TRACKERS, 200);
+    size_t full_size = strlen(last_body(&server));
+    assert(count_matches(last_body(&server), "current_score") == TRACKERS * OBJECTIVES);
+
+    // Nothing changed: nothing to send
+    assert(sync_worker_push(&worker, trackers, TRACKERS) == 0);
+
+    trackers[5].objectives[40].current_score = 12;
+    trackers[5].objectives[40].completed = true;
+    trackers[1].objectives[3].current_score = 4;
+    push_and_wait(&worker, trackers, TRACKERS, 200);
+    assert(count_matches(last_body(&server), "current_score") == 2);
+    assert(count_matches(last_body(&server), "\"label\"") == 2);
+    assert(strstr(last_body(&server), "{\"name\":\"Goal 40\",\"current_score\":12,\"completed\":true}"));
+    size_t delta_size = strlen(last_body(&server));
+    printf("  Full push %zu bytes, 2-change delta %zu bytes\n", full_size, delta_size);
+    assert(delta_size * 50 < full_size);
+
+    // A rejected push is not acknowledged, so its changes go out again
+    pthread_mutex_lock(&server.lock);
+    server.fail_posts = true;
+    pthread_mutex_unlock(&server.lock);
+    trackers[0].objectives[0].current_score = 1;
+    push_and_wait(&worker, trackers, TRACKERS, 500);
+    pthread_mutex_lock(&server.lock);
+    server.fail_posts = false;
+    pthread_mutex_unlock(&server.lock);
+    trackers[7].objectives[63].current_score = 9;
+    push_and_wait(&worker, trackers, TRACKERS, 200);
+    assert(count_matches(last_body(&server), "current_score") == 2);
+    assert(strstr(last_body(&server), "\"label\":\"Tracker 0\""));
+
+    sync_worker_resync(&worker);
+    push_and_wait(&worker, trackers, TRACKERS, 200);
+    assert(count_matches(last_body(&server), "current_score") == TRACKERS * OBJECTIVES);
+
+    SyncWorkerStats stats = sync_worker_stats(&worker);
+    assert(stats.objectives_sent == 2 * TRACKERS * OBJECTIVES + 2 + 1 + 2);
+
+    sync_worker_stop(&worker);
+    server_stop(&server);
+    for (int t = 0; t < TRACKERS; t++) combo_release(&trackers[t]);
+    printf("  ✓ Payload scales with changes, failures are resent\n");
+}
+
+void test_fetch_etag() {
+    printf("Test 4: Unchanged objective lists are not downloaded again\n");
+
+    StandInServer server;
+    server_start(&server, "{\"Tracker 0\":[{\"name\":\"Remote\",\"target_score\":40}]}");
+    pthread_mutex_lock(&server.lock);
+    server.etag = "\"v1\"";
+    pthread_mutex_unlock(&server.lock);
+    char url[64];
+    snprintf(url, sizeof(url), "http://127.0.0.1:%u/sync", server.port);
+    SyncWorker worker;
+    assert(sync_worker_start(&worker, url));
+
+    sync_worker_fetch(&worker);
+    SyncResult result = wait_result(&worker);
+    assert(result.http_status == 200 && result.catalog && result.catalog->objective_count == 1);
+    sync_result_free(&result);
+
+    for (int i = 0; i < 3; i++) {
+        sync_worker_fetch(&worker);
+        result = wait_result(&worker);
+        assert(result.http_status == 304 && result.body_size == 0 && !result.catalog);
+        sync_result_free(&result);
+    }
+
+    // A new version on the server is downloaded once
+    pthread_mutex_lock(&server.lock);
+    server.etag = "\"v2\"";
+    pthread_mutex_unlock(&server.lock);
+    sync_worker_fetch(&worker);
+    result = wait_result(&worker);
+    assert(result.http_status == 200 && objective_catalog_find(result.catalog, "Tracker 0"));
+    sync_result_free(&result);
+    sync_worker_fetch(&worker);
+    result = wait_result(&worker);
+    assert(result.http_status == 304);
+    sync_result_free(&result);
+
+    SyncWorkerStats stats = sync_worker_stats(&worker);
+    assert(stats.not_modified == 4 && stats.new_connections == 1);
+
+    sync_worker_stop(&worker);
+    server_stop(&server);
+    printf("  ✓ %u of 6 fetches answered 304\n", stats.not_modified);
+}
+
+int main() {
+    printf("Running sync worker tests...\n\n");
+
+    test_batched_push_and_fetch();
+    printf("\n");
+
+    test_submit_does_not_block();
+    printf("\n");
+
+    test_delta_push();
+    printf("\n");
+
+    test_fetch_etag();
+    printf("\n");
+
+    printf("🎉 All sync worker tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,223 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "src/timer_wheel.h"
+
+#define TEST_TICK 0.01
+
+typedef struct {
+    TimerWheel* wheel;
+    double step;            // Largest dt passed to advance
+    uint32_t fired;
+    uint32_t* fired_by_user;
+    uint32_t repeats_left;
+} FireLog;
+
+static void record_fire(void* context, uint32_t user, double deadline) {
+    FireLog* log = context;
+    // Never early, and late by at most one frame plus one tick
+    assert(log->wheel->now >= deadline - 1e-9);
+    assert(log->wheel->now < deadline + log->step + TEST_TICK + 1e-9);
+    log->fired++;
+    if (log->fired_by_user) log->fired_by_user[user]++;
+}
+
+static int32_t g_pair[2];
+
+static void cancel_partner(void* context, uint32_t user, double deadline) {
+    FireLog* log = context;
+    record_fire(context, user, deadline);
+    assert(timer_wheel_cancel(log->wheel, g_pair[1 - user]));
+}
+
+static void repeat(void* context, uint32_t user, double deadline) {
+    FireLog* log = context;
+    record_fire(context, user, deadline);
+    if (log->repeats_left > 0) {
+        log->repeats_left--;
+        assert(timer_wheel_schedule_at(log->wheel, deadline + 0.5, repeat, log, user) != TIMER_WHEEL_INVALID);
+    }
+}
+
+void test_basic_schedule_and_cancel() {
+    printf("Test 1: Schedule, cancel and remaining time\n");
+
+    TimerWheel wheel;
+    assert(timer_wheel_init(&wheel, TEST_TICK, 4));
+    FireLog log = {&wheel, 0.1, 0, NULL, 0};
+
+    int32_t a = timer_wheel_schedule(&wheel, 1.0, record_fire, &log, 0);
+    int32_t b = timer_wheel_schedule(&wheel, 2.0, record_fire, &log, 1);
+    int32_t c = timer_wheel_schedule(&wheel, 3.0, record_fire, &log, 2);
+    assert(wheel.active_count == 3);
+    assert(timer_wheel_remaining(&wheel, b) > 1.99 && timer_wheel_remaining(&wheel, b) < 2.01);
+
+    assert(timer_wheel_cancel(&wheel, b));
+    assert(!timer_wheel_cancel(&wheel, b));
+    assert(timer_wheel_remaining(&wheel, b) < 0.0);
+
+    assert(timer_wheel_advance(&wheel, 0.99) == 0);
+    assert(timer_wheel_advance(&wheel, 0.01) == 1);
+    assert(!timer_wheel_is_active(&wheel, a));
+    assert(timer_wheel_is_active(&wheel, c));
+    log.step = 5.0;
+    assert(timer_wheel_advance(&wheel, 5.0) == 1);
+    assert(wheel.active_count == 0 && log.fired == 2);
+
+    // Deadlines in the past fire on the next advance
+    timer_wheel_schedule_at(&wheel, 0.5, record_fire, &log, 3);
+    log.step = wheel.now;
+    assert(timer_wheel_advance(&wheel, TEST_TICK) == 1);
+
+    timer_wheel_free(&wheel);
+    printf("  ✓ Timers fire on their tick and cancel in O(1)\n");
+}
+
+void test_random_deadlines() {
+    printf("Test 2: Random deadlines across every level\n");
+
+    // Up to ~28 hours at 10ms ticks reaches the fourth level
+    const uint32_t count = 20000;
+    TimerWheel wheel;
+    assert(timer_wheel_init(&wheel, TEST_TICK, 0));
+    uint32_t* fired_by_user = calloc(count, sizeof(uint32_t));
+    FireLog log = {&wheel, 0.0, 0, fired_by_user, 0};
+
+    srand(42);
+    double max_deadline = 0.0;
+    for (uint32_t i = 0; i < count; i++) {
+        double scale = (i % 4 == 0) ? 100000.0 : (i % 4 == 1) ? 1000.0 : 10.0;
+        double deadline = scale * (double)rand() / RAND_MAX;
+        if (deadline > max_deadline) max_deadline = deadline;
+        assert(timer_wheel_schedule(&wheel, deadline, record_fire, &log, i) == (int32_t)i);
+    }
+    assert(wheel.capacity >= count);
+
+    // Cancel every tenth timer before it fires
+    uint32_t cancelled = 0;
+    for (uint32_t i = 0; i < count; i += 10) {
+        assert(timer_wheel_cancel(&wheel, (int32_t)i));
+        cancelled++;
+    }
+
+    // Mix short frames with long jumps
+    while (wheel.now <= max_deadline + 1.0) {
+        double dt = (rand() % 8 == 0) ? 37.5 : 0.016;
+        log.step = dt;
+        timer_wheel_advance(&wheel, dt);
+    }
+
+    assert(log.fired == count - cancelled);
+    assert(wheel.active_count == 0);
+    for (uint32_t i = 0; i < count; i++) {
+        assert(fired_by_user[i] == (i % 10 == 0 ? 0u : 1u));
+    }
+
+    free(fired_by_user);
+    timer_wheel_free(&wheel);
+    printf("  ✓ %u timers fired exactly once, %u cancelled\n", log.fired, cancelled);
+}
+
+void test_callbacks_modify_wheel() {
+    printf("Test 3: Callbacks reschedule and cancel\n");
+
+    TimerWheel wheel;
+    assert(timer_wheel_init(&wheel, TEST_TICK, 0));
+    FireLog log = {&wheel, 0.1, 0, NULL, 9};
+
+    // Drift-free repeat: ten fires at 0.5s spacing
+    timer_wheel_schedule(&wheel, 0.5, repeat, &log, 0);
+    for (int frame = 0; frame < 50; frame++) {
+        timer_wheel_advance(&wheel, 0.1);
+    }
+    assert(log.fired == 10);
+    assert(wheel.active_count == 0);
+
+    // Two timers due in the same tick; whichever runs first cancels the other
+    log.fired = 0;
+    g_pair[0] = timer_wheel_schedule(&wheel, 1.0, cancel_partner, &log, 0);
+    g_pair[1] = timer_wheel_schedule(&wheel, 1.0, cancel_partner, &log, 1);
+    assert(timer_wheel_advance(&wheel, 1.0) == 1);
+    assert(log.fired == 1 && wheel.active_count == 0);
+
+    // Moving a timer to another owner keeps its deadline
+    int32_t moved = timer_wheel_schedule(&wheel, 0.2, record_fire, &log, 5);
+    timer_wheel_set_user(&wheel, moved, 6);
+    assert(wheel.timers[moved].user == 6);
+
+    timer_wheel_free(&wheel);
+    printf("  ✓ Reentrant schedule and cancel work\n");
+}
+
+void test_idle_advance() {
+    printf("Test 4: Advancing an idle wheel\n");
+
+    TimerWheel wheel;
+    assert(timer_wheel_init(&wheel, 0.001, 0));
+    FireLog log = {&wheel, 0.0, 0, NULL, 0};
+
+    // No pending timers: a day passes without walking the ticks
+    assert(timer_wheel_advance(&wheel, 86400.0) == 0);
+    assert(wheel.current_tick == 86400000ull);
+
+    log.step = 0.25;
+    timer_wheel_schedule(&wheel, 0.25, record_fire, &log, 0);
+    assert(timer_wheel_advance(&wheel, 0.25) == 1);
+
+    timer_wheel_free(&wheel);
+    printf("  ✓ Idle time is skipped\n");
+}
+
+void test_sparse_advance() {
+    printf("Test 5: Long advances with timers pending\n");
+
+    TimerWheel wheel;
+    assert(timer_wheel_init(&wheel, 0.001, 0));
+    uint32_t fired_by_user[4] = {0};
+    FireLog log = {&wheel, 3600.0, 0, fired_by_user, 0};
+
+    // An hour asleep at 1ms ticks with a few far-apart timers pending
+    timer_wheel_schedule(&wheel, 0.5, record_fire, &log, 0);
+    timer_wheel_schedule(&wheel, 61.25, record_fire, &log, 1);
+    timer_wheel_schedule(&wheel, 1800.0, record_fire, &log, 2);
+    timer_wheel_schedule(&wheel, 7200.0, record_fire, &log, 3);
+    assert(timer_wheel_advance(&wheel, 3600.0) == 3);
+    assert(fired_by_user[0] == 1 && fired_by_user[1] == 1 && fired_by_user[2] == 1);
+    assert(fired_by_user[3] == 0 && wheel.active_count == 1);
+    assert(wheel.current_tick == 3600000ull);
+    printf("  Visited %llu of 3600000 ticks\n", (unsigned long long)wheel.visited_ticks);
+    assert(wheel.visited_ticks < 64);
+
+    // Frame-sized steps still fire on time after the jump
+    log.step = 0.016;
+    while (wheel.now < 7200.5) {
+        timer_wheel_advance(&wheel, 0.016);
+    }
+    assert(fired_by_user[3] == 1 && wheel.active_count == 0);
+
+    timer_wheel_free(&wheel);
+    printf("  ✓ Only ticks that fire or cascade are visited\n");
+}
+
+int main() {
+    printf("Running timer wheel tests...\n\n");
+
+    test_basic_schedule_and_cancel();
+    printf("\n");
+
+    test_random_deadlines();
+    printf("\n");
+
+    test_callbacks_modify_wheel();
+    printf("\n");
+
+    test_idle_advance();
+    printf("\n");
+
+    test_sparse_advance();
+    printf("\n");
+
+    printf("🎉 All timer wheel tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "src/core.h"
+#include "src/tracker_store.h"
+
+static long file_size(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    return size;
+}
+
+void test_create_and_reopen() {
+    printf("Test 1: Create store and reopen without parsing\n");
+
+    remove("test_store.map");
+    TrackerStore store;
+    assert(tracker_store_open(&store, "test_store.map", 4));
+    assert(tracker_store_count(&store) == 0);
+
+    ComboState trackers[3];
+    const char* labels[3] = {"Push-ups", "Squats", "Reading"};
+    for (int i = 0; i < 3; i++) {
+        combo_init(&trackers[i], labels[i]);
+        combo_resume(&trackers[i]);
+        combo_increment(&trackers[i], (uint32_t)(i + 1) * 5);
+        int index = tracker_store_add(&store, labels[i]);
+        assert(index == i);
+        tracker_store_put(&store, (uint32_t)index, &trackers[i]);
+    }
+    tracker_store_close(&store);
+
+    assert(tracker_store_open(&store, "test_store.map", 4));
+    assert(tracker_store_count(&store) == 3);
+    for (int i = 0; i < 3; i++) {
+        ComboState loaded;
+        tracker_store_get(&store, (uint32_t)i, &loaded);
+        printf("  %s: score %d, combo %d\n", loaded.label, loaded.score, loaded.combo);
+        assert(strcmp(loaded.label, labels[i]) == 0);
+        assert(loaded.score == trackers[i].score);
+        assert(loaded.combo == trackers[i].combo);
+        assert(loaded.paused == trackers[i].paused);
+        assert(loaded.total_hits == trackers[i].total_hits);
+    }
+    tracker_store_close(&store);
+    printf("  ✓ Records survive close and reopen\n");
+}
+
+void test_in_place_updates() {
+    printf("Test 2: In-place updates with batched sync\n");
+
+    TrackerStore store;
+    assert(tracker_store_open(&store, "test_store.map", 4));
+
+    TrackerRecord* record = tracker_store_record(&store, 1);
+    assert(record != NULL);
+    int start_score = record->score;
+    for (int i = 0; i < 200; i++) {
+        record->score += 1;
+        record->total_hits += 1;
+        tracker_store_touch(&store, 1);
+    }
+    // Auto-sync keeps the backlog below one batch
+    assert(store.pending_updates < TRACKER_STORE_SYNC_BATCH);
+    tracker_store_close(&store);
+
+    assert(tracker_store_open(&store, "test_store.map", 4));
+    record = tracker_store_record(&store, 1);
+    assert(record->score == start_score + 200);
+    assert(tracker_store_record(&store, 3) == NULL);
+    tracker_store_close(&store);
+    printf("  ✓ Direct record updates are persisted\n");
+}
+
+void test_growth_and_corruption() {
+    printf("Test 3: Growth past capacity and invalid files\n");
+
+    TrackerStore store;
+    assert(tracker_store_open(&store, "test_store.map", 4));
+    char label[MAX_LABEL_LENGTH];
+    for (int i = 3; i < 100; i++) {
+        snprintf(label, sizeof(label), "Tracker %d", i);
+        assert(tracker_store_add(&store, label) == i);
+    }
+    assert(store.header->capacity >= 100);
+    tracker_store_close(&store);
+
+    assert(tracker_store_open(&store, "test_store.map", 4));
+    assert(tracker_store_count(&store) == 100);
+    assert(strcmp(tracker_store_record(&store, 99)->label, "Tracker 99") == 0);
+    assert(strcmp(tracker_store_record(&store, 0)->label, "Push-ups") == 0);
+    tracker_store_close(&store);
+    printf("  ✓ Store grew to %d trackers\n", 100);
+
+    FILE* f = fopen("test_store.map", "r+b");
+    fwrite("JUNK", 1, 4, f);
+    fclose(f);
+    long junk_size = file_size("test_store.map");
+    assert(tracker_store_open(&store, "test_store.map", 4));
+    assert(tracker_store_count(&store) == 0);
+    tracker_store_close(&store);
+    // The old contents are set aside, not truncated
+    assert(file_size("test_store.map.invalid") == junk_size);
+    remove("test_store.map.invalid");
+    printf("  ✓ Invalid store is set aside and recreated\n");
+
+    // A small file that is not a store at all, e.g. a wrong path
+    f = fopen("test_store.map", "wb");
+    fputs("not a tracker store\n", f);
+    fclose(f);
+    assert(tracker_store_open(&store, "test_store.map", 4));
+    tracker_store_close(&store);
+    assert(file_size("test_store.map.invalid") == 20);
+    remove("test_store.map.invalid");
+
+    // A store from a newer version is not opened and not touched
+    f = fopen("test_store.map", "r+b");
+    uint32_t future = TRACKER_STORE_VERSION + 1;
+    fseek(f, 4, SEEK_SET);
+    fwrite(&future, sizeof(future), 1, f);
+    fclose(f);
+    long store_size = file_size("test_store.map");
+    assert(!tracker_store_open(&store, "test_store.map", 4));
+    assert(file_size("test_store.map") == store_size);
+    assert(file_size("test_store.map.invalid") == -1);
+    printf("  ✓ Newer store versions are refused\n");
+}
+
+int main() {
+    printf("Running tracker store tests...\n\n");
+
+    test_create_and_reopen();
+    printf("\n");
+
+    test_in_place_updates();
+    printf("\n");
+
+    test_growth_and_corruption();
+    printf("\n");
+
+    printf("🎉 All tracker store tests passed!\n");
+
+    remove("test_store.map");
+    return 0;
+}